@@ -335,7 +335,7 @@ void
 graph::
 reset() const
 {
-  xdp::native::profiling_wrapper("xrt::graph::reset", [=]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::reset")>([=]{
     handle->reset();
   });
 }
@@ -344,14 +344,14 @@ uint64_t
 graph::
 get_timestamp() const
 {
-  return xdp::native::profiling_wrapper("xrt::graph::get_timestamp", [=]{return (handle->get_timestamp());});
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::get_timestamp")>([=]{return (handle->get_timestamp());});
 }
 
 void
 graph::
 run(uint32_t iterations)
 {
-  xdp::native::profiling_wrapper("xrt::graph::run", [=]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::run")>([=]{
     handle->run(iterations);
   });
 }
@@ -360,7 +360,7 @@ void
 graph::
 wait(std::chrono::milliseconds timeout_ms)
 {
-  xdp::native::profiling_wrapper("xrt::graph::wait", [=]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::wait")>([=]{
     if (timeout_ms.count() == 0)
       handle->wait(static_cast<uint64_t>(0));
     else
@@ -372,7 +372,7 @@ void
 graph::
 wait(uint64_t cycles)
 {
-  xdp::native::profiling_wrapper("xrt::graph::wait", [=]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::wait")>([=]{
     handle->wait(cycles);
   });
 }
@@ -381,7 +381,7 @@ void
 graph::
 suspend()
 {
-  xdp::native::profiling_wrapper("xrt::graph::suspend", [=]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::suspend")>([=]{
     handle->suspend();
   });
 }
@@ -390,7 +390,7 @@ void
 graph::
 resume()
 {
-  xdp::native::profiling_wrapper("xrt::graph::resume", [=]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::resume")>([=]{
     handle->resume();
   });
 }
@@ -399,7 +399,7 @@ void
 graph::
 end(uint64_t cycles)
 {
-  xdp::native::profiling_wrapper("xrt::graph::end", [=]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::end")>([=]{
     handle->end(cycles);
   });
 }
@@ -408,7 +408,7 @@ void
 graph::
 update_port(const std::string& port_name, const void* value, size_t bytes)
 {
-  xdp::native::profiling_wrapper("xrt::graph::update_port", [=]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::update_port")>([=]{
     handle->update_rtp(port_name.c_str(), reinterpret_cast<const char*>(value), bytes);
   });
 }
@@ -417,7 +417,7 @@ void
 graph::
 read_port(const std::string& port_name, void* value, size_t bytes)
 {
-  xdp::native::profiling_wrapper("xrt::graph::read_port", [=]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::graph::read_port")>([=]{
     handle->read_rtp(port_name.c_str(), reinterpret_cast<char *>(value), bytes);
   });
 }
@@ -444,7 +444,7 @@ profiling::
 start(xrt::aie::profiling::profiling_option option, const std::string& port1_name, const std::string& port2_name, uint32_t value) const
 {
   int opt = static_cast<int>(option);
-  return xdp::native::profiling_wrapper("xrt::aie::profiling::start", [this, opt, &port1_name, &port2_name, value] {
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::aie::profiling::start")>([this, opt, &port1_name, &port2_name, value] {
     return get_handle()->start(opt, port1_name, port2_name, value);
   });
 }
@@ -453,7 +453,7 @@ uint64_t
 profiling::
 read() const
 {
-  return xdp::native::profiling_wrapper("xrt::aie::profiling::read", [this] {
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::aie::profiling::read")>([this] {
     return get_handle()->read();
   });
 }
@@ -462,7 +462,7 @@ void
 profiling::
 stop() const
 {
-  xdp::native::profiling_wrapper("xrt::aie::profiling::stop", [this] {
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::aie::profiling::stop")>([this] {
     return get_handle()->stop();
   });
 }
@@ -6,6 +6,7 @@
 #include "core/common/config.h"
 // This file defines implementation extensions to the XRT XCLBIN APIs.
 #include "core/include/experimental/xrt_hw_context.h"
+#include "core/include/experimental/xrt_kernel.h"
 
 #include <cstdint>
 
@@ -32,6 +33,14 @@ get_core_device_raw(const xrt::hw_context& ctx);
 void
 set_exclusive(xrt::hw_context& ctx);
 
+// Get and set the wait policy of run objects in this context,
+// see xrt::set_wait_policy().  Default is wait_policy::inherit.
+xrt::wait_policy
+get_wait_policy(const xrt::hw_context& ctx);
+
+void
+set_wait_policy(const xrt::hw_context& ctx, xrt::wait_policy policy);
+
 // Allows the creation of the hardware context from a void pointer
 // to the hardware context implementation. We use a void pointer
 // because we need to dynamically link to the callbacks that exist in 
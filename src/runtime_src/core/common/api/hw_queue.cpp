@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cassert>
 #include <chrono>
 #include <condition_variable>
 #include <map>
@@ -42,6 +43,155 @@ namespace {
 using command_queue_type = std::vector<xrt_core::command*>;
 static std::exception_ptr s_exception;
 
+// Cache line size used to keep producer and consumer indices apart
+constexpr size_t cache_line_size = 64;
+
+// Timeout used by the command monitor when waiting for command
+// completion.  The wait is bounded so that a cancelled submission
+// can never stall the monitor indefinitely.
+constexpr size_t monitor_wait_ms = 1000;
+
+// class submission_ring - bounded lock-free multi-producer single-consumer
+//
+// @m_slots: Ring of command slots, each with its own sequence number
+// @m_enqueue_pos: Next position to be reserved by a producer
+// @m_dequeue_pos: Next position to be consumed by the monitor thread
+//
+// Commands submitted for managed execution are pushed by the
+// launching thread and drained by the monitor thread without any
+// locking.  The algorithm is the bounded queue by D. Vyukov where a
+// per-slot sequence number tells producers and the consumer whether a
+// slot is free, reserved, or published.
+//
+// Publication is split in two steps.  A producer first reserves a slot
+// before the command is submitted to the driver, and publishes (or
+// cancels) the slot after submission returns.  This guarantees that the
+// monitor thread, which drains all reserved slots after exec_wait, will
+// always see a command for which exec_wait has returned, and that a
+// failed submission is never tracked by the monitor.
+//
+// A batch of commands reserves a contiguous range of slots with one
+// atomic operation.  Slots are freed by the consumer in order, so the
+// range is free if its last slot is free.
+class submission_ring
+{
+public:
+  static constexpr size_t capacity = 4096; // must be power of 2
+
+private:
+  static constexpr size_t mask = capacity - 1;
+
+  struct slot
+  {
+    std::atomic<size_t> seq;
+    xrt_core::command* cmd = nullptr;
+  };
+
+  std::unique_ptr<slot[]> m_slots;
+  alignas(cache_line_size) std::atomic<size_t> m_enqueue_pos {0};
+  alignas(cache_line_size) size_t m_dequeue_pos {0};
+
+public:
+  // Opaque reservation returned to producer
+  struct ticket
+  {
+    size_t pos = 0;
+    size_t count = 0;
+  };
+
+  submission_ring()
+    : m_slots(std::make_unique<slot[]>(capacity))
+  {
+    for (size_t i = 0; i < capacity; ++i)
+      m_slots[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  // reserve() - Reserve slots for @count commands (producer)
+  //
+  // Spin (yield) while the ring is full.  A full ring implies that
+  // the monitor thread has commands to drain, so this cannot block
+  // forever.  The @count must not exceed the ring capacity.
+  ticket
+  reserve(xrt_core::command* const* cmds, size_t count)
+  {
+    assert(count > 0 && count <= capacity);
+    auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      auto last = pos + count - 1;
+      auto seq = m_slots[last & mask].seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(last);
+      if (diff == 0) {
+        if (m_enqueue_pos.compare_exchange_weak(pos, pos + count)) {
+          for (size_t idx = 0; idx < count; ++idx)
+            m_slots[(pos + idx) & mask].cmd = cmds[idx];
+          return {pos, count};
+        }
+      }
+      else if (diff < 0) {
+        // full, let the monitor catch up
+        std::this_thread::yield();
+        pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      }
+      else {
+        pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // publish() - Make reserved commands visible to consumer (producer)
+  //
+  // The first @submitted commands of the reservation are published,
+  // remaining slots are released without a command.
+  void
+  publish(const ticket& t, size_t submitted)
+  {
+    for (size_t idx = 0; idx < t.count; ++idx) {
+      auto s = &m_slots[(t.pos + idx) & mask];
+      if (idx >= submitted)
+        s->cmd = nullptr;
+      s->seq.store(t.pos + idx + 1, std::memory_order_release);
+    }
+  }
+
+  // cancel() - Release reserved slots without commands (producer)
+  void
+  cancel(const ticket& t)
+  {
+    publish(t, 0);
+  }
+
+  // empty() - Check if all reserved slots have been consumed (consumer)
+  bool
+  empty() const
+  {
+    return m_enqueue_pos.load() == m_dequeue_pos;
+  }
+
+  // drain() - Consume all slots reserved prior to this call (consumer)
+  //
+  // Published commands are appended to @cmds, cancelled slots are
+  // skipped.  The function waits for slots that are reserved but not
+  // yet published, which is the duration of a command submission.
+  void
+  drain(command_queue_type& cmds)
+  {
+    auto end = m_enqueue_pos.load();
+    while (m_dequeue_pos != end) {
+      auto s = &m_slots[m_dequeue_pos & mask];
+      if (s->seq.load(std::memory_order_acquire) != m_dequeue_pos + 1) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      if (s->cmd)
+        cmds.push_back(s->cmd);
+
+      s->seq.store(m_dequeue_pos + capacity, std::memory_order_release);
+      ++m_dequeue_pos;
+    }
+  }
+};
+
 inline ert_cmd_state
 get_command_state(xrt_core::command* cmd)
 {
@@ -80,9 +230,15 @@ notify_host(xrt_core::command* cmd)
 // @m_qimpl: The hw queue used for command submission
 // @work_mutex: Syncrhonize monitor thread with launched commands
 // @work_cond: Kick off monitor thread when there are new commands
+// @submitted_cmds: Lock-free ring of commands submitted by launch()
+// @idle: Monitor thread is (about to be) blocked on work_cond
 // @monitor_thread: Thread for asynchronous monitoring of command execution
 // @stop: Stop the monitor thread
 //
+// Launching threads push commands to the monitor through a lock-free
+// ring.  The work mutex and condition variable are used only when the
+// monitor thread is idle, e.g. there are no running commands.
+//
 // This is constructed on demand when commands are submitted for managed
 // execution through a command queue.  Managed execution means that
 // commands are submitted for execution and receive a callback on
@@ -101,18 +257,43 @@ public:
 
     virtual void
     submit(xrt_core::command* cmd) = 0;
+
+    // Submit @count commands in order, return number of commands
+    // submitted.  Throws if the first command cannot be submitted.
+    virtual size_t
+    submit(xrt_core::command* const* cmds, size_t count) = 0;
   };
 
 private:
   executor* m_impl;
   std::mutex work_mutex;
   std::condition_variable work_cond;
-  command_queue_type submitted_cmds;
-  bool stop = false;
+  submission_ring submitted_cmds;
+  std::atomic<bool> idle {false};
+  std::atomic<bool> stop {false};
 
   // thread can be constructed only after data members are initialized
   std::thread monitor_thread;
 
+  // notify_completed() - Notify completed commands in range
+  //
+  // Commands in running_cmds starting at index @first are checked for
+  // completion.  Completed commands are notified and removed, busy
+  // commands are compacted in place, preserving order of processing.
+  static void
+  notify_completed(command_queue_type& running_cmds, size_t first)
+  {
+    auto busy = first;
+    for (auto idx = first; idx < running_cmds.size(); ++idx) {
+      auto cmd = running_cmds[idx];
+      if (completed(cmd))
+        notify_host(cmd);
+      else
+        running_cmds[busy++] = cmd;
+    }
+    running_cmds.resize(busy);
+  }
+
   // monitor_loop() - Manage running commands and notify on completion
   //
   // The monitor thread services managed command and asynchronously
@@ -123,57 +304,53 @@ private:
   void
   monitor_loop()
   {
-    std::vector<xrt_core::command*> busy_cmds;
-    std::vector<xrt_core::command*> running_cmds;
+    command_queue_type running_cmds;
 
     while (true) {
 
-      // Larger wait synchronized with launch()
-      {
+      // Larger wait synchronized with launch().  The idle flag is set
+      // before checking for submitted commands, and launch() checks the
+      // flag after publishing a command, so at least one side sees
+      // the other and a wakeup cannot be lost.
+      if (running_cmds.empty()) {
         std::unique_lock<std::mutex> lk(work_mutex);
-        while (!stop && running_cmds.empty() && submitted_cmds.empty())
+        idle = true;
+        while (!stop && submitted_cmds.empty())
           work_cond.wait(lk);
+        idle = false;
       }
 
       if (stop)
         return;
 
       // Finer wait
-      m_impl->wait(0);
+      auto status = m_impl->wait(monitor_wait_ms);
 
       // Drain submitted commands.  It is important that this comes
-      // after exec_wait and is synchronized with launch() that added
-      // to submitted_cmds.
+      // after exec_wait.
       //
       // Scenario if before exec_wait is that a new command was added
-      // to submitted_cmds and exec_buf immediately after the critical
-      // section above and that the command completion happens in the
-      // exec_wait call. If submitted_cmds was drained, in for example
-      // above critical section, before the call to exec_wait it would
-      // not be in running_cmds and would not be notified of
+      // to submitted_cmds and exec_buf immediately after the drain and
+      // that the command completion happens in the exec_wait call. If
+      // submitted_cmds was drained before the call to exec_wait it
+      // would not be in running_cmds and would not be notified of
       // completion.
       //
       // The sequence is very important.  It must be guaranteed that
-      // exec_wait will never return for a command that is not yet
-      // in either running_cmds or submitted_cmds.
-      {
-        std::lock_guard<std::mutex> lk(work_mutex);
-        std::copy(submitted_cmds.begin(), submitted_cmds.end(), std::back_inserter(running_cmds));
-        submitted_cmds.clear();
-      }
-      // At this point running_cmds is guaranteed to contain the
-      // command(s) for which exec_wait returned.
-
-      // Preserve order of processing
-      for (auto cmd : running_cmds) {
-        if (completed(cmd))
-          notify_host(cmd);
-        else
-          busy_cmds.push_back(cmd);
-      }
+      // exec_wait will never return for a command that is not yet in
+      // either running_cmds or submitted_cmds.  This is guaranteed by
+      // launch() reserving a ring slot prior to exec_buf, and by drain
+      // waiting for reserved slots to be published.
+      auto first_new = running_cmds.size();
+      submitted_cmds.drain(running_cmds);
 
-      running_cmds.swap(busy_cmds);
-      busy_cmds.clear();
+      // At this point running_cmds is guaranteed to contain the
+      // command(s) for which exec_wait returned.  If exec_wait timed
+      // out, no previously running command changed state and only the
+      // newly drained commands need to be checked.  Otherwise all
+      // running commands are checked, exec_wait does not tell which
+      // command completed.
+      notify_completed(running_cmds, status == std::cv_status::timeout ? first_new : 0);
     } // while (1)
   }
 
@@ -209,8 +386,8 @@ public:
     XRT_DEBUGF("command_manager::~command_manager() executor(0x%x)\n", m_impl);
     {
       // Modify stop while keeping the lock so that the multi
-      // conditional wait in monitor_loop is atomic.  E.g., a
-      // std::atomic stop is not sufficient.
+      // conditional wait in monitor_loop is atomic.  The flag is
+      // atomic because a busy monitor checks it without the lock.
       std::lock_guard lk(work_mutex);
       stop = true;
       work_cond.notify_one();
@@ -236,6 +413,20 @@ public:
     m_impl = impl;
   }
 
+  // wakeup() - Wake the monitor thread if it is idle
+  //
+  // Waking the monitor is somewhat expensive, it is done only if
+  // the monitor is idle and after the exec_buf call so that actual
+  // execution doesn't have to wait.
+  void
+  wakeup()
+  {
+    if (idle) {
+      std::lock_guard<std::mutex> lk(work_mutex);
+      work_cond.notify_one();
+    }
+  }
+
   // launch() - Submit a command for managed execution
   //
   // This function is used to schedule managed commands for
@@ -247,30 +438,55 @@ public:
   {
     XRT_DEBUGF("xrt_core::kds::command(%d) [new->submitted->running]\n", cmd->get_uid());
 
-    // Store command so completion can be tracked.  Make sure this is
-    // done prior to exec_buf as exec_wait can otherwise be missed.
-    // See detailed explanation in monitor loop.
-    {
-      std::lock_guard<std::mutex> lk(work_mutex);
-      submitted_cmds.push_back(cmd);
-    }
+    // Reserve a slot for the command so completion can be tracked.
+    // Make sure this is done prior to exec_buf as exec_wait can
+    // otherwise be missed.  See detailed explanation in monitor loop.
+    auto ticket = submitted_cmds.reserve(&cmd, 1);
 
     // Submit the command
     try {
       m_impl->submit(cmd);
     }
     catch (...) {
-      // Remove the pending command
-      std::lock_guard<std::mutex> lk(work_mutex);
+      // Release the reserved slot, the command is not running
       assert(get_command_state(cmd)==ERT_CMD_STATE_NEW);
-      if (!submitted_cmds.empty())
-        submitted_cmds.pop_back();
+      submitted_cmds.cancel(ticket);
+      throw;
+    }
+
+    submitted_cmds.publish(ticket, 1);
+    wakeup();
+  }
+
+  // launch() - Submit a batch of commands for managed execution
+  //
+  // The commands are submitted to the executor in one call and the
+  // monitor is woken at most once for the entire batch.  Returns the
+  // number of commands launched from the front of the batch, throws
+  // if the first command could not be launched.
+  size_t
+  launch(xrt_core::command* const* cmds, size_t count)
+  {
+    count = std::min(count, submission_ring::capacity);
+
+    XRT_DEBUGF("xrt_core::kds::command(%d) batch(%d) [new->submitted->running]\n", cmds[0]->get_uid(), count);
+
+    // Reserve slots for all commands prior to exec_buf, same as
+    // single command launch
+    auto ticket = submitted_cmds.reserve(cmds, count);
+
+    size_t submitted = 0;
+    try {
+      submitted = m_impl->submit(cmds, count);
+    }
+    catch (...) {
+      submitted_cmds.cancel(ticket);
       throw;
     }
 
-    // This is somewhat expensive, it is better to have this after the
-    // exec_buf call so that actual execution doesn't have to wait.
-    work_cond.notify_one();
+    submitted_cmds.publish(ticket, submitted);
+    wakeup();
+    return submitted;
   }
 };
 
@@ -372,6 +588,10 @@ public:
   virtual void
   submit(xrt_core::command* cmd) = 0;  // NOLINT override from base
 
+  // Submit batch of commands for execution
+  virtual size_t
+  submit(xrt_core::command* const* cmds, size_t count) = 0;  // NOLINT override from base
+
   // Wait for some command to finish
   virtual std::cv_status
   wait(size_t timeout_ms) = 0;         // NOLINT override from base
@@ -396,6 +616,23 @@ public:
   virtual void
   submit_signal(const xrt::fence& fence) = 0;
 
+  // Busy poll for completion of an unmanaged command until deadline.
+  // The command is notified if it completes.
+  std::cv_status
+  spin_wait(const xrt_core::command* cmd, const std::chrono::steady_clock::time_point& deadline) const
+  {
+    volatile auto pkt = cmd->get_ert_packet();
+    while (true) {
+      if (poll(cmd) && pkt->state >= ERT_CMD_STATE_COMPLETED) {
+        notify_host(const_cast<xrt_core::command*>(cmd), static_cast<ert_cmd_state>(pkt->state)); // NOLINT
+        return std::cv_status::no_timeout;
+      }
+
+      if (std::chrono::steady_clock::now() >= deadline)
+        return std::cv_status::timeout;
+    }
+  }
+
   // Managed start uses command manager for monitoring command
   // completion
   void
@@ -412,6 +649,38 @@ public:
     submit(cmd);
   }
 
+  // Managed start of a batch of commands.  Batches larger than the
+  // command manager's submission ring are launched in chunks.
+  size_t
+  managed_start(const std::vector<xrt_core::command*>& cmds)
+  {
+    auto mgr = get_cmd_manager();
+    size_t started = 0;
+    while (started < cmds.size()) {
+      auto remaining = cmds.size() - started;
+      size_t count = 0;
+      try {
+        count = mgr->launch(cmds.data() + started, remaining);
+      }
+      catch (...) {
+        if (!started)
+          throw;
+        break;
+      }
+      started += count;
+      if (count < std::min(remaining, submission_ring::capacity))
+        break;
+    }
+    return started;
+  }
+
+  // Unmanaged start of a batch of commands
+  size_t
+  unmanaged_start(const std::vector<xrt_core::command*>& cmds)
+  {
+    return cmds.empty() ? 0 : submit(cmds.data(), cmds.size());
+  }
+
 };
 
 // class qds_device - queue implementation for shim queue support
@@ -466,6 +735,15 @@ public:
     m_qhdl->submit_command(cmd->get_exec_bo());
   }
 
+  size_t
+  submit(xrt_core::command* const* cmds, size_t count) override
+  {
+    std::vector<xrt_core::buffer_handle*> bos(count);
+    std::transform(cmds, cmds + count, bos.begin(),
+                   [](auto cmd) { return cmd->get_exec_bo(); });
+    return m_qhdl->submit_command(bos);
+  }
+
   void
   submit(xrt_core::buffer_handle* cmd) override
   {
@@ -674,6 +952,26 @@ public:
     m_device->exec_buf(cmd->get_exec_bo());
   }
 
+  // Commands in the batch that share submission context are passed
+  // to the shim in one call.  Device specific commands are submitted
+  // one at a time.
+  size_t
+  submit(xrt_core::command* const* cmds, size_t count) override
+  {
+    auto hwctx = cmds[0]->get_hwctx_handle();
+    if (!hwctx) {
+      submit(cmds[0]);
+      return 1;
+    }
+
+    std::vector<xrt_core::buffer_handle*> bos;
+    bos.reserve(count);
+    for (size_t idx = 0; idx < count && cmds[idx]->get_hwctx_handle() == hwctx; ++idx)
+      bos.push_back(cmds[idx]->get_exec_bo());
+
+    return hwctx->exec_buf(bos);
+  }
+
   void
   submit(xrt_core::buffer_handle* cmd) override
   {
@@ -878,6 +1176,20 @@ unmanaged_start(xrt_core::command* cmd)
   get_handle()->unmanaged_start(cmd);
 }
 
+size_t
+hw_queue::
+managed_start(const std::vector<xrt_core::command*>& cmds)
+{
+  return get_handle()->managed_start(cmds);
+}
+
+size_t
+hw_queue::
+unmanaged_start(const std::vector<xrt_core::command*>& cmds)
+{
+  return get_handle()->unmanaged_start(cmds);
+}
+
 void
 hw_queue::
 submit(xrt_core::buffer_handle* cmd)
@@ -936,6 +1248,13 @@ wait(const xrt_core::command* cmd, const std::chrono::milliseconds& timeout_ms)
   return get_handle()->wait(cmd, timeout_ms.count());
 }
 
+std::cv_status
+hw_queue::
+spin_wait(const xrt_core::command* cmd, const std::chrono::steady_clock::time_point& deadline) const
+{
+  return get_handle()->spin_wait(cmd, deadline);
+}
+
 std::cv_status
 hw_queue::
 exec_wait(const xrt_core::device* device, const std::chrono::milliseconds& timeout_ms)
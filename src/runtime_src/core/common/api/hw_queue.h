@@ -56,6 +56,21 @@ public:
   void
   unmanaged_start(xrt_core::command* cmd);
 
+  // Start a batch of commands in order and manage their execution.
+  // The commands are submitted through a single submission call and
+  // the command monitor is woken at most once for the batch.
+  //
+  // Returns the number of commands started from the front of the
+  // batch, which is less than the batch size only if submission of
+  // a command failed.  Throws if the first command cannot be started.
+  size_t
+  managed_start(const std::vector<xrt_core::command*>& cmds);
+
+  // Start a batch of commands in order with explicit completion
+  // control from application.  Return value as managed_start().
+  size_t
+  unmanaged_start(const std::vector<xrt_core::command*>& cmds);
+
   // Submit a raw cmd for execution
   void
   submit(xrt_core::buffer_handle* cmd);
@@ -75,6 +90,12 @@ public:
   std::cv_status
   wait(const xrt_core::command* cmd, const std::chrono::milliseconds& timeout) const;
 
+  // Busy poll for command completion until deadline without
+  // blocking.  Returns std::cv_status::timeout if the command did not
+  // complete before the deadline.  Supports unmanaged commands only.
+  std::cv_status
+  spin_wait(const xrt_core::command* cmd, const std::chrono::steady_clock::time_point& deadline) const;
+
   // Poll for command state. A return value of 0 indicates the command
   // is still running. Any other return value implies the command
   // state must be checked.
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef NATIVE_API_IDS_DOT_H
+#define NATIVE_API_IDS_DOT_H
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+// The Native XRT APIs that are profiled.  Every API is identified by
+// its index in the name table, which is shared by XRT and the XDP
+// plugin so only the index is passed when an API is called.
+namespace xdp::native {
+
+constexpr const char* api_names[] = {
+  // xrt::bo
+  "xrt::bo::bo",
+  "xrt::bo::size",
+  "xrt::bo::address",
+  "xrt::bo::memory_group",
+  "xrt::bo::get_flags",
+  "xrt::bo::export_buffer",
+  "xrt::bo::sync",
+  "xrt::bo::map",
+  "xrt::bo::write",
+  "xrt::bo::read",
+  "xrt::bo::copy",
+  "xrt::sync",
+  "xrtBOAllocUserPtr",
+  "xrtBOAlloc",
+  "xrtBOSubAlloc",
+  "xrtBOImport",
+  "xrtBOExport",
+  "xrtBOAllocFromXcl",
+  "xrtBOFree",
+  "xrtBOSize",
+  "xrtBOSync",
+  "xrtBOMap",
+  "xrtBOWrite",
+  "xrtBORead",
+  "xrtBOCopy",
+  "xrtBOAddress",
+
+  // xrt::device
+  "xrt::device::device",
+  "xrt::device::load_xclbin",
+  "xrt::device::register_xclbin",
+  "xrt::device::get_xclbin_uuid",
+  "xrt::device::reset",
+  "xrt::device::get_xclbin_section",
+  "xrt::device::read_aie_reg",
+  "xrt::device::write_aie_reg",
+  "xrt::aie::device::read_aie_mem",
+  "xrt::aie::device::write_aie_mem",
+  "xrtDeviceOpen",
+  "xrtDeviceOpenByBDF",
+  "xrtDeviceClose",
+  "xrtDeviceLoadXclbin",
+  "xrtDeviceLoadXclbinFile",
+  "xrtDeviceLoadXclbinHandle",
+  "xrtDeviceLoadXclbinUUID",
+  "xrtDeviceGetXclbinUUID",
+  "xrtDeviceToXclDevice",
+  "xrtDeviceOpenFromXcl",
+
+  // xrt::error
+  "xrt::error::error",
+  "xrt::error::get_timestamp",
+  "xrt::error::get_error_code",
+  "xrt::error::to_string",
+  "xrtErrorGetLast",
+  "xrtErrorGetString",
+
+  // xrt::ip
+  "xrt::ip::write_register",
+  "xrt::ip::read_register",
+
+  // xrt::kernel and xrt::run
+  "xrt::run::run",
+  "xrt::run::start",
+  "xrt::run::wait",
+  "xrt::run::state",
+  "xrt::run::return_code",
+  "xrt::run::get_ert_packet",
+  "xrt::run::submit_wait",
+  "xrt::run::submit_signal",
+  "xrt::start",
+  "xrt::kernel::kernel",
+  "xrt::kernel::read_register",
+  "xrt::kernel::write_register",
+  "xrt::kernel::group_id",
+  "xrt::kernel::offset",
+  "xrtPLKernelOpen",
+  "xrtPLKernelOpenExclusive",
+  "xrtKernelClose",
+  "xrtRunOpen",
+  "xrtKernelArgGroupId",
+  "xrtKernelArgOffset",
+  "xrtKernelReadRegister",
+  "xrtKernelWriteRegister",
+  "xrtKernelRun",
+  "xrtRunClose",
+  "xrtRunState",
+  "xrtRunWait",
+  "xrtRunWaitFor",
+  "xrtRunSetCallback",
+  "xrtRunStart",
+  "xrtRunUpdateArg",
+  "xrtRunUpdateArgV",
+  "xrtRunSetArg",
+  "xrtRunSetArgV",
+  "xrtRunGetArgV",
+  "xrtRunGetArgVPP",
+
+  // xrt::xclbin
+  "xrtXclbinAllocFilename",
+  "xrtXclbinAllocRawData",
+  "xrtXclbinFreeHandle",
+  "xrtXclbinGetXSAName",
+  "xrtXclbinGetUUID",
+  "xrtXclbinGetNumKernels",
+  "xrtXclbinGetNumKernelComputeUnits",
+  "xrtXclbinGetData",
+  "xrtXclbinUUID",
+
+  // xrt::graph and xrt::aie
+  "xrt::graph::reset",
+  "xrt::graph::get_timestamp",
+  "xrt::graph::run",
+  "xrt::graph::wait",
+  "xrt::graph::suspend",
+  "xrt::graph::resume",
+  "xrt::graph::end",
+  "xrt::graph::update_port",
+  "xrt::graph::read_port",
+  "xrt::aie::profiling::start",
+  "xrt::aie::profiling::read",
+  "xrt::aie::profiling::stop",
+};
+
+constexpr uint16_t num_apis = static_cast<uint16_t>(std::size(api_names));
+
+// Look up the id of an API by name.  Used as a template argument, an
+// API that is missing from the table fails to compile.
+constexpr uint16_t
+api_id(std::string_view name)
+{
+  for (uint16_t id = 0; id < num_apis; ++id) {
+    if (name == api_names[id])
+      return id;
+  }
+  throw std::invalid_argument("Native XRT API is missing from api_names");
+}
+
+inline const char*
+api_name(uint16_t id)
+{
+  return id < num_apis ? api_names[id] : "unknown";
+}
+
+} // end namespace xdp::native
+
+#endif
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2016-2022 Xilinx, Inc.  All rights reserved.
-// Copyright (C) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
 #define XRT_CORE_COMMON_SOURCE
 #include "native_profile.h"
 
@@ -20,44 +20,60 @@ load()
                       warning_function);
 }
 
-// Callbacks for generic start/stop function tracking
-std::function<void (const char*, uint64_t)> function_start_cb ;
-std::function<void (const char*, uint64_t, uint64_t)> function_end_cb ;
+// Callbacks for generic start/stop function tracking.  The plugin
+// matches the end of a call with its start per thread, as calls on a
+// thread end in the reverse order they start.
+std::function<void (unsigned int)> function_start_cb ;
+std::function<void (unsigned int, uint64_t)> function_end_cb ;
 
 // Callbacks for individual functions to track start/stop and statistics
-std::function<void (const char*, uint64_t, bool)> sync_start_cb ;
-std::function<void (const char*, uint64_t, uint64_t, bool, uint64_t)> sync_end_cb ;
+std::function<void (unsigned int, bool)> sync_start_cb ;
+std::function<void (unsigned int, uint64_t, bool, uint64_t)> sync_end_cb ;
+
+// Callback for dumping the flight recorder
+std::function<void (const char*)> flight_recorder_dump_cb ;
   
 void
 register_functions(void* handle)
 {
-  using start_type      = void (*)(const char*, uint64_t) ;
-  using sync_start_type = void (*)(const char*, uint64_t, bool) ;
-  using end_type        = void (*)(const char*, uint64_t, uint64_t) ;
-  using end_sync_type   = void (*)(const char*, uint64_t, uint64_t, bool, uint64_t) ;
+  using start_type      = void (*)(unsigned int) ;
+  using sync_start_type = void (*)(unsigned int, bool) ;
+  using end_type        = void (*)(unsigned int, uint64_t) ;
+  using end_sync_type   = void (*)(unsigned int, uint64_t, bool, uint64_t) ;
+  using dump_type       = void (*)(const char*) ;
 
   // Generic callbacks
   function_start_cb =
-    reinterpret_cast<start_type>(xrt_core::dlsym(handle, "native_function_start")) ;
+    reinterpret_cast<start_type>(xrt_core::dlsym(handle, "native_api_start")) ;
 
   function_end_cb =
-    reinterpret_cast<end_type>(xrt_core::dlsym(handle, "native_function_end")) ;
+    reinterpret_cast<end_type>(xrt_core::dlsym(handle, "native_api_end")) ;
 
   // Sync callbacks
   sync_start_cb =
-    reinterpret_cast<sync_start_type>(xrt_core::dlsym(handle, "native_sync_start")) ;
+    reinterpret_cast<sync_start_type>(xrt_core::dlsym(handle, "native_api_sync_start")) ;
 
   sync_end_cb =
-    reinterpret_cast<end_sync_type>(xrt_core::dlsym(handle, "native_sync_end")) ;
+    reinterpret_cast<end_sync_type>(xrt_core::dlsym(handle, "native_api_sync_end")) ;
+
+  // Flight recorder
+  flight_recorder_dump_cb =
+    reinterpret_cast<dump_type>(xrt_core::dlsym(handle, "native_flight_recorder_dump")) ;
 }
 
 void warning_function()
 {}
 
+void
+flight_recorder_dump(const char* reason)
+{
+  if (xrt_core::config::get_flight_recorder() && flight_recorder_dump_cb)
+    flight_recorder_dump_cb(reason) ;
+}
+
 api_call_logger::
-api_call_logger(const char* function)
-  : m_funcid(0)
-  , m_fullname(function)
+api_call_logger(uint16_t id)
+  : m_id(id)
 {
   // With the addition of the generic "host_trace" feature, we have to
   // check if we should load the plugin.  We only want to load it if
@@ -65,6 +81,7 @@ api_call_logger(const char* function)
   // host_trace was specified
   static bool s_load_native =
     (xrt_core::config::get_native_xrt_trace()
+     || xrt_core::config::get_flight_recorder()
      || xrt_core::utils::load_host_trace())
     ? (load(), true)
     : false;
@@ -73,13 +90,11 @@ api_call_logger(const char* function)
 }
 
 generic_api_call_logger::
-generic_api_call_logger(const char* function)
-  : api_call_logger(function)
+generic_api_call_logger(uint16_t id)
+  : api_call_logger(id)
 {
-  if (function_start_cb) {
-    m_funcid = xrt_core::utils::issue_id() ;
-    function_start_cb(m_fullname, m_funcid) ;
-  }
+  if (function_start_cb)
+    function_start_cb(m_id) ;
 }
 
 generic_api_call_logger::
@@ -87,18 +102,16 @@ generic_api_call_logger::
 {
   if (function_end_cb) {
     auto timestamp = static_cast<uint64_t>(xrt_core::time_ns());
-    function_end_cb(m_fullname, m_funcid, timestamp) ;
+    function_end_cb(m_id, timestamp) ;
   }
 }
 
 sync_logger::
-sync_logger(const char* function, bool w, size_t s)
-  : api_call_logger(function), m_is_write(w), m_buffer_size(s)
+sync_logger(uint16_t id, bool w, size_t s)
+  : api_call_logger(id), m_is_write(w), m_buffer_size(s)
 {
-  if (sync_start_cb) {
-    m_funcid = xrt_core::utils::issue_id() ;
-    sync_start_cb(m_fullname, m_funcid, m_is_write) ;
-  }
+  if (sync_start_cb)
+    sync_start_cb(m_id, m_is_write) ;
 }
 
 sync_logger::
@@ -107,7 +120,7 @@ sync_logger::
   auto timestamp = static_cast<uint64_t>(xrt_core::time_ns());
 
   if (sync_end_cb) {
-    sync_end_cb(m_fullname, m_funcid, timestamp, m_is_write, static_cast<uint64_t>(m_buffer_size)) ;
+    sync_end_cb(m_id, timestamp, m_is_write, static_cast<uint64_t>(m_buffer_size)) ;
   }
 }
 
@@ -1,8 +1,9 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2016-2022 Xilinx, Inc.  All rights reserved.
-// Copyright (C) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (C) 2022-2024 Advanced Micro Devices, Inc. All rights reserved.
 #ifndef NATIVE_PROFILE_DOT_H
 #define NATIVE_PROFILE_DOT_H
+#include "core/common/api/native_api_ids.h"
 #include "core/common/config.h"
 #include "core/common/config_reader.h"
 #include "core/include/xrt.h"
@@ -21,16 +22,21 @@ register_functions(void* handle);
 void
 warning_function();
 
+// Write the calls kept by the flight recorder to a trace file.  Does
+// nothing unless Debug.flight_recorder is set and the plugin is loaded.
+void
+flight_recorder_dump(const char* reason);
+
 // An instance of the api_call_logger class will be created in every
 // function we are monitoring.  The constructor marks the start time,
-// and the destructor marks the end time
+// and the destructor marks the end time.  Functions are identified by
+// their id in api_names, so no strings are passed while profiling.
 class api_call_logger
 {
  protected:
-  uint64_t m_funcid ;
-  const char* m_fullname = nullptr ;
+  uint16_t m_id ;
  public:
-  explicit api_call_logger(const char* function);
+  explicit api_call_logger(uint16_t id);
   virtual ~api_call_logger() = default ;
 } ;
 
@@ -43,17 +49,22 @@ class generic_api_call_logger : public api_call_logger
   void operator=(generic_api_call_logger&&) = delete ;
 
 public:
-  explicit generic_api_call_logger(const char* function);
+  explicit generic_api_call_logger(uint16_t id);
   ~generic_api_call_logger();
 } ;
 
-template <typename Callable, typename ...Args>
+// The id is a template argument so the name of every profiled
+// function is looked up at compile time, for example
+//   profiling_wrapper<api_id("xrt::bo::size")>(f)
+template <uint16_t id, typename Callable, typename ...Args>
 auto
-profiling_wrapper(const char* function, Callable&& f, Args&&...args)
+profiling_wrapper(Callable&& f, Args&&...args)
 {
+  static_assert(id < num_apis, "Invalid Native XRT API id");
   if (xrt_core::config::get_native_xrt_trace()
-      || xrt_core::config::get_host_trace()) {
-    generic_api_call_logger log_object(function) ;
+      || xrt_core::config::get_host_trace()
+      || xrt_core::config::get_flight_recorder()) {
+    generic_api_call_logger log_object(id) ;
     return f(std::forward<Args>(args)...) ;  // NOLINT, clang-tidy false positive [potential leak]
   }
   return f(std::forward<Args>(args)...) ;    // NOLINT, clang-tidy false positive [potential leak]
@@ -73,17 +84,19 @@ class sync_logger : public api_call_logger
   void operator=(sync_logger&&) = delete;
 
  public:
-  explicit sync_logger(const char* function, bool w, size_t s);
+  explicit sync_logger(uint16_t id, bool w, size_t s);
   ~sync_logger();
 } ;
 
-template <typename Callable, typename ...Args>
+template <uint16_t id, typename Callable, typename ...Args>
 auto
-profiling_wrapper_sync(const char* function, xclBOSyncDirection dir, size_t size, Callable&& f, Args&&...args)
+profiling_wrapper_sync(xclBOSyncDirection dir, size_t size, Callable&& f, Args&&...args)
 {
+  static_assert(id < num_apis, "Invalid Native XRT API id");
   if (xrt_core::config::get_native_xrt_trace() ||
-      xrt_core::config::get_host_trace()) {
-    sync_logger log_object(function, (dir == XCL_BO_SYNC_BO_TO_DEVICE), size);
+      xrt_core::config::get_host_trace() ||
+      xrt_core::config::get_flight_recorder()) {
+    sync_logger log_object(id, (dir == XCL_BO_SYNC_BO_TO_DEVICE), size);
     return f(std::forward<Args>(args)...) ;
   }
   return f(std::forward<Args>(args)...) ;
@@ -21,11 +21,15 @@
 #include "kernel_int.h"
 #include "xrt_mem.h"
 #include "core/common/api/bo_int.h"
+#include "core/common/config_reader.h"
+#include "core/common/copy_engine.h"
 #include "core/common/device.h"
 #include "core/common/memalign.h"
 #include "core/common/message.h"
 #include "core/common/query_requests.h"
 #include "core/common/system.h"
+#include "core/common/task.h"
+#include "core/common/thread.h"
 #include "core/common/trace.h"
 #include "core/common/unistd.h"
 #include "core/common/xclbin_parser.h"
@@ -33,10 +37,17 @@
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/shared_handle.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdlib>
+#include <functional>
+#include <future>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 #ifdef _WIN32
@@ -110,6 +121,82 @@ send_exception_message(const std::string& msg)
   send_exception_message(msg.c_str());
 }
 
+// class transfer_pool - Worker threads for asynchronous BO syncs
+//
+// Each direction has its own queue and workers, so transfers from
+// device are not stuck behind transfers to device.  The number of
+// workers per direction is bounded by Runtime.bo_async_threads.
+//
+// A pool is shared by all buffers of a device that have been synced
+// asynchronously, it is destructed with the last of these buffers.
+class transfer_pool
+{
+  struct direction
+  {
+    xrt_core::task::queue queue;
+    std::vector<std::thread> workers;
+  };
+
+  std::array<direction, 2> m_directions;
+
+public:
+  transfer_pool()
+  {
+    auto threads = std::max(xrt_core::config::get_bo_async_threads(), 1u);
+    for (auto& dir : m_directions)
+      for (unsigned int i = 0; i < threads; ++i)
+        dir.workers.emplace_back(xrt_core::thread(xrt_core::task::worker, std::ref(dir.queue)));
+  }
+
+  ~transfer_pool()
+  {
+    for (auto& dir : m_directions) {
+      dir.queue.stop();
+      for (auto& worker : dir.workers)
+        worker.join();
+    }
+  }
+
+  transfer_pool(const transfer_pool&) = delete;
+  transfer_pool(transfer_pool&&) = delete;
+  transfer_pool& operator=(const transfer_pool&) = delete;
+  transfer_pool& operator=(transfer_pool&&) = delete;
+
+  // add() - Queue a transfer, the future is ready when it completes
+  std::shared_future<void>
+  add(xclBOSyncDirection dir, std::function<void()> transfer)
+  {
+    std::packaged_task<void()> task(std::move(transfer));
+    auto done = task.get_future().share();
+    m_directions[dir == XCL_BO_SYNC_BO_TO_DEVICE ? 0 : 1].queue.addWork(std::move(task));
+    return done;
+  }
+};
+
+// Get (and create) transfer pool for device
+//
+// The map is keyed by the device itself rather than its address,
+// which could be reused by a new device once the old device is
+// closed.  Entries of closed devices or released pools are purged
+// when a pool is created.
+static std::shared_ptr<transfer_pool>
+get_transfer_pool(const std::shared_ptr<xrt_core::device>& device)
+{
+  static std::map<std::weak_ptr<xrt_core::device>, std::weak_ptr<transfer_pool>,
+                  std::owner_less<std::weak_ptr<xrt_core::device>>> dev2pool;
+  static std::mutex mutex;
+  std::lock_guard lk(mutex);
+  auto& entry = dev2pool[device];
+  auto pool = entry.lock();
+  if (pool)
+    return pool;
+
+  entry = pool = std::make_shared<transfer_pool>();
+  for (auto itr = dev2pool.begin(); itr != dev2pool.end();)
+    itr = ((*itr).first.expired() || (*itr).second.expired()) ? dev2pool.erase(itr) : std::next(itr);
+  return pool;
+}
+
 } // namespace
 
 namespace {
@@ -226,6 +313,8 @@ protected:
   mutable uint32_t grpid = no_group;               // NOLINT memory group index
   mutable bo::flags flags = no_flags;              // NOLINT flags per bo properties
   mutable std::unique_ptr<xrt_core::shared_handle> shared_handle; // NOLINT
+  std::shared_ptr<transfer_pool> transfers;        // NOLINT pool for async syncs if any
+  std::once_flag transfers_init;                   // NOLINT
 
 public:
   // No handle
@@ -304,6 +393,28 @@ public:
     clones.push_back(std::move(clone));
   }
 
+  // Buffers from a bo_pool are allocated with the capacity of a size
+  // class and are handed out for any size that fits.
+  void
+  set_pooled_size(size_t sz)
+  {
+    size = sz;
+  }
+
+  // recycle() - Prepare buffer for reuse by a bo_pool
+  //
+  // Return: false if the buffer must not be reused, which is the
+  // case if it was exported and may be in use by another process
+  bool
+  recycle()
+  {
+    if (shared_handle)
+      return false;
+
+    clones.clear();
+    return true;
+  }
+
   const xrt_core::device*
   get_core_device() const
   {
@@ -337,7 +448,7 @@ public:
     if (sz + seek > size)
       throw xrt_core::error(-EINVAL,"attempting to write past buffer size");
     auto hbuf = static_cast<char*>(get_hbuf()) + seek;
-    std::memcpy(hbuf, src, sz);
+    xrt_core::copy_engine::copy(hbuf, src, sz);
   }
 
   virtual void
@@ -346,7 +457,7 @@ public:
     if (sz + skip > size)
       throw xrt_core::error(-EINVAL,"attempting to read past buffer size");
     auto hbuf = static_cast<char*>(get_hbuf()) + skip;
-    std::memcpy(dst, hbuf, sz);
+    xrt_core::copy_engine::copy(dst, hbuf, sz);
   }
 
   virtual void
@@ -366,14 +477,13 @@ public:
     }
 
     // try copying with m2m
-    try {
-      auto m2m = xrt_core::device_query<xrt_core::query::m2m>(get_device());
-      if (xrt_core::query::m2m::to_bool(m2m)) {
+    if (get_device()->get_capabilities()->m2m) {
+      try {
         handle->copy(src->handle.get(), sz, dst_offset, src_offset);
         return;
       }
-    }
-    catch (const std::exception&) {
+      catch (const std::exception&) {
+      }
     }
 
     // try copying with kdma
@@ -424,7 +534,7 @@ public:
     const_cast<bo_impl*>(src)->sync(XCL_BO_SYNC_BO_FROM_DEVICE, sz, src_offset);
 
     // copy host side buffer
-    std::memcpy(dst_hbuf + dst_offset, src_hbuf + src_offset, sz);
+    xrt_core::copy_engine::copy(dst_hbuf + dst_offset, src_hbuf + src_offset, sz);
 
     // sync modified host buffer to device
     sync(XCL_BO_SYNC_BO_TO_DEVICE, sz, dst_offset);
@@ -488,6 +598,16 @@ public:
     return flags;
   }
 
+  // get_root() - Buffer that is synced for a range of this buffer
+  //
+  // Returns the buffer and the offset of the range within it.  Sub
+  // buffers resolve to the buffer they were created from.
+  virtual std::pair<bo_impl*, size_t>
+  get_root(size_t offset)
+  {
+    return {this, offset};
+  }
+
   virtual size_t get_size()      const { return size;    }
   virtual size_t get_offset()    const { return 0;       }
   virtual void*  get_hbuf()      const { return nullptr; }
@@ -499,6 +619,7 @@ public:
 //
 // Derived classes:
 // [aie::b ::async_handle_impl]: For AIE BOs
+// [sync_handle_impl]: For all other BOs
 //
 // Impl Class associated with async bo which allows to wait for completion
 class bo::async_handle_impl
@@ -608,6 +729,39 @@ public:
 // Initialize static data member for async info
 aie::bo::async_handle_impl::handle_map aie::bo::async_handle_impl::async_info;
 
+// class sync_handle_impl - Handle for a sync done by a transfer pool
+//
+// The transfer refers to the buffer by raw pointer, the handle keeps
+// the buffer alive and waits for the transfer before it lets go of
+// the buffer.
+class sync_handle_impl : public xrt::bo::async_handle_impl
+{
+  std::shared_future<void> m_done;
+
+public:
+  sync_handle_impl(xrt::bo bo, std::shared_future<void> done)
+    : xrt::bo::async_handle_impl(std::move(bo))
+    , m_done(std::move(done))
+  {}
+
+  ~sync_handle_impl() override
+  {
+    m_done.wait();
+  }
+
+  sync_handle_impl(const sync_handle_impl&) = delete;
+  sync_handle_impl(sync_handle_impl&&) = delete;
+  sync_handle_impl& operator=(const sync_handle_impl&) = delete;
+  sync_handle_impl& operator=(sync_handle_impl&&) = delete;
+
+  // wait() - Wait for sync to complete, throws if the sync failed
+  void
+  wait() override
+  {
+    m_done.get();
+  }
+};
+
 xrt::bo::async_handle
 bo_impl::
 async(xrt::bo& bo, const std::string& port, xclBOSyncDirection dir, size_t sz, size_t offset)
@@ -624,13 +778,13 @@ xrt::bo::async_handle
 bo_impl::
 async(xrt::bo& bo, xclBOSyncDirection dir, size_t sz, size_t offset)
 {
-  throw std::runtime_error("Unsupported feature");
+  std::call_once(transfers_init, [this] {
+    transfers = get_transfer_pool(device.get_device());
+  });
 
-#if 0
-  //TODO for Alveo; base xrt::bo class
-  auto a_bo_impl = std::make_shared<xrt::bo::async_handle_impl>(bo);
-  return xrt::bo::async_handle{a_bo_impl};
-#endif
+  // The handle waits for the sync before releasing the buffer
+  auto done = transfers->add(dir, [this, dir, sz, offset] { sync(dir, sz, offset); });
+  return xrt::bo::async_handle{std::make_shared<sync_handle_impl>(bo, std::move(done))};
 }
 
 // class buffer_ubuf - User provide host side buffer
@@ -935,6 +1089,12 @@ public:
     // sync through parent buffer, which handles nodma case also
     m_parent->sync(dir, sz, off);
   }
+
+  std::pair<bo_impl*, size_t>
+  get_root(size_t offset) override
+  {
+    return m_parent->get_root(offset + m_offset);
+  }
 };
 
 // class buffer_xbuf - Wrapper for extern managed xclBufferHandle
@@ -1262,11 +1422,219 @@ adjust_buffer_flags(const device_type& dev, xrt::bo::flags flags, xrt::memory_gr
   return static_cast<xrtBufferFlags>(flags);
 }
 
+// sync_ranges() - Sync ranges with as few calls as possible
+//
+// Ranges are resolved to the root buffer of sub buffers, sorted, and
+// ranges of the same root buffer and direction that overlap or touch
+// are merged.  Each merged range is synced through the root buffer,
+// which handles nodma buffers also.  Returns the number of merged
+// ranges.
+static size_t
+sync_ranges(const std::vector<xrt::bo_sync_range>& ranges)
+{
+  struct root_range
+  {
+    xrt::bo_impl* root;
+    xclBOSyncDirection dir;
+    size_t offset;
+    size_t size;
+  };
+
+  std::vector<root_range> roots;
+  roots.reserve(ranges.size());
+  for (const auto& range : ranges) {
+    if (!range.size)
+      continue;
+
+    const auto& boh = range.bo.get_handle();
+    if (!boh)
+      throw xrt_core::error(-EINVAL, "Invalid buffer object in sync range");
+    if (range.offset > boh->get_size() || range.size > boh->get_size() - range.offset)
+      throw xrt_core::error(-EINVAL, "Invalid offset and size of sync range");
+
+    auto [root, offset] = boh->get_root(range.offset);
+    roots.push_back({root, range.dir, offset, range.size});
+  }
+
+  std::sort(roots.begin(), roots.end(), [](const auto& lhs, const auto& rhs) {
+    return std::tie(lhs.root, lhs.dir, lhs.offset) < std::tie(rhs.root, rhs.dir, rhs.offset);
+  });
+
+  size_t calls = 0;
+  for (auto itr = roots.begin(); itr != roots.end(); ++calls) {
+    auto merged = *itr;
+    for (++itr; itr != roots.end(); ++itr) {
+      if (itr->root != merged.root || itr->dir != merged.dir || itr->offset > merged.offset + merged.size)
+        break;
+      merged.size = std::max(merged.size, itr->offset + itr->size - merged.offset);
+    }
+    merged.root->sync(merged.dir, merged.size, merged.offset);
+  }
+
+  return calls;
+}
+
 } // namespace
 
 ////////////////////////////////////////////////////////////////
 // xrt_bo implementation of extension APIs not exposed to end-user
 ////////////////////////////////////////////////////////////////
+namespace xrt {
+
+// class bo_pool_impl - Cache of released buffers for reuse
+//
+// Buffers are bucketed by flags, memory group, and size class.  The
+// size classes are four per power of two, and buffers are allocated
+// in whole pages.  Above 16KB this bounds the unused part of a
+// buffer to 25% of its capacity, below 16KB a size class is the size
+// rounded up to a page, so the unused part is less than a page.
+//
+// A buffer allocated from the pool is returned to the pool when the
+// last xrt::bo referring to it is destructed, unless caching it would
+// exceed the high water mark of the pool, in which case it is freed.
+class bo_pool_impl : public std::enable_shared_from_this<bo_pool_impl>
+{
+  using key_type = std::tuple<xrtBufferFlags, xrtMemoryGroup, size_t>;
+
+  device_type m_device;
+  size_t m_high_water;
+
+  mutable std::mutex m_mutex;
+  std::map<key_type, std::vector<std::shared_ptr<bo_impl>>> m_free;
+  size_t m_cached = 0;
+  size_t m_cached_bytes = 0;
+  size_t m_peak_bytes = 0;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  uint64_t m_evictions = 0;
+  uint64_t m_trimmed = 0;
+
+  // Capacity of the size class that fits sz bytes.  The step between
+  // classes is a quarter of the power of two below sz, but no less than
+  // a page since finer classes would round up to the same page.
+  static size_t
+  get_capacity(size_t sz)
+  {
+    constexpr size_t page_size = 4096;
+    if (sz <= page_size)
+      return page_size;
+
+    size_t pow2 = page_size;
+    while (pow2 * 2 < sz)
+      pow2 *= 2;
+    auto step = std::max(pow2 / 4, page_size);
+    return (sz + step - 1) / step * step;
+  }
+
+  void
+  release(const key_type& key, std::shared_ptr<bo_impl>&& boh)
+  {
+    auto capacity = std::get<2>(key);
+    auto reusable = boh->recycle();
+    std::lock_guard lk(m_mutex);
+    if (!reusable || m_cached_bytes + capacity > m_high_water) {
+      ++m_evictions;
+      return; // buffer is freed by caller outside the lock
+    }
+
+    m_free[key].push_back(std::move(boh));
+    ++m_cached;
+    m_cached_bytes += capacity;
+    m_peak_bytes = std::max(m_peak_bytes, m_cached_bytes);
+  }
+
+public:
+  bo_pool_impl(device_type device, size_t high_water)
+    : m_device(std::move(device))
+    , m_high_water(high_water)
+  {}
+
+  std::shared_ptr<bo_impl>
+  alloc(size_t sz, xrt::bo::flags bo_flags, xrtMemoryGroup grp)
+  {
+    auto flags = adjust_buffer_flags(m_device, bo_flags, grp);
+    key_type key{flags, grp, get_capacity(sz)};
+    std::shared_ptr<bo_impl> boh;
+    {
+      std::lock_guard lk(m_mutex);
+      auto itr = m_free.find(key);
+      if (itr != m_free.end() && !itr->second.empty()) {
+        boh = std::move(itr->second.back());
+        itr->second.pop_back();
+        if (itr->second.empty())
+          m_free.erase(itr);
+        --m_cached;
+        m_cached_bytes -= std::get<2>(key);
+        ++m_hits;
+      }
+      else {
+        ++m_misses;
+      }
+    }
+
+    if (!boh)
+      boh = ::alloc(m_device, std::get<2>(key), flags, grp);
+    boh->set_pooled_size(sz);
+
+    // The deleter keeps the buffer alive until it is returned to the
+    // pool, or freed if the pool is gone
+    auto raw = boh.get();
+    return {raw, [pool = weak_from_this(), key, boh = std::move(boh)] (bo_impl*) mutable {
+      if (auto p = pool.lock())
+        p->release(key, std::move(boh));
+      boh.reset();
+    }};
+  }
+
+  // Free cached buffers, largest first, until at most bytes are cached
+  void
+  trim(size_t bytes)
+  {
+    std::vector<std::shared_ptr<bo_impl>> trimmed;
+    std::lock_guard lk(m_mutex);
+    auto by_capacity = [](const auto& lhs, const auto& rhs) {
+      return std::get<2>(lhs.first) < std::get<2>(rhs.first);
+    };
+    while (m_cached_bytes > bytes) {
+      auto itr = std::max_element(m_free.begin(), m_free.end(), by_capacity);
+      auto capacity = std::get<2>(itr->first);
+      trimmed.push_back(std::move(itr->second.back()));
+      itr->second.pop_back();
+      if (itr->second.empty())
+        m_free.erase(itr);
+      --m_cached;
+      m_cached_bytes -= capacity;
+      ++m_trimmed;
+    }
+  }
+
+  xrt::bo_pool::stats
+  get_stats() const
+  {
+    std::lock_guard lk(m_mutex);
+    return {m_hits, m_misses, m_evictions, m_trimmed, m_cached, m_cached_bytes, m_peak_bytes};
+  }
+};
+
+} // namespace xrt
+
+namespace {
+
+static std::shared_ptr<xrt::bo_impl>
+alloc_pooled(const xrt::bo_pool& pool, size_t sz, xrt::bo::flags flags, xrt::memory_group grp)
+{
+  XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_pooled);
+  const auto& pimpl = pool.get_handle();
+  if (!pimpl)
+    throw xrt_core::error(EINVAL, "Invalid buffer pool");
+  if (!sz)
+    throw xrt_core::system_error(EINVAL, "size must be a positive number");
+
+  return pimpl->alloc(sz, flags, grp);
+}
+
+} // namespace
+
 namespace xrt_core::bo {
 
 uint64_t
@@ -1341,7 +1709,7 @@ wait()
 
 bo::
 bo(const xrt::device& device, void* userptr, size_t sz, bo::flags flags, memory_group grp)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc_userptr, device_type{device.get_handle()}, userptr, sz
     , adjust_buffer_flags(device_type{device.get_handle()}, flags, grp), grp))
 {}
@@ -1353,7 +1721,7 @@ bo(const xrt::device& device, void* userptr, size_t sz, memory_group grp)
 
 bo::
 bo(const xrt::device& device, size_t sz, bo::flags flags, memory_group grp)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc, device_type{device.get_handle()}, sz
     , adjust_buffer_flags(device_type{device.get_handle()}, flags, grp), grp))
 {}
@@ -1365,19 +1733,19 @@ bo(const xrt::device& device, size_t sz, memory_group grp)
 
 bo::
 bo(const xrt::device& device, xrt::bo::export_handle ehdl)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc_import, device_type{device.get_handle()}, ehdl))
 {}
 
 bo::
 bo(const xrt::device& device, pid_type pid, xrt::bo::export_handle ehdl)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc_import_from_pid, device_type{device.get_handle()}, pid , ehdl))
 {}
 
 bo::
 bo(const xrt::hw_context& hwctx, void* userptr, size_t sz, bo::flags flags, memory_group grp)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc_userptr, device_type{hwctx}, userptr, sz
     , adjust_buffer_flags(device_type{hwctx}, flags, grp), grp))
 {}
@@ -1389,7 +1757,7 @@ bo(const xrt::hw_context& hwctx, void* userptr, size_t sz, memory_group grp)
 
 bo::
 bo(const xrt::hw_context& hwctx, size_t sz, bo::flags flags, memory_group grp)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc, device_type{hwctx}, sz
     , adjust_buffer_flags(device_type{hwctx}, flags, grp), grp))
 {}
@@ -1399,10 +1767,21 @@ bo(const xrt::hw_context& hwctx, size_t sz, memory_group grp)
   : bo(hwctx, sz, bo::flags::normal, grp)
 {}
 
+bo::
+bo(const xrt::bo_pool& pool, size_t sz, bo::flags flags, memory_group grp)
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
+      alloc_pooled, pool, sz, flags, grp))
+{}
+
+bo::
+bo(const xrt::bo_pool& pool, size_t sz, memory_group grp)
+  : bo(pool, sz, bo::flags::normal, grp)
+{}
+
 // Deprecated
 bo::
 bo(xclDeviceHandle dhdl, void* userptr, size_t sz, bo::flags flags, memory_group grp)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc_userptr, xcl_to_core_device(dhdl), userptr, sz
     , adjust_buffer_flags(xcl_to_core_device(dhdl), flags, grp), grp))
 {}
@@ -1410,7 +1789,7 @@ bo(xclDeviceHandle dhdl, void* userptr, size_t sz, bo::flags flags, memory_group
 // Deprecated
 bo::
 bo(xclDeviceHandle dhdl, size_t size, bo::flags flags, memory_group grp)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc, xcl_to_core_device(dhdl), size
     , adjust_buffer_flags(xcl_to_core_device(dhdl), flags, grp), grp))
 {}
@@ -1418,20 +1797,20 @@ bo(xclDeviceHandle dhdl, size_t size, bo::flags flags, memory_group grp)
 // Deprecated
 bo::
 bo(xclDeviceHandle dhdl, xrt::bo_impl::export_handle ehdl)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc_import, xcl_to_core_device(dhdl), ehdl))
 {}
 
 // Deprecated
 bo::
 bo(xclDeviceHandle dhdl, pid_type pid, xrt::bo_impl::export_handle ehdl)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc_import_from_pid, xcl_to_core_device(dhdl), pid , ehdl))
 {}
 
 bo::
 bo(const bo& parent, size_t size, size_t offset)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       alloc_sub, parent.handle, size, offset))
 {}
 
@@ -1442,7 +1821,7 @@ bo(xclDeviceHandle dhdl, xcl_buffer_handle xhdl)
 
 bo::
 bo(xrtBufferHandle xhdl)
-  : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::bo")>(
       get_boh, xhdl))
 {}
 
@@ -1450,7 +1829,7 @@ size_t
 bo::
 size() const
 {
-  return xdp::native::profiling_wrapper("xrt::bo::size", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::size")>([this]{
     return handle->get_size();
   }) ;
 }
@@ -1459,7 +1838,7 @@ uint64_t
 bo::
 address() const
 {
-  return xdp::native::profiling_wrapper("xrt::bo::address", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::address")>([this]{
     return handle->get_address();
   });
 }
@@ -1469,7 +1848,7 @@ memory_group
 bo::
 get_memory_group() const
 {
-  return xdp::native::profiling_wrapper("xrt::bo::memory_group", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::memory_group")>([this]{
     return handle->get_group_id();
   });
 }
@@ -1478,7 +1857,7 @@ bo::flags
 bo::
 get_flags() const
 {
-  return xdp::native::profiling_wrapper("xrt::bo::get_flags", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::get_flags")>([this]{
     return handle->get_flags();
   });
 }
@@ -1487,7 +1866,7 @@ bo::export_handle
 bo::
 export_buffer()
 {
-  return xdp::native::profiling_wrapper("xrt::bo::export_buffer", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::export_buffer")>([this]{
     return handle->export_buffer();
   });
 }
@@ -1496,7 +1875,7 @@ void
 bo::
 sync(xclBOSyncDirection dir, size_t size, size_t offset)
 {
-  return xdp::native::profiling_wrapper_sync("xrt::bo::sync", dir, size,
+  return xdp::native::profiling_wrapper_sync<xdp::native::api_id("xrt::bo::sync")>(dir, size,
     [this, dir, size, offset]{
       handle->sync(dir, size, offset);
     });
@@ -1513,7 +1892,7 @@ void*
 bo::
 map()
 {
-  return xdp::native::profiling_wrapper("xrt::bo::map", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::map")>([this]{
     return handle->get_hbuf();
   });
 }
@@ -1522,7 +1901,7 @@ void
 bo::
 write(const void* src, size_t size, size_t seek)
 {
-  xdp::native::profiling_wrapper("xrt::bo::write", [this, src, size, seek]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::write")>([this, src, size, seek]{
     handle->write(src, size, seek);
   });
 }
@@ -1531,7 +1910,7 @@ void
 bo::
 read(void* dst, size_t size, size_t skip)
 {
-  xdp::native::profiling_wrapper("xrt::bo::read", [this, dst, size, skip]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::read")>([this, dst, size, skip]{
     handle->read(dst, size, skip);
   });
 }
@@ -1540,7 +1919,7 @@ void
 bo::
 copy(const bo& src, size_t sz, size_t src_offset, size_t dst_offset)
 {
-  xdp::native::profiling_wrapper("xrt::bo::copy",
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::bo::copy")>(
     [this, &src, sz, src_offset, dst_offset]{
       handle->copy(src.handle.get(), sz, src_offset, dst_offset);
     });
@@ -1550,6 +1929,39 @@ bo::
 ~bo()
 {}
 
+bo_pool::
+bo_pool(const xrt::device& device, size_t high_water)
+  : detail::pimpl<bo_pool_impl>(std::make_shared<bo_pool_impl>(device_type{device.get_handle()}, high_water))
+{}
+
+bo_pool::
+bo_pool(const xrt::hw_context& hwctx, size_t high_water)
+  : detail::pimpl<bo_pool_impl>(std::make_shared<bo_pool_impl>(device_type{hwctx}, high_water))
+{}
+
+void
+bo_pool::
+trim(size_t bytes)
+{
+  handle->trim(bytes);
+}
+
+bo_pool::stats
+bo_pool::
+get_stats() const
+{
+  return handle->get_stats();
+}
+
+size_t
+sync(const std::vector<bo_sync_range>& ranges)
+{
+  XRT_TRACE_POINT_SCOPE(xrt_bo_sync_batch);
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::sync")>([&ranges]{
+    return sync_ranges(ranges);
+  });
+}
+
 } // xrt
 
 ////////////////////////////////////////////////////////////////
@@ -1723,7 +2135,7 @@ xrtBufferHandle
 xrtBOAllocUserPtr(xrtDeviceHandle dhdl, void* userptr, size_t size, xrtBufferFlags flags, xrtMemoryGroup grp)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOAllocUserPtr")>(
     [dhdl, userptr, size, flags, grp]{
       auto boh = alloc_userptr(xrt_to_core_device(dhdl), userptr, size, flags, grp);
       auto hdl = boh.get();
@@ -1746,7 +2158,7 @@ xrtBufferHandle
 xrtBOAlloc(xrtDeviceHandle dhdl, size_t size, xrtBufferFlags flags, xrtMemoryGroup grp)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOAlloc")>(
     [dhdl, size, flags, grp]{
       auto boh = alloc(xrt_to_core_device(dhdl), size, flags, grp);
       auto hdl = boh.get();
@@ -1768,7 +2180,7 @@ xrtBufferHandle
 xrtBOSubAlloc(xrtBufferHandle phdl, size_t sz, size_t offset)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [phdl, sz, offset]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOSubAlloc")>([phdl, sz, offset]{
       const auto& parent = get_boh(phdl);
       auto boh = alloc_sub(parent, sz, offset);
       auto hdl = boh.get();
@@ -1791,7 +2203,7 @@ xrtBufferHandle
 xrtBOImport(xrtDeviceHandle dhdl, xclBufferExportHandle ehdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl, ehdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOImport")>([dhdl, ehdl]{
       auto boh = alloc_import(xrt_to_core_device(dhdl), ehdl);
       auto hdl = boh.get();
       bo_cache.add(hdl, std::move(boh));
@@ -1812,7 +2224,7 @@ xclBufferExportHandle
 xrtBOExport(xrtBufferHandle bhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [bhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOExport")>([bhdl]{
       return get_boh(bhdl)->export_buffer();
     });
   }
@@ -1830,7 +2242,7 @@ xrtBufferHandle
 xrtBOAllocFromXcl(xrtDeviceHandle dhdl, xclBufferHandle xhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl, xhdl] {
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOAllocFromXcl")>([dhdl, xhdl] {
       auto boh = alloc_xbuf(xrt_to_core_device(dhdl), xcl_buffer_handle{xhdl});
       auto hdl = boh.get();
       bo_cache.add(hdl, std::move(boh));
@@ -1851,7 +2263,7 @@ int
 xrtBOFree(xrtBufferHandle bhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [bhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOFree")>([bhdl]{
       bo_cache.remove_or_error(bhdl);
       return 0;
     });
@@ -1870,7 +2282,7 @@ size_t
 xrtBOSize(xrtBufferHandle bhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [bhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOSize")>([bhdl]{
       return get_boh(bhdl)->get_size();
     });
   }
@@ -1889,7 +2301,7 @@ int
 xrtBOSync(xrtBufferHandle bhdl, xclBOSyncDirection dir, size_t size, size_t offset)
 {
   try {
-    return xdp::native::profiling_wrapper_sync(__func__, dir, size,
+    return xdp::native::profiling_wrapper_sync<xdp::native::api_id("xrtBOSync")>(dir, size,
     [bhdl, dir, size, offset]{
       get_boh(bhdl)->sync(dir, size, offset);
       return 0;
@@ -1909,7 +2321,7 @@ void*
 xrtBOMap(xrtBufferHandle bhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [bhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOMap")>([bhdl]{
       return get_boh(bhdl)->get_hbuf();
     });
   }
@@ -1927,7 +2339,7 @@ int
 xrtBOWrite(xrtBufferHandle bhdl, const void* src, size_t size, size_t seek)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOWrite")>(
     [bhdl, src, size, seek]{
       get_boh(bhdl)->write(src, size, seek);
       return 0;
@@ -1947,7 +2359,7 @@ int
 xrtBORead(xrtBufferHandle bhdl, void* dst, size_t size, size_t skip)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBORead")>(
     [bhdl, dst, size, skip]{
       get_boh(bhdl)->read(dst, size, skip);
       return 0;
@@ -1967,7 +2379,7 @@ int
 xrtBOCopy(xrtBufferHandle dhdl, xrtBufferHandle shdl, size_t sz, size_t dst_offset, size_t src_offset)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOCopy")>(
     [dhdl, shdl, sz, dst_offset, src_offset]{
       const auto& dst = get_boh(dhdl);
       const auto& src = get_boh(shdl);
@@ -1990,7 +2402,7 @@ uint64_t
 xrtBOAddress(xrtBufferHandle bhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [bhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtBOAddress")>([bhdl]{
       return get_boh(bhdl)->get_address();
     });
   }
@@ -232,7 +232,7 @@ namespace xrt {
 
 device::
 device(unsigned int index)
-  : handle(xdp::native::profiling_wrapper("xrt::device::device",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::device")>(
 	   alloc_device_index, index))
 {}
 
@@ -243,7 +243,7 @@ device(const std::string& bdf)
 
 device::
 device(xclDeviceHandle dhdl)
-  : handle(xdp::native::profiling_wrapper("xrt::device::device",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::device")>(
 	   alloc_device_handle, dhdl))
 {}
 
@@ -252,7 +252,7 @@ device::
 load_xclbin(const struct axlf* top)
 {
   XRT_TRACE_POINT_SCOPE(xrt_device_load_xclbin);
-  return xdp::native::profiling_wrapper("xrt::device::load_xclbin", [this, top]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::load_xclbin")>([this, top]{
     xrt::xclbin xclbin{top};
     handle->load_xclbin(xclbin);
     return xclbin.get_uuid();
@@ -264,7 +264,7 @@ device::
 load_xclbin(const std::string& fnm)
 {
   XRT_TRACE_POINT_SCOPE(xrt_device_load_xclbin);
-  return xdp::native::profiling_wrapper("xrt::device::load_xclbin", [this, &fnm]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::load_xclbin")>([this, &fnm]{
     xrt::xclbin xclbin{fnm};
     handle->load_xclbin(xclbin);
     return xclbin.get_uuid();
@@ -276,7 +276,7 @@ device::
 load_xclbin(const xclbin& xclbin)
 {
   XRT_TRACE_POINT_SCOPE(xrt_device_load_xclbin);
-  return xdp::native::profiling_wrapper("xrt::device::load_xclbin",
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::load_xclbin")>(
   [this, &xclbin]{
     handle->load_xclbin(xclbin);
     return xclbin.get_uuid();
@@ -288,7 +288,7 @@ device::
 register_xclbin(const xclbin& xclbin)
 {
   XRT_TRACE_POINT_SCOPE(xrt_device_register_xclbin);
-  return xdp::native::profiling_wrapper("xrt::device::register_xclbin",
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::register_xclbin")>(
   [this, &xclbin]{
     handle->record_xclbin(xclbin);
     return xclbin.get_uuid();
@@ -299,7 +299,7 @@ uuid
 device::
 get_xclbin_uuid() const
 {
-  return xdp::native::profiling_wrapper("xrt::device::get_xclbin_uuid", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::get_xclbin_uuid")>([this]{
     return handle->get_xclbin_uuid();
   });
 }
@@ -314,7 +314,7 @@ void
 device::
 reset()
 {
-  return xdp::native::profiling_wrapper("xrt::device::reset", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::reset")>([this]{
     handle.reset();
   });
 }
@@ -323,7 +323,7 @@ std::pair<const char*, size_t>
 device::
 get_xclbin_section(axlf_section_kind section, const uuid& uuid) const
 {
-  return xdp::native::profiling_wrapper("xrt::device::get_xclbin_section",
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::get_xclbin_section")>(
     [this, section, &uuid]{
       return handle->get_axlf_section_or_error(section, uuid);
     });
@@ -429,7 +429,7 @@ std::vector<char>
 device::
 read_aie_mem(uint16_t context_id, uint16_t col, uint16_t row, uint32_t offset, uint32_t size) const
 {
-  return xdp::native::profiling_wrapper("xrt::aie::device::read_aie_mem",
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::aie::device::read_aie_mem")>(
     [this, &col, row, offset, size, context_id] {
       try {
         // calculate absolute col index
@@ -447,7 +447,7 @@ size_t
 device::
 write_aie_mem(uint16_t context_id, uint16_t col, uint16_t row, uint32_t offset, const std::vector<char>& data)
 {
-  return xdp::native::profiling_wrapper("xrt::aie::device::write_aie_mem",
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::aie::device::write_aie_mem")>(
     [this, &col, row, offset, &data, context_id] {
       try {
         // calculate absolute col index
@@ -464,7 +464,7 @@ uint32_t
 device::
 read_aie_reg(uint16_t context_id, uint16_t col, uint16_t row, uint32_t reg_addr) const
 {
-  return xdp::native::profiling_wrapper("xrt::device::read_aie_reg",
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::read_aie_reg")>(
     [this, &col, row, reg_addr, context_id] {
       try {
         // calculate absolute col index
@@ -482,7 +482,7 @@ bool
 device::
 write_aie_reg(uint16_t context_id, uint16_t col, uint16_t row, uint32_t reg_addr, uint32_t reg_val)
 {
-  return xdp::native::profiling_wrapper("xrt::device::write_aie_reg",
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::device::write_aie_reg")>(
     [this, &col, row, reg_addr, &reg_val, context_id] {
       try {
         // calculate absolute col index
@@ -504,7 +504,7 @@ xrtDeviceHandle
 xrtDeviceOpen(unsigned int index)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [index]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceOpen")>([index]{
       auto device = xrt_core::get_userpf_device(index);
       auto handle = device.get();
       device_cache.add(handle, std::move(device));
@@ -525,7 +525,7 @@ xrtDeviceHandle
 xrtDeviceOpenByBDF(const char* bdf)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [bdf]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceOpenByBDF")>([bdf]{
       return xrtDeviceOpen(xrt_core::get_device_id(bdf));
     });
   }
@@ -543,7 +543,7 @@ int
 xrtDeviceClose(xrtDeviceHandle dhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceClose")>([dhdl]{
       device_cache.remove_or_error(dhdl);
       return 0;
     });
@@ -562,7 +562,7 @@ int
 xrtDeviceLoadXclbin(xrtDeviceHandle dhdl, const axlf* top)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl, top]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceLoadXclbin")>([dhdl, top]{
       xrt::xclbin xclbin{top};
       auto device = device_cache.get_or_error(dhdl);
       device->load_xclbin(xclbin);
@@ -583,7 +583,7 @@ int
 xrtDeviceLoadXclbinFile(xrtDeviceHandle dhdl, const char* fnm)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl, fnm]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceLoadXclbinFile")>([dhdl, fnm]{
       xrt::xclbin xclbin{fnm};
       auto device = device_cache.get_or_error(dhdl);
       device->load_xclbin(xclbin);
@@ -604,7 +604,7 @@ int
 xrtDeviceLoadXclbinHandle(xrtDeviceHandle dhdl, xrtXclbinHandle xhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl, xhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceLoadXclbinHandle")>([dhdl, xhdl]{
       auto device = device_cache.get_or_error(dhdl);
       device->load_xclbin(xrt_core::xclbin_int::get_xclbin(xhdl));
       return 0;
@@ -624,7 +624,7 @@ int
 xrtDeviceLoadXclbinUUID(xrtDeviceHandle dhdl, const xuid_t uuid)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl, uuid]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceLoadXclbinUUID")>([dhdl, uuid]{
       auto device = device_cache.get_or_error(dhdl);
       device->load_xclbin(uuid);
       return 0;
@@ -644,7 +644,7 @@ int
 xrtDeviceGetXclbinUUID(xrtDeviceHandle dhdl, xuid_t out)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl, out]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceGetXclbinUUID")>([dhdl, out]{
       auto device = device_cache.get_or_error(dhdl);
       auto uuid = device->get_xclbin_uuid();
       uuid_copy(out, uuid.get());
@@ -665,7 +665,7 @@ xclDeviceHandle
 xrtDeviceToXclDevice(xrtDeviceHandle dhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceToXclDevice")>([dhdl]{
       auto device = device_cache.get_or_error(dhdl);
       return device->get_device_handle();
     });
@@ -684,7 +684,7 @@ xrtDeviceHandle
 xrtDeviceOpenFromXcl(xclDeviceHandle dhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtDeviceOpenFromXcl")>([dhdl]{
       auto device = xrt_core::get_userpf_device(dhdl);
 
       // Only one xrt unmanaged device per xclDeviceHandle
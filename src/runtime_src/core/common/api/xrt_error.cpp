@@ -274,13 +274,13 @@ namespace xrt {
 
 error::
 error(const xrt::device& device, xrtErrorClass ecl)
-  : handle(xdp::native::profiling_wrapper("xrt::error::error",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::error::error")>(
            alloc_error_from_device, device.get_handle().get(), ecl))
 {}
 
 error::
 error(xrtErrorCode code, xrtErrorTime timestamp)
-  : handle(xdp::native::profiling_wrapper("xrt::error::error",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::error::error")>(
 	   alloc_error_from_code, code, timestamp))
 {}
 
@@ -288,7 +288,7 @@ xrtErrorTime
 error::
 get_timestamp() const
 {
-  return xdp::native::profiling_wrapper("xrt::error::get_timestamp", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::error::get_timestamp")>([this]{
     return handle->get_timestamp();
   });
 }
@@ -297,7 +297,7 @@ xrtErrorCode
 error::
 get_error_code() const
 {
-  return xdp::native::profiling_wrapper("xrt::error::get_error_code", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::error::get_error_code")>([this]{
     return handle->get_error_code();
   });
 }
@@ -306,7 +306,7 @@ std::string
 error::
 to_string() const
 {
-  return xdp::native::profiling_wrapper("xrt::error::to_string", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::error::to_string")>([this]{
     return handle->to_string();
   });
 }
@@ -320,7 +320,7 @@ int
 xrtErrorGetLast(xrtDeviceHandle dhdl, xrtErrorClass ecl, xrtErrorCode* error, uint64_t* timestamp)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtErrorGetLast")>(
     [dhdl, ecl, error, timestamp]{
       auto handle = xrt::error_impl(xrt_core::device_int::get_core_device(dhdl).get(), ecl);
       *error = handle.get_error_code();
@@ -342,7 +342,7 @@ int
 xrtErrorGetString(xrtDeviceHandle, xrtErrorCode error, char* out, size_t len, size_t* out_len)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtErrorGetString")>(
     [error, out, len, out_len]{
       auto str = error_code_to_string(error);
 
@@ -15,6 +15,7 @@
 #include "core/common/usage_metrics.h"
 #include "core/common/xdp/profile.h"
 
+#include <atomic>
 #include <limits>
 #include <memory>
 
@@ -35,6 +36,7 @@ class hw_context_impl : public std::enable_shared_from_this<hw_context_impl>
   std::unique_ptr<xrt_core::hwctx_handle> m_hdl;
   std::shared_ptr<xrt_core::usage_metrics::base_logger> m_usage_logger =
       xrt_core::usage_metrics::get_usage_metrics_logger();
+  std::atomic<xrt::wait_policy> m_wait_policy {xrt::wait_policy::inherit};
 
 public:
   hw_context_impl(std::shared_ptr<xrt_core::device> device, const xrt::uuid& xclbin_id, cfg_param_type cfg_param)
@@ -118,6 +120,18 @@ public:
     return m_mode;
   }
 
+  xrt::wait_policy
+  get_wait_policy() const
+  {
+    return m_wait_policy.load(std::memory_order_relaxed);
+  }
+
+  void
+  set_wait_policy(xrt::wait_policy policy)
+  {
+    m_wait_policy.store(policy, std::memory_order_relaxed);
+  }
+
   xrt_core::hwctx_handle*
   get_hwctx_handle()
   {
@@ -156,6 +170,18 @@ set_exclusive(xrt::hw_context& hwctx)
   hwctx.get_handle()->set_exclusive();
 }
 
+xrt::wait_policy
+get_wait_policy(const xrt::hw_context& hwctx)
+{
+  return hwctx.get_handle()->get_wait_policy();
+}
+
+void
+set_wait_policy(const xrt::hw_context& hwctx, xrt::wait_policy policy)
+{
+  hwctx.get_handle()->set_wait_policy(policy);
+}
+
 xrt::hw_context
 create_hw_context_from_implementation(void* hwctx_impl)
 {
@@ -346,7 +346,7 @@ void
 ip::
 write_register(uint32_t offset, uint32_t data)
 {
-  xdp::native::profiling_wrapper("xrt::ip::write_register",[this, offset, data]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::ip::write_register")>([this, offset, data]{
     handle->write_register(offset, data);
   }) ;
 }
@@ -355,7 +355,7 @@ uint32_t
 ip::
 read_register(uint32_t offset) const
 {
-  return xdp::native::profiling_wrapper("xrt::ip::read_register", [this, offset] {
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::ip::read_register")>([this, offset] {
     return handle->read_register(offset);
   }) ;
 }
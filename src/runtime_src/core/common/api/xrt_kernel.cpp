@@ -34,12 +34,12 @@
 #include "xclbin_int.h"
 
 #include "core/common/api/bo_int.h"
-#include "core/common/bo_cache.h"
 #include "core/common/config_reader.h"
 #include "core/common/cuidx_type.h"
 #include "core/common/device.h"
 #include "core/common/debug.h"
 #include "core/common/error.h"
+#include "core/common/exec_buffer_pool.h"
 #include "core/common/message.h"
 #include "core/common/system.h"
 #include "core/common/trace.h"
@@ -60,6 +60,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <fstream>
 #include <type_traits>
@@ -328,6 +329,24 @@ hwctx_access_mode(xrt::kernel::cu_access_mode mode)
   }
 }
 
+// Default wait policy as specified in xrt.ini
+static xrt::wait_policy
+get_default_wait_policy()
+{
+  static auto policy = [] {
+    auto value = xrt_core::config::get_wait_policy();
+    if (value == "spin")
+      return xrt::wait_policy::spin_then_block;
+    if (value == "poll")
+      return xrt::wait_policy::busy_poll;
+    if (value != "block")
+      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                              "Unknown Runtime.wait_policy '" + value + "', using 'block'");
+    return xrt::wait_policy::block;
+  }();
+  return policy;
+}
+
 // Transition only, to be removed
 static xrt::kernel::cu_access_mode
 cu_access_mode(xrt::hw_context::access_mode mode)
@@ -351,11 +370,8 @@ cu_access_mode(xrt::hw_context::access_mode mode)
 struct device_type
 {
   std::shared_ptr<xrt_core::device> core_device;
-  xrt_core::bo_cache exec_buffer_cache;
   uint32_t uid; // internal unique id for debug
 
-  static constexpr unsigned int cache_size = 128;
-
   static uint32_t
   create_uid()
   {
@@ -366,7 +382,6 @@ struct device_type
   explicit
   device_type(xrtDeviceHandle dhdl)
     : core_device(xrt_core::device_int::get_core_device(dhdl))
-    , exec_buffer_cache(core_device->get_device_handle(), cache_size)
     , uid(create_uid())
   {
     XRT_DEBUGF("device_type::device_type(%d)\n", uid);
@@ -375,7 +390,6 @@ struct device_type
   explicit
   device_type(std::shared_ptr<xrt_core::device> cdev)
     : core_device(std::move(cdev))
-    , exec_buffer_cache(core_device->get_device_handle(), cache_size)
     , uid(create_uid())
   {
     XRT_DEBUGF("device_type::device_type(%d)\n", uid);
@@ -393,10 +407,17 @@ struct device_type
   device_type& operator=(device_type&&) = delete;
 
   template <typename CommandType>
-  xrt_core::bo_cache::cmd_bo<CommandType>
+  xrt_core::exec_buffer_pool::cmd_bo<CommandType>
   create_exec_buf()
   {
-    return exec_buffer_cache.alloc<CommandType>();
+    return core_device->get_exec_buffer_pool().alloc<CommandType>();
+  }
+
+  template <typename CommandType>
+  void
+  release_exec_buf(xrt_core::exec_buffer_pool::cmd_bo<CommandType>&& execbuf)
+  {
+    core_device->get_exec_buffer_pool().release(std::move(execbuf));
   }
 
   [[nodiscard]] xrt_core::device*
@@ -686,9 +707,10 @@ private:
 class kernel_command : public xrt_core::command
 {
 public:
-  using execbuf_type = xrt_core::bo_cache::cmd_bo<ert_start_kernel_cmd>;
+  using execbuf_type = xrt_core::exec_buffer_pool::cmd_bo<ert_start_kernel_cmd>;
   using callback_function_type = std::function<void(ert_cmd_state)>;
   using callback_list = std::vector<callback_function_type>;
+  using clock_type = std::chrono::steady_clock;
 
 private:
   // Return state of underlying exec buffer packet This is an
@@ -719,8 +741,7 @@ public:
   ~kernel_command() override
   {
     XRT_DEBUGF("kernel_command::~kernel_command(%d)\n", m_uid);
-    // This is problematic, bo_cache should return managed BOs
-    m_device->exec_buffer_cache.release(std::move(m_execbuf));
+    m_device->release_exec_buf(std::move(m_execbuf));
   }
 
   kernel_command(const kernel_command&) = delete;
@@ -743,12 +764,12 @@ public:
     }
   }
 
-  // Check if this kernel_command object is in done state
+  // Check if this kernel_command object is in done state.  The
+  // flag is read without the lock so it can be polled while spinning.
   bool
   is_done() const
   {
-    std::lock_guard<std::mutex> lk(m_mutex);
-    return m_done;
+    return m_done.load(std::memory_order_acquire);
   }
 
   // Return state of command object.  The underlying packet
@@ -851,54 +872,228 @@ public:
       (*cb)(state);
   }
 
+  // Mark the command as running prior to submission
+  void
+  prep_run()
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_done)
+      throw std::runtime_error("bad command state, can't launch");
+    m_managed = (m_callbacks && !m_callbacks->empty());
+    m_done = false;
+    m_start_time.store(clock_type::now(), std::memory_order_relaxed);
+  }
+
+  // Revert prep_run() for a command that was not submitted
+  void
+  unprep_run()
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_done = true;
+  }
+
   // Submit the command for execution.
   void
   run()
   {
-    {
-      std::lock_guard<std::mutex> lk(m_mutex);
-      if (!m_done)
-        throw std::runtime_error("bad command state, can't launch");
-      m_managed = (m_callbacks && !m_callbacks->empty());
-      m_done = false;
-    }
+    prep_run();
     if (m_managed)
       m_hwqueue.managed_start(this);
     else
       m_hwqueue.unmanaged_start(this);
   }
 
-  // Wait for command completion
-  ert_cmd_state
-  wait() const
+  // Submit a batch of commands for execution.
+  //
+  // Commands are grouped by hw queue and by managed vs unmanaged
+  // execution, and each group is submitted in one call to its hw
+  // queue.  Commands that could not be submitted are reverted to
+  // done state before the submission error is propagated.
+  static void
+  run(const std::vector<kernel_command*>& cmds)
+  {
+    size_t prepped = 0;
+    try {
+      for (auto cmd : cmds) {
+        cmd->prep_run();
+        ++prepped;
+      }
+    }
+    catch (...) {
+      for (size_t idx = 0; idx < prepped; ++idx)
+        cmds[idx]->unprep_run();
+      throw;
+    }
+
+    struct batch_type
+    {
+      xrt_core::hw_queue hwqueue;
+      bool managed;
+      std::vector<xrt_core::command*> cmds;
+    };
+    std::vector<batch_type> batches;
+    for (auto cmd : cmds) {
+      auto itr = std::find_if(batches.begin(), batches.end(), [cmd](const auto& batch) {
+        return batch.managed == cmd->m_managed
+          && batch.hwqueue.get_handle() == cmd->m_hwqueue.get_handle();
+      });
+      if (itr == batches.end())
+        itr = batches.insert(batches.end(), {cmd->m_hwqueue, cmd->m_managed, {}});
+      (*itr).cmds.push_back(cmd);
+    }
+
+    for (auto bitr = batches.begin(); bitr != batches.end(); ++bitr) {
+      auto& batch = (*bitr);
+      try {
+        while (!batch.cmds.empty()) {
+          auto count = batch.managed
+            ? batch.hwqueue.managed_start(batch.cmds)
+            : batch.hwqueue.unmanaged_start(batch.cmds);
+          batch.cmds.erase(batch.cmds.begin(), batch.cmds.begin() + count);
+        }
+      }
+      catch (...) {
+        for (auto itr = bitr; itr != batches.end(); ++itr)
+          for (auto cmd : (*itr).cmds)
+            static_cast<kernel_command*>(cmd)->unprep_run();
+        throw;
+      }
+    }
+  }
+
+  // Set the wait policy for this command
+  void
+  set_wait_policy(xrt::wait_policy policy)
   {
-    if (m_managed) {
-      std::unique_lock<std::mutex> lk(m_mutex);
-      while (!m_done)
-        m_exec_done.wait(lk);
+    m_wait_policy.store(policy, std::memory_order_relaxed);
+  }
+
+  // Effective wait policy of this command, which is inherited from
+  // the hw context or xrt.ini unless explicitly set
+  xrt::wait_policy
+  get_wait_policy() const
+  {
+    auto cmd_policy = m_wait_policy.load(std::memory_order_relaxed);
+    if (cmd_policy != xrt::wait_policy::inherit)
+      return cmd_policy;
+
+    if (m_hwctx) {
+      auto policy = xrt_core::hw_context_int::get_wait_policy(m_hwctx);
+      if (policy != xrt::wait_policy::inherit)
+        return policy;
     }
-    else {
-      m_hwqueue.wait(this);
+
+    return get_default_wait_policy();
+  }
+
+  // Deadline for spinning prior to blocking.  Spin until twice the
+  // average observed execution time has elapsed since the command
+  // was started, but no longer than the configured max spin time.
+  // Commands that typically run longer than the max spin time do
+  // not spin at all.
+  clock_type::time_point
+  get_spin_deadline(clock_type::time_point now) const
+  {
+    static const auto spin_max = std::chrono::microseconds(xrt_core::config::get_wait_spin_max_us());
+    auto avg = std::chrono::nanoseconds(m_avg_exec_ns.load(std::memory_order_relaxed));
+    if (avg > spin_max)
+      return now;
+
+    auto start = m_start_time.load(std::memory_order_relaxed);
+    return std::min(start + 2 * avg, now + spin_max);
+  }
+
+  // Update average execution time with the elapsed time since start
+  void
+  record_exec_time() const
+  {
+    auto sample = static_cast<uint64_t>
+      (std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - m_start_time.load(std::memory_order_relaxed)).count());
+    auto avg = m_avg_exec_ns.load(std::memory_order_relaxed);
+    m_avg_exec_ns.store(avg ? (avg * 7 + sample) / 8 : sample, std::memory_order_relaxed);
+  }
+
+  // Spin for command completion as dictated by the wait policy.
+  // Returns std::nullopt if the caller should proceed to block.
+  std::optional<std::cv_status>
+  spin_wait(const std::chrono::milliseconds& timeout_ms) const
+  {
+    auto policy = get_wait_policy();
+    if (policy == xrt::wait_policy::block)
+      return std::nullopt;
+
+    auto now = clock_type::now();
+    auto deadline = timeout_ms.count() ? now + timeout_ms : clock_type::time_point::max();
+    if (policy == xrt::wait_policy::spin_then_block)
+      deadline = std::min(deadline, get_spin_deadline(now));
+
+    if (deadline <= now)
+      return std::nullopt;
+
+    if (m_managed) {
+      // Completion of managed commands is detected by the monitor
+      // thread, spinning avoids blocking on the condition variable
+      while (!is_done())
+        if (clock_type::now() >= deadline)
+          return (policy == xrt::wait_policy::busy_poll) ? std::optional{std::cv_status::timeout} : std::nullopt;
+      return std::cv_status::no_timeout;
     }
 
-    return get_state_raw(); // state wont change after wait
+    auto status = m_hwqueue.spin_wait(this, deadline);
+    if (status == std::cv_status::no_timeout || policy == xrt::wait_policy::busy_poll)
+      return status;
+
+    return std::nullopt;
   }
 
-  std::pair<ert_cmd_state, std::cv_status>
-  wait(const std::chrono::milliseconds& timeout_ms) const
+  // Block for command completion, 0 timeout means no timeout
+  std::cv_status
+  block_wait(const std::chrono::milliseconds& timeout_ms) const
   {
     if (m_managed) {
       std::unique_lock<std::mutex> lk(m_mutex);
-      while (!m_done)
-        if (m_exec_done.wait_for(lk, timeout_ms) == std::cv_status::timeout)
-          return {get_state_raw(), std::cv_status::timeout};
-    }
-    else {
-      if (m_hwqueue.wait(this, timeout_ms) == std::cv_status::timeout)
-        return {get_state_raw(), std::cv_status::timeout};
+      while (!m_done) {
+        if (!timeout_ms.count())
+          m_exec_done.wait(lk);
+        else if (m_exec_done.wait_for(lk, timeout_ms) == std::cv_status::timeout)
+          return std::cv_status::timeout;
+      }
+      return std::cv_status::no_timeout;
     }
 
-    return {get_state_raw(), std::cv_status::no_timeout};
+    return m_hwqueue.wait(this, timeout_ms);
+  }
+
+  // Wait for command completion per wait policy, 0 timeout means
+  // no timeout.  The execution time is sampled only if the command
+  // was running when the wait started.
+  std::cv_status
+  wait_for(const std::chrono::milliseconds& timeout_ms) const
+  {
+    bool running = get_state_raw() < ERT_CMD_STATE_COMPLETED;
+    auto status = spin_wait(timeout_ms);
+    if (!status)
+      status = block_wait(timeout_ms);
+
+    if (running && *status == std::cv_status::no_timeout)
+      record_exec_time();
+
+    return *status;
+  }
+
+  // Wait for command completion
+  ert_cmd_state
+  wait() const
+  {
+    wait_for(std::chrono::milliseconds(0));
+    return get_state_raw(); // state wont change after wait
+  }
+
+  std::pair<ert_cmd_state, std::cv_status>
+  wait(const std::chrono::milliseconds& timeout_ms) const
+  {
+    auto status = wait_for(timeout_ms);
+    return {get_state_raw(), status};
   }
 
   ////////////////////////////////////////////////////////////////
@@ -907,7 +1102,7 @@ public:
   ert_packet*
   get_ert_packet() const override
   {
-    return reinterpret_cast<ert_packet*>(m_execbuf.second);
+    return reinterpret_cast<ert_packet*>(m_execbuf.cmd);
   }
 
   xrt_core::device*
@@ -919,7 +1114,7 @@ public:
   xrt_core::buffer_handle*
   get_exec_bo() const override
   {
-    return m_execbuf.first.get();
+    return m_execbuf.bo.get();
   }
 
   xrt_core::hwctx_handle*
@@ -972,7 +1167,12 @@ private:
   execbuf_type m_execbuf;        // underlying execution buffer
   unsigned int m_uid = 0;
   bool m_managed = false;
-  mutable bool m_done = false;
+  mutable std::atomic<bool> m_done {false}; // written under m_mutex
+
+  // Read by waiting threads without holding m_mutex
+  std::atomic<xrt::wait_policy> m_wait_policy {xrt::wait_policy::inherit};
+  std::atomic<clock_type::time_point> m_start_time {clock_type::time_point{}}; // time of last run()
+  mutable std::atomic<uint64_t> m_avg_exec_ns {0};  // average observed execution time
 
   mutable std::mutex m_mutex;
   mutable std::condition_variable m_exec_done;
@@ -2085,6 +2285,7 @@ class run_impl
   uint32_t uid;                           // internal unique id for debug
   std::unique_ptr<arg_setter> asetter;    // helper to populate payload data
   bool encode_cumasks = false;            // indicate if cmd cumasks must be re-encoded
+  std::vector<xrt::bo::async_handle> m_transfers; // transfers next start waits for
   std::shared_ptr<xrt_core::usage_metrics::base_logger> m_usage_logger =
       xrt_core::usage_metrics::get_usage_metrics_logger();
 
@@ -2350,6 +2551,24 @@ public:
   void
   prep_start()
   {
+    // Host transfers this start depends on must complete first.  The
+    // transfers are consumed even if some failed, such that a retry
+    // of start() does not wait for them again.
+    auto transfers = std::move(m_transfers);
+    m_transfers.clear();
+    std::exception_ptr eptr;
+    for (auto& transfer : transfers) {
+      try {
+        transfer.wait();
+      }
+      catch (...) {
+        if (!eptr)
+          eptr = std::current_exception();
+      }
+    }
+    if (eptr)
+      std::rethrow_exception(eptr);
+
     if (m_module)
       // Sync the module to device to ensure any patches are applied,
       // noop if module patching hasn't changed since last sync.
@@ -2370,13 +2589,22 @@ public:
     XRT_DEBUG_CALL(debug_cmd_packet(kernel->get_name(), pkt));
   }
 
-  // start() - start the run object (execbuf)
+  // validate() - check that the run object can be started
+  //
+  // The check has no side effects, such that a batch of run objects
+  // can be validated before any of them is prepared.
   virtual void
-  start()
+  validate() const
   {
     if (m_runlist)
       throw xrt_core::error("Run object belongs to a runlist and cannot be explicitly started");
-    
+  }
+
+  // prepare() - prepare the run object for start
+  virtual void
+  prepare()
+  {
+    validate();
     prep_start();
     
     // log kernel start info
@@ -2385,9 +2613,38 @@ public:
     // constructing args in place
     // sending state as ERT_CMD_STATE_NEW for kernel start
     m_usage_logger->log_kernel_run_info(kernel.get(), this, ERT_CMD_STATE_NEW);
+  }
+
+  // start() - start the run object (execbuf)
+  void
+  start()
+  {
+    prepare();
     cmd->run();
   }
 
+  // start() - start a batch of run objects
+  static void
+  start(const std::vector<xrt::run>& runs)
+  {
+    // Validate all run objects before preparing any of them
+    std::vector<kernel_command*> cmds;
+    cmds.reserve(runs.size());
+    for (const auto& run : runs) {
+      const auto& rimpl = run.get_handle();
+      rimpl->validate();
+      auto cmd = rimpl->cmd.get();
+      if (!cmd->is_done() || std::find(cmds.begin(), cmds.end(), cmd) != cmds.end())
+        throw xrt_core::error(EBUSY, "Run object is already running");
+      cmds.push_back(cmd);
+    }
+
+    for (const auto& run : runs)
+      run.get_handle()->prepare();
+
+    kernel_command::run(cmds);
+  }
+
   void
   start(const autostart& iterations)
   {
@@ -2410,6 +2667,12 @@ public:
     m_hwqueue.submit_wait(fence);
   }
 
+  void
+  submit_wait(const xrt::bo::async_handle& transfer)
+  {
+    m_transfers.push_back(transfer);
+  }
+
   void
   submit_signal(const xrt::fence& fence)
   {
@@ -2468,8 +2731,10 @@ public:
     ert_cmd_state state {ERT_CMD_STATE_NEW}; // initial value doesn't matter
     if (timeout_ms.count()) {
       auto [ert_state, cv_status] = cmd->wait(timeout_ms);
-      if (cv_status == std::cv_status::timeout)
+      if (cv_status == std::cv_status::timeout) {
+        xdp::native::flight_recorder_dump("xrt::run::wait timeout");
         return ERT_CMD_STATE_TIMEOUT;
+      }
 
       state = ert_state;
     }
@@ -2477,6 +2742,9 @@ public:
       state = cmd->wait();
     }
 
+    if (state != ERT_CMD_STATE_COMPLETED)
+      xdp::native::flight_recorder_dump(("xrt::run::wait " + cmd_state_to_string(state)).c_str());
+
     m_usage_logger->log_kernel_run_info(kernel.get(), this, state);
     static bool dump = xrt_core::config::get_feature_toggle("Debug.dump_scratchpad_mem");
     if (dump)
@@ -2496,8 +2764,10 @@ public:
     ert_cmd_state state {ERT_CMD_STATE_NEW}; // initial value doesn't matter
     if (timeout_ms.count()) {
       auto [ert_state, cv_status] = cmd->wait(timeout_ms);
-      if (cv_status == std::cv_status::timeout)
+      if (cv_status == std::cv_status::timeout) {
+        xdp::native::flight_recorder_dump("xrt::run::wait timeout");
         return std::cv_status::timeout;
+      }
 
       state = ert_state;
     }
@@ -2514,6 +2784,7 @@ public:
       return std::cv_status::no_timeout;
     }
 
+    xdp::native::flight_recorder_dump(("xrt::run::wait " + cmd_state_to_string(state)).c_str());
     std::string msg = "Command failed to complete successfully (" + cmd_state_to_string(state) + ")";
     throw xrt::run::command_error(state, msg);
   }
@@ -2665,7 +2936,7 @@ class mailbox_impl : public run_impl
   // All mailboxes should be writeable otherwise nothing, not even
   // starting the kernel will work.
   void
-  mailbox_writeable_or_error()
+  mailbox_writeable_or_error() const
   {
     if (m_readonly)
       throw xrt_core::system_error(EPERM, "Mailbox is read-only");
@@ -2778,7 +3049,14 @@ public:
   }
 
   void
-  start() override
+  validate() const override
+  {
+    mailbox_writeable_or_error();
+    run_impl::validate();
+  }
+
+  void
+  prepare() override
   {
     // sync command payload to mailbox if necessary
     write();
@@ -2788,8 +3066,8 @@ public:
     auto pkt = cmd->get_ert_packet();
     pkt->count = kernel->get_num_cumasks() + ap_ctrl_reserved;
 
-    // Regular start
-    run_impl::start();
+    // Regular prepare
+    run_impl::prepare();
   }
 };
 
@@ -2923,14 +3201,14 @@ class runlist_impl
   // The runlist creates its own execution buffers, which are
   // ert_packets with payload interpreted as ert_cmd_chain_data
   using cmd_type = ert_packet;
-  using execbuf_type = xrt_core::bo_cache::cmd_bo<cmd_type>;
-  xrt_core::bo_cache_t<execbuf_size> m_exec_buffer_cache;
+  using execbuf_type = xrt_core::exec_buffer_pool::cmd_bo<cmd_type>;
 
   enum class state { idle, closed, running, error };
   mutable state m_state = state::idle;
   
   xrt::hw_context m_hwctx;
   xrt_core::hw_queue m_hwqueue;
+  std::shared_ptr<xrt_core::device> m_core_device;
   std::vector<xrt::run> m_runlist;
   std::vector<xrt_core::buffer_handle*> m_bos;
 
@@ -2958,7 +3236,7 @@ class runlist_impl
   static std::pair<xrt_core::buffer_handle*, cmd_type*>
   unpack(const execbuf_type& execbuf)
   {
-    return {execbuf.first.get(), execbuf.second};
+    return {execbuf.bo.get(), execbuf.cmd};
   }
 
   static std::pair<xrt_core::buffer_handle*, cmd_type*>
@@ -2967,14 +3245,15 @@ class runlist_impl
     return unpack(*execbuf);
   }
 
-  // Execution buffers are cached and reused within this runlist
-  // This function creates or gets an execbuf from the cache
-  // and initializes the command in prep for add chained commands.
+  // Execution buffers are allocated from the device exec buffer
+  // pool and returned to the pool when the runlist is reset or
+  // destroyed. This function gets an execbuf from the pool and
+  // initializes the command in prep for add chained commands.
   execbuf_type
   create_exec_buf()
   {
-    auto execbuf = m_exec_buffer_cache.alloc<cmd_type>();
-    auto pkt = execbuf.second;
+    auto execbuf = m_core_device->get_exec_buffer_pool().alloc<cmd_type>(execbuf_size);
+    auto pkt = execbuf.cmd;
     pkt->opcode = ERT_CMD_CHAIN;
     pkt->count = sizeof(ert_cmd_chain_data) / word_size;  // payload size in words
     auto chain_data = get_ert_cmd_chain_data(pkt);
@@ -3073,8 +3352,10 @@ class runlist_impl
   {
     // Wait on last chained command that was submitted; this implies
     // all have finished.
-    if (wait_last_cmd(timeout) == std::cv_status::timeout)
+    if (wait_last_cmd(timeout) == std::cv_status::timeout) {
+      xdp::native::flight_recorder_dump("xrt::runlist::wait timeout");
       return std::cv_status::timeout;
+    }
 
     // All submitted commands have completed (error or not).  If any
     // command failed to complete successfully, then all subsequent
@@ -3107,6 +3388,7 @@ class runlist_impl
       // the failing run object has been updated by find_first_error()
       auto run = m_runlist.at(first_error_idx);
       set_run_state(run, state);
+      xdp::native::flight_recorder_dump(("xrt::runlist::wait " + cmd_state_to_string(state)).c_str());
       throw xrt::runlist::command_error(run, state, "runlist failed execution");
     }
 
@@ -3141,12 +3423,22 @@ public:
       run.get_handle()->clear_runlist();
   }
 
+  // Return all chained command execbufs to the device pool
+  void
+  release_exec_bufs()
+  {
+    auto& pool = m_core_device->get_exec_buffer_pool();
+    for (auto& execbuf : m_cmds)
+      pool.release(std::move(execbuf));
+    m_cmds.clear();
+  }
+
 public:
   explicit
   runlist_impl(xrt::hw_context hwctx)
-    : m_exec_buffer_cache{hwctx.get_device().get_handle(), 128}
-    , m_hwctx{std::move(hwctx)}
+    : m_hwctx{std::move(hwctx)}
     , m_hwqueue{m_hwctx}
+    , m_core_device{xrt_core::hw_context_int::get_core_device(m_hwctx)}
   {}
 
   ~runlist_impl()
@@ -3154,6 +3446,7 @@ public:
     // Make sure all run objects are severed from this list
     try {
       clear_runs();
+      release_exec_bufs();
     }
     catch (const std::exception& ex) {
       xrt_core::send_exception_message("runlist clear_runs error: " + std::string(ex.what()));
@@ -3301,7 +3594,7 @@ public:
     m_runlist.clear();
     m_bos.clear();
     m_submitted_cmds.clear();
-    m_cmds.clear();
+    release_exec_bufs();
     m_state = state::idle;
   }
 };
@@ -3686,8 +3979,8 @@ namespace xrt {
 
 run::
 run(const kernel& krnl)
-  : handle(xdp::native::profiling_wrapper
-           ("xrt::run::run",alloc_run, krnl.get_handle()))
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::run")>
+           (alloc_run, krnl.get_handle()))
 {}
 
 void
@@ -3695,8 +3988,8 @@ run::
 start()
 {
   XRT_TRACE_POINT_SCOPE(xrt_run_start);
-  xdp::native::profiling_wrapper
-    ("xrt::run::start", [this] {
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::start")>
+    ([this] {
       handle->start();
     });
 }
@@ -3727,7 +4020,7 @@ run::
 wait(const std::chrono::milliseconds& timeout_ms) const
 {
   XRT_TRACE_POINT_SCOPE(xrt_run_wait);
-  return xdp::native::profiling_wrapper("xrt::run::wait",
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::wait")>(
     [this, &timeout_ms] {
       return handle->wait(timeout_ms);
     });
@@ -3738,7 +4031,7 @@ run::
 wait2(const std::chrono::milliseconds& timeout_ms) const
 {
   XRT_TRACE_POINT_SCOPE(xrt_run_wait2);
-  return xdp::native::profiling_wrapper("xrt::run::wait",
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::wait")>(
     [this, &timeout_ms] {
       return handle->wait_throw_on_error(timeout_ms);
     });
@@ -3748,7 +4041,7 @@ ert_cmd_state
 run::
 state() const
 {
-  return xdp::native::profiling_wrapper("xrt::run::state", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::state")>([this]{
     return handle->state();
   });
 }
@@ -3757,7 +4050,7 @@ uint32_t
 run::
 return_code() const
 {
-  return xdp::native::profiling_wrapper("xrt::run::return_code", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::return_code")>([this]{
     return handle->return_code();
   });
 }
@@ -3821,7 +4114,7 @@ ert_packet*
 run::
 get_ert_packet() const
 {
-  return xdp::native::profiling_wrapper("xrt::run::get_ert_packet", [this]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::get_ert_packet")>([this]{
     return handle->get_ert_packet();
   });
 }
@@ -3831,17 +4124,27 @@ run::
 submit_wait(const xrt::fence& fence)
 {
   XRT_TRACE_POINT_SCOPE(xrt_submit_wait);
-  return xdp::native::profiling_wrapper("xrt::run::submit_wait", [this, &fence]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::submit_wait")>([this, &fence]{
     handle->submit_wait(fence);
   });
 }
 
+void
+run::
+submit_wait(const xrt::bo::async_handle& transfer)
+{
+  XRT_TRACE_POINT_SCOPE(xrt_submit_wait);
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::submit_wait")>([this, &transfer]{
+    handle->submit_wait(transfer);
+  });
+}
+
 void
 run::
 submit_signal(const xrt::fence& fence)
 {
   XRT_TRACE_POINT_SCOPE(xrt_submit_signal);
-  return xdp::native::profiling_wrapper("xrt::run::submit_signal", [this, &fence]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::run::submit_signal")>([this, &fence]{
     handle->submit_signal(fence);
   });
 }
@@ -3852,13 +4155,13 @@ run::
 
 kernel::
 kernel(const xrt::device& xdev, const xrt::uuid& xclbin_id, const std::string& name, cu_access_mode mode)
-  : handle(xdp::native::profiling_wrapper("xrt::kernel::kernel",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::kernel::kernel")>(
       alloc_kernel, get_device(xdev), xclbin_id, name, mode))
 {}
 
 kernel::
 kernel(xclDeviceHandle dhdl, const xrt::uuid& xclbin_id, const std::string& name, cu_access_mode mode)
-  : handle(xdp::native::profiling_wrapper("xrt::kernel::kernel",
+  : handle(xdp::native::profiling_wrapper<xdp::native::api_id("xrt::kernel::kernel")>(
       alloc_kernel, get_device(xrt_core::get_userpf_device(dhdl)), xclbin_id, name, mode))
 {}
 
@@ -3871,7 +4174,7 @@ uint32_t
 kernel::
 read_register(uint32_t offset) const
 {
-  return xdp::native::profiling_wrapper("xrt::kernel::read_register", [this, offset]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::kernel::read_register")>([this, offset]{
     return handle->read_register(offset);
   });
 }
@@ -3880,7 +4183,7 @@ void
 kernel::
 write_register(uint32_t offset, uint32_t data)
 {
-  xdp::native::profiling_wrapper("xrt::kernel::write_register", [this, offset, data]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::kernel::write_register")>([this, offset, data]{
     handle->write_register(offset, data);
   });
 }
@@ -3890,7 +4193,7 @@ int
 kernel::
 group_id(int argno) const
 {
-  return xdp::native::profiling_wrapper("xrt::kernel::group_id", [this, argno]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::kernel::group_id")>([this, argno]{
     return handle->group_id(argno);
   });
 }
@@ -3899,7 +4202,7 @@ uint32_t
 kernel::
 offset(int argno) const
 {
-  return xdp::native::profiling_wrapper("xrt::kernel::offset", [this, argno]{
+  return xdp::native::profiling_wrapper<xdp::native::api_id("xrt::kernel::offset")>([this, argno]{
     return handle->arg_offset(argno);
   });
 }
@@ -4009,6 +4312,28 @@ reset()
   handle->reset();
 }
 
+void
+set_wait_policy(const xrt::run& run, wait_policy policy)
+{
+  run.get_handle()->get_cmd()->set_wait_policy(policy);
+}
+
+void
+set_wait_policy(const xrt::hw_context& hwctx, wait_policy policy)
+{
+  xrt_core::hw_context_int::set_wait_policy(hwctx, policy);
+}
+
+void
+start(const std::vector<xrt::run>& runs)
+{
+  XRT_TRACE_POINT_SCOPE(xrt_run_start_batch);
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrt::start")>
+    ([&runs] {
+      run_impl::start(runs);
+    });
+}
+
 } // namespace xrt
 
 ////////////////////////////////////////////////////////////////
@@ -4145,7 +4470,7 @@ xrtKernelHandle
 xrtPLKernelOpen(xrtDeviceHandle dhdl, const xuid_t xclbin_uuid, const char *name)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtPLKernelOpen")>(
     [dhdl, xclbin_uuid, name]{
       return api::xrtKernelOpen(dhdl, xclbin_uuid, name, ip_context::access_mode::shared);
     });
@@ -4164,7 +4489,7 @@ xrtKernelHandle
 xrtPLKernelOpenExclusive(xrtDeviceHandle dhdl, const xuid_t xclbin_uuid, const char *name)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtPLKernelOpenExclusive")>(
     [dhdl, xclbin_uuid, name]{
       return api::xrtKernelOpen(dhdl, xclbin_uuid, name, ip_context::access_mode::exclusive);
     });
@@ -4183,7 +4508,7 @@ int
 xrtKernelClose(xrtKernelHandle khdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [khdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtKernelClose")>([khdl]{
       api::xrtKernelClose(khdl);
       return 0;
     });
@@ -4202,7 +4527,7 @@ xrtRunHandle
 xrtRunOpen(xrtKernelHandle khdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [khdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunOpen")>([khdl]{
       return api::xrtRunOpen(khdl);
     });
   }
@@ -4220,7 +4545,7 @@ int
 xrtKernelArgGroupId(xrtKernelHandle khdl, int argno)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [khdl, argno]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtKernelArgGroupId")>([khdl, argno]{
       return kernels.get_or_error(khdl)->group_id(argno);
     });
   }
@@ -4238,7 +4563,7 @@ uint32_t
 xrtKernelArgOffset(xrtKernelHandle khdl, int argno)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [khdl, argno]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtKernelArgOffset")>([khdl, argno]{
       return kernels.get_or_error(khdl)->arg_offset(argno);
     });
   }
@@ -4256,7 +4581,7 @@ int
 xrtKernelReadRegister(xrtKernelHandle khdl, uint32_t offset, uint32_t* datap)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtKernelReadRegister")>(
     [khdl, offset, datap]{
       *datap = kernels.get_or_error(khdl)->read_register(offset);
       return 0;
@@ -4276,7 +4601,7 @@ int
 xrtKernelWriteRegister(xrtKernelHandle khdl, uint32_t offset, uint32_t data)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtKernelWriteRegister")>(
     [khdl, offset, data]{
       kernels.get_or_error(khdl)->write_register(offset, data);
       return 0;
@@ -4299,7 +4624,7 @@ xrtKernelRun(xrtKernelHandle khdl, ...)
     std::va_list args;
     std::va_list* argptr = &args;
     va_start(args, khdl);  // NOLINT
-    auto result = xdp::native::profiling_wrapper(__func__,
+    auto result = xdp::native::profiling_wrapper<xdp::native::api_id("xrtKernelRun")>(
     [khdl, argptr]{
       auto handle = xrtRunOpen(khdl);
       auto run = runs.get_or_error(handle);
@@ -4324,7 +4649,7 @@ int
 xrtRunClose(xrtRunHandle rhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [rhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunClose")>([rhdl]{
       api::xrtRunClose(rhdl);
       return 0;
     });
@@ -4343,7 +4668,7 @@ ert_cmd_state
 xrtRunState(xrtRunHandle rhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [rhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunState")>([rhdl]{
       return api::xrtRunState(rhdl);
     });
   }
@@ -4361,7 +4686,7 @@ ert_cmd_state
 xrtRunWait(xrtRunHandle rhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [rhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunWait")>([rhdl]{
       return api::xrtRunWait(rhdl, 0);
     });
   }
@@ -4379,7 +4704,7 @@ ert_cmd_state
 xrtRunWaitFor(xrtRunHandle rhdl, unsigned int timeout_ms)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [rhdl, timeout_ms]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunWaitFor")>([rhdl, timeout_ms]{
       return api::xrtRunWait(rhdl, timeout_ms);
     });
   }
@@ -4399,7 +4724,7 @@ xrtRunSetCallback(xrtRunHandle rhdl, ert_cmd_state state,
                   void* data)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunSetCallback")>(
     [rhdl, state, pfn_state_notify, data]{
       api::xrtRunSetCallback(rhdl, state, pfn_state_notify, data);
       return 0;
@@ -4419,7 +4744,7 @@ int
 xrtRunStart(xrtRunHandle rhdl)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [rhdl]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunStart")>([rhdl]{
       api::xrtRunStart(rhdl);
       return 0;
     });
@@ -4441,7 +4766,7 @@ xrtRunUpdateArg(xrtRunHandle rhdl, int index, ...)
     std::va_list args;
     std::va_list* argptr = &args;
     va_start(args, index); // NOLINT
-    auto result = xdp::native::profiling_wrapper(__func__,
+    auto result = xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunUpdateArg")>(
     [rhdl, index, argptr]{
       auto upd = get_run_update(rhdl);
       upd->update_arg_at_index(index, argptr);
@@ -4464,7 +4789,7 @@ int
 xrtRunUpdateArgV(xrtRunHandle rhdl, int index, const void* value, size_t bytes)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunUpdateArgV")>(
     [rhdl, index, value, bytes]{
       auto upd = get_run_update(rhdl);
       upd->update_arg_at_index(index, value, bytes);
@@ -4488,7 +4813,7 @@ xrtRunSetArg(xrtRunHandle rhdl, int index, ...)
     std::va_list args;
     std::va_list* argptr = &args;
     va_start(args, index);  // NOLINT
-    auto result = xdp::native::profiling_wrapper(__func__,
+    auto result = xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunSetArg")>(
     [rhdl, index, argptr]{
       auto run = runs.get_or_error(rhdl);
       run->set_arg_at_index(index, argptr);
@@ -4511,7 +4836,7 @@ int
 xrtRunSetArgV(xrtRunHandle rhdl, int index, const void* value, size_t bytes)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunSetArgV")>(
     [rhdl, index, value, bytes]{
       auto run = runs.get_or_error(rhdl);
       run->set_arg_at_index(index, value, bytes);
@@ -4532,7 +4857,7 @@ int
 xrtRunGetArgV(xrtRunHandle rhdl, int index, void* value, size_t bytes)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunGetArgV")>(
     [rhdl, index, value, bytes]{
       auto run = runs.get_or_error(rhdl);
       run->get_arg_at_index(index, static_cast<uint32_t*>(value), bytes);
@@ -4552,7 +4877,7 @@ xrtRunGetArgV(xrtRunHandle rhdl, int index, void* value, size_t bytes)
 void
 xrtRunGetArgVPP(xrt::run run, int index, void* value, size_t bytes)
 {
-  xdp::native::profiling_wrapper(__func__, [&run, index, value, bytes]{
+  xdp::native::profiling_wrapper<xdp::native::api_id("xrtRunGetArgVPP")>([&run, index, value, bytes]{
     const auto& rimpl = run.get_handle();
     rimpl->get_arg_at_index(index, static_cast<uint32_t*>(value), bytes);
   });
@@ -23,12 +23,13 @@
 #include <elfio/elfio.hpp>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <cctype>
 #include <cstdint>
 #include <cstring>
 #include <numeric>
 #include <map>
-#include <set>
 #include <string>
 #include <sstream>
 
@@ -98,6 +99,27 @@ using instr_buf = buf;
 using control_packet = buf;
 using ctrlcode = buf; // represent control code for column or partition
 
+// Granularity of control code buffer syncs after patching
+constexpr uint64_t sync_page_size = 4096;
+
+// Sort and merge overlapping or adjacent [begin, end) ranges
+void
+coalesce_ranges(std::vector<std::pair<uint64_t, uint64_t>>& ranges)
+{
+  if (ranges.size() < 2)
+    return;
+
+  std::sort(ranges.begin(), ranges.end());
+  size_t last = 0;
+  for (size_t idx = 1; idx < ranges.size(); ++idx) {
+    if (ranges[idx].first <= ranges[last].second)
+      ranges[last].second = std::max(ranges[last].second, ranges[idx].second);
+    else
+      ranges[++last] = ranges[idx];
+  }
+  ranges.resize(last + 1);
+}
+
 // struct patcher - patcher for a symbol
 //
 // Manage patching of a symbol in the control code.  The symbol
@@ -158,7 +180,7 @@ struct patcher
 // Replace certain bits of *data_to_patch with register_value. Which bits to be replaced is specified by mask
 // For     *data_to_patch be 0xbb11aaaa and mask be 0x00ff0000
 // To make *data_to_patch be 0xbb55aaaa, register_value must be 0x00550000
-  void
+  static void
   patch32(uint32_t* data_to_patch, uint64_t register_value, uint32_t mask)
   {
     if ((reinterpret_cast<uintptr_t>(data_to_patch) & 0x3) != 0)
@@ -169,7 +191,7 @@ struct patcher
     *data_to_patch = new_value;
   }
 
-  void
+  static void
   patch57(uint32_t* bd_data_ptr, uint64_t patch)
   {
     uint64_t base_address =
@@ -183,7 +205,7 @@ struct patcher
     bd_data_ptr[8] = (bd_data_ptr[8] & 0xFFFFFE00) | ((base_address >> 48) & 0x1FF);  // NOLINT
   }
 
-  void
+  static void
   patch57_aie4(uint32_t* bd_data_ptr, uint64_t patch)
   {
     constexpr uint64_t ddr_aie_addr_offset = 0x80000000;
@@ -197,7 +219,7 @@ struct patcher
     bd_data_ptr[0] = (bd_data_ptr[0] & 0xFE000000) | ((base_address >> 32) & 0x1FFFFFF);// NOLINT
   }
 
-  void
+  static void
   patch_ctrl48(uint32_t* bd_data_ptr, uint64_t patch)
   {
     // This patching scheme is originated from NPU firmware
@@ -212,7 +234,8 @@ struct patcher
     bd_data_ptr[3] = (bd_data_ptr[3] & 0xFFFF0000) | (base_address >> 32);            // NOLINT
   }
 
-  void patch_shim48(uint32_t* bd_data_ptr, uint64_t patch)
+  static void
+  patch_shim48(uint32_t* bd_data_ptr, uint64_t patch)
   {
     // This patching scheme is originated from NPU firmware
     constexpr uint64_t ddr_aie_addr_offset = 0x80000000;
@@ -226,37 +249,171 @@ struct patcher
     bd_data_ptr[2] = (bd_data_ptr[2] & 0xFFFF0000) | (base_address >> 32);            // NOLINT
   }
 
+  // Pages of control code modified by this patcher, [begin, end) byte
+  // ranges aligned to sync_page_size.  Computed once all relocations
+  // have been added to the patcher.
+  std::vector<std::pair<uint64_t, uint64_t>> m_dirty_pages;
+
+  // Number of bytes from patch offset modified by patching scheme
+  size_t
+  patch_size() const
+  {
+    switch (m_symbol_type) {
+    case symbol_type::scalar_32bit_kind:
+      return sizeof(uint32_t);
+    case symbol_type::shim_dma_base_addr_symbol_kind:
+      return 9 * sizeof(uint32_t); // NOLINT bd_data_ptr[0:8]
+    case symbol_type::shim_dma_aie4_base_addr_symbol_kind:
+      return 2 * sizeof(uint32_t); // bd_data_ptr[0:1]
+    case symbol_type::control_packet_48:
+      return 4 * sizeof(uint32_t); // bd_data_ptr[0:3]
+    case symbol_type::shim_dma_48:
+      return 3 * sizeof(uint32_t); // bd_data_ptr[0:2]
+    default:
+      return 0;
+    }
+  }
+
+  void
+  init_dirty_pages()
+  {
+    m_dirty_pages.clear();
+    auto size = patch_size();
+    for (const auto& item : m_ctrlcode_patchinfo) {
+      auto begin = item.offset_to_patch_buffer & ~(sync_page_size - 1);
+      auto end = (item.offset_to_patch_buffer + size + sync_page_size - 1) & ~(sync_page_size - 1);
+      m_dirty_pages.emplace_back(begin, end);
+    }
+    coalesce_ranges(m_dirty_pages);
+  }
+
+  // Apply fn to each relocation of this patcher
+  template <typename PatchFunction>
+  void
+  patch_each(uint8_t* base, PatchFunction&& fn) const
+  {
+    for (const auto& item : m_ctrlcode_patchinfo)
+      fn(reinterpret_cast<uint32_t*>(base + item.offset_to_patch_buffer), item);
+  }
+
+  // All relocations of a patcher share the symbol type, so the
+  // patching scheme is selected once and all relocations are applied
+  // in one pass.
   void
-  patch(uint8_t* base, uint64_t new_value)
+  patch(uint8_t* base, uint64_t new_value) const
   {
-    for (auto item : m_ctrlcode_patchinfo) {
-      auto bd_data_ptr = reinterpret_cast<uint32_t*>(base + item.offset_to_patch_buffer);
-      switch (m_symbol_type) {
-      case symbol_type::scalar_32bit_kind:
-        // new_value is a register value
+    switch (m_symbol_type) {
+    case symbol_type::scalar_32bit_kind:
+      // new_value is a register value
+      patch_each(base, [new_value](uint32_t* bd_data_ptr, const patch_info& item) {
         if (item.mask)
           patch32(bd_data_ptr, new_value, item.mask);
-        break;
-      case symbol_type::shim_dma_base_addr_symbol_kind:
-        // new_value is a bo address
+      });
+      break;
+    case symbol_type::shim_dma_base_addr_symbol_kind:
+      // new_value is a bo address
+      patch_each(base, [new_value](uint32_t* bd_data_ptr, const patch_info& item) {
         patch57(bd_data_ptr, new_value + item.offset_to_base_bo_addr);
-        break;
-      case symbol_type::shim_dma_aie4_base_addr_symbol_kind:
-        // new_value is a bo address
+      });
+      break;
+    case symbol_type::shim_dma_aie4_base_addr_symbol_kind:
+      // new_value is a bo address
+      patch_each(base, [new_value](uint32_t* bd_data_ptr, const patch_info& item) {
         patch57_aie4(bd_data_ptr, new_value + item.offset_to_base_bo_addr);
-        break;
-      case symbol_type::control_packet_48:
-        // new_value is a bo address
+      });
+      break;
+    case symbol_type::control_packet_48:
+      // new_value is a bo address
+      patch_each(base, [new_value](uint32_t* bd_data_ptr, const patch_info& item) {
         patch_ctrl48(bd_data_ptr, new_value + item.offset_to_base_bo_addr);
-        break;
-      case symbol_type::shim_dma_48:
-        // new_value is a bo address
+      });
+      break;
+    case symbol_type::shim_dma_48:
+      // new_value is a bo address
+      patch_each(base, [new_value](uint32_t* bd_data_ptr, const patch_info& item) {
         patch_shim48(bd_data_ptr, new_value + item.offset_to_base_bo_addr);
-        break;
-      default:
+      });
+      break;
+    default:
+      if (!m_ctrlcode_patchinfo.empty())
         throw std::runtime_error("Unsupported symbol type");
+    }
+  }
+};
+
+// struct arg_patchers - patchers of one argument
+//
+// Patchers of an argument are resolved once by argument name or
+// index, after which patching the argument is an index lookup.  The
+// patchers are owned by the module that created them.
+struct arg_patchers
+{
+  std::array<const patcher*, static_cast<int>(patcher::buf_type::buf_type_count)> patchers {};
+  bool resolved = false;
+  bool patched = false;
+
+  const patcher*
+  get(patcher::buf_type type) const
+  {
+    return patchers[static_cast<int>(type)];
+  }
+};
+
+// class dirty_ranges - pages of a buffer object patched since last sync
+//
+// Patching an argument marks the pages modified by its patcher.  When
+// the buffer object is synced, only runs of dirty pages are synced to
+// device.  The pages are tracked in a bitmap, so patching the same
+// argument repeatedly between syncs does not grow the state.
+class dirty_ranges
+{
+  std::vector<bool> m_pages;
+  bool m_empty = true;
+
+public:
+  void
+  add(const patcher* ptr)
+  {
+    for (auto [begin, end] : ptr->m_dirty_pages) {
+      auto last = end / sync_page_size;
+      if (m_pages.size() < last)
+        m_pages.resize(last);
+      for (auto page = begin / sync_page_size; page < last; ++page)
+        m_pages[page] = true;
+      m_empty = false;
+    }
+  }
+
+  bool
+  empty() const
+  {
+    return m_empty;
+  }
+
+  // Sync dirty pages of bo to device and clear the dirty pages
+  // @Return number of bytes synced
+  size_t
+  sync(xrt::bo& bo)
+  {
+    size_t synced = 0;
+    size_t page = 0;
+    while (page < m_pages.size()) {
+      if (!m_pages[page]) {
+        ++page;
+        continue;
       }
+
+      uint64_t begin = page * sync_page_size;
+      while (page < m_pages.size() && m_pages[page])
+        m_pages[page++] = false;
+      auto end = std::min<uint64_t>(page * sync_page_size, bo.size());
+      if (begin >= end)
+        continue;
+      bo.sync(XCL_BO_SYNC_BO_TO_DEVICE, end - begin, begin);
+      synced += end - begin;
     }
+    m_empty = true;
+    return synced;
   }
 };
 
@@ -425,6 +582,21 @@ public:
     throw std::runtime_error("Not supported");
   }
 
+  // Resolve patcher of symbol in control code
+  //
+  // @param symbol - symbol name
+  // @param index - argument index, used if no patcher for symbol name
+  // @param buf_type - whether it is control-code, control-packet, preempt-save or preempt-restore
+  // @Return patcher for symbol or nullptr if symbol is not patched
+  //
+  // The returned patcher is owned by this module and is valid for
+  // the lifetime of the module.
+  [[nodiscard]] virtual const patcher*
+  resolve_patcher(const std::string&, size_t, patcher::buf_type) const
+  {
+    throw std::runtime_error("Not supported");
+  }
+
   // Get the number of patchers for arguments.  The returned
   // value is the number of arguments that must be patched before
   // the control code can be executed.
@@ -483,6 +655,11 @@ class module_elf : public module_impl
   bool m_restore_buf_exist = false;
   size_t m_scratch_pad_mem_size = 0;
 
+  // Patchers of symbols named by argument index, indexed by buffer
+  // type and argument index.  Compiled when the module is loaded
+  // such that lookup by index does not construct a key string.
+  std::array<std::vector<const patcher*>, static_cast<int>(patcher::buf_type::buf_type_count)> m_index2patcher;
+
   // The ELF sections embed column and page information in their
   // names.  Extract the column and page information from the
   // section name, default to single column and page when nothing
@@ -785,32 +962,65 @@ class module_elf : public module_impl
     return arg2patcher;
   }
 
-  bool
-  patch(uint8_t* base, const std::string& argnm, size_t index, uint64_t patch, patcher::buf_type type) override
+  // Compile dense table of patchers for symbols named by argument
+  // index.  Key strings are <symbol><buf_type> where buf_type is a
+  // single digit.
+  void
+  initialize_index_patchers()
   {
-    const std::string key_string = generate_key_string(argnm, type);
-    auto it = m_arg2patcher.find(key_string);
-    auto not_found_use_argument_name = (it == m_arg2patcher.end());
-    if (not_found_use_argument_name) {// Search using index
-      auto index_string = std::to_string(index);
-      const std::string key_index_string = generate_key_string(index_string, type);
-      it = m_arg2patcher.find(key_index_string);
-      if (it == m_arg2patcher.end())
-        return false;
+    for (const auto& [key, arg_patcher] : m_arg2patcher) {
+      auto symbol = key.substr(0, key.size() - 1);
+      if (symbol.empty() || symbol.size() > 9 || !std::all_of(symbol.begin(), symbol.end(), ::isdigit))
+        continue;
+
+      auto& index2patcher = m_index2patcher[static_cast<int>(arg_patcher.m_buf_type)];
+      auto index = std::stoul(symbol);
+      if (index >= index2patcher.size())
+        index2patcher.resize(index + 1, nullptr);
+      index2patcher[index] = &arg_patcher;
     }
+  }
 
-    it->second.patch(base, patch);
-    if (xrt_core::config::get_xrt_debug()) {
-      if (not_found_use_argument_name) {
-        std::stringstream ss;
-        ss << "Patched " << patcher::section_name_to_string(type) << " using argument index " << index << " with value " << std::hex << patch;
-        xrt_core::message::send( xrt_core::message::severity_level::debug, "xrt_module", ss.str());
-      }
-      else {
+  [[nodiscard]] const patcher*
+  find_index_patcher(size_t index, patcher::buf_type type) const
+  {
+    const auto& index2patcher = m_index2patcher[static_cast<int>(type)];
+    return index < index2patcher.size() ? index2patcher[index] : nullptr;
+  }
+
+  [[nodiscard]] const patcher*
+  resolve_patcher(const std::string& argnm, size_t index, patcher::buf_type type) const override
+  {
+    if (auto it = m_arg2patcher.find(generate_key_string(argnm, type)); it != m_arg2patcher.end()) {
+      if (xrt_core::config::get_xrt_debug()) {
         std::stringstream ss;
-        ss << "Patched " << patcher::section_name_to_string(type) << " using argument name " << argnm << " with value " << std::hex << patch;
+        ss << "Resolved " << patcher::section_name_to_string(type) << " patcher using argument name " << argnm;
         xrt_core::message::send( xrt_core::message::severity_level::debug, "xrt_module", ss.str());
       }
+      return &it->second;
+    }
+
+    auto index_patcher = find_index_patcher(index, type);
+    if (index_patcher && xrt_core::config::get_xrt_debug()) {
+      std::stringstream ss;
+      ss << "Resolved " << patcher::section_name_to_string(type) << " patcher using argument index " << index;
+      xrt_core::message::send( xrt_core::message::severity_level::debug, "xrt_module", ss.str());
+    }
+    return index_patcher;
+  }
+
+  bool
+  patch(uint8_t* base, const std::string& argnm, size_t index, uint64_t patch, patcher::buf_type type) override
+  {
+    auto arg_patcher = resolve_patcher(argnm, index, type);
+    if (!arg_patcher)
+      return false;
+
+    arg_patcher->patch(base, patch);
+    if (xrt_core::config::get_xrt_debug()) {
+      std::stringstream ss;
+      ss << "Patched " << patcher::section_name_to_string(type) << " argument " << argnm << " (" << index << ") with value " << std::hex << patch;
+      xrt_core::message::send( xrt_core::message::severity_level::debug, "xrt_module", ss.str());
     }
     return true;
   }
@@ -857,6 +1067,11 @@ public:
 
       m_arg2patcher = initialize_arg_patchers(xrt_core::elf_int::get_elfio(m_elf));
     }
+
+    for (auto& [key, arg_patcher] : m_arg2patcher)
+      arg_patcher.init_dirty_pages();
+
+    initialize_index_patchers();
   }
 
   [[nodiscard]] const std::vector<ctrlcode>&
@@ -975,14 +1190,23 @@ class module_sram : public module_impl
   // each column.
   std::vector<std::pair<uint64_t, uint64_t>> m_column_bo_address;
 
-  // Arguments patched in the ctrlcode buffer object
+  // Patchers of arguments indexed by argument index, resolved in
+  // parent module when an argument is first patched
+  std::vector<arg_patchers> m_arg_patchers;
+
+  // Number of arguments patched in the ctrlcode buffer object
   // Must match number of argument patchers in parent module
-  std::set<std::string> m_patched_args;
+  size_t m_patched_args = 0;
 
   // Dirty bit to indicate that patching was done prior to last
   // buffer sync to device.
   bool m_dirty{ false };
 
+  // Pages patched since last sync to device for each buffer type.
+  // The ctrltext buffer is m_instr_bo for Aie2p and m_buffer for
+  // Aie2ps.
+  std::array<dirty_ranges, static_cast<int>(patcher::buf_type::buf_type_count)> m_dirty_ranges;
+
   union debug_flag_union {
     struct debug_mode_struct {
       uint32_t dump_control_codes     : 1;
@@ -1186,36 +1410,71 @@ class module_sram : public module_impl
     patch_instr_value(bo_ctrlcode, argnm, index, bo.address(), type);
   }
 
+  void
+  patch_buffer(xrt::bo& bo, const patcher* ptr, uint64_t value, patcher::buf_type type)
+  {
+    ptr->patch(bo.map<uint8_t*>(), value);
+    m_dirty_ranges[static_cast<int>(type)].add(ptr);
+  }
+
+  // Get patchers of argument, resolve by name or index on first use
+  arg_patchers&
+  get_arg_patchers(const std::string& argnm, size_t index)
+  {
+    if (index >= m_arg_patchers.size())
+      m_arg_patchers.resize(index + 1);
+
+    auto& arg = m_arg_patchers[index];
+    if (arg.resolved)
+      return arg;
+
+    if (m_parent->get_os_abi() == Elf_Amd_Aie2p && m_ctrlpkt_bo)
+      arg.patchers[static_cast<int>(patcher::buf_type::ctrldata)] =
+        m_parent->resolve_patcher(argnm, index, patcher::buf_type::ctrldata);
+
+    arg.patchers[static_cast<int>(patcher::buf_type::ctrltext)] =
+      m_parent->resolve_patcher(argnm, index, patcher::buf_type::ctrltext);
+
+    arg.resolved = true;
+    return arg;
+  }
+
   void
   patch_value(const std::string& argnm, size_t index, uint64_t value)
   {
-    bool patched = false;
+    auto& arg = get_arg_patchers(argnm, index);
+    auto ctrldata = arg.get(patcher::buf_type::ctrldata);
+    auto ctrltext = arg.get(patcher::buf_type::ctrltext);
+    if (!ctrldata && !ctrltext)
+      return;
+
     if (m_parent->get_os_abi() == Elf_Amd_Aie2p) {
       // patch control-packet buffer
-      if (m_ctrlpkt_bo) {
-        if (m_parent->patch(m_ctrlpkt_bo.map<uint8_t*>(), argnm, index, value, patcher::buf_type::ctrldata))
-          patched = true;
-      }
+      if (ctrldata)
+        patch_buffer(m_ctrlpkt_bo, ctrldata, value, patcher::buf_type::ctrldata);
 
       // patch instruction buffer
-      if (m_parent->patch(m_instr_bo.map<uint8_t*>(), argnm, index, value, patcher::buf_type::ctrltext))
-          patched = true;
+      if (ctrltext)
+        patch_buffer(m_instr_bo, ctrltext, value, patcher::buf_type::ctrltext);
     }
-    else if (m_parent->patch(m_buffer.map<uint8_t*>(), argnm, index, value, patcher::buf_type::ctrltext))
-      patched = true;
+    else if (ctrltext)
+      patch_buffer(m_buffer, ctrltext, value, patcher::buf_type::ctrltext);
 
-    if (patched) {
-      m_patched_args.insert(argnm);
-      m_dirty = true;
+    if (!arg.patched) {
+      arg.patched = true;
+      ++m_patched_args;
     }
+    m_dirty = true;
   }
 
   void
   patch_instr_value(xrt::bo& bo, const std::string& argnm, size_t index, uint64_t value, patcher::buf_type type)
   {
-    if (!m_parent->patch(bo.map<uint8_t*>(), argnm, index, value, type))
+    auto ptr = m_parent->resolve_patcher(argnm, index, type);
+    if (!ptr)
       return;
 
+    patch_buffer(bo, ptr, value, type);
     m_dirty = true;
   }
 
@@ -1235,8 +1494,21 @@ class module_sram : public module_impl
     patch_value(argnm, index, arg_value);
   }
 
-  // Check that all arguments have been patched and sync the buffer
-  // to device if it is dirty.
+  // Sync pages of buffer patched since last sync to device
+  void
+  sync_dirty(xrt::bo& bo, patcher::buf_type type)
+  {
+    auto& dirty = m_dirty_ranges[static_cast<int>(type)];
+    if (dirty.empty())
+      return;
+
+    [[maybe_unused]] auto synced = dirty.sync(bo);
+    XRT_DEBUGF("module_sram::sync_dirty(%s) synced %zu of %zu bytes\n",
+               patcher::section_name_to_string(type), synced, bo.size());
+  }
+
+  // Check that all arguments have been patched and sync the pages
+  // of buffers that were patched since last sync to device.
   void
   sync_if_dirty() override
   {
@@ -1245,15 +1517,15 @@ class module_sram : public module_impl
 
     auto os_abi = m_parent.get()->get_os_abi();
     if (os_abi == Elf_Amd_Aie2ps) {
-      if (m_patched_args.size() != m_parent->number_of_arg_patchers()) {
+      if (m_patched_args != m_parent->number_of_arg_patchers()) {
         auto fmt = boost::format("ctrlcode requires %d patched arguments, but only %d are patched")
-            % m_parent->number_of_arg_patchers() % m_patched_args.size();
+            % m_parent->number_of_arg_patchers() % m_patched_args;
         throw std::runtime_error{ fmt.str() };
       }
-      m_buffer.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+      sync_dirty(m_buffer, patcher::buf_type::ctrltext);
     }
     else if (os_abi == Elf_Amd_Aie2p) {
-      m_instr_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+      sync_dirty(m_instr_bo, patcher::buf_type::ctrltext);
 
       if (is_dump_control_codes()) {
         std::string dump_file_name = "ctr_codes_post_patch" + std::to_string(get_id()) + ".bin";
@@ -1265,7 +1537,7 @@ class module_sram : public module_impl
       }
 
       if (m_ctrlpkt_bo) {
-        m_ctrlpkt_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+        sync_dirty(m_ctrlpkt_bo, patcher::buf_type::ctrldata);
 
         if (is_dump_control_packet()) {
           std::string dump_file_name = "ctr_packet_post_patch" + std::to_string(get_id()) + ".bin";
@@ -1278,8 +1550,8 @@ class module_sram : public module_impl
       }
 
       if (m_preempt_save_bo && m_preempt_restore_bo) {
-        m_preempt_save_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
-        m_preempt_restore_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+        sync_dirty(m_preempt_save_bo, patcher::buf_type::preempt_save);
+        sync_dirty(m_preempt_restore_bo, patcher::buf_type::preempt_restore);
 
         if (is_dump_preemption_codes()) {
           std::string dump_file_name = "preemption_save_post_patch" + std::to_string(get_id()) + ".bin";
@@ -23,6 +23,7 @@
 #define XRT_CORE_COMMON_SOURCE
 #include "core/include/experimental/xrt_profile.h"
 
+#include "core/common/api/native_profile.h"
 #include "core/common/dlfcn.h"
 #include "core/common/error.h"
 #include "core/common/module_loader.h"
@@ -95,6 +96,12 @@ mark_time_ns(const std::chrono::nanoseconds& time_ns, const char* label)
   xrtUEMarkTimeNs(static_cast<unsigned long long int>(time_ns.count()), label);
 }
 
+void
+dump_flight_recorder(const char* reason)
+{
+  xrtFlightRecorderDump(reason);
+}
+
 } // xrt::profile
 
 
@@ -192,4 +199,16 @@ xrtUEMarkTimeNs(unsigned long long int time_ns, const char* label)
   }
 }
 
+void
+xrtFlightRecorderDump(const char* reason)
+{
+  try {
+    xdp::native::flight_recorder_dump(reason);
+  }
+  catch (const std::exception& ex)
+  {
+    xrt_core::send_exception_message(ex.what());
+  }
+}
+
 } // extern C
@@ -8,11 +8,13 @@
 #define XRT_CORE_COMMON_SOURCE // in same dll as core_common
 #include "core/include/experimental/xrt_xclbin.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/system.h"
 #include "core/common/device.h"
 #include "core/common/message.h"
 #include "core/common/module_loader.h"
 #include "core/common/query_requests.h"
+#include "core/common/xclbin_catalog.h"
 #include "core/common/xclbin_parser.h"
 #include "core/common/xclbin_swemu.h"
 
@@ -25,9 +27,12 @@
 #include <boost/algorithm/string.hpp>
 
 #include <array>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <regex>
 #include <set>
 #include <vector>
@@ -38,6 +43,10 @@
 # pragma warning( disable : 4244 4267 4996)
 #else
 # include <linux/uuid.h>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
 #endif
 
 namespace {
@@ -90,6 +99,71 @@ read_xclbin(const std::string& fnm)
   return read_file(path.string());
 }
 
+#ifndef _WIN32
+// class file_mapping - Read-only private mapping of a file
+//
+// Pages of the file are loaded on demand and are shared with the
+// page cache and other processes mapping the same file.
+class file_mapping
+{
+  const char* m_addr = nullptr;
+  size_t m_size = 0;
+
+public:
+  explicit
+  file_mapping(const std::string& fnm)
+  {
+    auto fd = ::open(fnm.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      throw std::runtime_error("Failed to open file '" + fnm + "' for reading");
+
+    struct stat st {};
+    if (::fstat(fd, &st) || st.st_size == 0) {
+      ::close(fd);
+      throw std::runtime_error("Failed to stat file '" + fnm + "'");
+    }
+
+    m_size = st.st_size;
+    auto addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+      throw std::runtime_error("Failed to map file '" + fnm + "'");
+
+    m_addr = static_cast<const char*>(addr);
+  }
+
+  ~file_mapping()
+  {
+    ::munmap(const_cast<char*>(m_addr), m_size);
+  }
+
+  file_mapping(const file_mapping&) = delete;
+  file_mapping& operator=(const file_mapping&) = delete;
+
+  const char*
+  data() const
+  {
+    return m_addr;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+};
+
+static std::unique_ptr<file_mapping>
+map_xclbin(const std::string& fnm)
+{
+  if (fnm.empty())
+    throw std::runtime_error("No xclbin specified");
+
+  auto path = xrt_core::environment::platform_path(fnm);
+  return std::make_unique<file_mapping>(path.string());
+}
+#endif
+
 static std::vector<char>
 copy_axlf(const axlf* top)
 {
@@ -383,6 +457,10 @@ class xclbin_impl
   struct xclbin_info
   {
     const xclbin_impl* m_ximpl;
+
+    // index of EMBEDDED_METADATA, shared with xclbin parser
+    std::shared_ptr<const xrt_core::xclbin::xml_metadata> m_xml;
+
     std::string m_project_name;           // <project name="foo">
     std::string m_fpga_device_name;       // <device fpgaDevice="foo">
     std::vector<xclbin::mem> m_mems;
@@ -447,22 +525,28 @@ class xclbin_impl
     //
     // Pre-condition for this function is that init_mems() and init_ips()
     // have been called.
+    //
+    // The kernels are in same order as the kernels of the XML meta
+    // data index, which allows lookup of kernel by name through the
+    // index.
     static std::vector<xclbin::kernel>
-    init_kernels(const xclbin_impl* ximpl, const std::vector<xclbin::ip>& ips)
+    init_kernels(const xrt_core::xclbin::xml_metadata* xml, const std::vector<xclbin::ip>& ips)
     {
-      auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
-      if (!xml.first)
+      if (!xml)
         return {};
 
       // get kernel CUs from xclbin meta data
+      xml->check_kernels();
       std::vector<xclbin::kernel> kernels;
-      for (auto& kernel : xrt_core::xclbin::get_kernels(xml.first, xml.second)) {
-        auto props = xrt_core::xclbin::get_kernel_properties(xml.first, xml.second, kernel.name);
+      kernels.reserve(xml->kernels.size());
+      for (const auto& kernel : xml->kernels) {
+        const auto& name = kernel.properties.name;
         std::vector<xclbin::ip> cus;
-        copy_if_name_match(ips.begin(), ips.end(), std::back_inserter(cus), kernel.name);
+        copy_if_name_match(ips.begin(), ips.end(), std::back_inserter(cus), name);
         kernels.emplace_back
           (std::make_shared<xclbin::kernel_impl>
-           (std::move(kernel.name), std::move(props), std::move(cus), std::move(kernel.args)));
+           (std::string{name}, xrt_core::xclbin::kernel_properties{kernel.properties},
+            std::move(cus), std::vector<xrt_core::xclbin::kernel_argument>{kernel.args}));
       }
 
       return kernels;
@@ -480,22 +564,29 @@ class xclbin_impl
       return aie_partitions;
     }
 
-    static std::string
-    init_project_name(const xclbin_impl* ximpl)
+    // init_xml() - get index of XML meta data
+    //
+    // The index is cached by the xclbin parser, such that other
+    // users of the same xclbin do not parse the XML again.
+    static std::shared_ptr<const xrt_core::xclbin::xml_metadata>
+    init_xml(const xclbin_impl* ximpl)
     {
       auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
       return xml.first
-        ? xrt_core::xclbin::get_project_name(xml.first, xml.second)
-        : "";
+        ? xrt_core::xclbin::get_xml_metadata(ximpl->get_axlf())
+        : nullptr;
     }
 
     static std::string
-    init_fpga_device_name(const xclbin_impl* ximpl)
+    init_project_name(const xrt_core::xclbin::xml_metadata* xml)
     {
-      auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
-      return xml.first
-        ? xrt_core::xclbin::get_fpga_device_name(xml.first, xml.second)
-        : "";
+      return xml ? xml->project_name : "";
+    }
+
+    static std::string
+    init_fpga_device_name(const xrt_core::xclbin::xml_metadata* xml)
+    {
+      return xml ? xml->fpga_device_name : "";
     }
 
     // init_mem_encoding() - compress memory indices
@@ -572,11 +663,12 @@ class xclbin_impl
     explicit
     xclbin_info(const xrt::xclbin_impl* impl)
       : m_ximpl(impl)
-      , m_project_name(init_project_name(m_ximpl))
-      , m_fpga_device_name(init_fpga_device_name(m_ximpl))
+      , m_xml(init_xml(m_ximpl))
+      , m_project_name(init_project_name(m_xml.get()))
+      , m_fpga_device_name(init_fpga_device_name(m_xml.get()))
       , m_mems(init_mems(m_ximpl))
       , m_ips(init_ips(m_ximpl, m_mems))
-      , m_kernels(init_kernels(m_ximpl, m_ips))
+      , m_kernels(init_kernels(m_xml.get(), m_ips))
       , m_aie_partitions(init_aie_partitions(m_ximpl))
       , m_membank_encoding(init_mem_encoding(m_mems))
     {}
@@ -682,11 +774,14 @@ public:
   xclbin::kernel
   get_kernel(const std::string& nm) const
   {
-    for (auto& kernel : get_xclbin_info()->m_kernels)
-      if (kernel.get_name() == nm)
-        return kernel;
+    auto info = get_xclbin_info();
+    if (!info->m_xml)
+      return xclbin::kernel{};
 
-    return xclbin::kernel{};
+    auto itr = info->m_xml->kernel_index.find(nm);
+    return (itr != info->m_xml->kernel_index.end())
+      ? info->m_kernels[(*itr).second]
+      : xclbin::kernel{};
   }
 
   const std::vector<xclbin::ip>&
@@ -753,22 +848,48 @@ public:
 //
 // A full xclbin is constructed from a file on disk or from a complete
 // binary images for file content
+//
+// When constructed from a file with Runtime.xclbin_mmap enabled, the
+// file is mapped read-only into memory rather than copied.  The file
+// must then not be truncated while mapped.  Sections are views into
+// the raw xclbin data, a section is copied only if it is not suitably
+// aligned for access to its meta data structures.  A private copy of
+// a mapped xclbin is created on demand if the raw data is requested
+// as a std::vector.
 class xclbin_full : public xclbin_impl
 {
   std::vector<char> m_axlf;    // complete copy of xclbin raw data
+#ifndef _WIN32
+  std::unique_ptr<file_mapping> m_mapping; // or mapping of xclbin file
+#endif
   const axlf* m_top = nullptr; // axlf pointer to the raw data
+  size_t m_size = 0;           // size of raw data
   uuid m_uuid;                 // uuid of xclbin
   uuid m_intf_uuid;
 
-  // sections within this xclbin
-  std::multimap<axlf_section_kind, std::vector<char>> m_axlf_sections;
+  // sections within this xclbin, views into raw data or copies
+  std::multimap<axlf_section_kind, std::pair<const char*, size_t>> m_axlf_sections;
+  std::vector<std::unique_ptr<uint64_t[]>> m_section_copies;
+
+  // private copy of mapped xclbin for get_data()
+  mutable std::once_flag m_data_flag;
+  mutable std::vector<char> m_data;
 
   void
   emplace_section(const axlf_section_header* hdr, axlf_section_kind kind)
   {
+    if (hdr->m_sectionOffset > m_size || hdr->m_sectionSize > m_size - hdr->m_sectionOffset)
+      throw std::runtime_error("Invalid xclbin, section " + std::to_string(kind) + " exceeds xclbin size");
+
     auto section_data = reinterpret_cast<const char*>(m_top) + hdr->m_sectionOffset;
-    std::vector<char> data{section_data, section_data + hdr->m_sectionSize};
-    m_axlf_sections.emplace(kind , std::move(data));
+    auto section_size = static_cast<size_t>(hdr->m_sectionSize);
+    if (reinterpret_cast<uintptr_t>(section_data) % alignof(uint64_t)) {
+      auto copy = std::make_unique<uint64_t[]>((section_size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+      std::memcpy(copy.get(), section_data, section_size);
+      section_data = reinterpret_cast<const char*>(copy.get());
+      m_section_copies.push_back(std::move(copy));
+    }
+    m_axlf_sections.emplace(kind, std::make_pair(section_data, section_size));
   }
 
   void
@@ -781,12 +902,13 @@ class xclbin_full : public xclbin_impl
   }
 
   void
-  init_axlf()
+  init_axlf(const char* data, size_t size)
   {
-    const axlf* tmp = reinterpret_cast<const axlf*>(m_axlf.data());
-    if (strncmp(tmp->m_magic, "xclbin2", strlen("xclbin2")) != 0) // Future: Do not hardcode "xclbin2"
+    const axlf* tmp = reinterpret_cast<const axlf*>(data);
+    if (size < sizeof(axlf) || strncmp(tmp->m_magic, "xclbin2", strlen("xclbin2")) != 0) // Future: Do not hardcode "xclbin2"
       throw std::runtime_error("Invalid xclbin");
     m_top = tmp;
+    m_size = size;
 
     m_uuid = uuid(m_top->m_header.uuid);
     m_intf_uuid = uuid(m_top->m_header.m_interface_uuid);
@@ -808,14 +930,21 @@ class xclbin_full : public xclbin_impl
   void
   init()
   {
-    init_axlf();
+    init_axlf(m_axlf.data(), m_axlf.size());
   }
 
 public:
   explicit
   xclbin_full(const std::string& filename)
-    : m_axlf(read_xclbin(filename))
   {
+#ifndef _WIN32
+    if (xrt_core::config::get_xclbin_mmap()) {
+      m_mapping = map_xclbin(filename);
+      init_axlf(m_mapping->data(), m_mapping->size());
+      return;
+    }
+#endif
+    m_axlf = read_xclbin(filename);
     init();
   }
 
@@ -833,6 +962,20 @@ public:
     init();
   }
 
+  const std::vector<char>&
+  get_data() const override
+  {
+#ifndef _WIN32
+    if (m_mapping) {
+      std::call_once(m_data_flag, [this] {
+        m_data.assign(m_mapping->data(), m_mapping->data() + m_mapping->size());
+      });
+      return m_data;
+    }
+#endif
+    return m_axlf;
+  }
+
   uuid
   get_uuid() const override
   {
@@ -875,7 +1018,7 @@ public:
   {
     auto itr = m_axlf_sections.find(kind);
     return itr != m_axlf_sections.end()
-      ? std::make_pair((*itr).second.data(), (*itr).second.size())
+      ? (*itr).second
       : std::make_pair(nullptr, size_t(0));
   }
 
@@ -890,7 +1033,7 @@ public:
       std::vector<std::pair<const char*, size_t>> return_sections;
 
       for (auto itr = result.first; itr != result.second; itr++)
-        return_sections.emplace_back(std::make_pair(itr->second.data(), itr->second.size()));
+        return_sections.emplace_back(itr->second);
 
       return return_sections;
     }
@@ -959,6 +1102,50 @@ class xclbin_repository_impl
   std::vector<std::filesystem::path> m_paths;
   std::vector<std::filesystem::path> m_xclbin_paths;
 
+  // catalog per repository path, created on first lookup by uuid
+  // or kernel name, and rescanned when a lookup finds a stale entry
+  mutable std::mutex m_catalog_mutex;
+  mutable std::vector<xrt_core::xclbin_catalog> m_catalogs;
+
+  // Must be called with m_catalog_mutex locked
+  std::vector<xrt_core::xclbin_catalog>&
+  get_catalogs() const
+  {
+    if (m_catalogs.empty())
+      for (const auto& path : m_paths)
+        m_catalogs.emplace_back(path);
+    return m_catalogs;
+  }
+
+  // Rescan the directory of a catalog, the catalog constructor opens
+  // only files that changed since the catalog was persisted
+  void
+  rescan(size_t idx) const
+  {
+    m_catalogs[idx] = xrt_core::xclbin_catalog{m_paths[idx]};
+  }
+
+  // Load the xclbin of catalog idx with uuid.  Returns nullopt if
+  // the catalog has no such entry or if the file no longer has the
+  // uuid, e.g. it was replaced after the catalog was created
+  std::optional<xclbin>
+  load_from(size_t idx, const xrt::uuid& uuid) const
+  {
+    auto entry = m_catalogs[idx].find(uuid);
+    if (!entry)
+      return std::nullopt;
+
+    try {
+      xclbin xclbin{entry->path.string()};
+      if (xclbin.get_uuid() == uuid)
+        return xclbin;
+    }
+    catch (const std::exception&) {
+      // file removed or no longer an xclbin
+    }
+    return std::nullopt;
+  }
+
   static std::vector<std::filesystem::path>
   get_xclbin_paths(const std::vector<std::filesystem::path>& dirs)
   {
@@ -1013,6 +1200,38 @@ public:
 
     throw std::runtime_error("xclbin file not found: " + name);
   }
+
+  [[nodiscard]] xclbin
+  load(const xrt::uuid& uuid) const
+  {
+    std::lock_guard lk(m_catalog_mutex);
+    auto& catalogs = get_catalogs();
+    for (size_t idx = 0; idx < catalogs.size(); ++idx)
+      if (auto xclbin = load_from(idx, uuid))
+        return *xclbin;
+
+    // The catalogs are stale, the xclbin may have been added or
+    // replaced since the catalogs were created
+    for (size_t idx = 0; idx < catalogs.size(); ++idx) {
+      rescan(idx);
+      if (auto xclbin = load_from(idx, uuid))
+        return *xclbin;
+    }
+
+    throw std::runtime_error("xclbin not found: " + uuid.to_string());
+  }
+
+  [[nodiscard]] std::vector<std::string>
+  find_kernel(const std::string& name) const
+  {
+    std::lock_guard lk(m_catalog_mutex);
+    std::vector<std::string> paths;
+    for (const auto& catalog : get_catalogs())
+      for (auto entry : catalog.find_kernel(name))
+        paths.push_back(entry->path.string());
+
+    return paths;
+  }
 };
 
 } // xrt
@@ -1472,6 +1691,20 @@ load(const std::string& name) const
   return handle->load(name);
 }
 
+xclbin
+xclbin_repository::
+load(const xrt::uuid& uuid) const
+{
+  return handle->load(uuid);
+}
+
+std::vector<std::string>
+xclbin_repository::
+find_kernel(const std::string& name) const
+{
+  return handle->find_kernel(name);
+}
+
 ////////////////////////////////////////////////////////////////
 // xrt::xclbin_repository::iterator
 ////////////////////////////////////////////////////////////////
@@ -1616,7 +1849,7 @@ xrtXclbinHandle
 xrtXclbinAllocFilename(const char* filename)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [filename]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtXclbinAllocFilename")>([filename]{
       auto xclbin = std::make_shared<xrt::xclbin_full>(filename);
       auto handle = xclbin.get();
       xclbins.add(handle, std::move(xclbin));
@@ -1637,7 +1870,7 @@ xrtXclbinHandle
 xrtXclbinAllocRawData(const char* data, int size)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [data, size]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtXclbinAllocRawData")>([data, size]{
       std::vector<char> raw_data(data, data + size);
       auto xclbin = std::make_shared<xrt::xclbin_full>(raw_data);
       auto handle = xclbin.get();
@@ -1659,7 +1892,7 @@ int
 xrtXclbinFreeHandle(xrtXclbinHandle handle)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [handle]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtXclbinFreeHandle")>([handle]{
       xclbins.remove_or_error(handle);
       return 0;
     });
@@ -1679,7 +1912,7 @@ int
 xrtXclbinGetXSAName(xrtXclbinHandle handle, char* name, int size, int* ret_size)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtXclbinGetXSAName")>(
     [handle, name, size, ret_size]{
       auto xclbin = xclbins.get_or_error(handle);
       const std::string& xsaname = xclbin->get_xsa_name();
@@ -1706,7 +1939,7 @@ int
 xrtXclbinGetUUID(xrtXclbinHandle handle, xuid_t ret_uuid)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [handle, ret_uuid]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtXclbinGetUUID")>([handle, ret_uuid]{
       auto xclbin = xclbins.get_or_error(handle);
       auto result = xclbin->get_uuid();
       uuid_copy(ret_uuid, result.get());
@@ -1727,7 +1960,7 @@ size_t
 xrtXclbinGetNumKernels(xrtXclbinHandle handle)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtXclbinGetNumKernels")>(
     [handle]{
       auto xclbin = xclbins.get_or_error(handle);
       return xclbin->get_kernels().size();
@@ -1747,7 +1980,7 @@ size_t
 xrtXclbinGetNumKernelComputeUnits(xrtXclbinHandle handle)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtXclbinGetNumKernelComputeUnits")>(
     [handle]{
       auto xclbin = xclbins.get_or_error(handle);
       auto kernels = xclbin->get_kernels();
@@ -1771,7 +2004,7 @@ int
 xrtXclbinGetData(xrtXclbinHandle handle, char* data, int size, int* ret_size)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__,
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtXclbinGetData")>(
     [handle, data, size, ret_size]{
       auto xclbin = xclbins.get_or_error(handle);
       auto& result = xclbin->get_data();
@@ -1804,7 +2037,7 @@ int
 xrtXclbinUUID(xclDeviceHandle dhdl, xuid_t out)
 {
   try {
-    return xdp::native::profiling_wrapper(__func__, [dhdl, out]{
+    return xdp::native::profiling_wrapper<xdp::native::api_id("xrtXclbinUUID")>([dhdl, out]{
       auto device = xrt_core::get_userpf_device(dhdl);
       auto uuid = device->get_xclbin_uuid();
       uuid_copy(out, uuid.get());
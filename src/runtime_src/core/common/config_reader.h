@@ -226,6 +226,13 @@ get_trace_buffer_offload_interval_ms()
   return value;
 }
 
+inline unsigned int
+get_trace_decode_threads()
+{
+  static unsigned int value = detail::get_uint_value("Debug.trace_decode_threads", 1);
+  return value;
+}
+
 inline unsigned int
 get_trace_file_dump_interval_s()
 {
@@ -233,6 +240,14 @@ get_trace_file_dump_interval_s()
   return value;
 }
 
+// csv, binary, or binary_compressed
+inline std::string
+get_trace_file_format()
+{
+  static std::string value = detail::get_string_value("Debug.trace_file_format", "csv");
+  return value;
+}
+
 inline std::string
 get_trace_buffer_size()
 {
@@ -308,6 +323,40 @@ get_native_xrt_trace()
   return value;
 }
 
+// Keep the last flight_recorder_duration_s seconds of native API events
+// in bounded per thread buffers and only write them to a trace file when
+// triggered by a failed or timed out wait, the flight_recorder_signal, or
+// an API call
+inline bool
+get_flight_recorder()
+{
+  static bool value = detail::get_bool_value("Debug.flight_recorder", false);
+  return value;
+}
+
+inline unsigned int
+get_flight_recorder_duration_s()
+{
+  static unsigned int value = detail::get_uint_value("Debug.flight_recorder_duration_s", 10);
+  return value;
+}
+
+// Maximum number of calls kept for each thread
+inline unsigned int
+get_flight_recorder_events()
+{
+  static unsigned int value = detail::get_uint_value("Debug.flight_recorder_events", 4096);
+  return value;
+}
+
+// Signal that triggers a dump, 0 to not install a signal handler
+inline unsigned int
+get_flight_recorder_signal()
+{
+  static unsigned int value = detail::get_uint_value("Debug.flight_recorder_signal", 0);
+  return value;
+}
+
 inline bool
 get_opencl_trace()
 {
@@ -601,12 +650,139 @@ get_noop_completion_delay_us()
 }
 
 /**
- * Set CMD BO cache size. CUrrently it is only used in xclCopyBO()
+ * Number of compute units modeled by the noop shim.  Commands are
+ * scheduled on the first available compute unit and queue up when
+ * all are busy.  A value of 0 models unlimited compute units.
+ */
+inline unsigned int
+get_noop_cus()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_cus", 0);
+  return value;
+}
+
+/**
+ * Max number of commands in flight in the noop shim.  Submission
+ * blocks when the limit is reached.  A value of 0 is unbounded.
+ */
+inline unsigned int
+get_noop_queue_depth()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_queue_depth", 0);
+  return value;
+}
+
+/**
+ * Per kernel execution latency distributions in the noop shim.
+ * Comma separated list of <kernel>:<distribution>:<args> in us,
+ * where distribution is one of fixed:<us>, uniform:<min>:<max>,
+ * normal:<mean>:<stddev> with stddev > 0, exponential:<mean>.
+ * Kernel 'default' applies to kernels not listed, and otherwise
+ * defaults to fixed noop_completion_delay_us.
+ */
+inline std::string
+get_noop_latency()
+{
+  static std::string value = detail::get_string_value("Runtime.noop_latency", "");
+  return value;
+}
+
+/**
+ * Construct xrt::xclbin objects from files by mapping the file
+ * read-only into memory rather than reading it into a private copy.
+ * Off by default, since a process using the xclbin gets SIGBUS if the
+ * file is truncated or rewritten while mapped.  Only enable when
+ * xclbin files are replaced by rename rather than rewritten in place.
+ * Not supported on Windows.
+ */
+inline bool
+get_xclbin_mmap()
+{
+  static bool value = detail::get_bool_value("Runtime.xclbin_mmap", false);
+  return value;
+}
+
+/**
+ * Directory for persisted xclbin repository catalogs.  Defaults to
+ * a per user cache directory if empty.
+ */
+inline std::string
+get_xclbin_catalog_dir()
+{
+  static std::string value = detail::get_string_value("Runtime.xclbin_catalog_dir", "");
+  return value;
+}
+
+/**
+ * Max number of cached command buffers per size class in the
+ * per device command buffer pool.  A value of 0 disables caching.
+ * Falls back on the deprecated Runtime.cmdbo_cache if not specified.
+ */
+inline unsigned int
+get_exec_buffer_pool_size()
+{
+  static unsigned int value = detail::get_uint_value
+    ("Runtime.exec_buffer_pool_size", detail::get_uint_value("Runtime.cmdbo_cache",128));
+  return value;
+}
+
+/**
+ * Default policy for waiting on run completion: block, spin (spin
+ * then block), or poll (busy poll).  Can be overridden per
+ * hw_context and per run object.
+ */
+inline std::string
+get_wait_policy()
+{
+  static std::string value = detail::get_string_value("Runtime.wait_policy","block");
+  return value;
+}
+
+/**
+ * Upper bound on time spent spinning before blocking when the wait
+ * policy is spin.  The actual spin time adapts to observed command
+ * completion times.
+ */
+inline unsigned int
+get_wait_spin_max_us()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.wait_spin_max_us",100);
+  return value;
+}
+
+/**
+ * Number of threads that copy large buffers between host memory and
+ * the host side of buffer objects.  0 uses one thread per core up to
+ * 8 threads, 1 copies on the calling thread only.
+ */
+inline unsigned int
+get_copy_engine_threads()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.copy_engine_threads",0);
+  return value;
+}
+
+/**
+ * Copies of at least this many bytes are split across the copy
+ * engine threads and use non-temporal stores if the CPU supports
+ * them.  Smaller copies are a plain memcpy.  0 disables the copy
+ * engine.
+ */
+inline unsigned int
+get_copy_engine_threshold()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.copy_engine_threshold",16*1024*1024);
+  return value;
+}
+
+/**
+ * Number of threads per device and per direction that perform
+ * xrt::bo::async() transfers.  Minimum is 1.
  */
 inline unsigned int
-get_cmdbo_cache()
+get_bo_async_threads()
 {
-  static unsigned int value = detail::get_uint_value("Runtime.cmdbo_cache",0x4);
+  static unsigned int value = detail::get_uint_value("Runtime.bo_async_threads",2);
   return value;
 }
 
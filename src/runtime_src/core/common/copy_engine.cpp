@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE // in same dll as coreutil
+#include "copy_engine.h"
+#include "config_reader.h"
+#include "task.h"
+#include "thread.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+# define XRT_COPY_ENGINE_X86
+# include <immintrin.h>
+# ifdef _MSC_VER
+#  include <intrin.h>
+#  define XRT_TARGET_AVX
+# else
+#  define XRT_TARGET_AVX __attribute__((target("avx")))
+# endif
+#endif
+
+namespace {
+
+// Smallest part of a copy given to one thread
+constexpr size_t min_part_size = 1024 * 1024;
+
+// Parts are split at page boundaries of the destination so threads
+// never write the same cache line
+constexpr size_t part_alignment = 4096;
+
+// Default max number of copy threads, more threads than this do not
+// add bandwidth on typical hosts
+constexpr unsigned int max_default_threads = 8;
+
+static unsigned int
+get_num_threads()
+{
+  auto threads = xrt_core::config::get_copy_engine_threads();
+  if (threads)
+    return threads;
+
+  auto hwc = std::thread::hardware_concurrency();
+  return std::clamp<unsigned int>(hwc, 1, max_default_threads);
+}
+
+#ifdef XRT_COPY_ENGINE_X86
+// AVX needs both CPU and OS support (saved ymm state)
+static bool
+cpu_has_avx()
+{
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 1);
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  bool avx = (info[2] & (1 << 28)) != 0;
+  return osxsave && avx && ((_xgetbv(0) & 0x6) == 0x6);
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx");
+#endif
+}
+
+// Number of bytes to copy before dst is aligned to alignment
+static size_t
+head_size(const char* dst, size_t size, size_t alignment)
+{
+  auto misalignment = reinterpret_cast<uintptr_t>(dst) & (alignment - 1);
+  return std::min(size, misalignment ? alignment - misalignment : 0);
+}
+
+// Copy with 16 byte streaming stores, SSE2 is part of x86-64
+static void
+stream_copy_sse2(char* dst, const char* src, size_t size)
+{
+  auto head = head_size(dst, size, 16);
+  std::memcpy(dst, src, head);
+  dst += head; src += head; size -= head;
+
+  for (; size >= 64; dst += 64, src += 64, size -= 64) {
+    auto s = reinterpret_cast<const __m128i*>(src);
+    auto d = reinterpret_cast<__m128i*>(dst);
+    __m128i v0 = _mm_loadu_si128(s);
+    __m128i v1 = _mm_loadu_si128(s + 1);
+    __m128i v2 = _mm_loadu_si128(s + 2);
+    __m128i v3 = _mm_loadu_si128(s + 3);
+    _mm_stream_si128(d, v0);
+    _mm_stream_si128(d + 1, v1);
+    _mm_stream_si128(d + 2, v2);
+    _mm_stream_si128(d + 3, v3);
+  }
+
+  std::memcpy(dst, src, size);
+}
+
+// Copy with 32 byte streaming stores
+XRT_TARGET_AVX
+static void
+stream_copy_avx(char* dst, const char* src, size_t size)
+{
+  auto head = head_size(dst, size, 32);
+  std::memcpy(dst, src, head);
+  dst += head; src += head; size -= head;
+
+  for (; size >= 128; dst += 128, src += 128, size -= 128) {
+    auto s = reinterpret_cast<const __m256i*>(src);
+    auto d = reinterpret_cast<__m256i*>(dst);
+    __m256i v0 = _mm256_loadu_si256(s);
+    __m256i v1 = _mm256_loadu_si256(s + 1);
+    __m256i v2 = _mm256_loadu_si256(s + 2);
+    __m256i v3 = _mm256_loadu_si256(s + 3);
+    _mm256_stream_si256(d, v0);
+    _mm256_stream_si256(d + 1, v1);
+    _mm256_stream_si256(d + 2, v2);
+    _mm256_stream_si256(d + 3, v3);
+  }
+
+  std::memcpy(dst, src, size);
+}
+#endif
+
+// Copy one part of a large copy.  Streaming stores are weakly
+// ordered, the fence makes them visible before the part is reported
+// as done.
+static void
+copy_part(char* dst, const char* src, size_t size)
+{
+#ifdef XRT_COPY_ENGINE_X86
+  static const bool avx = cpu_has_avx();
+  if (avx)
+    stream_copy_avx(dst, src, size);
+  else
+    stream_copy_sse2(dst, src, size);
+  _mm_sfence();
+#else
+  std::memcpy(dst, src, size);
+#endif
+}
+
+// Worker threads copying the parts of large copies
+class copy_pool
+{
+  xrt_core::task::queue m_queue;
+  std::vector<std::thread> m_workers;
+
+public:
+  explicit
+  copy_pool(unsigned int workers)
+  {
+    for (unsigned int i = 0; i < workers; ++i)
+      m_workers.emplace_back(xrt_core::thread(xrt_core::task::worker, std::ref(m_queue)));
+  }
+
+  ~copy_pool()
+  {
+    m_queue.stop();
+    for (auto& worker : m_workers)
+      worker.join();
+  }
+
+  xrt_core::task::event<void>
+  add(char* dst, const char* src, size_t size)
+  {
+    return xrt_core::task::createF(m_queue, &copy_part, dst, src, size);
+  }
+};
+
+// The calling thread copies one part, so the pool has one thread
+// less than the configured number of copy threads
+static copy_pool&
+get_pool()
+{
+  static copy_pool pool(get_num_threads() - 1);
+  return pool;
+}
+
+} // namespace
+
+namespace xrt_core::copy_engine {
+
+void
+copy(void* dst, const void* src, size_t size)
+{
+  static const size_t threshold = config::get_copy_engine_threshold();
+  static const unsigned int threads = get_num_threads();
+
+  if (!threshold || size < threshold) {
+    std::memcpy(dst, src, size);
+    return;
+  }
+
+  auto d = static_cast<char*>(dst);
+  auto s = static_cast<const char*>(src);
+  size_t parts = std::clamp<size_t>(size / min_part_size, 1, threads);
+  size_t part_size = size / parts;
+
+  // Offset of the first page boundary of dst at or after offset.  The
+  // boundaries are absolute addresses, dst itself need not be aligned.
+  auto base = reinterpret_cast<uintptr_t>(d);
+  auto split = [base, size](size_t offset) {
+    auto boundary = (base + offset + part_alignment - 1) & ~static_cast<uintptr_t>(part_alignment - 1);
+    return std::min<size_t>(boundary - base, size);
+  };
+
+  std::vector<xrt_core::task::event<void>> events;
+  if (parts > 1) {
+    auto& pool = get_pool();
+    size_t begin = split(part_size);
+    for (size_t part = 2; part <= parts; ++part) {
+      size_t end = (part == parts) ? size : split(part * part_size);
+      events.push_back(pool.add(d + begin, s + begin, end - begin));
+      begin = end;
+    }
+  }
+
+  copy_part(d, s, split(part_size));
+
+  for (auto& event : events)
+    event.wait();
+}
+
+bool
+has_streaming_stores()
+{
+#ifdef XRT_COPY_ENGINE_X86
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // copy_engine, xrt_core
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef core_common_copy_engine_h_
+#define core_common_copy_engine_h_
+
+#include "core/common/config.h"
+
+#include <cstddef>
+
+// Copy engine for the host side of buffer objects
+//
+// Copies smaller than Runtime.copy_engine_threshold are a plain
+// memcpy.  Larger copies are split in parts that are copied by a pool
+// of Runtime.copy_engine_threads threads, with the calling thread
+// copying one of the parts.  Large copies use non-temporal stores
+// where the CPU supports them, so staging a large buffer does not
+// evict the working set of the application from the last level
+// cache.
+namespace xrt_core::copy_engine {
+
+// copy() - Copy size bytes from src to dst
+//
+// The source and destination must not overlap.  Returns when all
+// bytes have been copied and are visible to other threads.
+XRT_CORE_COMMON_EXPORT
+void
+copy(void* dst, const void* src, size_t size);
+
+// has_streaming_stores() - True if large copies use non-temporal stores
+XRT_CORE_COMMON_EXPORT
+bool
+has_streaming_stores();
+
+} // copy_engine, xrt_core
+
+#endif
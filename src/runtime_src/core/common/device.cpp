@@ -8,6 +8,7 @@
 #include "config_reader.h"
 #include "debug.h"
 #include "error.h"
+#include "exec_buffer_pool.h"
 #include "query_requests.h"
 #include "utils.h"
 #include "xclbin_parser.h"
@@ -33,11 +34,51 @@
 #pragma warning ( disable : 4996 )
 #endif
 
+namespace {
+
+// Query requests that are implemented by xrt_core::device itself
+// rather than by the concrete device (shim) classes.
+struct exec_buffer_pool_stats : xrt_core::query::exec_buffer_pool_stats
+{
+  std::any
+  get(const xrt_core::device* device) const override
+  {
+    return device->get_exec_buffer_pool().get_stats();
+  }
+};
+
+struct capability_stats : xrt_core::query::capability_stats
+{
+  std::any
+  get(const xrt_core::device* device) const override
+  {
+    auto [builds, lookups] = device->get_capability_stats();
+    return result_type{builds, lookups};
+  }
+};
+
+// Boolean property of the device, false if the query is not
+// supported or fails
+template <typename QueryRequestType>
+static bool
+query_bool(const xrt_core::device* device)
+{
+  try {
+    return QueryRequestType::to_bool(xrt_core::device_query<QueryRequestType>(device));
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+}
+
+} // namespace
+
 namespace xrt_core {
 
 device::
 device(id_type device_id)
   : m_device_id(device_id)
+  , m_exec_buffer_pool(std::make_unique<exec_buffer_pool>(this, config::get_exec_buffer_pool_size()))
 {
   XRT_DEBUGF("xrt_core::device::device(0x%x) idx(%d)\n", this, device_id);
 }
@@ -50,23 +91,66 @@ device::
   hw_queue::finish(this);
 }
 
+const query::request*
+device::
+lookup_common_query(query::key_type query_key)
+{
+  static const ::exec_buffer_pool_stats s_exec_buffer_pool_stats;
+  static const ::capability_stats s_capability_stats;
+
+  switch (query_key) {
+  case query::key_type::exec_buffer_pool_stats:
+    return &s_exec_buffer_pool_stats;
+  case query::key_type::capability_stats:
+    return &s_capability_stats;
+  default:
+    return nullptr;
+  }
+}
+
+void
+device::
+clear_exec_buffer_pool()
+{
+  m_exec_buffer_pool->clear();
+}
+
 bool
 device::
 is_nodma() const
 {
-  std::lock_guard lk(m_mutex);
-  if (m_nodma != boost::none)
-    return *m_nodma;
+  return get_capabilities()->nodma;
+}
 
-  try {
-    auto nodma = xrt_core::device_query<xrt_core::query::nodma>(this);
-    m_nodma = xrt_core::query::nodma::to_bool(nodma);
-  }
-  catch (const std::exception&) {
-    m_nodma = false;
-  }
+std::shared_ptr<const device::capabilities>
+device::
+get_capabilities() const
+{
+  m_capability_lookups.fetch_add(1, std::memory_order_relaxed);
+  if (auto snapshot = std::atomic_load(&m_capabilities))
+    return snapshot;
+
+  // Only one thread builds the snapshot, others wait for it
+  std::lock_guard lk(m_capability_mutex);
+  if (auto snapshot = std::atomic_load(&m_capabilities))
+    return snapshot;
+
+  // The queries below are the only driver round-trips for the
+  // properties in the snapshot until the snapshot is invalidated.
+  capabilities caps;
+  caps.m2m = query_bool<query::m2m>(this);
+  caps.nodma = query_bool<query::nodma>(this);
+  auto snapshot = std::make_shared<const capabilities>(caps);
+  std::atomic_store(&m_capabilities, snapshot);
+  m_capability_builds.fetch_add(1, std::memory_order_relaxed);
+  return snapshot;
+}
 
-  return *m_nodma;
+std::pair<uint64_t, uint64_t>
+device::
+get_capability_stats() const
+{
+  return {m_capability_builds.load(), m_capability_lookups.load()};
 }
 
 uuid
@@ -189,6 +273,15 @@ update_xclbin_info()
 {
   // Update cached slot xclbin uuid mapping
   std::lock_guard lk(m_mutex);
+
+  // Device properties may have changed with the xclbin, or with the
+  // reset that preceded loading it.  Invalidate under the build lock
+  // so a snapshot built from the old properties is not published after.
+  {
+    std::lock_guard caps_lk(m_capability_mutex);
+    std::atomic_store(&m_capabilities, std::shared_ptr<const capabilities>{});
+  }
+
   try {
     // [slot, xclbin_uuid]+
     auto xclbin_slot_info = xrt_core::device_query<xrt_core::query::xclbin_slots>(this);
@@ -410,13 +503,17 @@ get_ert_slots(const char* xml_data, size_t xml_size) const
   //  - minimum 2 concurrently scheduled CUs, plus 1 reserved slot
   //  - minimum min_slots
   //  - maximum max_slots
-  auto num_cus = xrt_core::xclbin::get_cus(xml_data, xml_size).size();
+  auto md = xrt_core::xclbin::get_xml_metadata(xml_data, xml_size);
+  md->check_kernels();
+  auto num_cus = md->cus.size();
   auto slots = std::min(max_slots, std::max(min_slots, (num_cus * 2) + 1));
 
   // Required slot size bounded by max of
   //  - number of slots needed
   //  - max cu_size per xclbin
-  auto size = std::max(cq_size / slots, xrt_core::xclbin::get_max_cu_size(xml_data, xml_size));
+  if (!md->max_cu_size_error.empty())
+    throw error(md->max_cu_size_error);
+  auto size = std::max(cq_size / slots, md->max_cu_size);
   slots = cq_size / size;
 
   // Round desired slots to minimum 32, 64, 96, 128 (status register boundary)
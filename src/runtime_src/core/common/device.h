@@ -19,11 +19,14 @@
 #include "core/include/experimental/xrt_xclbin.h"
 
 #include <any>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <string>
 #include <map>
+#include <utility>
 #include <memory>
+#include <mutex>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/optional/optional.hpp>
 
@@ -34,6 +37,8 @@
 
 namespace xrt_core {
 
+class exec_buffer_pool;
+
 using device_collection = std::vector<std::shared_ptr<xrt_core::device>>;
 
 /**
@@ -195,11 +200,62 @@ public:
   bool
   is_nodma() const;
 
+  /**
+   * struct capabilities - Device properties consulted in hot paths
+   *
+   * The properties are queried from the driver when the snapshot is
+   * built, after which the snapshot is immutable.  A new snapshot is
+   * built on first use after the xclbin data of the device changes,
+   * which covers xclbin load and the reload following a reset.
+   */
+  struct capabilities
+  {
+    bool m2m = false;     // device has m2m engine for copying BOs
+    bool nodma = false;   // device has no DMA, host memory only
+  };
+
+  /**
+   * get_capabilities() - Get current capability snapshot
+   *
+   * Return: shared pointer to immutable capability snapshot
+   *
+   * Callers must not query the driver for properties that are
+   * part of the snapshot in critical paths.
+   */
+  XRT_CORE_COMMON_EXPORT
+  std::shared_ptr<const capabilities>
+  get_capabilities() const;
+
+  /**
+   * get_capability_stats() - Number of snapshot builds and lookups
+   *
+   * Return: pair of {builds, lookups}
+   *
+   * Each lookup that did not build the snapshot is a driver query
+   * that was avoided.  Also available as query::capability_stats.
+   */
+  std::pair<uint64_t, uint64_t>
+  get_capability_stats() const;
+
  private:
   // Private look up function for concrete query::request
   virtual const query::request&
   lookup_query(query::key_type query_key) const = 0;
 
+  // Look up query::request implemented by this class for all devices
+  XRT_CORE_COMMON_EXPORT
+  static const query::request*
+  lookup_common_query(query::key_type query_key);
+
+  const query::request&
+  lookup(query::key_type query_key) const
+  {
+    if (auto qr = lookup_common_query(query_key))
+      return *qr;
+
+    return lookup_query(query_key);
+  }
+
 public:
   /**
    * query() - Query the device for specific property
@@ -211,7 +267,7 @@ public:
   std::any
   query() const
   {
-    auto& qr = lookup_query(QueryRequestType::key);
+    auto& qr = lookup(QueryRequestType::key);
     return qr.get(this);
   }
 
@@ -226,7 +282,7 @@ public:
   std::any
   query(Args&&... args) const
   {
-    auto& qr = lookup_query(QueryRequestType::key);
+    auto& qr = lookup(QueryRequestType::key);
     return qr.get(this, std::forward<Args>(args)...);
   }
 
@@ -464,6 +520,35 @@ public:
     return {fd, std::bind(&device::close, this, fd)};
   }
 
+  /**
+   * get_exec_buffer_pool() - get pool of command buffers
+   *
+   * All command producers allocate execution buffers from this pool.
+   */
+  exec_buffer_pool&
+  get_exec_buffer_pool()
+  {
+    return *m_exec_buffer_pool;
+  }
+
+  const exec_buffer_pool&
+  get_exec_buffer_pool() const
+  {
+    return *m_exec_buffer_pool;
+  }
+
+  /**
+   * clear_exec_buffer_pool() - free all cached command buffers
+   *
+   * Cached command buffers must be released before the device is
+   * closed.  This function is called by shim::close_device() when
+   * the last reference to a managed device goes away, and by shims
+   * that close the device from their own destructor.
+   */
+  XRT_CORE_COMMON_EXPORT
+  void
+  clear_exec_buffer_pool();
+
   /**
    * get_usage_logger() - get usage metrics logger
    */
@@ -475,7 +560,12 @@ public:
 
  private:
   id_type m_device_id;
-  mutable boost::optional<bool> m_nodma = boost::none;
+  // Snapshot is read and replaced with std::atomic_load/atomic_store,
+  // m_capability_mutex only serializes building a new snapshot
+  mutable std::shared_ptr<const capabilities> m_capabilities;
+  mutable std::mutex m_capability_mutex;
+  mutable std::atomic<uint64_t> m_capability_builds {0};
+  mutable std::atomic<uint64_t> m_capability_lookups {0};
 
   using name2idx_type = std::map<std::string, cuidx_type>;
   std::map<slot_id, name2idx_type> m_cu2idx;  // slot -> cu name mapping to cuidx
@@ -485,6 +575,7 @@ public:
   xclbin_map m_xclbins;                       // currently loaded xclbins (multi-slot)
   mutable std::mutex m_mutex;
   std::shared_ptr<usage_metrics::base_logger> m_usage_logger = usage_metrics::get_usage_metrics_logger();
+  std::unique_ptr<exec_buffer_pool> m_exec_buffer_pool;
 };
 
 /**
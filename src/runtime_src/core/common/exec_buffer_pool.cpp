@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE // in same dll as coreutil
+#include "exec_buffer_pool.h"
+#include "device.h"
+
+#include "core/include/xrt_mem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Max number of shards, threads beyond this share shards
+constexpr size_t max_shards = 16;
+
+// Cache line size, used to avoid false sharing between shards
+constexpr size_t cache_line_size = 64;
+
+static size_t
+get_num_shards()
+{
+  auto hwc = static_cast<size_t>(std::thread::hardware_concurrency());
+  return std::clamp<size_t>(hwc, 1, max_shards);
+}
+
+// Threads are assigned shards in round robin order as they first
+// access any pool.  This spreads concurrent threads evenly across
+// shards without hashing thread ids.
+static size_t
+get_thread_index()
+{
+  static std::atomic<size_t> count {0};
+  static thread_local size_t idx = count++;
+  return idx;
+}
+
+} // namespace
+
+namespace xrt_core {
+
+// struct shard - Per thread group cache of command buffers
+//
+// Counters are atomics so that statistics can be read without
+// locking each shard.  They are updated only while holding the shard
+// lock, hence relaxed ordering.
+struct alignas(cache_line_size) exec_buffer_pool::shard
+{
+  std::mutex mutex;
+  std::array<std::vector<cmd_bo<void>>, num_size_classes> free;
+  std::array<std::atomic<uint64_t>, num_size_classes> hits {};
+  std::array<std::atomic<uint64_t>, num_size_classes> misses {};
+  std::array<std::atomic<uint64_t>, num_size_classes> evictions {};
+};
+
+static void
+destroy(const exec_buffer_pool::cmd_bo<void>& bo)
+{
+  bo.bo->unmap(bo.cmd);
+}
+
+exec_buffer_pool::
+exec_buffer_pool(device* device, unsigned int max_size)
+  : m_device(device)
+  , m_num_shards(get_num_shards())
+  , m_max_per_shard((max_size + m_num_shards - 1) / m_num_shards)
+  , m_shards(std::make_unique<shard[]>(m_num_shards))
+{}
+
+exec_buffer_pool::
+~exec_buffer_pool()
+{
+  clear();
+}
+
+exec_buffer_pool::shard&
+exec_buffer_pool::
+get_shard() const
+{
+  return m_shards[get_thread_index() % m_num_shards];
+}
+
+exec_buffer_pool::cmd_bo<void>
+exec_buffer_pool::
+alloc_impl(size_class sclass)
+{
+  auto sc = static_cast<size_t>(sclass);
+  auto& local = get_shard();
+
+  if (m_max_per_shard) {
+    {
+      std::lock_guard lk(local.mutex);
+      auto& free = local.free[sc];
+      if (!free.empty()) {
+        auto bo = std::move(free.back());
+        free.pop_back();
+        local.hits[sc].fetch_add(1, std::memory_order_relaxed);
+        return bo;
+      }
+    }
+
+    // Steal from other shards, but don't wait for a busy shard
+    for (size_t idx = 0; idx < m_num_shards; ++idx) {
+      auto& other = m_shards[idx];
+      if (&other == &local)
+        continue;
+
+      std::unique_lock lk(other.mutex, std::try_to_lock);
+      if (!lk.owns_lock() || other.free[sc].empty())
+        continue;
+
+      auto bo = std::move(other.free[sc].back());
+      other.free[sc].pop_back();
+      lk.unlock();
+      local.hits[sc].fetch_add(1, std::memory_order_relaxed);
+      return bo;
+    }
+  }
+
+  local.misses[sc].fetch_add(1, std::memory_order_relaxed);
+  auto bo = m_device->alloc_bo(class_size[sc], XCL_BO_FLAGS_EXECBUF);
+  auto map = bo->map(buffer_handle::map_type::write);
+  return {std::move(bo), map, sclass};
+}
+
+void
+exec_buffer_pool::
+release_impl(cmd_bo<void>&& bo)
+{
+  auto sc = static_cast<size_t>(bo.sclass);
+  auto& local = get_shard();
+
+  if (m_max_per_shard) {
+    std::lock_guard lk(local.mutex);
+    auto& free = local.free[sc];
+    if (free.size() < m_max_per_shard) {
+      free.push_back(std::move(bo));
+      return;
+    }
+  }
+
+  local.evictions[sc].fetch_add(1, std::memory_order_relaxed);
+  destroy(bo);
+}
+
+void
+exec_buffer_pool::
+clear()
+{
+  for (size_t idx = 0; idx < m_num_shards; ++idx) {
+    auto& s = m_shards[idx];
+    std::lock_guard lk(s.mutex);
+    for (auto& free : s.free) {
+      for (auto& bo : free)
+        destroy(bo);
+      free.clear();
+    }
+  }
+}
+
+query::exec_buffer_pool_stats::result_type
+exec_buffer_pool::
+get_stats() const
+{
+  query::exec_buffer_pool_stats::result_type stats(num_size_classes);
+  for (size_t sc = 0; sc < num_size_classes; ++sc) {
+    auto& data = stats[sc];
+    data = {class_size[sc], 0, 0, 0, 0};
+    for (size_t idx = 0; idx < m_num_shards; ++idx) {
+      auto& s = m_shards[idx];
+      data.hits += s.hits[sc].load(std::memory_order_relaxed);
+      data.misses += s.misses[sc].load(std::memory_order_relaxed);
+      data.evictions += s.evictions[sc].load(std::memory_order_relaxed);
+      std::lock_guard lk(s.mutex);
+      data.cached += s.free[sc].size();
+    }
+  }
+  return stats;
+}
+
+} // xrt_core
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef core_common_exec_buffer_pool_h_
+#define core_common_exec_buffer_pool_h_
+
+#include "core/common/config.h"
+#include "core/common/query_requests.h"
+#include "core/common/shim/buffer_handle.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace xrt_core {
+
+class device;
+
+// class exec_buffer_pool - Per device pool of command (exec) buffers
+//
+// All command producers (runs, runlists, copy commands) allocate their
+// execution buffer objects from the pool owned by the core device.
+// Allocating and mapping an EXECBUF BO is a driver round trip, the
+// pool recycles released BOs to avoid this overhead.
+//
+// Buffers are bucketed by size class so that small control commands
+// do not hold on to page sized buffers.  Fixed size commands (copy,
+// scheduler control, runlist chains) allocate the size of the command
+// and use the small class, while kernel start commands, whose size
+// depends on the register map, use the default medium class.
+// Commands larger than the largest class are rejected.
+//
+// The pool is sharded, each thread maps to a shard that is protected
+// by its own mutex.  A thread first looks in its own shard and falls
+// back to stealing from other shards before allocating a new BO.
+// Released buffers are returned to the shard of the releasing thread.
+//
+// Hit and miss counters are maintained per shard and are accessible
+// through xrt_core::query::exec_buffer_pool_stats.
+class exec_buffer_pool
+{
+public:
+  enum class size_class { small, medium };
+  static constexpr size_t num_size_classes = 2;
+
+  // Note that xocl/zocl upsize allocations to a full page
+  static constexpr std::array<size_t, num_size_classes> class_size
+    { 1024, 4096 };
+
+  // Smallest size class that fits a command of specified bytes
+  static constexpr size_class
+  get_size_class(size_t bytes)
+  {
+    if (bytes <= class_size[0])
+      return size_class::small;
+    if (bytes <= class_size[1])
+      return size_class::medium;
+    throw std::length_error("command buffer size " + std::to_string(bytes) +
+                            " exceeds max size " + std::to_string(class_size[1]));
+  }
+
+  // Command buffer BO and its host mapping interpreted as CommandType
+  template <typename CommandType>
+  struct cmd_bo
+  {
+    std::unique_ptr<buffer_handle> bo;
+    CommandType* cmd = nullptr;
+    size_class sclass = size_class::medium;
+  };
+
+private:
+  struct shard;
+
+  device* m_device;
+  size_t m_num_shards;
+  size_t m_max_per_shard;
+  std::unique_ptr<shard[]> m_shards;
+
+  shard&
+  get_shard() const;
+
+  XRT_CORE_COMMON_EXPORT
+  cmd_bo<void>
+  alloc_impl(size_class sclass);
+
+  XRT_CORE_COMMON_EXPORT
+  void
+  release_impl(cmd_bo<void>&& bo);
+
+public:
+  // exec_buffer_pool() - Construct pool for device
+  //
+  // @device:   Device for BO allocation, must outlive the pool
+  // @max_size: Max number of cached BOs per size class, 0 disables caching
+  XRT_CORE_COMMON_EXPORT
+  exec_buffer_pool(device* device, unsigned int max_size);
+
+  XRT_CORE_COMMON_EXPORT
+  ~exec_buffer_pool();
+
+  exec_buffer_pool(const exec_buffer_pool&) = delete;
+  exec_buffer_pool(exec_buffer_pool&&) = delete;
+  exec_buffer_pool& operator=(const exec_buffer_pool&) = delete;
+  exec_buffer_pool& operator=(exec_buffer_pool&&) = delete;
+
+  // alloc() - Get a command buffer of at least @bytes
+  //
+  // Throws std::length_error if @bytes exceeds the largest class
+  template <typename CommandType>
+  cmd_bo<CommandType>
+  alloc(size_t bytes = class_size[1])
+  {
+    auto bo = alloc_impl(get_size_class(bytes));
+    return {std::move(bo.bo), static_cast<CommandType*>(bo.cmd), bo.sclass};
+  }
+
+  // release() - Return a command buffer to the pool
+  template <typename CommandType>
+  void
+  release(cmd_bo<CommandType>&& bo)
+  {
+    release_impl({std::move(bo.bo), static_cast<void*>(bo.cmd), bo.sclass});
+  }
+
+  // clear() - Unmap and free all cached command buffers
+  //
+  // Must be called before the underlying device is closed.  This is
+  // done by xrt_core::shim::close_device() for all shims.
+  XRT_CORE_COMMON_EXPORT
+  void
+  clear();
+
+  // get_stats() - Pool statistics per size class
+  XRT_CORE_COMMON_EXPORT
+  query::exec_buffer_pool_stats::result_type
+  get_stats() const;
+};
+
+} // xrt_core
+
+#endif
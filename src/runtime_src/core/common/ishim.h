@@ -260,6 +260,8 @@ struct shim : public DeviceType
   void
   close_device() override
   {
+    // Cached command buffers must be freed while the device is open
+    DeviceType::clear_exec_buffer_pool();
     xclClose(DeviceType::get_device_handle());
   }
 
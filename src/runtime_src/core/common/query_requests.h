@@ -327,6 +327,8 @@ enum class key_type
   kernel_max_bandwidth_mbps,
   sub_device_path,
   read_trace_data,
+  exec_buffer_pool_stats,
+  capability_stats,
   noop
 };
 
@@ -3954,6 +3956,40 @@ struct read_trace_data : request
   virtual std::any
   get(const device*, const std::any&) const = 0;
 };
+
+// Statistics of the command buffer pool per size class.  This
+// request is implemented by xrt_core::device for all devices.
+struct exec_buffer_pool_stats : request
+{
+  struct data {
+    size_t size;         // size of command buffers in this class
+    uint64_t hits;       // allocations served from the pool
+    uint64_t misses;     // allocations that required a new BO
+    uint64_t evictions;  // released BOs freed because pool was full
+    uint64_t cached;     // BOs currently cached
+  };
+  using result_type = std::vector<data>;
+  static const key_type key = key_type::exec_buffer_pool_stats;
+
+  virtual std::any
+  get(const device*) const = 0;
+};
+
+// Use of the device capability snapshot.  Every lookup that did not
+// build the snapshot replaced a driver query.  This request is
+// implemented by xrt_core::device for all devices.
+struct capability_stats : request
+{
+  struct data {
+    uint64_t builds;     // snapshots built from driver queries
+    uint64_t lookups;    // snapshot lookups in hot paths
+  };
+  using result_type = data;
+  static const key_type key = key_type::capability_stats;
+
+  virtual std::any
+  get(const device*) const = 0;
+};
 } // query
 
 } // xrt_core
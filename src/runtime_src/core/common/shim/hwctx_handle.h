@@ -15,6 +15,7 @@
 #include "xrt/xrt_graph.h"
 
 #include <memory>
+#include <vector>
 
 namespace xrt_core {
 
@@ -96,6 +97,33 @@ public:
   virtual void
   exec_buf(buffer_handle* cmd) = 0;
 
+  // Execution of a batch of command objects in order.  Shims that
+  // can submit multiple commands in one call should override.
+  //
+  // @cmds   Commands to execute
+  // @return Number of commands submitted from the front of @cmds
+  //
+  // Throws if the first command could not be submitted.  If a later
+  // command fails, the number of commands submitted prior to the
+  // failing command is returned.
+  virtual size_t
+  exec_buf(const std::vector<buffer_handle*>& cmds)
+  {
+    size_t count = 0;
+    for (auto cmd : cmds) {
+      try {
+        exec_buf(cmd);
+        ++count;
+      }
+      catch (...) {
+        if (!count)
+          throw;
+        break;
+      }
+    }
+    return count;
+  }
+
   virtual std::unique_ptr<xrt_core::graph_handle>
   open_graph_handle(const char*, xrt::graph::access_mode)
   {
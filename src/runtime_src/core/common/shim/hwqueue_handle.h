@@ -28,6 +28,33 @@ public:
   virtual void
   submit_command(buffer_handle* cmd) = 0;
 
+  // Submit a batch of commands for execution in order.  Shims that
+  // can submit multiple commands in one call should override.
+  //
+  // @cmds   Commands to submit
+  // @return Number of commands submitted from the front of @cmds
+  //
+  // Throws if the first command could not be submitted.  If a later
+  // command fails, the number of commands submitted prior to the
+  // failing command is returned.
+  virtual size_t
+  submit_command(const std::vector<buffer_handle*>& cmds)
+  {
+    size_t count = 0;
+    for (auto cmd : cmds) {
+      try {
+        submit_command(cmd);
+        ++count;
+      }
+      catch (...) {
+        if (!count)
+          throw;
+        break;
+      }
+    }
+    return count;
+  }
+
   // Poll for command completion
   //
   // @cmd    Handle to command to poll for
@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE // in same dll as coreutil
+#include "xclbin_catalog.h"
+#include "config_reader.h"
+#include "message.h"
+#include "utils.h"
+#include "xclbin_parser.h"
+
+#include "core/include/xclbin.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+namespace {
+
+namespace sfs = std::filesystem;
+using entry = xrt_core::xclbin_catalog::entry;
+
+// Version of persisted catalog format, bump when format changes
+constexpr const char* catalog_version = "xrt-xclbin-catalog 1";
+
+static sfs::path
+get_cache_dir()
+{
+  auto dir = xrt_core::config::get_xclbin_catalog_dir();
+  if (!dir.empty())
+    return dir;
+
+#ifdef _WIN32
+  if (auto local = std::getenv("LOCALAPPDATA"))
+    return sfs::path(local) / "xrt";
+#else
+  if (auto cache = std::getenv("XDG_CACHE_HOME"))
+    return sfs::path(cache) / "xrt";
+  if (auto home = std::getenv("HOME"))
+    return sfs::path(home) / ".cache" / "xrt";
+#endif
+
+  return {};
+}
+
+// Path to persisted catalog for directory, empty if no cache directory
+static sfs::path
+get_catalog_path(const sfs::path& dir)
+{
+  auto cache_dir = get_cache_dir();
+  if (cache_dir.empty())
+    return {};
+
+  std::error_code ec;
+  sfs::create_directories(cache_dir, ec);
+  if (ec)
+    return {};
+
+  auto hash = std::hash<std::string>{}(dir.string());
+  std::stringstream ss;
+  ss << "xclbin_catalog_" << std::hex << hash << ".txt";
+  return cache_dir / ss.str();
+}
+
+static int64_t
+get_mtime(const sfs::directory_entry& dentry)
+{
+  std::error_code ec;
+  return static_cast<int64_t>(dentry.last_write_time(ec).time_since_epoch().count());
+}
+
+// Read uuids and kernel names of an xclbin.  Only the axlf header,
+// section headers, and the XML meta data are read from the file.
+static entry
+read_entry(const sfs::path& path, uintmax_t size, int64_t mtime)
+{
+  std::ifstream stream(path, std::ios::binary);
+  axlf top {};
+  stream.read(reinterpret_cast<char*>(&top), sizeof(axlf));
+  if (!stream || std::strncmp(top.m_magic, "xclbin2", std::strlen("xclbin2")) != 0)
+    throw std::runtime_error("Invalid xclbin");
+
+  entry xentry {path, size, mtime, xrt::uuid{top.m_header.uuid}, xrt::uuid{top.m_header.m_interface_uuid}, {}};
+
+  auto num_sections = top.m_header.m_numSections;
+  if (num_sections == 0)
+    return xentry;
+  if (num_sections > XCLBIN_MAX_NUM_SECTION)
+    throw std::runtime_error("Invalid xclbin, too many sections");
+
+  // First section header is part of axlf, the remaining follow
+  std::vector<axlf_section_header> hdrs(num_sections);
+  hdrs[0] = top.m_sections[0];
+  stream.read(reinterpret_cast<char*>(hdrs.data() + 1), (num_sections - 1) * sizeof(axlf_section_header));
+  if (!stream)
+    throw std::runtime_error("Invalid xclbin, truncated section headers");
+
+  auto itr = std::find_if(hdrs.begin(), hdrs.end(),
+                          [](const auto& hdr) { return hdr.m_sectionKind == EMBEDDED_METADATA; });
+  if (itr == hdrs.end())
+    return xentry;
+
+  if ((*itr).m_sectionOffset > size || (*itr).m_sectionSize > size - (*itr).m_sectionOffset)
+    throw std::runtime_error("Invalid xclbin, section exceeds xclbin size");
+
+  std::vector<char> xml((*itr).m_sectionSize);
+  stream.seekg((*itr).m_sectionOffset);
+  stream.read(xml.data(), xml.size());
+  if (!stream)
+    throw std::runtime_error("Invalid xclbin, truncated meta data");
+
+  for (const auto& kernel : xrt_core::xclbin::get_xml_metadata(xml.data(), xml.size())->kernels)
+    xentry.kernels.push_back(kernel.properties.name);
+
+  return xentry;
+}
+
+// Persisted entries keyed by file name.  Each line of a persisted
+// catalog is a tab separated record of
+//   <file name> <size> <mtime> <uuid> <interface uuid> <kernel,...>
+static std::map<std::string, entry>
+load_catalog(const sfs::path& file, const sfs::path& dir)
+{
+  std::map<std::string, entry> entries;
+  std::ifstream stream(file);
+  std::string line;
+  if (!std::getline(stream, line) || line != catalog_version)
+    return entries;
+  if (!std::getline(stream, line) || line != dir.string())
+    return entries;
+
+  while (std::getline(stream, line)) {
+    std::stringstream record(line);
+    std::string name, size, mtime, uuid, intf_uuid, kernels;
+    if (!std::getline(record, name, '\t') || !std::getline(record, size, '\t')
+        || !std::getline(record, mtime, '\t') || !std::getline(record, uuid, '\t')
+        || !std::getline(record, intf_uuid, '\t'))
+      continue;
+    std::getline(record, kernels, '\t');
+
+    try {
+      entry xentry {dir / name, std::stoull(size), std::stoll(mtime), xrt::uuid{uuid}, xrt::uuid{intf_uuid}, {}};
+      std::stringstream knames(kernels);
+      for (std::string kname; std::getline(knames, kname, ',');)
+        xentry.kernels.push_back(kname);
+      entries.emplace(name, std::move(xentry));
+    }
+    catch (const std::exception&) {
+      // ignore corrupt record, the file will be read again
+    }
+  }
+
+  return entries;
+}
+
+// Write catalog to a temporary file that is renamed to catalog
+// file, such that concurrent processes never see a partial catalog
+static void
+save_catalog(const sfs::path& file, const sfs::path& dir, const std::vector<entry>& entries)
+{
+  auto tmp = file;
+  tmp += "." + std::to_string(xrt_core::utils::get_pid());
+
+  {
+    std::ofstream stream(tmp);
+    if (!stream)
+      return;
+
+    stream << catalog_version << '\n' << dir.string() << '\n';
+    for (const auto& xentry : entries) {
+      auto name = xentry.path.filename().string();
+      if (name.find_first_of("\t\n") != std::string::npos)
+        continue;
+
+      stream << name << '\t' << xentry.size << '\t' << xentry.mtime << '\t'
+             << xentry.uuid.to_string() << '\t' << xentry.interface_uuid.to_string() << '\t';
+      for (size_t idx = 0; idx < xentry.kernels.size(); ++idx)
+        stream << (idx ? "," : "") << xentry.kernels[idx];
+      stream << '\n';
+    }
+
+    if (!stream)
+      return;
+  }
+
+  std::error_code ec;
+  sfs::rename(tmp, file, ec);
+  if (ec)
+    sfs::remove(tmp, ec);
+}
+
+} // namespace
+
+namespace xrt_core {
+
+xclbin_catalog::
+xclbin_catalog(std::filesystem::path dir)
+  : m_dir(std::move(dir))
+{
+  auto catalog_path = get_catalog_path(m_dir);
+  auto persisted = catalog_path.empty()
+    ? std::map<std::string, entry>{}
+    : load_catalog(catalog_path, m_dir);
+
+  // Reuse persisted entries of unchanged files, read all others
+  bool modified = false;
+  std::error_code ec;
+  for (const auto& dentry : sfs::directory_iterator{m_dir, ec}) {
+    if (!dentry.is_regular_file(ec) || dentry.path().extension() != ".xclbin")
+      continue;
+
+    auto size = dentry.file_size(ec);
+    auto mtime = get_mtime(dentry);
+    auto itr = persisted.find(dentry.path().filename().string());
+    if (itr != persisted.end() && (*itr).second.size == size && (*itr).second.mtime == mtime) {
+      m_entries.push_back(std::move((*itr).second));
+      persisted.erase(itr);
+      continue;
+    }
+
+    try {
+      m_entries.push_back(read_entry(dentry.path(), size, mtime));
+      modified = true;
+    }
+    catch (const std::exception& ex) {
+      xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                              "Skipping '" + dentry.path().string() + "' in xclbin catalog: " + ex.what());
+    }
+  }
+
+  // Remaining persisted entries are for removed files
+  modified = modified || !persisted.empty();
+
+  std::sort(m_entries.begin(), m_entries.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.path < rhs.path; });
+
+  for (size_t idx = 0; idx < m_entries.size(); ++idx) {
+    const auto& xentry = m_entries[idx];
+    m_uuid_index.emplace(xentry.uuid, idx);
+    for (const auto& kname : xentry.kernels)
+      m_kernel_index[kname].push_back(idx);
+  }
+
+  if (modified && !catalog_path.empty())
+    save_catalog(catalog_path, m_dir, m_entries);
+}
+
+const xclbin_catalog::entry*
+xclbin_catalog::
+find(const xrt::uuid& uuid) const
+{
+  auto itr = m_uuid_index.find(uuid);
+  return (itr != m_uuid_index.end()) ? &m_entries[(*itr).second] : nullptr;
+}
+
+std::vector<const xclbin_catalog::entry*>
+xclbin_catalog::
+find_kernel(const std::string& kname) const
+{
+  std::vector<const entry*> entries;
+  auto itr = m_kernel_index.find(kname);
+  if (itr == m_kernel_index.end())
+    return entries;
+
+  for (auto idx : (*itr).second)
+    entries.push_back(&m_entries[idx]);
+
+  return entries;
+}
+
+} // xrt_core
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef core_common_xclbin_catalog_h_
+#define core_common_xclbin_catalog_h_
+
+#include "core/common/config.h"
+#include "core/include/xrt/xrt_uuid.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace xrt_core {
+
+// class xclbin_catalog - Catalog of xclbin files in a directory
+//
+// The catalog records uuid, interface uuid, and kernel names of all
+// xclbin files in a directory, which allows for lookup of xclbins by
+// uuid or kernel name without opening every file.
+//
+// The catalog is persisted in a per user cache directory and is
+// updated incrementally when constructed.  Only xclbin files that
+// are new or whose size or modification time changed since the
+// catalog was last persisted are opened, and only their header and
+// XML meta data are read.
+//
+// The cache directory is Runtime.xclbin_catalog_dir in xrt.ini, and
+// defaults to $XDG_CACHE_HOME/xrt or $HOME/.cache/xrt (%LOCALAPPDATA%
+// on Windows).  The catalog is not persisted if the cache directory
+// cannot be created.
+class xclbin_catalog
+{
+public:
+  struct entry
+  {
+    std::filesystem::path path;
+    uintmax_t size = 0;
+    int64_t mtime = 0;
+    xrt::uuid uuid;
+    xrt::uuid interface_uuid;
+    std::vector<std::string> kernels;
+  };
+
+private:
+  std::filesystem::path m_dir;
+  std::vector<entry> m_entries;                                 // sorted by path
+  std::map<xrt::uuid, size_t> m_uuid_index;                     // uuid -> entry
+  std::map<std::string, std::vector<size_t>> m_kernel_index;    // kernel -> entries
+
+public:
+  // xclbin_catalog() - Construct and update catalog for directory
+  XRT_CORE_COMMON_EXPORT
+  explicit
+  xclbin_catalog(std::filesystem::path dir);
+
+  // find() - Find xclbin by uuid, returns nullptr if not found
+  XRT_CORE_COMMON_EXPORT
+  const entry*
+  find(const xrt::uuid& uuid) const;
+
+  // find_kernel() - Find xclbins with kernel of specified name
+  XRT_CORE_COMMON_EXPORT
+  std::vector<const entry*>
+  find_kernel(const std::string& kname) const;
+
+  const std::vector<entry>&
+  get_entries() const
+  {
+    return m_entries;
+  }
+};
+
+} // xrt_core
+
+#endif
@@ -20,7 +20,11 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <string_view>
+#include <tuple>
 #include <cstring>
 #include <cstdlib>
 #include <boost/property_tree/ptree.hpp>
@@ -387,6 +391,222 @@ merge_args(std::vector<xrt_core::xclbin::kernel_argument>& args)
       throw std::runtime_error("xclbin parser internal error: mismatched argument index");
 }
 
+// Parse kernel properties from kernel xml entry
+static xrt_core::xclbin::kernel_properties
+parse_kernel_properties(const pt::ptree& xml_kernel)
+{
+  using xrt_core::xclbin::kernel_properties;
+  auto kname = xml_kernel.get<std::string>("<xmlattr>.name");
+
+  // Determine features
+  auto mailbox = convert_to_mailbox_type(xml_kernel.get<std::string>("<xmlattr>.mailbox", "none"));
+  if (mailbox == kernel_properties::mailbox_type::none)
+    mailbox = get_mailbox_from_ini(kname);
+  auto restart = convert(xml_kernel.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
+  if (restart == 0)
+    restart = get_restart_from_ini(kname);
+  auto sw_reset = to_bool(xml_kernel.get<std::string>("<xmlattr>.swReset", "false"));
+  if (!sw_reset)
+    sw_reset = get_sw_reset_from_ini(kname);
+
+  auto functional = get_functional(xml_kernel, "extended-data");
+  auto kernel_id = get_kernel_id(xml_kernel, "extended-data");
+
+  return kernel_properties
+    { kname
+    , to_kernel_type(xml_kernel.get<std::string>("<xmlattr>.type", "pl"))
+    , restart
+    , mailbox
+    , get_address_range(xml_kernel)
+    , sw_reset
+    , functional
+    , kernel_id
+
+    , convert(xml_kernel.get<std::string>("<xmlattr>.workGroupSize", "0"))
+    , get_xyz(xml_kernel, "compileWorkGroupSize")
+    , get_xyz(xml_kernel, "maxWorkGroupSize")
+    , get_stringtable(xml_kernel) };
+}
+
+// Parse kernel arguments from kernel xml entry
+static std::vector<xrt_core::xclbin::kernel_argument>
+parse_kernel_arguments(const pt::ptree& xml_kernel)
+{
+  using xrt_core::xclbin::kernel_argument;
+  std::vector<kernel_argument> args;
+
+  auto pwmap = get_portname_width_map(xml_kernel);
+
+  for (auto& xml_arg : xml_kernel) {
+    if (xml_arg.first != "arg")
+      continue;
+
+    std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
+    size_t index = id.empty() ? kernel_argument::no_index : convert(id);
+
+    std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
+    auto itr = pwmap.find(port);
+    size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
+
+    args.emplace_back(kernel_argument{
+        xml_arg.second.get<std::string>("<xmlattr>.name")
+       ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
+       ,port
+       ,pwidth
+       ,index
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.offset"))
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.size"))
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
+       ,0  // fa_desc_offset post computed if necessary
+       ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
+       ,kernel_argument::direction(kernel_argument::direction::input)
+    });
+  }
+
+  // stable sort to preserve order of multi-component arguments
+  // for example global_size, local_size, etc.
+  std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
+
+  // merge args with same index
+  merge_args(args);
+
+  return args;
+}
+
+// Compute register map size of kernel and validate that arguments
+// are within the kernel address range.
+static size_t
+parse_kernel_cu_size(const pt::ptree& xml_kernel, std::string& error)
+{
+  // determine address range to ensure args are within
+  size_t address_range = get_address_range(xml_kernel);
+
+  // iterate arguments and find offset and size to compute max
+  size_t maxsz = 0;
+  for (auto& xml_arg : xml_kernel) {
+    if (xml_arg.first != "arg")
+      continue;
+
+    auto ofs = convert(xml_arg.second.get<std::string>("<xmlattr>.offset"));
+    auto sz = convert(xml_arg.second.get<std::string>("<xmlattr>.size"));
+
+    // Validate offset and size against address range
+    if (ofs + sz > address_range && error.empty()) {
+      auto knm = xml_kernel.get<std::string>("<xmlattr>.name");
+      auto argnm = xml_arg.second.get<std::string>("<xmlattr>.name");
+      auto fmt = boost::format
+        ("Invalid kernel offset in xclbin for kernel (%s) argument (%s).\n"
+         "The offset (0x%x) and size (0x%x) exceeds kernel address range (0x%x)")
+        % knm % argnm % ofs % sz % address_range;
+      error = fmt.str();
+    }
+    maxsz = std::max(maxsz, ofs + sz);
+  }
+  return maxsz;
+}
+
+// Extract CU base addresses from kernel xml entry
+static void
+parse_kernel_cus(const pt::ptree& xml_kernel, std::vector<uint64_t>& cus)
+{
+  for (auto& xml_inst : xml_kernel) {
+    if (xml_inst.first != "instance")
+      continue;
+    for (auto& xml_remap : xml_inst.second) {
+      if (xml_remap.first != "addrRemap")
+        continue;
+      cus.push_back(convert(xml_remap.second.get<std::string>("<xmlattr>.base")));
+    }
+  }
+}
+
+// Extract kernel clock frequency from kernelClocks xml entry
+static size_t
+parse_kernel_freq(const pt::ptree& xml_clocks, size_t kernel_clk_freq)
+{
+  for (auto& xml_clock : xml_clocks) {
+    if (xml_clock.first != "clock")
+      continue;
+    auto port = xml_clock.second.get<std::string>("<xmlattr>.port","");
+    auto freq = xml_clock.second.get<std::string>("<xmlattr>.frequency","100");
+    //clock is always represented in units in XML
+    auto units = "MHz";
+    size_t found = freq.find(units);
+
+    //remove the units from the string
+    if (found != std::string::npos)
+      freq = freq.substr(0,found);
+
+    if(!freq.empty() && port == "KERNEL_CLK")
+      kernel_clk_freq = convert(freq);
+  }
+
+  return kernel_clk_freq;
+}
+
+// Build the meta data index in one pass over the XML
+static std::shared_ptr<const xrt_core::xclbin::xml_metadata>
+parse_xml_metadata(const char* xml_data, size_t xml_size)
+{
+  pt::ptree xml_project;
+  std::stringstream xml_stream;
+  xml_stream.write(xml_data,xml_size);
+  pt::read_xml(xml_stream,xml_project);
+
+  auto md = std::make_shared<xrt_core::xclbin::xml_metadata>();
+  md->project_name = xml_project.get<std::string>("project.<xmlattr>.name","");
+  md->fpga_device_name = xml_project.get<std::string>("project.platform.device.<xmlattr>.fpgaDevice","");
+
+  auto xml_core = xml_project.get_child_optional("project.platform.device.core");
+  if (!xml_core) {
+    md->core_error = "No such node (project.platform.device.core)";
+    return md;
+  }
+
+  bool clocks = false;
+  for (auto& xml_elem : *xml_core) {
+    if (xml_elem.first == "kernelClocks" && !clocks) {
+      md->kernel_freq = parse_kernel_freq(xml_elem.second, md->kernel_freq);
+      clocks = true;
+      continue;
+    }
+
+    if (xml_elem.first != "kernel")
+      continue;
+
+    // A malformed kernel is recorded as an error of the kernel, such
+    // that it fails only the accessors of kernel meta data
+    auto& xml_kernel = xml_elem.second;
+    md->kernel_names.push_back(xml_kernel.get<std::string>("<xmlattr>.name", ""));
+    try {
+      auto props = parse_kernel_properties(xml_kernel);
+      auto args = parse_kernel_arguments(xml_kernel);
+      std::string cu_size_error;
+      auto cu_size = parse_kernel_cu_size(xml_kernel, cu_size_error);
+      std::vector<uint64_t> cus;
+      parse_kernel_cus(xml_kernel, cus);
+
+      if (md->max_cu_size_error.empty())
+        md->max_cu_size_error = std::move(cu_size_error);
+      md->max_cu_size = std::max(md->max_cu_size, cu_size);
+      md->cus.insert(md->cus.end(), cus.begin(), cus.end());
+
+      // first kernel with a name is the one returned by name lookup
+      if (md->kernel_errors.find(props.name) == md->kernel_errors.end())
+        md->kernel_index.emplace(props.name, md->kernels.size());
+      md->kernels.push_back({std::move(props), std::move(args)});
+    }
+    catch (const std::exception& ex) {
+      const auto& kname = md->kernel_names.back();
+      if (md->kernel_index.find(kname) == md->kernel_index.end())
+        md->kernel_errors.emplace(kname, ex.what());
+    }
+  }
+
+  std::sort(md->cus.begin(), md->cus.end());
+  return md;
+}
+
 
 } // namespace
 
@@ -468,46 +688,61 @@ get_first_used_mem(const axlf* top)
   return -1;
 }
 
-// Compute max register map size of CUs in xclbin
-size_t
-get_max_cu_size(const char* xml_data, size_t xml_size)
+std::shared_ptr<const xml_metadata>
+get_xml_metadata(const char* xml_data, size_t xml_size)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
+  return parse_xml_metadata(xml_data, xml_size);
+}
 
-  size_t maxsz = 0;
+// The cache holds weak references so that the index is released
+// along with the last xrt::xclbin (or other user) referencing it.
+// The most recently used index is kept alive to serve repeated
+// calls from code that does not hold on to the index.
+//
+// The uuid alone does not identify the XML, tools may produce
+// xclbins with the same uuid but different meta data, so the key
+// includes the size and a hash of the XML section contents.  The
+// section address is not part of the key, a new xclbin can be loaded
+// at the address of a released one.  A null uuid identifies nothing.
+std::shared_ptr<const xml_metadata>
+get_xml_metadata(const axlf* top)
+{
+  using key_type = std::tuple<xrt::uuid, size_t, size_t>;
+  static std::mutex mutex;
+  static std::map<key_type, std::weak_ptr<const xml_metadata>> cache;
+  static std::shared_ptr<const xml_metadata> mru;
 
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
+  xrt::uuid uuid{top->m_header.uuid};
+  auto xml = get_xml_section(top);
+  if (!uuid)
+    return parse_xml_metadata(xml.first, xml.second);
+
+  auto hash = std::hash<std::string_view>{}({xml.first, xml.second});
+  key_type key{uuid, xml.second, hash};
+  std::lock_guard lk(mutex);
+  auto md = cache[key].lock();
+  if (!md) {
+    md = parse_xml_metadata(xml.first, xml.second);
+    cache[key] = md;
+
+    // purge entries of released indices
+    for (auto itr = cache.begin(); itr != cache.end();)
+      itr = (*itr).second.expired() ? cache.erase(itr) : std::next(itr);
+  }
 
-    // determine address range to ensure args are within
-    size_t address_range = get_address_range(xml_kernel.second);
+  return mru = md;
+}
 
-    // iterate arguments and find offset and size to compute max
-    for (auto& xml_arg : xml_kernel.second) {
-      if (xml_arg.first != "arg")
-        continue;
+// Compute max register map size of CUs in xclbin
+size_t
+get_max_cu_size(const char* xml_data, size_t xml_size)
+{
+  auto md = get_xml_metadata(xml_data, xml_size);
+  md->check_kernels();
+  if (!md->max_cu_size_error.empty())
+    throw xrt_core::error(md->max_cu_size_error);
 
-      auto ofs = convert(xml_arg.second.get<std::string>("<xmlattr>.offset"));
-      auto sz = convert(xml_arg.second.get<std::string>("<xmlattr>.size"));
-
-      // Validate offset and size against address range
-      if (ofs + sz > address_range) {
-        auto knm = xml_kernel.second.get<std::string>("<xmlattr>.name");
-        auto argnm = xml_arg.second.get<std::string>("<xmlattr>.name");
-        auto fmt = boost::format
-          ("Invalid kernel offset in xclbin for kernel (%s) argument (%s).\n"
-           "The offset (0x%x) and size (0x%x) exceeds kernel address range (0x%x)")
-          % knm % argnm % ofs % sz % address_range;
-        throw xrt_core::error(fmt.str());
-      }
-      maxsz = std::max(maxsz, ofs + sz);
-    }
-  }
-  return maxsz;
+  return md->max_cu_size;
 }
 
 std::map<std::string, cuidx_type>
@@ -625,30 +860,9 @@ get_cus(const ip_layout* ip_layout, const std::string& kname)
 std::vector<uint64_t>
 get_cus(const char* xml_data, size_t xml_size, bool)
 {
-  std::vector<uint64_t> cus;
-
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data, xml_size);
-  pt::read_xml(xml_stream, xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-    for (auto& xml_inst : xml_kernel.second) {
-      if (xml_inst.first != "instance")
-        continue;
-      for (auto& xml_remap : xml_inst.second) {
-        if (xml_remap.first != "addrRemap")
-          continue;
-        auto base = convert(xml_remap.second.get<std::string>("<xmlattr>.base"));
-        cus.push_back(base);
-      }
-    }
-  }
-
-  std::sort(cus.begin(), cus.end());
-  return cus;
+  auto md = get_xml_metadata(xml_data, xml_size);
+  md->check_kernels();
+  return md->cus;
 }
 
 std::vector<uint64_t>
@@ -892,188 +1106,62 @@ get_aie_partition(const axlf* top)
 size_t
 get_kernel_freq(const axlf* top)
 {
-  constexpr size_t default_kernel_clk_freq = 100;
-  size_t kernel_clk_freq = default_kernel_clk_freq;
-  auto xml = get_xml_section(top);
-
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml.first,xml.second);
-  pt::read_xml(xml_stream,xml_project);
-
-  auto clock_child = xml_project.get_child_optional("project.platform.device.core.kernelClocks");
-
-  if (clock_child) { // check whether kernelClocks field exists or not
-    for (auto& xml_clock : xml_project.get_child("project.platform.device.core.kernelClocks")) {
-      if (xml_clock.first != "clock")
-        continue;
-      auto port = xml_clock.second.get<std::string>("<xmlattr>.port","");
-      auto freq = xml_clock.second.get<std::string>("<xmlattr>.frequency","100");
-      //clock is always represented in units in XML
-      auto units = "MHz";
-      size_t found = freq.find(units);
-
-      //remove the units from the string
-      if (found != std::string::npos)
-        freq = freq.substr(0,found);
-
-      if(!freq.empty() && port == "KERNEL_CLK")
-        kernel_clk_freq = convert(freq);
-    }
-  }
-
-  return kernel_clk_freq;
+  return get_xml_metadata(top)->kernel_freq;
 }
 
 std::vector<kernel_argument>
 get_kernel_arguments(const char* xml_data, size_t xml_size, const std::string& kname)
 {
-  std::vector<kernel_argument> args;
-
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-    if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
-      continue;
-
-    auto pwmap = get_portname_width_map(xml_kernel.second);
-
-    for (auto& xml_arg : xml_kernel.second) {
-      if (xml_arg.first != "arg")
-        continue;
-
-      std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
-      size_t index = id.empty() ? kernel_argument::no_index : convert(id);
-
-      std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
-      auto itr = pwmap.find(port);
-      size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
-
-      args.emplace_back(kernel_argument{
-          xml_arg.second.get<std::string>("<xmlattr>.name")
-         ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
-         ,port
-         ,pwidth
-         ,index
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.offset"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.size"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
-         ,0  // fa_desc_offset post computed if necessary
-         ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
-         ,kernel_argument::direction(kernel_argument::direction::input)
-      });
-    }
-
-    // stable sort to preserve order of multi-component arguments
-    // for example global_size, local_size, etc.
-    std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
-
-    // merge args with same index
-    merge_args(args);
-
-    break;
-  }
-  return args;
+  auto md = get_xml_metadata(xml_data, xml_size);
+  auto kernel = md->find_kernel(kname);
+  return kernel ? kernel->args : std::vector<kernel_argument>{};
 }
 
 std::vector<kernel_argument>
 get_kernel_arguments(const axlf* top, const std::string& kname)
 {
-  auto xml = get_xml_section(top);
-  return get_kernel_arguments(xml.first, xml.second, kname);
+  auto md = get_xml_metadata(top);
+  auto kernel = md->find_kernel(kname);
+  return kernel ? kernel->args : std::vector<kernel_argument>{};
 }
 
 kernel_properties
 get_kernel_properties(const char* xml_data, size_t xml_size, const std::string& kname)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-    if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
-      continue;
-
-    // Determine features
-    auto mailbox = convert_to_mailbox_type(xml_kernel.second.get<std::string>("<xmlattr>.mailbox", "none"));
-    if (mailbox == kernel_properties::mailbox_type::none)
-      mailbox = get_mailbox_from_ini(kname);
-    auto restart = convert(xml_kernel.second.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
-    if (restart == 0)
-      restart = get_restart_from_ini(kname);
-    auto sw_reset = to_bool(xml_kernel.second.get<std::string>("<xmlattr>.swReset", "false"));
-    if (!sw_reset)
-      sw_reset = get_sw_reset_from_ini(kname);
-
-    auto functional = get_functional(xml_kernel.second, "extended-data");
-    auto kernel_id = get_kernel_id(xml_kernel.second, "extended-data");
-
-    return kernel_properties
-      { kname
-      , to_kernel_type(xml_kernel.second.get<std::string>("<xmlattr>.type", "pl"))
-      , restart
-      , mailbox
-      , get_address_range(xml_kernel.second)
-      , sw_reset
-      , functional
-      , kernel_id
-
-      , convert(xml_kernel.second.get<std::string>("<xmlattr>.workGroupSize", "0"))
-      , get_xyz(xml_kernel.second, "compileWorkGroupSize")
-      , get_xyz(xml_kernel.second, "maxWorkGroupSize")
-      , get_stringtable(xml_kernel.second) };
-
-  }
-
-  return kernel_properties{};
+  auto md = get_xml_metadata(xml_data, xml_size);
+  auto kernel = md->find_kernel(kname);
+  return kernel ? kernel->properties : kernel_properties{};
 }
 
 kernel_properties
 get_kernel_properties(const axlf* top, const std::string& kname)
 {
-  auto xml = get_xml_section(top);
-  return get_kernel_properties(xml.first, xml.second, kname);
+  auto md = get_xml_metadata(top);
+  auto kernel = md->find_kernel(kname);
+  return kernel ? kernel->properties : kernel_properties{};
 }
 
 std::vector<std::string>
 get_kernel_names(const char *xml_data, size_t xml_size)
 {
-  std::vector<std::string> names;
-
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-
-    names.push_back(xml_kernel.second.get<std::string>("<xmlattr>.name"));
-  }
+  auto md = get_xml_metadata(xml_data, xml_size);
+  if (!md->core_error.empty())
+    throw std::runtime_error(md->core_error);
 
-  return names;
+  return md->kernel_names;
 }
 
-std::vector<kernel_object>
-get_kernels(const char* xml_data, size_t xml_size)
+static std::vector<kernel_object>
+get_kernels(const xml_metadata& md)
 {
+  md.check_kernels();
   std::vector<kernel_object> kernels;
-
-  auto knames = get_kernel_names(xml_data, xml_size);
-  for (auto& kname : get_kernel_names(xml_data, xml_size)) {
-    auto kprop = get_kernel_properties(xml_data, xml_size, kname);
+  kernels.reserve(md.kernels.size());
+  for (const auto& kernel : md.kernels) {
+    const auto& kprop = kernel.properties;
     kernels.emplace_back(kernel_object{
-        kname
-       ,get_kernel_arguments(xml_data, xml_size, kname)
+        kprop.name
+       ,kernel.args
        ,kprop.address_range
        ,kprop.sw_reset
     });
@@ -1082,11 +1170,16 @@ get_kernels(const char* xml_data, size_t xml_size)
   return kernels;
 }
 
+std::vector<kernel_object>
+get_kernels(const char* xml_data, size_t xml_size)
+{
+  return get_kernels(*get_xml_metadata(xml_data, xml_size));
+}
+
 std::vector<kernel_object>
 get_kernels(const axlf* top)
 {
-  auto xml = get_xml_section(top);
-  return get_kernels(xml.first, xml.second);
+  return get_kernels(*get_xml_metadata(top));
 }
 
 // AIE only xclbin has LOAD_AIE action mask
@@ -1110,20 +1203,14 @@ get_vbnv(const axlf* top)
 std::string
 get_project_name(const char* xml_data, size_t xml_size)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  return xml_project.get<std::string>("project.<xmlattr>.name","");
+  return get_xml_metadata(xml_data, xml_size)->project_name;
 }
 
 std::string
 get_project_name(const axlf* top)
 {
   try {
-    auto xml = get_xml_section(top);
-    return get_project_name(xml.first, xml.second);
+    return get_xml_metadata(top)->project_name;
   }
   catch (const std::exception&) {
     return "";
@@ -1133,12 +1220,7 @@ get_project_name(const axlf* top)
 std::string
 get_fpga_device_name(const char* xml_data, size_t xml_size)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  return xml_project.get<std::string>("project.platform.device.<xmlattr>.fpgaDevice","");
+  return get_xml_metadata(xml_data, xml_size)->fpga_device_name;
 }
 
 }} // xclbin, xrt_core
@@ -24,6 +24,7 @@
 #include <array>
 #include <limits>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -81,6 +82,69 @@ struct kernel_object
   bool sw_reset;
 };
 
+// struct xml_metadata - index of xclbin EMBEDDED_METADATA
+//
+// The index is built in a single pass over the XML meta data and
+// serves all the kernel, argument, and cu accessors below that
+// otherwise would parse the XML for every call.
+//
+// @kernels: kernel properties and arguments in order of XML
+// @kernel_index: kernel name to index in kernels
+// @kernel_names: names of all kernels in order of XML, also malformed
+// @cus: sorted cu base addresses per addrRemap entries
+// @max_cu_size: max register map size of all kernels
+// @max_cu_size_error: error if some argument exceeds address range
+// @kernel_freq: frequency of KERNEL_CLK in MHz
+// @core_error: error if XML has no kernel section
+// @kernel_errors: kernel name to error if kernel meta data is malformed
+//
+// Errors from parsing kernel meta data are thrown by the accessors of
+// kernel meta data only.  Project name, device name, and kernel clock
+// are available regardless.
+struct xml_metadata
+{
+  struct kernel
+  {
+    kernel_properties properties;
+    std::vector<kernel_argument> args;
+  };
+
+  std::vector<kernel> kernels;
+  std::map<std::string, size_t> kernel_index;
+  std::vector<std::string> kernel_names;
+  std::vector<uint64_t> cus;
+  size_t max_cu_size = 0;
+  std::string max_cu_size_error;
+  size_t kernel_freq = 100; // NOLINT, default kernel clock
+  std::string project_name;
+  std::string fpga_device_name;
+  std::string core_error;
+  std::map<std::string, std::string> kernel_errors;
+
+  // Throw if the meta data of some kernel could not be parsed
+  void
+  check_kernels() const
+  {
+    if (!core_error.empty())
+      throw std::runtime_error(core_error);
+    if (!kernel_errors.empty())
+      throw std::runtime_error((*kernel_errors.begin()).second);
+  }
+
+  // Find kernel by name, throws if the kernel could not be parsed
+  const kernel*
+  find_kernel(const std::string& kname) const
+  {
+    if (!core_error.empty())
+      throw std::runtime_error(core_error);
+    if (auto eitr = kernel_errors.find(kname); eitr != kernel_errors.end())
+      throw std::runtime_error((*eitr).second);
+
+    auto itr = kernel_index.find(kname);
+    return (itr != kernel_index.end()) ? &kernels[(*itr).second] : nullptr;
+  }
+};
+
 // struct softkernel_object - wrapper for a soft kernel object
 //
 // @ninst: number of instances
@@ -201,6 +265,29 @@ address_to_memidx(const mem_topology* mem, uint64_t address);
 std::map<std::string, cuidx_type>
 get_cu_indices(const ip_layout* ip_layout);
 
+/**
+ * get_xml_metadata() - Parse XML meta data into an index
+ *
+ * @xml_data: XML metadata from xclbin
+ * @xml_size: Size of XML metadata from xclbin
+ */
+XRT_CORE_COMMON_EXPORT
+std::shared_ptr<const xml_metadata>
+get_xml_metadata(const char* xml_data, size_t xml_size);
+
+/**
+ * get_xml_metadata() - Get index of XML meta data of an xclbin
+ *
+ * @top: Full axlf
+ *
+ * The index is cached by xclbin uuid and XML section and is shared
+ * between all callers for as long as some caller holds on to it.
+ * Xclbins with a null uuid are not cached.
+ */
+XRT_CORE_COMMON_EXPORT
+std::shared_ptr<const xml_metadata>
+get_xml_metadata(const axlf* top);
+
 /**
  * get_max_cu_size() - Compute max register map size of CUs in xclbin
  */
@@ -15,7 +15,7 @@
 
 #include "core/edge/common/aie_parser.h"
 
-#include "core/common/bo_cache.h"
+#include "core/common/exec_buffer_pool.h"
 #include "core/common/config_reader.h"
 #include "core/common/config_reader.h"
 #include "core/common/error.h"
@@ -123,7 +123,6 @@ shim(unsigned index)
   mKernelFD = open(zocl_drm_device.c_str(), O_RDWR);
   // Validity of mKernelFD is checked using handleCheck in every shim function
 
-  mCmdBOCache = std::make_unique<xrt_core::bo_cache>(this, xrt_core::config::get_cmdbo_cache());
   mDev = zynq_device::get_dev();
 }
 
@@ -137,9 +136,9 @@ shim::
   // library before the device is closed (when profiling is enabled).
   xdp::finish_flush_device(this);
 
-  // The BO cache unmaps and releases all execbo, but this must
-  // be done before the device (mKernelFD) is closed.
-  mCmdBOCache.reset(nullptr);
+  // The exec buffer pool unmaps and releases all execbo, but this
+  // must be done before the device (mKernelFD) is closed.
+  mCoreDevice->clear_exec_buffer_pool();
 
   if (mKernelFD > 0) {
     close(mKernelFD);
@@ -465,14 +464,14 @@ xclCopyBO(unsigned int dst_boHandle, unsigned int src_boHandle, size_t size,
 {
   int ret = -EOPNOTSUPP;
 #ifdef __aarch64__
-  auto bo = mCmdBOCache->alloc<ert_start_copybo_cmd>();
-  ert_fill_copybo_cmd(bo.second, src_boHandle, dst_boHandle,
+  auto bo = mCoreDevice->get_exec_buffer_pool().alloc<ert_start_copybo_cmd>(sizeof(ert_start_copybo_cmd));
+  ert_fill_copybo_cmd(bo.cmd, src_boHandle, dst_boHandle,
                       src_offset, dst_offset, size);
 
-  auto boh = static_cast<buffer_object*>(bo.first.get());
+  auto boh = static_cast<buffer_object*>(bo.bo.get());
   ret = xclExecBuf(boh->get_handle());
   if (ret) {
-    mCmdBOCache->release(std::move(bo));
+    mCoreDevice->get_exec_buffer_pool().release(std::move(bo));
     return ret;
   }
 
@@ -481,13 +480,13 @@ xclCopyBO(unsigned int dst_boHandle, unsigned int src_boHandle, size_t size,
     if (ret == -1)
       break;
   }
-  while (bo.second->state < ERT_CMD_STATE_COMPLETED);
+  while (bo.cmd->state < ERT_CMD_STATE_COMPLETED);
 
   ret = (ret == -1) ? -errno : 0;
-  if (!ret && (bo.second->state != ERT_CMD_STATE_COMPLETED))
+  if (!ret && (bo.cmd->state != ERT_CMD_STATE_COMPLETED))
     ret = -EINVAL;
 
-  mCmdBOCache->release(std::move(bo));
+  mCoreDevice->get_exec_buffer_pool().release(std::move(bo));
 #endif
   xclLog(XRT_INFO, "%s: return %d", __func__, ret);
   return ret;
@@ -12,7 +12,6 @@
 
 #include "core/common/system.h"
 #include "core/common/device.h"
-#include "core/common/bo_cache.h"
 #include "core/common/xrt_profiling.h"
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/hwctx_handle.h"
@@ -365,7 +364,6 @@ private:
   std::ifstream mVBNV;
   int mKernelFD;
   static std::map<uint64_t, uint32_t *> mKernelControl;
-  std::unique_ptr<xrt_core::bo_cache> mCmdBOCache;
   zynq_device *mDev = nullptr;
   size_t mKernelClockFreq;
   bool hw_context_enable = false;
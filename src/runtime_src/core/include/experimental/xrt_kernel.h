@@ -12,11 +12,70 @@
 # include "xrt/detail/pimpl.h"
 # include <chrono>
 # include <condition_variable>
+# include <vector>
 #endif
 
 #ifdef __cplusplus
 namespace xrt {
 
+/**
+ * enum class wait_policy - How a host thread waits for run completion
+ *
+ * @var inherit
+ *  Use the policy of the enclosing scope.  A run object inherits the
+ *  policy of its hw_context, a hw_context inherits the policy
+ *  specified in xrt.ini (Runtime.wait_policy).
+ * @var block
+ *  Block the waiting thread until the command completes.  This is
+ *  the default policy and has the lowest CPU usage.
+ * @var spin_then_block
+ *  Busy poll for command completion for a bounded time before
+ *  blocking.  The spin time adapts to observed completion times of
+ *  the run object and is capped by xrt.ini (Runtime.wait_spin_max_us).
+ *  Reduces wakeup latency of short running kernels.
+ * @var busy_poll
+ *  Busy poll for command completion without ever blocking.  Lowest
+ *  latency at the expense of one fully utilized CPU core per waiting
+ *  thread.
+ *
+ * The policy affects waiting on run objects without completion
+ * callbacks.  For run objects with callbacks, completion is detected
+ * by the XRT command monitor, spinning only avoids the cost of
+ * blocking the waiting thread.
+ */
+enum class wait_policy : uint8_t
+{
+  inherit,
+  block,
+  spin_then_block,
+  busy_poll
+};
+
+/**
+ * set_wait_policy() - Set wait policy for a run object
+ *
+ * @param run
+ *  Run object to set wait policy for
+ * @param policy
+ *  Policy to use in subsequent calls to xrt::run::wait()
+ */
+XRT_API_EXPORT
+void
+set_wait_policy(const xrt::run& run, wait_policy policy);
+
+/**
+ * set_wait_policy() - Set wait policy for a hardware context
+ *
+ * @param hwctx
+ *  Hardware context to set wait policy for
+ * @param policy
+ *  Policy used by run objects of kernels in the hardware context,
+ *  unless overridden per run object.
+ */
+XRT_API_EXPORT
+void
+set_wait_policy(const xrt::hw_context& hwctx, wait_policy policy);
+
 /**
  * class runlist - A class to manage a list of xrt::run objects
  *
@@ -239,6 +298,34 @@ public:
   reset();
 };
 
+/**
+ * start() - Start a batch of independent run objects
+ *
+ * @param runs
+ *  Run objects to start.  The run objects can be from different
+ *  kernels, but must not be part of a runlist.
+ *
+ * @details
+ * The run objects are submitted for execution in the order they are
+ * listed.  Unlike a runlist, the run objects are independent of each
+ * other and complete individually, each run object must be waited on
+ * or polled as if it was started with `xrt::run::start()`.
+ *
+ * All run objects that share a hardware queue are submitted to the
+ * driver as one batch and the XRT command monitor is notified at
+ * most once per batch, which reduces the host side overhead of
+ * starting many run objects.
+ *
+ * All run objects are validated prior to submitting any, a run object
+ * that is already running or that is part of a runlist results in an
+ * exception without any run object being started.  If submission
+ * fails, run objects not yet submitted are left in their prior state
+ * and the error is thrown.
+ */
+XRT_API_EXPORT
+void
+start(const std::vector<xrt::run>& runs);
+
 } // namespace xrt
 
 #endif // __cplusplus
@@ -192,6 +192,21 @@ public:
   mark_time_ns(const std::chrono::nanoseconds& time_ns, const char* label = nullptr);
 };
 
+/**
+ * dump_flight_recorder() - Write the recent Native XRT API calls kept by
+ * the flight recorder to a trace file
+ *
+ * @param reason
+ * An optional description of why the dump was requested, written in the
+ * header of the trace file
+ *
+ * Does nothing unless the flight recorder is enabled with
+ * Debug.flight_recorder in xrt.ini.
+ */
+XCL_DRIVER_DLLESPEC
+void
+dump_flight_recorder(const char* reason = nullptr);
+
 } // end namespace profile
 } // end namespace xrt
 
@@ -246,6 +261,18 @@ XCL_DRIVER_DLLESPEC
 void
 xrtUEMarkTimeNs(unsigned long long int time_ns, const char* label);
 
+/**
+ * xrtFlightRecorderDump() - Write the recent Native XRT API calls kept
+ * by the flight recorder to a trace file
+ *
+ * @reason:  An optional description of why the dump was requested
+ * Return:   none
+ *
+ */
+XCL_DRIVER_DLLESPEC
+void
+xrtFlightRecorderDump(const char* reason);
+
 #ifdef __cplusplus
 }
 #endif
@@ -975,6 +975,31 @@ public:
   XRT_API_EXPORT
   xclbin
   load(const std::string& name) const;
+
+  /**
+   * load() - Load xclbin with specified uuid from repository
+   *
+   * @uuid:  UUID of xclbin to load
+   *
+   * The xclbin is found through the repository catalog, which
+   * is built on first use and persisted between processes.
+   * Only the matching xclbin file is opened.
+   */
+  XRT_API_EXPORT
+  xclbin
+  load(const xrt::uuid& uuid) const;
+
+  /**
+   * find_kernel() - Find xclbins with a kernel
+   *
+   * @name:  Name of kernel
+   * Return: Paths to xclbin files in repository with the kernel
+   *
+   * The xclbins are found through the repository catalog.
+   */
+  XRT_API_EXPORT
+  std::vector<std::string>
+  find_kernel(const std::string& name) const;
 };
 
 } // namespace xrt
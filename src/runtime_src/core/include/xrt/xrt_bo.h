@@ -11,6 +11,7 @@
 
 #ifdef __cplusplus
 # include <memory>
+# include <vector>
 #endif
 
 /**
@@ -67,6 +68,7 @@ struct pid_type { pid_t pid; };
 class device;
 class hw_context;
 class bo_impl;
+class bo_pool;
 class bo
 {
 public:
@@ -329,6 +331,41 @@ public:
   XCL_DRIVER_DLLESPEC
   bo(const xrt::hw_context& hwctx, size_t sz, memory_group grp);
 
+  /**
+   * bo() - Constructor for buffer object from a buffer pool
+   *
+   * @param pool
+   *  The buffer pool to allocate this buffer from
+   * @param sz
+   *  Size of buffer
+   * @param flags
+   *  Specify type of buffer
+   * @param grp
+   *  Device memory group to allocate buffer in
+   *
+   * The buffer is allocated in the device or hardware context of the
+   * pool.  A released buffer of same flags, memory group, and size
+   * class is reused if the pool has one, otherwise a new buffer is
+   * allocated.  The buffer is returned to the pool when the last
+   * reference to it is destructed.  The content of a reused buffer
+   * is undefined.
+   */
+  XCL_DRIVER_DLLESPEC
+  bo(const xrt::bo_pool& pool, size_t sz, bo::flags flags, memory_group grp);
+
+  /**
+   * bo() - Constructor for buffer object from a buffer pool, default flags
+   *
+   * @param pool
+   *  The buffer pool to allocate this buffer from
+   * @param sz
+   *  Size of buffer
+   * @param grp
+   *  Device memory group to allocate buffer in
+   */
+  XCL_DRIVER_DLLESPEC
+  bo(const xrt::bo_pool& pool, size_t sz, memory_group grp);
+
   /// @cond
   // Deprecated constructor, use xrt::device variant
   XCL_DRIVER_DLLESPEC
@@ -533,6 +570,12 @@ public:
    *
    * Asynchronously transfer specified size bytes of buffer
    * starting at specified offset.
+   *
+   * The transfer is done by a per device pool of transfer threads
+   * with Runtime.bo_async_threads threads per direction.  Wait for
+   * completion with the returned handle, or pass it to
+   * xrt::run::submit_wait().  Destructing the last copy of the
+   * handle waits for the transfer to complete.
    */
   XCL_DRIVER_DLLESPEC
   async_handle
@@ -750,6 +793,160 @@ private:
   std::shared_ptr<bo_impl> handle;
 };
 
+/*!
+ * @class bo_pool
+ *
+ * @brief
+ * xrt::bo_pool is a cache of buffer objects for reuse
+ *
+ * @details
+ * Allocating a buffer object is a driver round trip and, for most
+ * buffer types, an allocation and mapping of host memory.  Buffers
+ * allocated from a pool are returned to the pool when released and
+ * are reused by later allocations of same flags, memory group, and
+ * size class, which avoids this overhead for short lived buffers.
+ *
+ * The pool caches at most high water bytes of released buffers.
+ * Buffers released to a full pool are freed.  Buffers that have been
+ * exported are never reused.
+ *
+ * The pool is opt-in, only buffers constructed from a pool are
+ * cached.  Buffers allocated from a pool can outlive the pool.
+ */
+class bo_pool_impl;
+class bo_pool : public detail::pimpl<bo_pool_impl>
+{
+public:
+  /**
+   * struct stats - Pool statistics
+   *
+   * @var hits
+   *  Buffers allocated by reusing a cached buffer
+   * @var misses
+   *  Buffers that required a new allocation
+   * @var evictions
+   *  Released buffers that were freed because the pool was full
+   * @var trimmed
+   *  Cached buffers freed by trim()
+   * @var cached
+   *  Number of buffers currently cached
+   * @var cached_bytes
+   *  Capacity of buffers currently cached
+   * @var peak_bytes
+   *  Max capacity of buffers cached at any time
+   */
+  struct stats
+  {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t trimmed;
+    size_t cached;
+    size_t cached_bytes;
+    size_t peak_bytes;
+  };
+
+  /**
+   * bo_pool() - Construct empty pool object
+   */
+  bo_pool() = default;
+
+  /**
+   * bo_pool() - Constructor for pool of device buffers
+   *
+   * @param device
+   *  The device on which to allocate buffers
+   * @param high_water
+   *  Max number of bytes of released buffers to cache
+   */
+  XCL_DRIVER_DLLESPEC
+  bo_pool(const xrt::device& device, size_t high_water);
+
+  /**
+   * bo_pool() - Constructor for pool of hardware context buffers
+   *
+   * @param hwctx
+   *  The hardware context in which to allocate buffers
+   * @param high_water
+   *  Max number of bytes of released buffers to cache
+   */
+  XCL_DRIVER_DLLESPEC
+  bo_pool(const xrt::hw_context& hwctx, size_t high_water);
+
+  /**
+   * trim() - Free cached buffers
+   *
+   * @param bytes
+   *  Max number of bytes to keep cached
+   *
+   * Largest buffers are freed first.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  trim(size_t bytes);
+
+  /**
+   * trim() - Free all cached buffers
+   */
+  void
+  trim()
+  {
+    trim(0);
+  }
+
+  /**
+   * get_stats() - Get pool statistics
+   */
+  XCL_DRIVER_DLLESPEC
+  stats
+  get_stats() const;
+};
+
+/**
+ * struct bo_sync_range - A range of a buffer object to synchronize
+ *
+ * @var bo
+ *  Buffer object, can be a sub-buffer
+ * @var offset
+ *  Offset within the buffer object
+ * @var size
+ *  Size of the range
+ * @var dir
+ *  To device or from device
+ */
+struct bo_sync_range
+{
+  xrt::bo bo;
+  size_t offset;
+  size_t size;
+  xclBOSyncDirection dir;
+};
+
+/**
+ * sync() - Synchronize a batch of buffer ranges with device side
+ *
+ * @param ranges
+ *  Ranges to synchronize.  Ranges of zero size are ignored.
+ * @return
+ *  Number of combined ranges, each synchronized with one sync of
+ *  its buffer object
+ *
+ * @details
+ * Ranges of sub-buffers are resolved to ranges of the buffer they
+ * were created from.  Ranges of the same buffer and direction that
+ * overlap or are adjacent are combined, so each combined range is
+ * synchronized with one driver call.  Gaps between ranges are never
+ * synchronized.
+ *
+ * The ranges are not synchronized in the order they are listed.
+ * Ranges of one buffer that overlap must have the same direction.
+ * Throws if a range exceeds its buffer object, in which case no
+ * range is synchronized.
+ */
+XCL_DRIVER_DLLESPEC
+size_t
+sync(const std::vector<bo_sync_range>& ranges);
+
 } // namespace xrt
 
 /// @cond
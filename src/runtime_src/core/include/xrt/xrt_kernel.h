@@ -497,6 +497,22 @@ public:
   submit_signal(const xrt::fence& fence);
   ///@endcond
 
+  /**
+   * submit_wait() - Make next start wait for a buffer transfer
+   *
+   * @param transfer
+   *  Handle of a transfer started with xrt::bo::async()
+   *
+   * The next start() of this run object waits for the transfer to
+   * complete before the run is submitted to the device.  This
+   * allows staging of input buffers while a previous run is
+   * executing.  If the transfer failed, start() throws the
+   * transfer's exception.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  submit_wait(const xrt::bo::async_handle& transfer);
+
   /**
    * set_arg - set named argument
    *
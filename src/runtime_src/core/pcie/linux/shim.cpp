@@ -19,7 +19,7 @@
 #include "core/include/xdp/trace.h"
 #include "core/include/experimental/xrt_hw_context.h"
 
-#include "core/common/bo_cache.h"
+#include "core/common/exec_buffer_pool.h"
 #include "core/common/config_reader.h"
 #include "core/common/message.h"
 #include "core/common/query_requests.h"
@@ -759,7 +759,6 @@ shim(unsigned index)
   , mAccelProfilingNumberSlots(0)
   , mStallProfilingNumberSlots(0)
   , mStreamProfilingNumberSlots(0)
-  , mCmdBOCache(nullptr)
   , mCuMaps{128, {nullptr, 0, 0, 0}}
 {
   init(index);
@@ -799,7 +798,6 @@ int shim::dev_init()
     // We're good now.
     mDev = dev;
     (void) xclGetDeviceInfo2(&mDeviceInfo);
-    mCmdBOCache = std::make_unique<xrt_core::bo_cache>(this, xrt_core::config::get_cmdbo_cache());
 
     mStreamHandle = mDev->open("dma.qdma", O_RDWR | O_SYNC);
     memset(&mAioContext, 0, sizeof(mAioContext));
@@ -857,9 +855,9 @@ shim::~shim()
     // library before the device is closed (when profiling is enabled).
     xdp::finish_flush_device(this);
 
-    // The BO cache unmaps and releases all execbo, but this must
-    // be done before the device is closed.
-    mCmdBOCache.reset(nullptr);
+    // The exec buffer pool unmaps and releases all execbo, but this
+    // must be done before the device is closed.
+    mCoreDevice->clear_exec_buffer_pool();
 
     dev_fini();
 
@@ -1079,14 +1077,14 @@ execbufCopyBO(unsigned int dst_bo_handle,
               unsigned int src_bo_handle, size_t size, size_t dst_offset,
               size_t src_offset)
 {
-  auto bo = mCmdBOCache->alloc<ert_start_copybo_cmd>();
-  ert_fill_copybo_cmd(bo.second, src_bo_handle, dst_bo_handle,
+  auto bo = mCoreDevice->get_exec_buffer_pool().alloc<ert_start_copybo_cmd>(sizeof(ert_start_copybo_cmd));
+  ert_fill_copybo_cmd(bo.cmd, src_bo_handle, dst_bo_handle,
                       src_offset, dst_offset, size);
 
-  auto boh = static_cast<xrt_shim::buffer_object*>(bo.first.get());
+  auto boh = static_cast<xrt_shim::buffer_object*>(bo.bo.get());
   int ret = xclExecBuf(boh->get_handle());
   if (ret) {
-    mCmdBOCache->release<ert_start_copybo_cmd>(std::move(bo));
+    mCoreDevice->get_exec_buffer_pool().release(std::move(bo));
     return ret;
   }
 
@@ -1095,13 +1093,13 @@ execbufCopyBO(unsigned int dst_bo_handle,
     if (ret == -1)
       break;
   }
-  while (bo.second->state < ERT_CMD_STATE_COMPLETED);
+  while (bo.cmd->state < ERT_CMD_STATE_COMPLETED);
 
   ret = (ret == -1) ? -errno : 0;
-  if (!ret && (bo.second->state != ERT_CMD_STATE_COMPLETED))
+  if (!ret && (bo.cmd->state != ERT_CMD_STATE_COMPLETED))
     ret = -EINVAL;
 
-  mCmdBOCache->release<ert_start_copybo_cmd>(std::move(bo));
+  mCoreDevice->get_exec_buffer_pool().release(std::move(bo));
   return ret;
 }
 
@@ -1136,14 +1134,14 @@ int
 shim::
 xclUpdateSchedulerStat()
 {
-  auto bo = mCmdBOCache->alloc<ert_packet>();
-  bo.second->opcode = ERT_CU_STAT;
-  bo.second->type = ERT_CTRL;
+  auto bo = mCoreDevice->get_exec_buffer_pool().alloc<ert_packet>(sizeof(ert_packet));
+  bo.cmd->opcode = ERT_CU_STAT;
+  bo.cmd->type = ERT_CTRL;
 
-  auto boh = static_cast<xrt_shim::buffer_object*>(bo.first.get());
+  auto boh = static_cast<xrt_shim::buffer_object*>(bo.bo.get());
   int ret = xclExecBuf(boh->get_handle());
   if (ret) {
-    mCmdBOCache->release(std::move(bo));
+    mCoreDevice->get_exec_buffer_pool().release(std::move(bo));
     return ret;
   }
 
@@ -1151,13 +1149,13 @@ xclUpdateSchedulerStat()
     ret = xclExecWait(1000);
     if (ret == -1)
       break;
-  } while (bo.second->state < ERT_CMD_STATE_COMPLETED);
+  } while (bo.cmd->state < ERT_CMD_STATE_COMPLETED);
 
   ret = (ret == -1) ? -errno : 0;
-  if (!ret && (bo.second->state != ERT_CMD_STATE_COMPLETED))
+  if (!ret && (bo.cmd->state != ERT_CMD_STATE_COMPLETED))
     ret = -EINVAL;
 
-  mCmdBOCache->release(move(bo));
+  mCoreDevice->get_exec_buffer_pool().release(std::move(bo));
   return ret;
 }
 
@@ -7,7 +7,6 @@
 #include "pcidev.h"
 #include "xclhal2.h"
 
-#include "core/common/bo_cache.h"
 #include "core/common/device.h"
 #include "core/common/system.h"
 #include "core/common/xrt_profiling.h"
@@ -179,7 +178,6 @@ private:
   uint32_t mStallProfilingNumberSlots;
   uint32_t mStreamProfilingNumberSlots;
   std::string mDevUserName;
-  std::unique_ptr<xrt_core::bo_cache> mCmdBOCache;
 
   /*
    * Mapped CU register space for xclRegRead/Write(). We support at most
@@ -17,17 +17,30 @@
 #include "core/common/device.h"
 #include "core/common/message.h"
 #include "core/common/system.h"
-#include "core/common/task.h"
 #include "core/common/thread.h"
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/hwctx_handle.h"
 
 #include "core/common/api/hw_context_int.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <map>
 #include <mutex>
+#include <queue>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace { // private implementation details
 
@@ -101,6 +114,21 @@ map(unsigned int handle)
   return bo->hbuf;
 }
 
+// Map multiple handles while holding the lock once.  Handles that
+// have been freed map to nullptr.
+std::vector<void*>
+map(const std::vector<unsigned int>& handles)
+{
+  std::vector<void*> hbufs;
+  hbufs.reserve(handles.size());
+  std::lock_guard<std::mutex> lk(mutex);
+  for (auto handle : handles) {
+    auto itr = h2b.find(handle);
+    hbufs.push_back(itr == h2b.end() ? nullptr : (*itr).second->hbuf);
+  }
+  return hbufs;
+}
+
 void
 free(unsigned int handle)
 {
@@ -243,6 +271,15 @@ public:
     }
   }
 
+  // name of cu at index, empty if no such cu
+  std::string
+  get_cu_name(uint32_t cuidx)
+  {
+    std::lock_guard lk(m_mutex);
+    auto cu_itr = m_idx2cu.find(cuidx);
+    return (cu_itr == m_idx2cu.end()) ? std::string{} : (*cu_itr).second.name;
+  }
+
   xrt_core::query::kds_cu_info::result_type
   kds_cu_info()
   {
@@ -283,83 +320,382 @@ public:
 static std::vector<std::shared_ptr<pl::device>> s_devices;
 
 
-// Simulate asynchronous command completion.
+// Simulate asynchronous command execution.
+//
+// The command engine models a device with a number of compute units
+// and per kernel execution latency distributions.  A submitted
+// command is scheduled on the compute unit that becomes available
+// first, its completion deadline is a latency sampled from the
+// distribution configured for the kernel of the command.  Commands
+// queue up in virtual time when all compute units are busy.
 //
-// Command handles are added to a producer/consumer queue A worker
-// thread pretends to run the command and marks it complete only if
-// the command was enqueue some constant time before now.
+// A completer thread sleeps until the earliest deadline, marks all
+// commands that are due as complete, and signals an eventfd which is
+// polled by exec_wait.  Neither the completer nor the waiting host
+// thread burn a core while commands are in flight, the completer
+// spins only for the last few microseconds before a deadline.
+//
+// Configuration in xrt.ini [Runtime]:
+//  noop_completion_delay_us: default fixed latency
+//  noop_latency:             per kernel latency distributions
+//  noop_cus:                 number of compute units, 0 is unlimited
+//  noop_queue_depth:         max commands in flight, 0 is unbounded
 namespace cmd {
 
-static unsigned int completion_delay_us = 0;
-static xrt_core::task::queue running_queue;
-static std::thread completer;
-static std::atomic<uint64_t> completion_count {0};
+using clock = std::chrono::steady_clock;
 
-struct cmd_type
+// Execution latency distribution, parameters are in us
+struct latency
 {
-  xclBufferHandle handle;
-  unsigned long queue_time;
-  cmd_type(xclBufferHandle h)
-    : handle(h), queue_time(xrt_core::time_ns())
-  {}
-};
+  enum class distribution { fixed, uniform, normal, exponential };
+  distribution dist = distribution::fixed;
+  double a = 0;
+  double b = 0;
 
-static void
-init()
-{
-  if ( (completion_delay_us = xrt_core::config::get_noop_completion_delay_us()) )
-    completer = std::move(xrt_core::thread(xrt_core::task::worker, std::ref(running_queue)));
-}
+  bool
+  is_zero() const
+  {
+    return dist == distribution::fixed && a == 0;
+  }
 
-static void
-stop()
-{
-  if (completion_delay_us) {
-    running_queue.stop();
-    completer.join();
+  clock::duration
+  sample(std::mt19937_64& rng) const
+  {
+    double us = a;
+    switch (dist) {
+    case distribution::fixed:
+      break;
+    case distribution::uniform:
+      us = std::uniform_real_distribution<double>(a, b)(rng);
+      break;
+    case distribution::normal:
+      us = std::normal_distribution<double>(a, b)(rng);
+      break;
+    case distribution::exponential:
+      us = std::exponential_distribution<double>(1.0 / a)(rng);
+      break;
+    }
+    using usec = std::chrono::duration<double, std::micro>;
+    return std::chrono::duration_cast<clock::duration>(usec(std::max(us, 0.0)));
+  }
+};
+
+// Parse <kernel>:<distribution>:<args>
+static std::pair<std::string, latency>
+parse_latency(const std::string& entry)
+{
+  std::vector<std::string> tokens;
+  std::stringstream ss(entry);
+  for (std::string token; std::getline(ss, token, ':');)
+    tokens.push_back(token);
+
+  if (tokens.size() < 3)
+    throw std::runtime_error("expected <kernel>:<distribution>:<args>");
+
+  std::vector<double> args;
+  std::transform(tokens.begin() + 2, tokens.end(), std::back_inserter(args),
+                 [](const std::string& arg) { return std::stod(arg); });
+  if (std::any_of(args.begin(), args.end(), [](double arg) { return arg < 0; }))
+    throw std::runtime_error("negative latency");
+
+  using distribution = latency::distribution;
+  const auto& dist = tokens[1];
+  latency lat;
+  if (dist == "fixed" && args.size() == 1)
+    lat = {distribution::fixed, args[0], 0};
+  else if (dist == "uniform" && args.size() == 2)
+    lat = {distribution::uniform, std::min(args[0], args[1]), std::max(args[0], args[1])};
+  else if (dist == "normal" && args.size() == 2) {
+    if (args[1] <= 0)
+      throw std::runtime_error("normal distribution needs a positive stddev");
+    lat = {distribution::normal, args[0], args[1]};
   }
+  else if (dist == "exponential" && args.size() == 1)
+    lat = {args[0] ? distribution::exponential : distribution::fixed, args[0], 0};
+  else
+    throw std::runtime_error("bad distribution '" + dist + "' or number of arguments");
+
+  return {tokens[0], lat};
 }
 
-static void
-wait()
+// Parse comma separated list of latency distributions
+static std::map<std::string, latency>
+parse_latencies(const std::string& spec)
 {
-  while (!completion_count) ;
-  --completion_count;
+  std::map<std::string, latency> latencies;
+  std::stringstream ss(spec);
+  for (std::string entry; std::getline(ss, entry, ',');) {
+    if (entry.empty())
+      continue;
+
+    try {
+      latencies.insert(parse_latency(entry));
+    }
+    catch (const std::exception& ex) {
+      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                              "Ignoring noop_latency '" + entry + "': " + ex.what());
+    }
+  }
+  return latencies;
 }
 
 static void
 mark_cmd_handle_complete(xclBufferHandle handle)
 {
-  //XRT_PRINTF("handle(%d) is complete\n", handle);
   auto hbuf = buffer::map(handle);
   auto cmd = reinterpret_cast<ert_packet*>(hbuf);
   cmd->state = ERT_CMD_STATE_COMPLETED;
-  ++completion_count;
 }
 
 static void
-mark_cmd_complete(cmd_type ct)
+mark_cmd_handles_complete(const std::vector<xclBufferHandle>& handles)
 {
-  while (xrt_core::time_ns() - ct.queue_time < completion_delay_us * 1000);
-  mark_cmd_handle_complete(ct.handle);
+  // Command buffers may have been freed while the command was
+  // pretending to run
+  for (auto hbuf : buffer::map(handles)) {
+    if (auto cmd = reinterpret_cast<ert_packet*>(hbuf))
+      cmd->state = ERT_CMD_STATE_COMPLETED;
+  }
 }
 
-static void
-add(xclBufferHandle handle)
+class engine
 {
-  if (completion_delay_us)
-    xrt_core::task::createF(running_queue, mark_cmd_complete, cmd_type(handle));
-  else
+  struct entry
+  {
+    clock::time_point deadline;
+    xclBufferHandle handle;
+
+    bool
+    operator>(const entry& rhs) const
+    {
+      return deadline > rhs.deadline;
+    }
+  };
+
+  // Sleep granularity is too coarse for short latencies, the
+  // completer spins when the earliest deadline is this close
+  static constexpr auto spin_threshold = std::chrono::microseconds(50);
+
+  pl::device* m_pldev;
+  std::map<std::string, latency> m_latencies; // kernel -> latency
+  latency m_default;
+  size_t m_queue_depth;
+  bool m_inline;     // complete commands when submitted
+
+  std::mutex m_mutex;
+  std::condition_variable m_work;   // completer waits for commands
+  std::condition_variable m_space;  // submitters wait for queue space
+  std::priority_queue<entry, std::vector<entry>, std::greater<>> m_running;
+  std::vector<clock::time_point> m_cu_free; // time when cu is available
+  std::mt19937_64 m_rng;
+  size_t m_inflight = 0;
+  bool m_stop = false;
+
+  int m_efd;   // eventfd signalled when commands complete
+  std::thread m_completer;
+
+  void
+  signal()
+  {
+    uint64_t one = 1;
+    auto bytes = ::write(m_efd, &one, sizeof(one));
+    (void) bytes;
+  }
+
+  // Latency distribution for kernel of command.  The kernel is
+  // identified by the first compute unit in the command's cu masks
+  const latency&
+  get_latency(xclBufferHandle handle)
+  {
+    if (m_latencies.empty())
+      return m_default;
+
+    auto cmd = reinterpret_cast<ert_start_kernel_cmd*>(buffer::map(handle));
+    if (cmd->type != ERT_CU)
+      return m_default;
+
+    const uint32_t* masks = &cmd->cu_mask;
+    for (uint32_t idx = 0; idx < 1u + cmd->extra_cu_masks; ++idx) {
+      if (!masks[idx])
+        continue;
+
+      auto cuidx = idx * 32 + __builtin_ctz(masks[idx]);
+      auto cuname = m_pldev->get_cu_name(cuidx);
+      auto itr = m_latencies.find(cuname.substr(0, cuname.find(':')));
+      return (itr == m_latencies.end()) ? m_default : (*itr).second;
+    }
+
+    return m_default;
+  }
+
+  // Schedule command on first available cu, must hold lock.
+  // Returns true if command has the earliest deadline
+  bool
+  schedule(xclBufferHandle handle, const latency& lat, clock::time_point now)
+  {
+    auto start = now;
+    auto cu = std::min_element(m_cu_free.begin(), m_cu_free.end());
+    if (cu != m_cu_free.end())
+      start = std::max(now, *cu);
+
+    auto deadline = start + lat.sample(m_rng);
+    if (cu != m_cu_free.end())
+      *cu = deadline;
+
+    auto earliest = m_running.empty() || deadline < m_running.top().deadline;
+    m_running.push({deadline, handle});
+    ++m_inflight;
+    return earliest;
+  }
+
+  void
+  schedule(const xclBufferHandle* handles, size_t count)
+  {
+    std::vector<const latency*> latencies;
+    latencies.reserve(count);
+    for (size_t idx = 0; idx < count; ++idx)
+      latencies.push_back(&get_latency(handles[idx]));
+
+    std::unique_lock lk(m_mutex);
+    bool notify = false;
+    for (size_t idx = 0; idx < count && !m_stop; ++idx) {
+      if (m_queue_depth && m_inflight >= m_queue_depth) {
+        // Completer must see already scheduled commands
+        m_work.notify_one();
+        notify = false;
+        m_space.wait(lk, [this] { return m_inflight < m_queue_depth || m_stop; });
+      }
+      notify |= schedule(handles[idx], *latencies[idx], clock::now());
+    }
+
+    if (notify)
+      m_work.notify_one();
+  }
+
+  void
+  complete()
+  {
+    std::vector<xclBufferHandle> done;
+    std::unique_lock lk(m_mutex);
+    while (!m_stop) {
+      if (m_running.empty()) {
+        m_work.wait(lk);
+        continue;
+      }
+
+      auto deadline = m_running.top().deadline;
+      auto now = clock::now();
+      if (deadline - now > spin_threshold) {
+        m_work.wait_until(lk, deadline - spin_threshold);
+        continue;
+      }
+
+      if (deadline > now) {
+        // Spin without lock, a new command may have an earlier deadline
+        lk.unlock();
+        while (clock::now() < deadline) ;
+        lk.lock();
+        continue;
+      }
+
+      while (!m_running.empty() && m_running.top().deadline <= now) {
+        done.push_back(m_running.top().handle);
+        m_running.pop();
+      }
+
+      lk.unlock();
+      mark_cmd_handles_complete(done);
+      signal();
+      lk.lock();
+
+      m_inflight -= done.size();
+      done.clear();
+      if (m_queue_depth)
+        m_space.notify_all();
+    }
+  }
+
+public:
+  explicit
+  engine(pl::device* pldev)
+    : m_pldev(pldev)
+    , m_latencies(parse_latencies(xrt_core::config::get_noop_latency()))
+    , m_default{latency::distribution::fixed, static_cast<double>(xrt_core::config::get_noop_completion_delay_us()), 0}
+    , m_queue_depth(xrt_core::config::get_noop_queue_depth())
+    , m_cu_free(xrt_core::config::get_noop_cus())
+    , m_rng(std::random_device{}())
+    , m_efd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+  {
+    if (m_efd < 0)
+      throw xrt_core::system_error(errno, "noop shim failed to create eventfd");
+
+    if (auto itr = m_latencies.find("default"); itr != m_latencies.end()) {
+      m_default = (*itr).second;
+      m_latencies.erase(itr);
+    }
+
+    m_inline = m_default.is_zero()
+      && std::all_of(m_latencies.begin(), m_latencies.end(),
+                     [](const auto& kl) { return kl.second.is_zero(); });
+
+    if (!m_inline)
+      m_completer = xrt_core::thread(&engine::complete, this);
+  }
+
+  ~engine()
+  {
+    if (m_completer.joinable()) {
+      {
+        std::lock_guard lk(m_mutex);
+        m_stop = true;
+      }
+      m_work.notify_all();
+      m_space.notify_all();
+      m_completer.join();
+    }
+    ::close(m_efd);
+  }
+
+  engine(const engine&) = delete;
+  engine& operator=(const engine&) = delete;
+
+  void
+  add(xclBufferHandle handle)
+  {
+    if (!m_inline)
+      return schedule(&handle, 1);
+
     mark_cmd_handle_complete(handle);
-}
+    signal();
+  }
 
-struct X
-{
-  X() { init(); }
-  ~X() { stop(); }
-};
+  void
+  add(const std::vector<xclBufferHandle>& handles)
+  {
+    if (!m_inline)
+      return schedule(handles.data(), handles.size());
 
-static X x;
+    mark_cmd_handles_complete(handles);
+    signal();
+  }
+
+  // Wait for command completion, returns 1 if some command completed
+  // since last call, 0 if timeout expired.
+  int
+  wait(int msec)
+  {
+    pollfd pfd {m_efd, POLLIN, 0};
+    auto ret = ::poll(&pfd, 1, msec);
+    if (ret <= 0)
+      return ret;
+
+    // Reset eventfd counter, nonblocking in case of racing waiters
+    uint64_t count = 0;
+    auto bytes = ::read(m_efd, &count, sizeof(count));
+    (void) bytes;
+    return 1;
+  }
+};
 
 } // cmd
 
@@ -370,8 +706,13 @@ struct shim
   unsigned int m_devidx;
   bool m_locked = false;
   pl::device* m_pldev;
+  std::unique_ptr<cmd::engine> m_cmd_engine;
   std::shared_ptr<xrt_core::device> m_core_device;
 
+  // Buffer sync accounting, reported when the shim is closed
+  std::atomic<uint64_t> m_sync_count {0};
+  std::atomic<uint64_t> m_sync_bytes {0};
+
   // Capture xclbins loaded using load_xclbin.
   // load_xclbin is legacy and creates a hw_context implicitly.  If an
   // xclbin is loaded with load_xclbin, an explicit hw_context cannot
@@ -528,6 +869,16 @@ public:
       m_shim->exec_buf(cmd->get_xcl_handle());
     }
 
+    size_t
+    exec_buf(const std::vector<xrt_core::buffer_handle*>& cmds) override
+    {
+      std::vector<buffer_handle_type> handles(cmds.size());
+      std::transform(cmds.begin(), cmds.end(), handles.begin(),
+                     [](auto cmd) { return cmd->get_xcl_handle(); });
+      m_shim->exec_buf(std::move(handles));
+      return cmds.size();
+    }
+
     bool
     is_null() const
     {
@@ -545,11 +896,22 @@ public:
     if (!s_devices[devidx])
       s_devices[devidx] = std::make_shared<pl::device>();
     m_pldev = s_devices[devidx].get();
+    m_cmd_engine = std::make_unique<cmd::engine>(m_pldev);
   }
 
   // destruct shim object, close the device
   ~shim()
-  {}
+  {
+    // Cached command buffers reference this shim
+    m_core_device->clear_exec_buffer_pool();
+
+    if (m_sync_count) {
+      std::stringstream ss;
+      ss << "noop device(" << m_devidx << ") synced " << m_sync_bytes << " bytes in "
+         << m_sync_count << " buffer syncs";
+      xrt_core::message::send(xrt_core::message::severity_level::info, "XRT", ss.str());
+    }
+  }
 
   std::unique_ptr<xrt_core::buffer_handle>
   alloc_bo(size_t size, unsigned int flags)
@@ -582,8 +944,10 @@ public:
   }
 
   int
-  sync_bo(buffer_handle_type, xclBOSyncDirection, size_t, size_t)
+  sync_bo(buffer_handle_type, xclBOSyncDirection, size_t size, size_t)
   {
+    ++m_sync_count;
+    m_sync_bytes += size;
     return 0;
   }
 
@@ -609,15 +973,21 @@ public:
   int
   exec_buf(buffer_handle_type handle)
   {
-    cmd::add(handle);
+    m_cmd_engine->add(handle);
+    return 0;
+  }
+
+  int
+  exec_buf(std::vector<buffer_handle_type> handles)
+  {
+    m_cmd_engine->add(handles);
     return 0;
   }
 
   int
   exec_wait(int msec)
   {
-    cmd::wait();
-    return 1;
+    return m_cmd_engine->wait(msec);
   }
 
   int
@@ -80,6 +80,15 @@ namespace xdp {
     device_db->addPLTraceEvent(event);
   }
 
+  void VPDynamicDatabase::addDeviceEvents(uint64_t deviceId,
+                                          const std::vector<VTFEvent*>& events)
+  {
+    if (events.empty())
+      return;
+    auto device_db = getDeviceDB(deviceId);
+    device_db->addPLTraceEvents(events);
+  }
+
   void VPDynamicDatabase::addEvent(VTFEvent* event)
   {
     if (event == nullptr)
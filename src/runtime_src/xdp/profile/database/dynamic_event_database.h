@@ -24,6 +24,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string_view>
 #include <vector>
 
 #include "core/common/uuid.h"
@@ -94,6 +95,13 @@ namespace xdp {
     // Add an event to the database to be sorted later when we write
     XDP_CORE_EXPORT void addUnsortedEvent(VTFEvent* event);
 
+    // For loggers that add device events in bulk.  The ID of each event
+    // is issued when the event is created so the event can be matched
+    // with its end before all of the events are added at once.
+    inline void issueEventId(VTFEvent* event) { issueId(event); }
+    XDP_CORE_EXPORT void addDeviceEvents(uint64_t deviceId,
+                                         const std::vector<VTFEvent*>& events);
+
     // For API events, find the event id of the start event for an end event
     XDP_CORE_EXPORT void markStart(uint64_t functionID, uint64_t eventID) ;
     XDP_CORE_EXPORT uint64_t matchingStart(uint64_t functionID) ;
@@ -128,8 +136,12 @@ namespace xdp {
 
     // A lookup into the string table.  If the string isn't already in
     // the string table it will be added
-    inline uint64_t addString(const std::string& value)
+    inline uint64_t addString(std::string_view value)
     { return stringTable.addString(value); }
+    // Faster lookup for strings with static storage duration, like
+    // the function names passed to callbacks
+    inline uint64_t addStaticString(const char* value)
+    { return stringTable.addStaticString(value); }
 
     // A function that iterates on the dynamic events and returns
     // copies of the events based upon the filter passed in
@@ -154,6 +166,9 @@ namespace xdp {
     // A function that each writer calls to dump the string table
     inline void dumpStringTable(std::ofstream& fout)
     { stringTable.dumpTable(fout); }
+    inline void
+    forEachString(const std::function<void(uint64_t, const std::string&)>& f)
+    { stringTable.forEachString(f); }
 
     // OpenCL mappings and dependencies
     XDP_CORE_EXPORT void addOpenCLMapping(uint64_t openclID, uint64_t eventID, uint64_t startID) ;
@@ -58,6 +58,8 @@ namespace xdp {
     // inlined accesses to the PL database object.
     // ****************************************************************
     inline void addPLTraceEvent(VTFEvent* event) { pl_db.addEvent(event); }
+    inline void addPLTraceEvents(const std::vector<VTFEvent*>& events)
+    { pl_db.addEvents(events); }
     inline bool eventsExist() { return pl_db.eventsExist(); }
 
     inline std::vector<std::unique_ptr<VTFEvent>> moveEvents()
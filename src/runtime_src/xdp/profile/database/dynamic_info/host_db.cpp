@@ -18,15 +18,116 @@
 
 #include "xdp/profile/database/dynamic_info/host_db.h"
 #include "xdp/profile/database/events/vtf_event.h"
+#include "xdp/profile/database/thread_local_state.h"
 #include <algorithm>
+#include <queue>
+
+namespace {
+
+  std::atomic<uint64_t> nextHostDBId{1};
+
+  // k-way merge of runs sorted by timestamp.  Events with equal
+  // timestamps are ordered by run.
+  std::vector<xdp::TimedEvent>
+  mergeRuns(std::vector<std::vector<xdp::TimedEvent>>& runs)
+  {
+    size_t total = 0;
+    for (auto& run : runs)
+      total += run.size();
+
+    std::vector<xdp::TimedEvent> merged;
+    merged.reserve(total);
+
+    // (timestamp, run) of the next event of each run
+    using head = std::pair<double, size_t>;
+    std::priority_queue<head, std::vector<head>, std::greater<head>> heads;
+    std::vector<size_t> positions(runs.size(), 0);
+    for (size_t idx = 0; idx < runs.size(); ++idx) {
+      if (!runs[idx].empty())
+        heads.emplace(runs[idx][0].first, idx);
+    }
+
+    while (!heads.empty()) {
+      auto run = heads.top().second;
+      heads.pop();
+      merged.push_back(runs[run][positions[run]++]);
+      if (positions[run] < runs[run].size())
+        heads.emplace(runs[run][positions[run]].first, run);
+    }
+
+    return merged;
+  }
+
+} // end anonymous namespace
 
 namespace xdp {
 
+  EventBuffer::EventBuffer() : head(new Chunk), tail(head)
+  {
+  }
+
+  EventBuffer::~EventBuffer()
+  {
+    while (head != nullptr) {
+      auto next = head->next.load(std::memory_order_relaxed);
+      delete head;
+      head = next;
+    }
+  }
+
+  void EventBuffer::append(double timestamp, VTFEvent* event)
+  {
+    auto count = tail->count.load(std::memory_order_relaxed);
+    if (count < chunkSize) {
+      tail->events[count] = {timestamp, event};
+      tail->count.store(count + 1, std::memory_order_release);
+      return;
+    }
+
+    auto chunk = new Chunk;
+    chunk->events[0] = {timestamp, event};
+    chunk->count.store(1, std::memory_order_relaxed);
+    tail->next.store(chunk, std::memory_order_release);
+    tail = chunk;
+  }
+
+  void EventBuffer::drain(std::vector<TimedEvent>& events)
+  {
+    while (true) {
+      auto count = head->count.load(std::memory_order_acquire);
+      events.insert(events.end(), head->events + headIndex, head->events + count);
+      headIndex = count;
+      if (headIndex < chunkSize)
+        return;
+
+      // The producer has moved on once the next chunk is linked
+      auto next = head->next.load(std::memory_order_acquire);
+      if (next == nullptr)
+        return;
+      delete head;
+      head = next;
+      headIndex = 0;
+    }
+  }
+
+  bool EventBuffer::empty() const
+  {
+    if (head->count.load(std::memory_order_acquire) != headIndex)
+      return false;
+    return headIndex < chunkSize ||
+      head->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+  HostDB::HostDB() : id(nextHostDBId++)
+  {
+  }
+
   HostDB::~HostDB()
   {
     // Delete sorted events still in the database and not moved
     {
       std::lock_guard<std::mutex> lock(sortedLock);
+      drainSortedEvents();
       for (auto& iter : sortedEvents) {
         auto event = iter.second;
         delete event;
@@ -35,18 +136,92 @@ namespace xdp {
     // Delete unsorted events still in the database and not moved
     {
       std::lock_guard<std::mutex> lock(unsortedLock);
+      drainUnsortedEvents();
       for (auto event : unsortedEvents)
         delete event;
     }
   }
 
+  // Get the buffers of the calling thread, the buffers are created
+  // and registered with this HostDB when the thread adds its first event
+  ThreadEventBuffers* HostDB::getThreadBuffers()
+  {
+    return &ThreadLocalState<ThreadEventBuffers>::get(id,
+      [this](const std::shared_ptr<ThreadEventBuffers>& buffers)
+      {
+        std::lock_guard<std::mutex> lock(threadBuffersLock);
+        threadBuffers.push_back(buffers);
+      });
+  }
+
+  std::vector<std::shared_ptr<ThreadEventBuffers>> HostDB::copyThreadBuffers()
+  {
+    std::lock_guard<std::mutex> lock(threadBuffersLock);
+    return threadBuffers;
+  }
+
+  // Merge the sorted events of all threads into sortedEvents.
+  // Must be called with sortedLock held.
+  void HostDB::drainSortedEvents()
+  {
+    std::vector<std::vector<TimedEvent>> runs;
+    for (auto& buffers : copyThreadBuffers()) {
+      std::vector<TimedEvent> events;
+      buffers->sorted.drain(events);
+      if (events.empty())
+        continue;
+
+      // Events of one thread are appended in almost sorted order
+      auto earlier = [](const TimedEvent& lhs, const TimedEvent& rhs) {
+        return lhs.first < rhs.first;
+      };
+      if (!std::is_sorted(events.begin(), events.end(), earlier))
+        std::stable_sort(events.begin(), events.end(), earlier);
+      runs.push_back(std::move(events));
+    }
+
+    if (runs.empty())
+      return;
+
+    // Previously merged events precede new events with equal timestamps
+    runs.insert(runs.begin(), std::move(sortedEvents));
+    sortedEvents = mergeRuns(runs);
+  }
+
+  // Move the unsorted events of all threads into unsortedEvents.
+  // Must be called with unsortedLock held.
+  void HostDB::drainUnsortedEvents()
+  {
+    std::vector<TimedEvent> events;
+    for (auto& buffers : copyThreadBuffers()) {
+      events.clear();
+      buffers->unsorted.drain(events);
+      for (auto& iter : events)
+        unsortedEvents.push_back(iter.second);
+    }
+  }
+
+  // Release the buffers of exited threads once all their events
+  // have been drained.  Must be called without sortedLock and
+  // unsortedLock held.
+  void HostDB::releaseRetiredBuffers()
+  {
+    std::scoped_lock lock(sortedLock, unsortedLock, threadBuffersLock);
+    threadBuffers.erase(std::remove_if(threadBuffers.begin(), threadBuffers.end(),
+                                       [](const auto& retiring) {
+                                         return retiring->retired &&
+                                           retiring->sorted.empty() &&
+                                           retiring->unsorted.empty();
+                                       }),
+                        threadBuffers.end());
+  }
+
   void HostDB::addSortedEvent(VTFEvent* event)
   {
     if (event == nullptr)
       return;
 
-    std::lock_guard<std::mutex> lock(sortedLock);
-    sortedEvents.emplace(event->getTimestamp(), event);
+    getThreadBuffers()->sorted.append(event->getTimestamp(), event);
   }
 
   void HostDB::addUnsortedEvent(VTFEvent* event)
@@ -54,13 +229,13 @@ namespace xdp {
     if (event == nullptr)
       return;
 
-    std::lock_guard<std::mutex> lock(unsortedLock);
-    unsortedEvents.push_back(event);
+    getThreadBuffers()->unsorted.append(0, event);
   }
 
   bool HostDB::sortedEventsExist(std::function<bool (VTFEvent*)>& filter)
   {
     std::lock_guard<std::mutex> lock(sortedLock);
+    drainSortedEvents();
     for (auto& iter : sortedEvents) {
       auto event = iter.second;
       if (filter(event))
@@ -73,6 +248,7 @@ namespace xdp {
   HostDB::filterSortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
     std::lock_guard<std::mutex> lock(sortedLock);
+    drainSortedEvents();
 
     std::vector<VTFEvent*> collected;
     for (auto& iter : sortedEvents) {
@@ -87,6 +263,7 @@ namespace xdp {
   HostDB::filterUnsortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
     std::lock_guard<std::mutex> lock(unsortedLock);
+    drainUnsortedEvents();
 
     std::vector<VTFEvent*> collected;
     for (auto event : unsortedEvents) {
@@ -99,40 +276,46 @@ namespace xdp {
   std::vector<std::unique_ptr<VTFEvent>>
   HostDB::moveSortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
-    std::lock_guard<std::mutex> lock(sortedLock);
-
     std::vector<std::unique_ptr<VTFEvent>> collected;
+    {
+      std::lock_guard<std::mutex> lock(sortedLock);
+      drainSortedEvents();
 
-    for (auto iter = sortedEvents.begin(); iter != sortedEvents.end(); ) {
-      auto event = (*iter).second;
-      if (filter(event)) {
-        collected.emplace_back(event);
-        iter = sortedEvents.erase(iter);
-      }
-      else
-        ++iter;
+      auto newEnd = std::remove_if(sortedEvents.begin(), sortedEvents.end(), [&filter, &collected](const TimedEvent& iter) {
+          if (filter(iter.second)) {
+              collected.emplace_back(iter.second);
+              return true;
+          }
+          return false;
+      });
+      sortedEvents.erase(newEnd, sortedEvents.end());
     }
+
+    releaseRetiredBuffers();
     return collected;
   }
 
   std::vector<VTFEvent*>
   HostDB::moveUnsortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
-    std::lock_guard<std::mutex> lock(unsortedLock);
-
     std::vector<VTFEvent*> collected;
+    {
+      std::lock_guard<std::mutex> lock(unsortedLock);
+      drainUnsortedEvents();
 
-    auto newEnd = std::remove_if(unsortedEvents.begin(), unsortedEvents.end(), [&filter, &collected](VTFEvent* event) {
-        if (filter(event)) {
-            collected.push_back(event);
-            return true;  // Mark the event for removal from unsortedEvents vector
-        }
-        return false; // Keep event in the unsortedEvents vector
-    });
+      auto newEnd = std::remove_if(unsortedEvents.begin(), unsortedEvents.end(), [&filter, &collected](VTFEvent* event) {
+          if (filter(event)) {
+              collected.push_back(event);
+              return true;  // Mark the event for removal from unsortedEvents vector
+          }
+          return false; // Keep event in the unsortedEvents vector
+      });
 
-    // Resize the UnsortedEvents vector to keep only the remaining unfiltered events
-    unsortedEvents.erase(newEnd, unsortedEvents.end());
+      // Resize the UnsortedEvents vector to keep only the remaining unfiltered events
+      unsortedEvents.erase(newEnd, unsortedEvents.end());
+    }
 
+    releaseRetiredBuffers();
     return collected;
   }
 
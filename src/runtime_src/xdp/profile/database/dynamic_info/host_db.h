@@ -17,11 +17,13 @@
 #ifndef HOST_DB_DOT_H
 #define HOST_DB_DOT_H
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
 #include "xdp/config.h"
@@ -34,6 +36,55 @@ namespace xdp {
   // Forward declarations
   class VTFEvent;
 
+  // Host events along with their timestamp when added to the database
+  using TimedEvent = std::pair<double, VTFEvent*>;
+
+  // A single producer, single consumer append buffer of events.  The
+  // producer thread appends events without locking, and a consumer
+  // drains the events appended since the last drain.  Events are
+  // stored in fixed size chunks that are released by the consumer
+  // once the producer has moved on to the next chunk.
+  class EventBuffer
+  {
+  private:
+    static constexpr size_t chunkSize = 1024;
+
+    struct Chunk
+    {
+      TimedEvent events[chunkSize];
+      std::atomic<size_t> count{0};
+      std::atomic<Chunk*> next{nullptr};
+    };
+
+    Chunk* head;           // Owned by the consumer
+    size_t headIndex = 0;  // Owned by the consumer
+    Chunk* tail;           // Owned by the producer
+
+  public:
+    EventBuffer();
+    ~EventBuffer();
+
+    EventBuffer(const EventBuffer&) = delete;
+    EventBuffer& operator=(const EventBuffer&) = delete;
+
+    // Called only by the producer thread
+    void append(double timestamp, VTFEvent* event);
+
+    // Called by one consumer at a time
+    void drain(std::vector<TimedEvent>& events);
+    bool empty() const;
+  };
+
+  // The per thread buffers of one producer thread.  The buffers are
+  // shared between the HostDB and the thread, and are retired when
+  // the thread exits.
+  struct ThreadEventBuffers
+  {
+    EventBuffer sorted;
+    EventBuffer unsorted;
+    std::atomic<bool> retired{false};
+  };
+
   // The HostDB contains all the dynamic event information related
   // to the different host tracing and anything higher level (like user events)
   class HostDB
@@ -42,13 +93,29 @@ namespace xdp {
     static constexpr uint64_t eventThreshold = 10000000;
 
     // Before all events are printed in a CSV, they have to be sorted.
-    // The multimap sorts them as we create and insert them.
-    std::multimap<double, VTFEvent*> sortedEvents;
+    // Events are appended to per thread buffers without locking and
+    // merged by timestamp into this vector when the events are
+    // accessed.
+    std::vector<TimedEvent> sortedEvents;
 
     // For host events that will be sorted later (when printed), we
     // can store them away in a simple vector
     std::vector<VTFEvent*> unsortedEvents;
 
+    // Each producer thread appends to its own buffers.  The buffers
+    // are drained into sortedEvents and unsortedEvents when accessed.
+    std::vector<std::shared_ptr<ThreadEventBuffers>> threadBuffers;
+
+    // Unique id of this HostDB used by threads to validate their
+    // cached buffers
+    const uint64_t id;
+
+    ThreadEventBuffers* getThreadBuffers();
+    std::vector<std::shared_ptr<ThreadEventBuffers>> copyThreadBuffers();
+    void drainSortedEvents();
+    void drainUnsortedEvents();
+    void releaseRetiredBuffers();
+
     // This object keeps track of matching start events with end events
     APIMatch<uint64_t, uint64_t> eventStarts;
 
@@ -69,11 +136,12 @@ namespace xdp {
     // Different host layers can have dependencies between events
     DependencyManager openclDependencies;
 
-    std::mutex sortedLock; // Protects the "sortedEvents" multimap
+    std::mutex sortedLock; // Protects the "sortedEvents" vector
     std::mutex unsortedLock; // Protects the "unsortedEvents" vector
+    std::mutex threadBuffersLock; // Protects the "threadBuffers" vector
 
   public:
-    HostDB() = default;
+    HostDB();
     XDP_CORE_EXPORT ~HostDB();
 
     // Functions to add host events to the database
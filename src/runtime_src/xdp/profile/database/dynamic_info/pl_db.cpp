@@ -38,6 +38,24 @@ namespace xdp {
       VPDatabase::Instance()->broadcast(VPDatabase::DUMP_TRACE);
   }
 
+  // Events decoded from one trace buffer are mostly in timestamp
+  // order, so each one is inserted with a hint at the end
+  void PLDB::addEvents(const std::vector<VTFEvent*>& newEvents)
+  {
+    bool overLimit = false;
+    {
+      std::lock_guard<std::mutex> lock(eventLock);
+      for (auto event : newEvents) {
+        if (event != nullptr)
+          events.emplace_hint(events.end(), event->getTimestamp(), event);
+      }
+      if (events.size() > eventThreshold)
+        overLimit = true;
+    }
+    if (overLimit)
+      VPDatabase::Instance()->broadcast(VPDatabase::DUMP_TRACE);
+  }
+
   bool PLDB::eventsExist()
   {
     std::lock_guard<std::mutex> lock(eventLock);
@@ -16,26 +16,105 @@
 
 #define XDP_CORE_SOURCE
 
+#include <algorithm>
+#include <vector>
+
 #include "xdp/profile/database/dynamic_info/string_table.h"
 
+namespace {
+
+  std::atomic<uint64_t> nextInstanceId{1} ;
+
+  // Direct mapped cache of static strings for the table of one
+  // instance.  Only the owning thread accesses the cache.  It is
+  // trivially destructible so it can be used at any point of thread
+  // exit.
+  struct StaticStringCache
+  {
+    static constexpr size_t size = 256 ;
+
+    struct Entry
+    {
+      const char* key ;
+      uint64_t id ;
+    } ;
+
+    uint64_t instanceId ;
+    Entry entries[size] ;
+
+    static size_t slot(const char* key)
+    {
+      auto value = reinterpret_cast<uintptr_t>(key) ;
+      return (value ^ (value >> 8)) % size ;
+    }
+  } ;
+
+  thread_local StaticStringCache staticStringCache = {} ;
+
+} // end anonymous namespace
+
 namespace xdp {
 
-  uint64_t StringTable::addString(const std::string& value)
+  StringTable::StringTable() : instanceId(nextInstanceId++)
   {
-    std::lock_guard<std::mutex> lock(dataLock);
+  }
 
-    if (table.find(value) == table.end())
-      table[value] = currentId++;
+  uint64_t StringTable::addString(std::string_view value)
+  {
+    auto& shard = shards[std::hash<std::string_view>{}(value) % numShards];
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    auto iter = shard.table.find(value);
+    if (iter != shard.table.end())
+      return iter->second;
+
+    // Ids are unique across shards, but only increase per shard
+    uint64_t id = currentId++;
+    const std::string& key = shard.strings.emplace_back(value);
+    shard.table.emplace(key, id);
+    return id;
+  }
+
+  uint64_t StringTable::addStaticString(const char* value)
+  {
+    auto& cache = staticStringCache;
+    if (cache.instanceId != instanceId) {
+      cache = {};
+      cache.instanceId = instanceId;
+    }
+
+    auto& entry = cache.entries[StaticStringCache::slot(value)];
+    if (entry.key == value)
+      return entry.id;
 
-    return table[value];
+    uint64_t id = addString(value);
+    entry.key = value;
+    entry.id = id;
+    return id;
   }
 
   void StringTable::dumpTable(std::ofstream& fout)
   {
-    std::lock_guard<std::mutex> lock(dataLock);
+    forEachString([&fout](uint64_t id, const std::string& value)
+                  {
+                    fout << id << "," << value.c_str() << "\n";
+                  });
+  }
+
+  // Strings are visited in the order they were added
+  void StringTable::
+  forEachString(const std::function<void(uint64_t, const std::string&)>& f)
+  {
+    std::vector<std::pair<uint64_t, const std::string*>> entries;
+    for (auto& shard : shards) {
+      std::lock_guard<std::mutex> lock(shard.lock);
+      for (auto& s : shard.strings)
+        entries.emplace_back(shard.table.at(s), &s);
+    }
+    std::sort(entries.begin(), entries.end());
 
-    for (auto& s : table)
-      fout << s.second << "," << s.first.c_str() << "\n";
+    for (auto& entry : entries)
+      f(entry.first, *entry.second);
   }
 
 } // end namespace xdp
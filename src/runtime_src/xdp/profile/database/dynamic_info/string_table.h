@@ -17,29 +17,59 @@
 #ifndef STRING_TABLE_DOT_H
 #define STRING_TABLE_DOT_H
 
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <deque>
 #include <fstream>
-#include <map>
+#include <functional>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "xdp/config.h"
 
 namespace xdp {
 
+  // The string table assigns unique ids to all strings that show up
+  // in trace events.  Strings are added from the callbacks of every
+  // profiled API, so the table is split into shards that each have
+  // their own lock, and strings with static storage duration (like the
+  // function names passed to the native callbacks) are additionally
+  // cached per thread by address, which makes repeated lookups lock
+  // free.
   class StringTable
   {
   private:
-    std::map<std::string, uint64_t> table;
-    uint64_t currentId = 1; // Start at 1 so we can use 0 as a special value
+    static constexpr size_t numShards = 16 ;
+
+    struct Shard
+    {
+      std::mutex lock ;
+      std::deque<std::string> strings ; // Owns the keys of table
+      std::unordered_map<std::string_view, uint64_t> table ;
+    } ;
+
+    std::array<Shard, numShards> shards ;
+    std::atomic<uint64_t> currentId{1} ; // Start at 1 so we can use 0 as a special value
+
+    // Identifies this table in the thread local caches
+    const uint64_t instanceId ;
 
-    std::mutex dataLock; // Protects "table" map and currentId
   public:
-    StringTable() = default;
+    XDP_CORE_EXPORT StringTable() ;
     ~StringTable() = default;
 
-    XDP_CORE_EXPORT uint64_t addString(const std::string& value);
+    XDP_CORE_EXPORT uint64_t addString(std::string_view value);
+
+    // Same as addString, but the string must have static storage
+    // duration (a string literal or __func__) as it is cached by address
+    XDP_CORE_EXPORT uint64_t addStaticString(const char* value);
+
     XDP_CORE_EXPORT void dumpTable(std::ofstream& fout);
+    XDP_CORE_EXPORT void
+    forEachString(const std::function<void(uint64_t, const std::string&)>& f);
   };
 
 } // end namespace xdp
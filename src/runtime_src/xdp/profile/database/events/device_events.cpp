@@ -113,6 +113,12 @@ namespace xdp {
     fout << "," << memoryName << std::endl;
   }
 
+  void DeviceMemoryAccess::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket) ;
+    record.addField(memoryName) ;
+  }
+
   DeviceStreamAccess::DeviceStreamAccess(uint64_t s_id, double ts, VTFEventType ty,
                                          uint64_t devId, uint32_t monId, int32_t cuIdx)
                     : VTFDeviceEvent(s_id, ts, ty, devId, monId),
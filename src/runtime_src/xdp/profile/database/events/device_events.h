@@ -43,6 +43,7 @@ namespace xdp {
 
   protected:
     virtual void dumpTimestamp(std::ofstream& fout) ;
+    virtual double getTraceTimestamp() { return timestamp ; }
 
   public:
     XDP_CORE_EXPORT VTFDeviceEvent(uint64_t s_id, double ts, VTFEventType ty,
@@ -107,6 +108,7 @@ namespace xdp {
     XDP_CORE_EXPORT ~DeviceMemoryAccess();
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket);
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket);
 
     virtual int32_t getCUId() { return cuId; }
 
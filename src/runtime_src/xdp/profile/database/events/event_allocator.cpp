@@ -0,0 +1,351 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include "xdp/profile/database/events/event_allocator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  using xdp::EventAllocator;
+
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  // Singly linked list of free blocks of one size class
+  struct FreeList
+  {
+    FreeBlock* head = nullptr;
+    size_t count = 0;
+
+    void push(void* ptr)
+    {
+      auto block = static_cast<FreeBlock*>(ptr);
+      block->next = head;
+      head = block;
+      ++count;
+    }
+
+    void* pop()
+    {
+      auto block = head;
+      head = block->next;
+      --count;
+      return block;
+    }
+  };
+
+  // Free blocks of one size class in a thread cache.  Blocks are
+  // allocated from and freed to the active list.  A full active list
+  // is set aside as spare, such that batches are exchanged with the
+  // shared pool without walking the lists.
+  struct ClassCache
+  {
+    FreeList active;
+    FreeList spare;
+  };
+
+  using ClassCaches = std::array<ClassCache, EventAllocator::numClasses>;
+
+  struct Slab
+  {
+    std::unique_ptr<char[]> data;
+    size_t idx; // size class of blocks in slab
+  };
+
+  constexpr size_t blockSize(size_t idx)
+  {
+    return (idx + 1) * EventAllocator::granularity;
+  }
+
+  // The shared pool owns all slabs and keeps batches of free blocks
+  // of each size class.  The pool is never destroyed, since events
+  // can be destroyed during static destruction.
+  struct Pool
+  {
+    std::mutex lock;
+    std::vector<Slab> slabs;
+    std::array<std::vector<FreeList>, EventAllocator::numClasses> batches;
+
+    // Get a batch of free blocks of size class, carve a new slab
+    // into batches if there are none.  Called with lock held.
+    FreeList getBatch(size_t idx)
+    {
+      auto& free = batches[idx];
+      if (free.empty()) {
+        slabs.push_back({std::unique_ptr<char[]>(new char[EventAllocator::slabSize]), idx});
+        auto slab = slabs.back().data.get();
+        auto size = blockSize(idx);
+
+        // Carve from the end such that blocks are handed out in
+        // address order
+        FreeList batch;
+        for (auto offset = (EventAllocator::slabSize / size) * size; offset >= size; offset -= size) {
+          batch.push(slab + offset - size);
+          if (batch.count == EventAllocator::batchSize) {
+            free.push_back(batch);
+            batch = FreeList{};
+          }
+        }
+        if (batch.count)
+          free.push_back(batch);
+        std::reverse(free.begin(), free.end());
+      }
+
+      auto batch = free.back();
+      free.pop_back();
+      return batch;
+    }
+
+    // Return a batch of free blocks to the pool.  Called with lock held.
+    void putBatch(size_t idx, FreeList& batch)
+    {
+      if (batch.count)
+        batches[idx].push_back(batch);
+      batch = FreeList{};
+    }
+  };
+
+  Pool& getPool()
+  {
+    static Pool* pool = new Pool;
+    return *pool;
+  }
+
+  // Per thread cache of free blocks, returned to the shared pool when
+  // the thread exits
+  struct ThreadCache
+  {
+    ClassCaches classes;
+
+    ~ThreadCache();
+  };
+
+  // The cache of the calling thread.  Kept in a trivially destructible
+  // thread local such that the cache can be looked up cheaply and
+  // safely after it has been destroyed when the thread exits.
+  struct LocalCache
+  {
+    ThreadCache* cache;
+    bool destroyed;
+  };
+
+  thread_local LocalCache localCache = {nullptr, false};
+
+  ThreadCache::~ThreadCache()
+  {
+    auto& pool = getPool();
+    std::lock_guard<std::mutex> guard(pool.lock);
+    for (size_t idx = 0; idx < classes.size(); ++idx) {
+      pool.putBatch(idx, classes[idx].active);
+      pool.putBatch(idx, classes[idx].spare);
+    }
+    localCache = {nullptr, true};
+  }
+
+  // Cache of calling thread, nullptr if the thread is exiting and
+  // its cache has been destroyed
+  ThreadCache* getCache()
+  {
+    if (localCache.cache != nullptr || localCache.destroyed)
+      return localCache.cache;
+
+    thread_local ThreadCache cache;
+    localCache.cache = &cache;
+    return localCache.cache;
+  }
+
+} // end anonymous namespace
+
+namespace xdp {
+
+  void* EventAllocator::allocate(size_t size)
+  {
+    if (size == 0 || size > maxSize)
+      return ::operator new(size);
+
+    auto idx = (size - 1) / granularity;
+    auto cache = getCache();
+    if (cache == nullptr) {
+      auto& pool = getPool();
+      std::lock_guard<std::mutex> guard(pool.lock);
+      auto batch = pool.getBatch(idx);
+      auto ptr = batch.pop();
+      pool.putBatch(idx, batch);
+      return ptr;
+    }
+
+    auto& cls = cache->classes[idx];
+    if (cls.active.head == nullptr) {
+      if (cls.spare.head != nullptr) {
+        std::swap(cls.active, cls.spare);
+      }
+      else {
+        auto& pool = getPool();
+        std::lock_guard<std::mutex> guard(pool.lock);
+        cls.active = pool.getBatch(idx);
+      }
+    }
+    return cls.active.pop();
+  }
+
+  void EventAllocator::deallocate(void* ptr, size_t size)
+  {
+    if (ptr == nullptr)
+      return;
+
+    if (size == 0 || size > maxSize) {
+      ::operator delete(ptr);
+      return;
+    }
+
+    auto idx = (size - 1) / granularity;
+    auto cache = getCache();
+    if (cache == nullptr) {
+      auto& pool = getPool();
+      std::lock_guard<std::mutex> guard(pool.lock);
+      FreeList batch;
+      batch.push(ptr);
+      pool.putBatch(idx, batch);
+      return;
+    }
+
+    auto& cls = cache->classes[idx];
+    if (cls.active.count == batchSize) {
+      // Set aside full active list, return spare to shared pool
+      if (cls.spare.head != nullptr) {
+        auto& pool = getPool();
+        std::lock_guard<std::mutex> guard(pool.lock);
+        pool.putBatch(idx, cls.spare);
+      }
+      cls.spare = cls.active;
+      cls.active = FreeList{};
+    }
+    cls.active.push(ptr);
+  }
+
+  // The free blocks are taken out of the shared pool, so that the
+  // slabs can be sorted and the blocks counted and rebatched without
+  // holding the pool lock.  Threads that need blocks meanwhile carve
+  // new slabs.  Only one trim runs at a time.
+  size_t EventAllocator::trim(size_t highWater)
+  {
+    static std::mutex trimLock;
+    std::lock_guard<std::mutex> trimGuard(trimLock);
+
+    auto& pool = getPool();
+    std::vector<std::pair<const char*, size_t>> slabs; // start, size class
+    std::array<std::vector<FreeList>, numClasses> batches;
+    {
+      std::lock_guard<std::mutex> guard(pool.lock);
+      if (pool.slabs.size() * slabSize <= highWater)
+        return 0;
+      slabs.reserve(pool.slabs.size());
+      for (auto& slab : pool.slabs)
+        slabs.emplace_back(slab.data.get(), slab.idx);
+      std::swap(batches, pool.batches);
+    }
+
+    // Count free blocks per slab
+    std::sort(slabs.begin(), slabs.end());
+    auto slabOf = [&slabs](const void* ptr) {
+      auto itr = std::upper_bound(slabs.begin(), slabs.end(), static_cast<const char*>(ptr),
+                                  [](const char* addr, const auto& slab) { return addr < slab.first; });
+      return static_cast<size_t>(std::distance(slabs.begin(), itr) - 1);
+    };
+
+    std::vector<size_t> freeBlocks(slabs.size(), 0);
+    for (auto& free : batches)
+      for (auto& batch : free)
+        for (auto block = batch.head; block != nullptr; block = block->next)
+          ++freeBlocks[slabOf(block)];
+
+    // Slabs with all blocks free are released, the free blocks of the
+    // remaining slabs are rebatched
+    std::vector<bool> release(slabs.size(), false);
+    std::vector<const char*> released;
+    for (size_t sidx = 0; sidx < slabs.size(); ++sidx) {
+      release[sidx] = (freeBlocks[sidx] == slabSize / blockSize(slabs[sidx].second));
+      if (release[sidx])
+        released.push_back(slabs[sidx].first);
+    }
+
+    if (!released.empty()) {
+      for (auto& free : batches) {
+        std::vector<FreeList> rebatched;
+        FreeList batch;
+        for (auto& old : free) {
+          for (auto block = old.head; block != nullptr; ) {
+            auto next = block->next;
+            if (!release[slabOf(block)]) {
+              batch.push(block);
+              if (batch.count == batchSize) {
+                rebatched.push_back(batch);
+                batch = FreeList{};
+              }
+            }
+            block = next;
+          }
+        }
+        if (batch.count)
+          rebatched.push_back(batch);
+        free = std::move(rebatched);
+      }
+    }
+
+    // Return the blocks and take out the released slabs, which are
+    // deleted after the lock is dropped
+    std::vector<Slab> garbage;
+    {
+      std::lock_guard<std::mutex> guard(pool.lock);
+      for (size_t idx = 0; idx < numClasses; ++idx)
+        pool.batches[idx].insert(pool.batches[idx].end(), batches[idx].begin(), batches[idx].end());
+
+      if (!released.empty()) {
+        auto isReleased = [&released](const Slab& slab) {
+          return std::binary_search(released.begin(), released.end(),
+                                    static_cast<const char*>(slab.data.get()));
+        };
+        auto itr = std::stable_partition(pool.slabs.begin(), pool.slabs.end(),
+                                         [&isReleased](const Slab& slab) { return !isReleased(slab); });
+        std::move(itr, pool.slabs.end(), std::back_inserter(garbage));
+        pool.slabs.erase(itr, pool.slabs.end());
+      }
+    }
+    return garbage.size() * slabSize;
+  }
+
+  size_t EventAllocator::getSlabBytes()
+  {
+    auto& pool = getPool();
+    std::lock_guard<std::mutex> guard(pool.lock);
+    return pool.slabs.size() * slabSize;
+  }
+
+} // end namespace xdp
@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef EVENT_ALLOCATOR_DOT_H
+#define EVENT_ALLOCATOR_DOT_H
+
+#include <cstddef>
+
+#include "xdp/config.h"
+
+namespace xdp {
+
+  // The EventAllocator provides the memory for all trace events.
+  // Events are carved out of large slabs in a small number of size
+  // classes.  Every thread that creates or destroys events keeps its
+  // own cache of free blocks, so host threads and device offload
+  // threads allocate events without locking.  Blocks are exchanged
+  // in batches between the thread caches and a shared pool.
+  //
+  // Slabs are not released when individual events are destroyed.
+  // After events have been written and destroyed, trim() releases all
+  // slabs whose blocks are free in the shared pool at once.  Periodic
+  // dumps trim only above a high water mark, the final dump always
+  // trims.
+  class EventAllocator
+  {
+  public:
+    static constexpr size_t granularity = 16;
+    static constexpr size_t maxSize = 256;
+    static constexpr size_t numClasses = maxSize / granularity;
+    static constexpr size_t slabSize = 64 * 1024;
+    static constexpr size_t batchSize = 256;
+    static constexpr size_t trimHighWater = 64 * 1024 * 1024;
+
+    // Events larger than maxSize are allocated with ::operator new
+    XDP_CORE_EXPORT static void* allocate(size_t size);
+    XDP_CORE_EXPORT static void deallocate(void* ptr, size_t size);
+
+    // Release all slabs that have no live events and no blocks held
+    // in thread caches, if more than highWater bytes are held in
+    // slabs.  Returns the number of bytes released.
+    XDP_CORE_EXPORT static size_t trim(size_t highWater = 0);
+
+    // Number of bytes currently held in slabs
+    XDP_CORE_EXPORT static size_t getSlabBytes();
+  };
+
+} // end namespace xdp
+
+#endif
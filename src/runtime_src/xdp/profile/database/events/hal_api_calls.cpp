@@ -36,6 +36,12 @@ namespace xdp {
     fout << "," << functionName << std::endl ;
   }
 
+  void HALAPICall::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket) ;
+    record.addField(functionName) ;
+  }
+
   AllocBoCall::AllocBoCall(uint64_t s_id, double ts, uint64_t name) 
              : HALAPICall(s_id, ts, name)
   {
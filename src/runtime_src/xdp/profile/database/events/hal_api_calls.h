@@ -39,6 +39,7 @@ namespace xdp {
     virtual bool isHALHostEvent() { return true ; }
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
   } ;
 
   class AllocBoCall : public HALAPICall
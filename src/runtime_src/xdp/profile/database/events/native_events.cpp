@@ -33,10 +33,16 @@ namespace xdp {
     fout << "," << functionName << "\n";
   }
 
+  void NativeAPICall::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket);
+    record.addField(functionName);
+  }
+
   NativeSyncRead::NativeSyncRead(uint64_t s_id, double ts, uint64_t name) :
     NativeAPICall(s_id, ts, name)
   {
-    readStr = VPDatabase::Instance()->getDynamicInfo().addString("READ");
+    readStr = VPDatabase::Instance()->getDynamicInfo().addStaticString("READ");
   }
 
   void NativeSyncRead::dumpSync(std::ofstream& fout, uint32_t bucket)
@@ -45,10 +51,16 @@ namespace xdp {
     fout << "," << readStr << "\n";
   }
 
+  void NativeSyncRead::dumpSyncBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket);
+    record.addField(readStr);
+  }
+
   NativeSyncWrite::NativeSyncWrite(uint64_t s_id, double ts, uint64_t name) :
     NativeAPICall(s_id, ts, name)
   {
-    writeStr = VPDatabase::Instance()->getDynamicInfo().addString("WRITE");
+    writeStr = VPDatabase::Instance()->getDynamicInfo().addStaticString("WRITE");
   }
 
   void NativeSyncWrite::dumpSync(std::ofstream& fout, uint32_t bucket)
@@ -57,4 +69,10 @@ namespace xdp {
     fout << "," << writeStr << "\n";
   }
 
+  void NativeSyncWrite::dumpSyncBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket);
+    record.addField(writeStr);
+  }
+
 } // end namespace xdp
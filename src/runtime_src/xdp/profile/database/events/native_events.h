@@ -31,6 +31,7 @@ namespace xdp {
     virtual bool isNativeHostEvent() { return true; }
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket);
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket);
   };
 
   class NativeSyncRead : public NativeAPICall
@@ -46,6 +47,7 @@ namespace xdp {
     // For printing out the event in a different bucket as a different
     //  type of event, without having to store additional events in the database
     XDP_CORE_EXPORT virtual void dumpSync(std::ofstream& fout, uint32_t bucket) override;
+    XDP_CORE_EXPORT virtual void dumpSyncBinary(VTFRecord& record, uint32_t bucket) override;
   };
 
   class NativeSyncWrite : public NativeAPICall
@@ -61,6 +63,7 @@ namespace xdp {
     // For printing out the event in a different bucket as a different
     //  type of event, without having to store additional events in the databaes
     XDP_CORE_EXPORT virtual void dumpSync(std::ofstream& fout, uint32_t bucket) override;
+    XDP_CORE_EXPORT virtual void dumpSyncBinary(VTFRecord& record, uint32_t bucket) override;
   };
 
 } // end namespace xdp
@@ -39,4 +39,10 @@ namespace xdp {
     fout << "," << functionName << std::endl ;
   }
 
+  void OpenCLAPICall::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket) ;
+    record.addField(functionName) ;
+  }
+
 } // end namespace xdp
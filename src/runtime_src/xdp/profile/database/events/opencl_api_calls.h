@@ -41,6 +41,7 @@ namespace xdp {
     virtual bool isLOPAPI() { return isLOP ; }
     virtual bool isOpenCLHostEvent() { return !isLOP ; }
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
   } ;
 
 } // end namespace xdp
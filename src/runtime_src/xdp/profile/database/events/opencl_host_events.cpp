@@ -17,8 +17,42 @@
 
 #define XDP_CORE_SOURCE
 
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
 #include "xdp/profile/database/events/opencl_host_events.h"
 
+namespace {
+
+  // Thread ids are written to trace files as the hex value that
+  // std::thread::id prints.  The value is only available through
+  // formatting, so cache it for the few threads that issue transfers.
+  uint64_t getThreadIdValue(const std::thread::id& threadId)
+  {
+    static std::mutex lock ;
+    static std::map<std::thread::id, uint64_t> values ;
+
+    std::lock_guard<std::mutex> guard(lock) ;
+    auto iter = values.find(threadId) ;
+    if (iter != values.end())
+      return iter->second ;
+
+    std::stringstream ss ;
+    ss << std::hex << threadId ;
+    uint64_t value = 0 ;
+    try {
+      value = std::stoull(ss.str(), nullptr, 16) ;
+    }
+    catch (...) {
+    }
+    values[threadId] = value ;
+    return value ;
+  }
+
+} // end anonymous namespace
+
 namespace xdp {
 
   // **************************
@@ -54,6 +88,15 @@ namespace xdp {
     fout << std::endl; 
   }
 
+  void KernelEnqueue::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket) ;
+    record.addField(kernelName) ;
+    record.addField(workgroupConfiguration) ;
+    record.addField(workgroupSize) ;
+    record.addField(0) ; // This is the "size"
+  }
+
   LOPKernelEnqueue::LOPKernelEnqueue(uint64_t s_id, double ts) :
     VTFEvent(s_id, ts, LOP_KERNEL_ENQUEUE)
   {
@@ -103,6 +146,14 @@ namespace xdp {
     fout << std::endl;
   }
 
+  void BufferTransfer::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket);
+    if(0 == start_id) {  // Dump the detailed information only for start event
+      record.addField(size);
+    }
+  }
+
   OpenCLBufferTransfer::OpenCLBufferTransfer(uint64_t s_id, double ts,
                                              VTFEventType ty,
                                              uint64_t address,
@@ -131,6 +182,18 @@ namespace xdp {
     fout << std::endl ;
   }
 
+  void OpenCLBufferTransfer::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket) ;
+    if (0 == start_id) // Dump the detailed information only for start event
+    {
+      record.addField(bufferSize) ;
+      record.addField(deviceAddress, true) ;
+      record.addField(memoryResource) ;
+      record.addField(getThreadIdValue(threadId), true) ;
+    }
+  }
+
 
   OpenCLCopyBuffer::OpenCLCopyBuffer(uint64_t s_id, double ts, VTFEventType ty,
                                      uint64_t srcAddress, uint64_t srcResource,
@@ -163,6 +226,21 @@ namespace xdp {
     fout << std::endl ;
   }
 
+  void OpenCLCopyBuffer::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket) ;
+    if (0 == start_id) // Dump the detailed information only for start event
+    {
+      record.addField(1) ; // Transfer type
+      record.addField(bufferSize) ;
+      record.addField(srcDeviceAddress) ;
+      record.addField(srcMemoryResource) ;
+      record.addField(dstDeviceAddress) ;
+      record.addField(dstMemoryResource) ;
+      record.addField(getThreadIdValue(threadId), true) ;
+    }
+  }
+
   LOPBufferTransfer::LOPBufferTransfer(uint64_t s_id, double ts, 
                                        VTFEventType ty) :
     VTFEvent(s_id, ts, ty), threadId(std::this_thread::get_id())
@@ -180,6 +258,12 @@ namespace xdp {
     fout << "," << std::hex << "0x" << threadId << std::dec << std::endl ;
   }
 
+  void LOPBufferTransfer::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    VTFEvent::dumpBinary(record, bucket) ;
+    record.addField(getThreadIdValue(threadId), true) ;
+  }
+
   StreamRead::StreamRead(uint64_t s_id, double ts) :
     VTFEvent(s_id, ts, STREAM_READ)
   {
@@ -56,6 +56,7 @@ namespace xdp {
     virtual bool isOpenCLHostEvent() { return true ; }
     
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
   } ;
 
   class LOPKernelEnqueue : public VTFEvent
@@ -108,6 +109,7 @@ namespace xdp {
     virtual bool isHostEvent() { return true ; } 
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
   } ;
 
   class OpenCLBufferTransfer : public VTFEvent
@@ -129,6 +131,7 @@ namespace xdp {
     virtual bool isOpenCLHostEvent() { return true ; }
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
   } ;
 
   class OpenCLCopyBuffer : public VTFEvent
@@ -153,6 +156,7 @@ namespace xdp {
     virtual bool isOpenCLHostEvent() { return true ; }
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
   } ;
 
   class LOPBufferTransfer : public VTFEvent
@@ -167,6 +171,7 @@ namespace xdp {
     virtual bool isLOPHostEvent() { return true ; }
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
   } ;
 
   class StreamRead : public VTFEvent
@@ -41,6 +41,7 @@ namespace xdp {
     XDP_CORE_EXPORT ~UserMarker() ;
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
   } ;
 
   class UserRange : public VTFEvent
@@ -61,6 +62,7 @@ namespace xdp {
     XDP_CORE_EXPORT ~UserRange() ;
 
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
   } ;
 
 } // end namespace xdp
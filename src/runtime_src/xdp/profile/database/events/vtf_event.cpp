@@ -55,111 +55,138 @@ namespace xdp {
     fout.flags(flags) ;
   }
 
+  void VTFEvent::dumpBinary(VTFRecord& record, uint32_t bucket)
+  {
+    record.id = id ;
+    record.startId = start_id ;
+    record.timestamp = getTraceTimestamp() ;
+    record.bucket = bucket ;
+    record.type = static_cast<uint16_t>(type) ;
+  }
+
+  const char* VTFEvent::getTypeName(VTFEventType ty)
+  {
+    switch (ty)
+    {
+    case USER_MARKER:
+      return "USER_MARKER" ;
+    case USER_RANGE:
+      return "USER_RANGE" ;
+    case KERNEL_ENQUEUE:
+      return "KERNEL_ENQUEUE" ;
+    case CU_ENQUEUE:
+      return "CU_ENQUEUE" ;
+    case READ_BUFFER:
+      return "READ_BUFFER" ;
+    case READ_BUFFER_P2P:
+      return "READ_BUFFER_P2P" ;
+    case WRITE_BUFFER:
+      return "WRITE_BUFFER" ;
+    case WRITE_BUFFER_P2P:
+      return "WRITE_BUFFER_P2P" ;
+    case COPY_BUFFER:
+      return "COPY_BUFFER" ;
+    case COPY_BUFFER_P2P:
+      return "COPY_BUFFER_P2P" ;
+    case OPENCL_API_CALL:
+      return "OPENCL_API_CALL" ;
+    case STREAM_READ:
+      return "STREAM_READ" ;
+    case STREAM_WRITE:
+      return "STREAM_WRITE" ;
+    case LOP_READ_BUFFER:
+      return "LOP_READ_BUFFER" ;
+    case LOP_WRITE_BUFFER:
+      return "LOP_WRITE_BUFFER" ;
+    case LOP_KERNEL_ENQUEUE:
+      return "LOP_KERNEL_ENQUEUE" ;
+    case KERNEL:
+      return "KERNEL" ;
+    case KERNEL_STALL:
+      return "KERNEL_STALL" ;
+    case KERNEL_STALL_EXT_MEM:
+      return "KERNEL_STALL_EXT_MEM" ;
+    case KERNEL_STALL_DATAFLOW:
+      return "KERNEL_STALL_DATAFLOW" ;
+    case KERNEL_STALL_PIPE:
+      return "KERNEL_STALL_PIPE" ;
+    case KERNEL_READ:
+      return "KERNEL_READ" ;
+    case KERNEL_WRITE:
+      return "KERNEL_WRITE" ;
+    case KERNEL_STREAM_READ:
+      return "KERNEL_STREAM_READ" ;
+    case KERNEL_STREAM_READ_STALL:
+      return "KERNEL_STREAM_READ_STALL" ;
+    case KERNEL_STREAM_READ_STARVE:
+      return "KERNEL_STREAM_READ_STARVE" ;
+    case KERNEL_STREAM_WRITE:
+      return "KERNEL_STREAM_WRITE" ;
+    case KERNEL_STREAM_WRITE_STALL:
+      return "KERNEL_STREAM_WRITE_STALL" ;
+    case KERNEL_STREAM_WRITE_STARVE:
+      return "KERNEL_STREAM_WRITE_STARVE" ;
+    case HOST_READ:
+      return "HOST_READ" ;
+    case HOST_WRITE:
+      return "HOST_WRITE" ;
+    case HAL_API_CALL:
+      return "API_CALL" ;
+    case NATIVE_API_CALL:
+      return "API_CALL" ;
+    default:
+      return "UNKNOWN" ;
+    }
+  }
+
   void VTFEvent::dumpType(std::ofstream& fout, bool humanReadable)
   {
+    if (humanReadable) {
+      fout << getTypeName(type) ;
+      return ;
+    }
+
     switch (type)
     {
     case USER_MARKER:
-      humanReadable ? (fout << "USER_MARKER") : (fout << USER_MARKER) ;
-      break ;
     case USER_RANGE:
-      humanReadable ? (fout << "USER_RANGE") : (fout << USER_RANGE) ;
-      break ;
     case KERNEL_ENQUEUE:
-      humanReadable ? (fout << "KERNEL_ENQUEUE") : (fout << KERNEL_ENQUEUE) ;
-      break ;
     case CU_ENQUEUE:
-      humanReadable ? (fout << "CU_ENQUEUE") : (fout << CU_ENQUEUE) ;
-      break ;
     case READ_BUFFER:
-      humanReadable ? (fout << "READ_BUFFER") : (fout << READ_BUFFER) ;
-      break ;
     case READ_BUFFER_P2P:
-      humanReadable ? (fout << "READ_BUFFER_P2P") : (fout << READ_BUFFER_P2P) ;
-      break ;
     case WRITE_BUFFER:
-      humanReadable ? (fout << "WRITE_BUFFER") : (fout << WRITE_BUFFER) ;
-      break ;
     case WRITE_BUFFER_P2P:
-      humanReadable ? (fout << "WRITE_BUFFER_P2P") : (fout << WRITE_BUFFER_P2P);
-      break ;
     case COPY_BUFFER:
-      humanReadable ? (fout << "COPY_BUFFER") : (fout << COPY_BUFFER) ;
-      break ;
     case COPY_BUFFER_P2P:
-      humanReadable ? (fout << "COPY_BUFFER_P2P") : (fout << COPY_BUFFER_P2P) ;
-      break ;
     case OPENCL_API_CALL:
-      humanReadable ? (fout << "OPENCL_API_CALL") : (fout << OPENCL_API_CALL) ;
-      break ;
     case STREAM_READ:
-      humanReadable ? (fout << "STREAM_READ") : (fout << STREAM_READ) ;
-      break ;
     case STREAM_WRITE:
-      humanReadable ? (fout << "STREAM_WRITE") : (fout << STREAM_WRITE) ;
-      break ;
     case LOP_READ_BUFFER:
-      humanReadable ? (fout << "LOP_READ_BUFFER") : (fout << LOP_READ_BUFFER) ;
-      break ;
     case LOP_WRITE_BUFFER:
-      humanReadable ? (fout << "LOP_WRITE_BUFFER") : (fout << LOP_WRITE_BUFFER);
-      break ;
     case LOP_KERNEL_ENQUEUE:
-      humanReadable ? (fout << "LOP_KERNEL_ENQUEUE") : (fout << LOP_KERNEL_ENQUEUE) ;
-      break ;
     case KERNEL:
-      humanReadable ? (fout << "KERNEL") : (fout << KERNEL) ;
-      break ;
     case KERNEL_STALL:
-      humanReadable ? (fout << "KERNEL_STALL") : (fout << KERNEL_STALL) ;
-      break ;
     case KERNEL_STALL_EXT_MEM:
-      humanReadable ? (fout << "KERNEL_STALL_EXT_MEM") : (fout << KERNEL_STALL_EXT_MEM) ;
-      break ;
     case KERNEL_STALL_DATAFLOW:
-      humanReadable ? (fout << "KERNEL_STALL_DATAFLOW") : (fout << KERNEL_STALL_DATAFLOW) ;
-      break ;
     case KERNEL_STALL_PIPE:
-      humanReadable ? (fout << "KERNEL_STALL_PIPE") : (fout << KERNEL_STALL_PIPE) ;
-      break ;
     case KERNEL_READ:
-      humanReadable ? (fout << "KERNEL_READ") : (fout << KERNEL_READ) ;
-      break ;
     case KERNEL_WRITE:
-      humanReadable ? (fout << "KERNEL_WRITE") : (fout << KERNEL_WRITE) ;
-      break ;
     case KERNEL_STREAM_READ:
-      humanReadable ? (fout << "KERNEL_STREAM_READ") : (fout << KERNEL_STREAM_READ) ;
-      break ;
     case KERNEL_STREAM_READ_STALL:
-      humanReadable ? (fout << "KERNEL_STREAM_READ_STALL") : (fout << KERNEL_STREAM_READ_STALL) ;
-      break ;
     case KERNEL_STREAM_READ_STARVE:
-      humanReadable ? (fout << "KERNEL_STREAM_READ_STARVE") : (fout << KERNEL_STREAM_READ_STARVE) ;
-      break ;
     case KERNEL_STREAM_WRITE:
-      humanReadable ? (fout << "KERNEL_STREAM_WRITE") : (fout << KERNEL_STREAM_WRITE) ;
-      break ;
     case KERNEL_STREAM_WRITE_STALL:
-      humanReadable ? (fout << "KERNEL_STREAM_WRITE_STALL") : (fout << KERNEL_STREAM_WRITE_STALL) ;
-      break ;
     case KERNEL_STREAM_WRITE_STARVE:
-      humanReadable ? (fout << "KERNEL_STREAM_WRITE_STARVE") : (fout << KERNEL_STREAM_WRITE_STARVE) ;
-      break ;
     case HOST_READ:
-      humanReadable ? (fout << "HOST_READ") : (fout << HOST_READ) ;
-      break ;
     case HOST_WRITE:
-      humanReadable ? (fout << "HOST_WRITE") : (fout << HOST_WRITE) ;
+      fout << type ;
       break ;
     case HAL_API_CALL:
-      humanReadable ? (fout << "API_CALL") : (fout << API_CALL) ;
-      break ;
     case NATIVE_API_CALL:
-      humanReadable ? (fout << "API_CALL") : (fout << API_CALL) ;
+      fout << API_CALL ;
       break ;
     default:
-      humanReadable ? (fout << "UNKNOWN") : (fout << -1) ;
+      fout << -1 ;
       break ;
     }
   }
@@ -22,6 +22,8 @@
 #include <fstream>
 
 #include "xdp/config.h"
+#include "xdp/profile/database/events/event_allocator.h"
+#include "xdp/profile/database/events/vtf_record.h"
 
 namespace xdp {
 
@@ -92,10 +94,19 @@ namespace xdp {
     virtual void dumpTimestamp(std::ofstream& fout) ;
     void dumpType(std::ofstream& fout, bool humanReadable) ;
 
+    // The timestamp in ms as it is written to the trace file
+    virtual double getTraceTimestamp() { return timestamp / 1.0e6 ; }
+
   public:
     XDP_CORE_EXPORT VTFEvent(uint64_t s_id, double ts, VTFEventType ty) ;
     XDP_CORE_EXPORT virtual ~VTFEvent() ;
 
+    // All events are allocated from the slabs of the EventAllocator
+    static void* operator new(std::size_t size)
+      { return EventAllocator::allocate(size) ; }
+    static void operator delete(void* ptr, std::size_t size)
+      { EventAllocator::deallocate(ptr, size) ; }
+
     // Getters and Setters
     inline double       getTimestamp()    const { return timestamp ; }
     inline void         setTimestamp(double ts) { timestamp = ts ; }
@@ -136,6 +147,13 @@ namespace xdp {
     virtual uint64_t getDevice() { return 0 ; } // CHECK
     XDP_CORE_EXPORT virtual void dump(std::ofstream& fout, uint32_t bucket) ;
     virtual void dumpSync(std::ofstream& /*fout*/, uint32_t /*bucket*/) {};
+
+    // Binary trace file equivalents of dump and dumpSync
+    XDP_CORE_EXPORT virtual void dumpBinary(VTFRecord& record, uint32_t bucket) ;
+    virtual void dumpSyncBinary(VTFRecord& /*record*/, uint32_t /*bucket*/) {};
+
+    // The human readable name of an event type in trace files
+    XDP_CORE_EXPORT static const char* getTypeName(VTFEventType ty) ;
   } ;
 
   // Used so the database can sort based on timestamp order
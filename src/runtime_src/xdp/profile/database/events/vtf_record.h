@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef VTF_RECORD_DOT_H
+#define VTF_RECORD_DOT_H
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace xdp {
+
+  // The fixed width form of one line in the EVENTS section of a
+  // trace file.  Events fill in a record instead of formatting text
+  // when the binary trace file format is selected.  Every value an
+  // event adds after the common columns is an unsigned integer
+  // (string table ids, sizes, addresses) that is printed either in
+  // decimal or in hex with a "0x" prefix when converted back to CSV.
+  struct VTFRecord
+  {
+    static constexpr uint32_t maxFields = 8 ;
+
+    uint64_t id = 0 ;
+    uint64_t startId = 0 ;
+    double   timestamp = 0.0 ; // In ms, as printed in the CSV file
+    uint32_t bucket = 0 ;
+    uint16_t type = 0 ;
+    uint8_t  numFields = 0 ;
+    uint8_t  hexFields = 0 ;   // Bit i set if fields[i] is printed in hex
+    uint64_t fields[maxFields] = {} ;
+
+    // Events add a fixed number of fields, so running out of fields
+    // is a bug in the event and not something to recover from
+    inline void addField(uint64_t value, bool hex = false)
+    {
+      if (numFields == maxFields)
+        throw std::length_error("Too many fields in VTF record") ;
+      if (hex)
+        hexFields |= static_cast<uint8_t>(1 << numFields) ;
+      fields[numFields++] = value ;
+    }
+  } ;
+
+} // end namespace xdp
+
+#endif
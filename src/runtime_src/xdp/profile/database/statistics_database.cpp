@@ -18,15 +18,58 @@
 #include <vector>
 #include <thread>
 #include <iostream>
+#include <unordered_map>
 
 #define XDP_CORE_SOURCE
 
 #include "xdp/profile/database/statistics_database.h"
+#include "xdp/profile/database/thread_local_state.h"
+
+namespace xdp {
+
+  // API call statistics of one thread.  Only the owning thread logs
+  //  calls, so it looks up APIs without a lock and only takes the lock
+  //  to add an API it has not called before.  Readers take the lock
+  //  to walk the calls.
+  struct ThreadCallStatistics
+  {
+    // Bound on the number of calls waiting for their end, in case
+    //  some end is never logged
+    static constexpr size_t maxOpenCalls = 256 ;
+
+    std::mutex lock ;
+    std::unordered_map<std::string,
+                       std::unique_ptr<ThreadStreamingStatistics>> calls ;
+    std::vector<std::pair<ThreadStreamingStatistics*, double>> openCalls ;
+    std::atomic<bool> retired{false} ;
+  } ;
+
+} // end namespace xdp
+
+namespace {
+
+  std::atomic<uint64_t> nextInstanceId{1} ;
+
+  // The statistics of one API called by the current thread
+  xdp::ThreadStreamingStatistics*
+  findCallStatistics(xdp::ThreadCallStatistics& thread, const std::string& name)
+  {
+    auto iter = thread.calls.find(name) ;
+    if (iter != thread.calls.end())
+      return iter->second.get() ;
+
+    std::lock_guard<std::mutex> lock(thread.lock) ;
+    auto& entry = thread.calls[name] ;
+    entry = std::make_unique<xdp::ThreadStreamingStatistics>() ;
+    return entry.get() ;
+  }
+
+} // end anonymous namespace
 
 namespace xdp {
 
   VPStatisticsDatabase::VPStatisticsDatabase(VPDatabase* d) :
-    db(d), numMigrateMemCalls(0), numHostP2PTransfers(0),
+    db(d), instanceId(nextInstanceId++), numMigrateMemCalls(0), numHostP2PTransfers(0),
     numObjectsReleased(0), contextEnabled(false),
     totalHostReadTime(0), totalHostWriteTime(0), totalBufferStartTime(0),
     totalBufferEndTime(0), firstKernelStartTime(0.0), lastKernelEndTime(0.0)
@@ -206,61 +249,104 @@ namespace xdp {
     }
   }
 
+  ThreadCallStatistics& VPStatisticsDatabase::getThreadCallStatistics()
+  {
+    return ThreadLocalState<ThreadCallStatistics>::get(instanceId,
+      [this](const std::shared_ptr<ThreadCallStatistics>& stats)
+      {
+        std::lock_guard<std::mutex> lock(threadStatsLock);
+        foldRetiredCallStatistics();
+        threadCallStats.push_back(stats);
+      });
+  }
+
+  // Must be called with threadStatsLock held
+  void VPStatisticsDatabase::foldRetiredCallStatistics()
+  {
+    for (auto iter = threadCallStats.begin(); iter != threadCallStats.end();) {
+      if (!(*iter)->retired) {
+        ++iter;
+        continue;
+      }
+      for (const auto& call : (*iter)->calls)
+        call.second->mergeInto(retiredCallStats[call.first]);
+      iter = threadCallStats.erase(iter);
+    }
+  }
+
+  std::map<std::string, StreamingStatistics>
+  VPStatisticsDatabase::getCallStatistics()
+  {
+    std::lock_guard<std::mutex> lock(threadStatsLock);
+    foldRetiredCallStatistics();
+
+    std::map<std::string, StreamingStatistics> result = retiredCallStats;
+    for (auto& thread : threadCallStats) {
+      std::lock_guard<std::mutex> threadLock(thread->lock);
+      for (const auto& call : thread->calls)
+        call.second->mergeInto(result[call.first]);
+    }
+    return result;
+  }
+
   void VPStatisticsDatabase::logFunctionCallStart(const std::string& name,
                                                   double timestamp)
   {
-    std::lock_guard<std::mutex> lock(dbLock);
+    // OpenCL specific information 
+    if (name == "clEnqueueMigrateMemObjects") {
+      std::lock_guard<std::mutex> lock(dbLock);
+      addMigrateMemCall();
+    }
 
     // Each function that we are tracking will have two distinct entry
     // points that we need to keep track of, the starting point
     // and the ending point.  In this function, we log the starting point
-    // of a function call.  Since the calls could be coming in simultaneously
-    // from different threads, we also use the thread id to create
-    // a unique identifier.
-
-    auto threadId = std::this_thread::get_id();
-    auto key      = std::make_pair(name, threadId);
-    auto value    = std::make_pair(timestamp, (double)0.0);
-
-    // Since a single thread can call a function multiple times, we store
-    // the starts in a vector.  If the thread makes a recursive call, we'll
-    // have multiple elements where the start value is set but the end value
-    // needs to be filled in.
-    if (callCount.find(key) == callCount.end()) {
-      std::vector<std::pair<double, double>> newVector;
-      newVector.push_back(value);
-      callCount[key] = newVector;
-    }
-    else
-      callCount[key].push_back(value);
-
-    // OpenCL specific information 
-    if (name == "clEnqueueMigrateMemObjects")
-      addMigrateMemCall();
+    // of a function call.  Only the duration of the call is kept, so
+    // the start waits in the calling thread's list of open calls until
+    // the matching end is logged.
+    auto& thread = getThreadCallStatistics();
+    auto stats = findCallStatistics(thread, name);
+
+    if (thread.openCalls.size() == ThreadCallStatistics::maxOpenCalls)
+      thread.openCalls.erase(thread.openCalls.begin());
+    thread.openCalls.emplace_back(stats, timestamp);
   }
 
   void VPStatisticsDatabase::logFunctionCallEnd(const std::string& name,
                                                 double timestamp)
   {
-    std::lock_guard<std::mutex> lock(dbLock);
+    auto& thread = getThreadCallStatistics();
 
-    auto threadId = std::this_thread::get_id();
-    auto key      = std::make_pair(name, threadId);
+    auto iter = thread.calls.find(name);
+    if (iter == thread.calls.end())
+      return;
+    auto stats = iter->second.get();
 
     // Since some calls might be recursive, we must go backwards to find
-    // the first call that has a start time set but no end time.  Since we've
-    // incorporated the thread id as part of our key, we will match recursive
-    // calls correctly
-    for (auto iter = callCount[key].rbegin();
-         iter != callCount[key].rend();
-         ++iter) {
-      if ((*iter).second == 0) {
-        (*iter).second = timestamp;
-        break;
-      }
+    // the most recent start of this function.  Since the open calls are
+    // kept per thread, we will match recursive calls correctly
+    for (auto call = thread.openCalls.rbegin();
+         call != thread.openCalls.rend();
+         ++call) {
+      if ((*call).first != stats)
+        continue;
+
+      double duration = timestamp - (*call).second;
+      stats->record(duration > 0 ? static_cast<uint64_t>(duration + 0.5) : 0);
+      thread.openCalls.erase(std::next(call).base());
+      break;
     }
   }
 
+  void VPStatisticsDatabase::logFunctionCall(const std::string& name,
+                                             double startTime,
+                                             double endTime)
+  {
+    auto stats = findCallStatistics(getThreadCallStatistics(), name);
+    double duration = endTime - startTime;
+    stats->record(duration > 0 ? static_cast<uint64_t>(duration + 0.5) : 0);
+  }
+
   void VPStatisticsDatabase::logMemoryTransfer(uint64_t deviceId,
                                                 DeviceMemoryStatistics::ChannelType channelNum,
                                                 size_t count)
@@ -306,12 +392,7 @@ namespace xdp {
                                                 const char** buffers,
                                                 uint64_t numBuffers)
   {
-    if (kernelExecutionStats.find(kernelName) == kernelExecutionStats.end())
-    {
-      TimeStatistics blank ;
-      kernelExecutionStats[kernelName] = blank ;
-    }
-    (kernelExecutionStats[kernelName]).update(executionTime) ;
+    (kernelExecutionStats[kernelName]).record(executionTime) ;
     kernelGlobalWorkGroups[kernelName] = globalWorkSize ;
 
     // Also keep track of top kernel executions
@@ -344,6 +425,9 @@ namespace xdp {
                                                      const std::string& globalWorkGroup,
                                                      uint64_t executionTime)
   {
+    // Device trace of different streams is decoded concurrently
+    std::lock_guard<std::mutex> lock(dbLock) ;
+
     // If global work size is not known, then we need to get it from the latest enqueue 
     // of the associated kernel.
     std::string globalWork = globalWorkGroup;
@@ -438,7 +522,10 @@ namespace xdp {
 
   void VPStatisticsDatabase::setFirstKernelStartTime(double startTime)
   {
-    if (firstKernelStartTime != 0.0) return ;
+    // Trace may be decoded out of order, so keep the earliest start
+    std::lock_guard<std::mutex> lock(dbLock) ;
+    if (firstKernelStartTime != 0.0 && firstKernelStartTime <= startTime)
+      return ;
     firstKernelStartTime = startTime ;
   }
 
@@ -446,23 +533,9 @@ namespace xdp {
   {
     // For each function call, across all of the threads, find out
     //  the number of calls
-    std::map<std::string, uint64_t> counts ;
-
-    for (const auto& c : callCount)
-    {
-      if (counts.find(c.first.first) == counts.end())
-      {
-        counts[c.first.first] = c.second.size() ;
-      }
-      else
-      {
-        counts[c.first.first] += c.second.size() ;
-      }
-    }
-
-    for (const auto& i : counts)
+    for (const auto& i : getCallStatistics())
     {
-      fout << i.first << "," << i.second << std::endl ;
+      fout << i.first << "," << i.second.getCount() << std::endl ;
     }
   }
 
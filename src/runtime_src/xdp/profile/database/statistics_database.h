@@ -18,9 +18,11 @@
 #ifndef VP_STATISTICS_DATABASE_DOT_H
 #define VP_STATISTICS_DATABASE_DOT_H
 
+#include <atomic>
 #include <fstream>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -31,11 +33,13 @@
 #include "core/include/xdp/counters.h"
 
 #include "xdp/config.h"
+#include "xdp/profile/database/streaming_statistics.h"
 
 namespace xdp {
 
   // Forward declarations
   class VPDatabase ;
+  struct ThreadCallStatistics ;
 
   // All of the statistics in this database will be used in 
   //  summary files.  Different plugins might use different
@@ -175,9 +179,15 @@ namespace xdp {
     VPDatabase* db ;
 
   private:
-    // Statistics on API calls (OpenCL and HAL) have to be thread specific
-    std::map<std::pair<std::string, std::thread::id>,
-             std::vector<std::pair<double, double>>> callCount ;
+    const uint64_t instanceId ;
+
+    // Statistics on API calls (OpenCL, HAL, and native XRT) are
+    //  accumulated by each calling thread without locks and merged
+    //  when read.  Statistics of threads that have exited are folded
+    //  into retiredCallStats so memory does not grow with the number
+    //  of threads created over the life of the application.
+    std::list<std::shared_ptr<ThreadCallStatistics>> threadCallStats ;
+    std::map<std::string, StreamingStatistics> retiredCallStats ;
 
     // **** User Level Event Statistics ****
     std::map<std::string, uint64_t> eventCounts ;
@@ -194,7 +204,7 @@ namespace xdp {
     // **** OpenCL Statistics ****
     // Statistics on kernel enqueues and executions
     std::map<std::string, std::string> kernelGlobalWorkGroups ;
-    std::map<std::string, TimeStatistics> kernelExecutionStats ;
+    std::map<std::string, StreamingStatistics> kernelExecutionStats ;
     std::map<std::string, uint64_t> maxExecutions ; // per kernel
     std::map<std::string, std::vector<std::string>> bufferInfo ;
     
@@ -242,6 +252,10 @@ namespace xdp {
     std::mutex readsLock ;
     std::mutex writesLock ;
     std::mutex dbLock ;
+    std::mutex threadStatsLock ;
+
+    ThreadCallStatistics& getThreadCallStatistics() ;
+    void foldRetiredCallStatistics() ;
 
     // Helper functions for OpenCL
     void addTopHostRead(BufferTransferStats& transfer) ;
@@ -253,12 +267,11 @@ namespace xdp {
     XDP_CORE_EXPORT ~VPStatisticsDatabase() ;
 
     // Getters and setters
-    inline const std::map<std::pair<std::string, std::thread::id>,
-                    std::vector<std::pair<double, double>>>& getCallCount() 
-      { return callCount ; }
+    // Statistics on every API called so far, merged across all threads
+    XDP_CORE_EXPORT std::map<std::string, StreamingStatistics> getCallStatistics() ;
     inline const std::map<uint64_t, DeviceMemoryStatistics>& getMemoryStats() 
       { return memoryStats ; }
-    inline const std::map<std::string, TimeStatistics>& getKernelExecutionStats() 
+    inline const std::map<std::string, StreamingStatistics>& getKernelExecutionStats() 
       { return kernelExecutionStats ; }
     inline const std::map<std::tuple<std::string, std::string, std::string>, 
                           TimeStatistics>& getComputeUnitExecutionStats() 
@@ -336,6 +349,11 @@ namespace xdp {
                                          double timestamp) ;
     XDP_CORE_EXPORT void logFunctionCallEnd(const std::string& name, 
                                        double timestamp) ;
+    // Log a whole call at once, for callers that match the start
+    //  and end of their calls themselves
+    XDP_CORE_EXPORT void logFunctionCall(const std::string& name,
+                                         double startTime,
+                                         double endTime) ;
 
     XDP_CORE_EXPORT void logMemoryTransfer(uint64_t deviceId, 
                                       DeviceMemoryStatistics::ChannelType channelType,
@@ -379,7 +397,12 @@ namespace xdp {
     // Getters and setters on statistical information
     XDP_CORE_EXPORT void setFirstKernelStartTime(double startTime) ;
     inline double getFirstKernelStartTime() { return firstKernelStartTime ; }
-    inline void setLastKernelEndTime(double endTime) { lastKernelEndTime = endTime ; }
+    inline void setLastKernelEndTime(double endTime)
+    {
+      std::lock_guard<std::mutex> lock(dbLock) ;
+      if (endTime > lastKernelEndTime)
+        lastKernelEndTime = endTime ;
+    }
     inline double getLastKernelEndTime() { return lastKernelEndTime ; }
 
     // Helper functions for printing out summary information temporarily
@@ -0,0 +1,115 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include <algorithm>
+#include <cmath>
+
+#include "xdp/profile/database/streaming_statistics.h"
+
+namespace xdp {
+
+  uint32_t StreamingStatistics::bucketIndex(uint64_t value)
+  {
+    if (value < (1ULL << subBucketBits))
+      return static_cast<uint32_t>(value) ;
+    if (value >= (1ULL << maxValueBits))
+      return numBuckets - 1 ;
+
+    uint32_t msb = 0 ;
+    for (uint64_t v = value ; v > 1 ; v >>= 1)
+      ++msb ;
+
+    // Keep the top subBucketBits bits of the value.  The leading bit
+    //  is always set, so they select one of subBuckets buckets.
+    uint32_t shift = msb - (subBucketBits - 1) ;
+    return shift * subBuckets + static_cast<uint32_t>(value >> shift) ;
+  }
+
+  uint64_t StreamingStatistics::bucketValue(uint32_t index)
+  {
+    if (index < (1U << subBucketBits))
+      return index ;
+
+    uint32_t shift = index / subBuckets - 1 ;
+    uint64_t low   = static_cast<uint64_t>(index % subBuckets + subBuckets) << shift ;
+    return low + ((1ULL << shift) >> 1) ;
+  }
+
+  void StreamingStatistics::record(uint64_t value)
+  {
+    ++count ;
+    total += value ;
+    if (value < minimum) minimum = value ;
+    if (value > maximum) maximum = value ;
+    ++buckets[bucketIndex(value)] ;
+  }
+
+  void StreamingStatistics::merge(const StreamingStatistics& other)
+  {
+    if (other.count == 0)
+      return ;
+
+    count += other.count ;
+    total += other.total ;
+    minimum = (std::min)(minimum, other.minimum) ;
+    maximum = (std::max)(maximum, other.maximum) ;
+    for (uint32_t i = 0 ; i < numBuckets ; ++i)
+      buckets[i] += other.buckets[i] ;
+  }
+
+  uint64_t StreamingStatistics::getPercentile(double percentile) const
+  {
+    if (count == 0)
+      return 0 ;
+
+    auto rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * count)) ;
+    rank = (std::max)(rank, static_cast<uint64_t>(1)) ;
+
+    uint64_t seen = 0 ;
+    for (uint32_t i = 0 ; i < numBuckets ; ++i) {
+      seen += buckets[i] ;
+      if (seen >= rank)
+        return (std::clamp)(bucketValue(i), minimum, maximum) ;
+    }
+    return maximum ;
+  }
+
+  void ThreadStreamingStatistics::record(uint64_t value)
+  {
+    add(count, 1) ;
+    add(total, value) ;
+    if (value < minimum.load(std::memory_order_relaxed))
+      minimum.store(value, std::memory_order_relaxed) ;
+    if (value > maximum.load(std::memory_order_relaxed))
+      maximum.store(value, std::memory_order_relaxed) ;
+    add(buckets[StreamingStatistics::bucketIndex(value)], 1) ;
+  }
+
+  void ThreadStreamingStatistics::mergeInto(StreamingStatistics& result) const
+  {
+    StreamingStatistics snapshot ;
+    snapshot.count   = count.load(std::memory_order_relaxed) ;
+    snapshot.total   = total.load(std::memory_order_relaxed) ;
+    snapshot.minimum = minimum.load(std::memory_order_relaxed) ;
+    snapshot.maximum = maximum.load(std::memory_order_relaxed) ;
+    for (uint32_t i = 0 ; i < StreamingStatistics::numBuckets ; ++i)
+      snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed) ;
+    result.merge(snapshot) ;
+  }
+
+} // end namespace xdp
@@ -0,0 +1,108 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef STREAMING_STATISTICS_DOT_H
+#define STREAMING_STATISTICS_DOT_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+#include "xdp/config.h"
+
+namespace xdp {
+
+  // Constant memory statistics on a stream of durations (in ns).
+  //  Along with the count, total, minimum, and maximum, every value
+  //  is counted in a log-linear histogram so percentiles can be
+  //  reported without keeping the individual values.  Values below
+  //  2^subBucketBits are counted exactly, larger values fall into one
+  //  of 2^(subBucketBits-1) buckets per power of two, which bounds the
+  //  error of a percentile to under 2%.  Values of 2^maxValueBits ns
+  //  (about 18 minutes) and above share the last bucket.
+  class StreamingStatistics
+  {
+  public:
+    static constexpr uint32_t subBucketBits = 6 ;
+    static constexpr uint32_t maxValueBits  = 40 ;
+    static constexpr uint32_t subBuckets    = 1 << (subBucketBits - 1) ;
+    static constexpr uint32_t numBuckets    =
+      (maxValueBits - subBucketBits + 2) * subBuckets ;
+
+    static uint32_t bucketIndex(uint64_t value) ;
+    // The value reported for every entry in a bucket
+    static uint64_t bucketValue(uint32_t index) ;
+
+  private:
+    uint64_t count = 0 ;
+    uint64_t total = 0 ;
+    uint64_t minimum = (std::numeric_limits<uint64_t>::max)() ;
+    uint64_t maximum = 0 ;
+    std::array<uint64_t, numBuckets> buckets = {} ;
+
+    friend class ThreadStreamingStatistics ;
+
+  public:
+    XDP_CORE_EXPORT void record(uint64_t value) ;
+    XDP_CORE_EXPORT void merge(const StreamingStatistics& other) ;
+
+    inline uint64_t getCount() const { return count ; }
+    inline uint64_t getTotal() const { return total ; }
+    inline uint64_t getMin()   const { return count ? minimum : 0 ; }
+    inline uint64_t getMax()   const { return maximum ; }
+    inline double getAverage() const
+    {
+      return count ? static_cast<double>(total) / static_cast<double>(count)
+                   : 0.0 ;
+    }
+
+    // Percentile in the range [0, 100]
+    XDP_CORE_EXPORT uint64_t getPercentile(double percentile) const ;
+  } ;
+
+  // The same statistics updated by a single owning thread while other
+  //  threads may merge them at any time.  The owner updates every
+  //  value with relaxed loads and stores, so no locks or atomic
+  //  read-modify-write instructions are needed when logging.  A merge
+  //  that runs concurrently with an update may see that update
+  //  partially, which is acceptable for summary information.
+  class ThreadStreamingStatistics
+  {
+  private:
+    std::atomic<uint64_t> count{0} ;
+    std::atomic<uint64_t> total{0} ;
+    std::atomic<uint64_t> minimum{(std::numeric_limits<uint64_t>::max)()} ;
+    std::atomic<uint64_t> maximum{0} ;
+    std::array<std::atomic<uint64_t>, StreamingStatistics::numBuckets> buckets = {} ;
+
+    static inline void add(std::atomic<uint64_t>& value, uint64_t amount)
+    {
+      value.store(value.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed) ;
+    }
+
+  public:
+    // Only called by the owning thread
+    XDP_CORE_EXPORT void record(uint64_t value) ;
+
+    // Can be called by any thread
+    XDP_CORE_EXPORT void mergeInto(StreamingStatistics& result) const ;
+  } ;
+
+} // end namespace xdp
+
+#endif
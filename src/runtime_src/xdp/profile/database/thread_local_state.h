@@ -0,0 +1,117 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef THREAD_LOCAL_STATE_DOT_H
+#define THREAD_LOCAL_STATE_DOT_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace xdp {
+
+  // The state of the calling thread for an owner, such as a database
+  //  or a recorder, that keeps the states of all threads using it.
+  //  The thread caches its state together with the unique id of the
+  //  owner, so finding the state needs no lock.  The state is marked
+  //  as retired when the thread exits or starts using another owner,
+  //  after which the owner can release it.  T must have a
+  //  std::atomic<bool> member named retired.
+  template <typename T>
+  class ThreadLocalState
+  {
+  private:
+    struct Holder
+    {
+      uint64_t owner = 0 ;
+      std::shared_ptr<T> state ;
+
+      void retire()
+      {
+        if (state)
+          state->retired = true ;
+        state.reset() ;
+        owner = 0 ;
+      }
+
+      ~Holder() ;
+    } ;
+
+    // State of calls made after the holder was destroyed during thread
+    //  exit, for example by the destructors of other thread_local
+    //  objects or by static destructors on the main thread.  This is
+    //  trivially destructible so it stays valid until the thread is
+    //  gone.  The state is never retired, so the owner keeps it.
+    struct Late
+    {
+      bool destroyed = false ;
+      uint64_t owner = 0 ;
+      T* state = nullptr ;
+    } ;
+
+    static Holder& holder()
+    {
+      static thread_local Holder local ;
+      return local ;
+    }
+
+    static Late& late()
+    {
+      static thread_local Late local ;
+      return local ;
+    }
+
+  public:
+    // Get the state of the calling thread for the owner with id owner.
+    //  The first time the thread uses the owner, a new state is passed
+    //  to registerState, which adds it to the states kept by the owner.
+    template <typename Register>
+    static T& get(uint64_t owner, Register&& registerState)
+    {
+      auto& fallback = late() ;
+      if (fallback.destroyed) {
+        if (fallback.owner != owner) {
+          auto state = std::make_shared<T>() ;
+          registerState(state) ;
+          fallback.owner = owner ;
+          fallback.state = state.get() ;
+        }
+        return *(fallback.state) ;
+      }
+
+      auto& local = holder() ;
+      if (local.owner == owner)
+        return *(local.state) ;
+
+      local.retire() ;
+      auto state = std::make_shared<T>() ;
+      registerState(state) ;
+      local.owner = owner ;
+      local.state = std::move(state) ;
+      return *(local.state) ;
+    }
+  } ;
+
+  template <typename T>
+  ThreadLocalState<T>::Holder::~Holder()
+  {
+    retire() ;
+    late().destroyed = true ;
+  }
+
+} // end namespace xdp
+
+#endif
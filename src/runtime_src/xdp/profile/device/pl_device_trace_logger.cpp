@@ -17,6 +17,8 @@
 
 #define XDP_CORE_SOURCE
 
+#include <algorithm>
+
 #include "xdp/profile/database/static_info/pl_constructs.h"
 #include "xdp/profile/device/pl_device_trace_logger.h"
 #include "xdp/profile/plugin/vp_base/utility.h"
@@ -78,7 +80,7 @@ namespace xdp {
     auto event = new KernelEvent(startEventID,
                                  hostTimestamp, KERNEL, deviceId, s, cuId);
     event->setDeviceTimestamp(deviceTimestamp);
-    db->getDynamicInfo().addEvent(event);
+    logEvent(event);
     (db->getStats()).setLastKernelEndTime(hostTimestamp);
 
     // Log a CU execution in our statistics database
@@ -117,7 +119,7 @@ namespace xdp {
       // start event
       event = new KernelEvent(0, hostTimestamp, KERNEL, deviceId, slot, cuId);
       event->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(event);
+      logEvent(event);
       DeviceEventInfo info;
       info.type = event->getEventType();
       info.eventID = event->getEventId();
@@ -130,8 +132,7 @@ namespace xdp {
       if(1 == cuStarts[slot].size()) {
         traceIDs[slot] = 0; // When current CU starts, reset stall status
       }
-      if (db->getStats().getFirstKernelStartTime() == 0.0)
-        (db->getStats()).setFirstKernelStartTime(hostTimestamp);
+      (db->getStats()).setFirstKernelStartTime(hostTimestamp);
     }
   }
 
@@ -157,13 +158,13 @@ namespace xdp {
                               slot,
                               cuId);
       event->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(event);
+      logEvent(event);
     }
     else {
       // Start event
       event = new KernelStall(0, hostTimestamp, type, deviceId, slot, cuId);
       event->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(event);
+      logEvent(event);
       DeviceEventInfo info;
       info.type = event->getEventType();
       info.eventID = event->getEventId();
@@ -290,7 +291,7 @@ namespace xdp {
       // start event
       strmEvent = new DeviceStreamAccess(0, hostTimestamp, streamEventType, deviceId, slot, cuId);
       strmEvent->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(strmEvent);
+      logEvent(strmEvent);
       DeviceEventInfo info;
       info.type = strmEvent->getEventType();
       info.eventID = strmEvent->getEventId();
@@ -304,7 +305,7 @@ namespace xdp {
         // add dummy start event
         strmEvent = new DeviceStreamAccess(0, hostTimestamp, streamEventType, deviceId, slot, cuId);
         strmEvent->setDeviceTimestamp(deviceTimestamp);
-        db->getDynamicInfo().addEvent(strmEvent);
+        logEvent(strmEvent);
         matchingStart.type = strmEvent->getEventType();
         matchingStart.eventID = strmEvent->getEventId();
         matchingStart.hostTimestamp = hostTimestamp;
@@ -314,7 +315,7 @@ namespace xdp {
       // add end event
       strmEvent = new DeviceStreamAccess(matchingStart.eventID, hostTimestamp, streamEventType, deviceId, slot, cuId);
       strmEvent->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(strmEvent);
+      logEvent(strmEvent);
       asmLastTrans[slot] = deviceTimestamp;
     }
   }
@@ -346,13 +347,13 @@ namespace xdp {
                                  ty, deviceId, slot, cuId,
                                  memStrId);
         memEvent->setDeviceTimestamp(deviceTimestamp);
-        db->getDynamicInfo().addEvent(memEvent);
+        logEvent(memEvent);
         aimLastTrans[slot] = deviceTimestamp;
       }
 
       memEvent = new DeviceMemoryAccess(0, hostTimestamp, ty, deviceId, slot, cuId, memStrId);
       memEvent->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(memEvent);
+      logEvent(memEvent);
       DeviceEventInfo info;
       info.type = memEvent->getEventType();
       info.eventID = memEvent->getEventId();
@@ -367,7 +368,7 @@ namespace xdp {
         // We need to add a dummy start event for this observed end event
         memEvent = new DeviceMemoryAccess(0, hostTimestamp, ty, deviceId, slot, cuId, memStrId);
         memEvent->setDeviceTimestamp(deviceTimestamp);
-        db->getDynamicInfo().addEvent(memEvent);
+        logEvent(memEvent);
         matchingStart.type = memEvent->getEventType();
         matchingStart.eventID = memEvent->getEventId();
         matchingStart.hostTimestamp = hostTimestamp;
@@ -388,13 +389,13 @@ namespace xdp {
                                             hostTimestamp, ty,
                                             deviceId, slot, cuId, memStrId);
           memEvent->setDeviceTimestamp(deviceTimestamp);
-          db->getDynamicInfo().addEvent(memEvent);
+          logEvent(memEvent);
 
           // Now create the dummy start
           memEvent = new DeviceMemoryAccess(0, hostTimestamp, ty,
                                             deviceId, slot, cuId, memStrId);
           memEvent->setDeviceTimestamp(deviceTimestamp);
-          db->getDynamicInfo().addEvent(memEvent);
+          logEvent(memEvent);
           matchingStart.type = memEvent->getEventType();
           matchingStart.eventID = memEvent->getEventId();
           matchingStart.hostTimestamp = hostTimestamp;
@@ -409,7 +410,7 @@ namespace xdp {
                                         hostTimestamp, ty,
                                         deviceId, slot, cuId, memStrId);
       memEvent->setDeviceTimestamp(deviceTimestamp);
-      db->getDynamicInfo().addEvent(memEvent);
+      logEvent(memEvent);
       aimLastTrans[slot] = deviceTimestamp;
     }
   }
@@ -522,7 +523,7 @@ namespace xdp {
                              type,
                              deviceId, amId, cuId, memStrId);
     endEvent->setDeviceTimestamp(transApproxEndTimestamp);
-    db->getDynamicInfo().addEvent(endEvent);
+    logEvent(endEvent);
   }
 
   void PLDeviceTraceLogger::addApproximateDataTransferEndEvents()
@@ -689,7 +690,7 @@ namespace xdp {
       DeviceStreamAccess* strmEvent = new DeviceStreamAccess(matchingStart.eventID, asmAppxEndHostTimestamp,
                                                            streamEventType, deviceId, asmIndex, cuId);
       strmEvent->setDeviceTimestamp(asmAppxEndTimestamp);
-      db->getDynamicInfo().addEvent(strmEvent);
+      logEvent(strmEvent);
 
       matchingStart = db->getDynamicInfo().matchingDeviceEventStart(deviceId, asmTraceID, streamEventType);
     }
@@ -703,17 +704,15 @@ namespace xdp {
   // to keep track of the last packet we've seen.
   void PLDeviceTraceLogger::trainDeviceHostTimestamps(uint64_t deviceTimestamp, uint64_t hostTimestamp)
   {
-    static double y1 = 0.0;
-    static double y2 = 0.0;
-    static double x1 = 0.0;
-    static double x2 = 0.0;
+    double& y1 = clockTrainingY1;
+    double& x1 = clockTrainingX1;
 
     if (!y1 && !x1) {
       y1 = static_cast <double> (hostTimestamp);
       x1 = static_cast <double> (deviceTimestamp);
     } else {
-      y2 = static_cast <double> (hostTimestamp);
-      x2 = static_cast <double> (deviceTimestamp);
+      double y2 = static_cast <double> (hostTimestamp);
+      double x2 = static_cast <double> (deviceTimestamp);
       // slope in ns/cycle
       if (xdp::getFlowMode() == HW) {
         clockTrainSlope = 1000.0/traceClockRateMHz;
@@ -733,101 +732,206 @@ namespace xdp {
     return ((clockTrainSlope * (double)deviceTimestamp) + clockTrainOffset)/1e6;
   }
 
+  // Classify every packet of a block by the type of monitor that sent
+  //  it.  The loop has no branches and only works on the upper 32 bits
+  //  of every packet (trace id and clock training flag) so it can be
+  //  vectorized.
+  void PLDeviceTraceLogger::classifyPackets(const uint64_t* packets,
+                                            uint64_t count,
+                                            uint32_t* kinds)
+  {
+    constexpr uint32_t amRange  = util::max_trace_id_am - util::min_trace_id_am;
+    constexpr uint32_t asmRange = util::max_trace_id_asm - util::min_trace_id_asm;
+
+    for (uint64_t i = 0; i < count; ++i) {
+      auto high = static_cast<uint32_t>(packets[i] >> 32);
+      uint32_t traceId  = (high >> 17) & 0xFFF;
+      uint32_t training = high >> 31;
+
+      // min trace id aim == 0
+      uint32_t am  = (traceId - util::min_trace_id_am) <= amRange;
+      uint32_t aim = traceId <= util::max_trace_id_aim;
+      uint32_t as  = (traceId - util::min_trace_id_asm) < asmRange;
+
+      uint32_t monitors = am | (aim << 1) | (as << 2);
+      kinds[i] = (monitors & (training - 1)) | (training << 3);
+    }
+  }
+
+  // Convert the device timestamps of a run of packets that are not
+  //  clock training packets, so the conversion is the same for all
+  void PLDeviceTraceLogger::convertTimestamps(const uint64_t* packets,
+                                              uint64_t count,
+                                              double* hostTimestamps)
+  {
+    const double slope  = clockTrainSlope;
+    const double offset = clockTrainOffset;
+
+    for (uint64_t i = 0; i < count; ++i) {
+      auto deviceTimestamp = static_cast<double>(getDeviceTimestamp(packets[i]));
+      hostTimestamps[i] = ((slope * deviceTimestamp) + offset)/1e6;
+    }
+  }
+
+  // Try to find 8 contiguous clock training packets.  Anything before that
+  //  is garbage from the previous run
+  uint64_t PLDeviceTraceLogger::findClockTrainingStart(const uint64_t* packets,
+                                                       uint64_t numPackets)
+  {
+    uint64_t contiguous = 0;
+    for (uint64_t i = 0; i < numPackets; ++i) {
+      contiguous = isClockTraining(packets[i]) ? contiguous + 1 : 0;
+      if (contiguous == 8) {
+        clockTrainingFound = true;
+        return i - 7;
+      }
+    }
+    return 0;
+  }
+
+  void PLDeviceTraceLogger::processClockTraining(uint64_t packet)
+  {
+    auto clockTrainingDeviceTimestamp = getDeviceTimestamp(packet);
+
+    if (clockTrainingModulus == 0) {
+      if (clockTrainingDeviceTimestamp >= firstTimestamp) {
+        clockTrainingDeviceTimestamp =
+          clockTrainingDeviceTimestamp - firstTimestamp;
+      }
+      else {
+        clockTrainingDeviceTimestamp =
+          clockTrainingDeviceTimestamp + (0x1FFFFFFFFFFF - firstTimestamp);
+      }
+    }
+    clockTrainingHostTimestamp |=
+      ((packet >> 45) & 0xFFFF) << (16 * clockTrainingModulus);
+    ++clockTrainingModulus;
+    if (clockTrainingModulus == 4) {
+      // It requires four complete clock training packets before
+      //  we can perform the clock training algorithm
+      trainDeviceHostTimestamps(clockTrainingDeviceTimestamp,
+                                clockTrainingHostTimestamp);
+      clockTrainingHostTimestamp = 0;
+      clockTrainingModulus = 0;
+    }
+  }
+
+  // The ID of the event is issued right away so the event can be
+  //  matched, but the event is added to the database with the rest
+  //  of the events decoded from the same buffer
+  void PLDeviceTraceLogger::logEvent(VTFEvent* event)
+  {
+    db->getDynamicInfo().issueEventId(event);
+    pendingEvents.push_back(event);
+  }
+
+  void PLDeviceTraceLogger::flushEvents()
+  {
+    if (pendingEvents.empty())
+      return;
+    db->getDynamicInfo().addDeviceEvents(deviceId, pendingEvents);
+    pendingEvents.clear();
+  }
+
   void PLDeviceTraceLogger::processTraceData(void* data, uint64_t numBytes)
+  {
+    decodeTraceData(data, numBytes);
+    flushEvents();
+  }
+
+  void PLDeviceTraceLogger::decodeTraceData(void* data, uint64_t numBytes)
   {
     if (numBytes == 0)
       return;
     if (!VPDatabase::alive())
       return;
 
+    auto packets = static_cast<const uint64_t*>(data);
     uint64_t numPackets = numBytes / sizeof(uint64_t);
     uint64_t start = 0;
 
-    // Try to find 8 contiguous clock training packets.  Anything before that
-    //  is garbage from the previous run
     // Note: This needs to be done only in beginning chunk of data
-    static bool found = false;
-    if (!found) {
-      for (uint64_t i = 0; i < numPackets - 8; ++i) {
-        for (uint64_t j = i; j < i + 8; ++j) {
-          uint64_t packet = (static_cast<uint64_t*>(data))[j];
-          if (!isClockTraining(packet))
-            break;
-          if (j == (i + 7)) {
-            start = i ;
-            found = true;
-          }
+    if (!clockTrainingFound)
+      start = findClockTrainingStart(packets, numPackets);
+
+    uint32_t kinds[decodeBlockSize];
+    double hostTimestamps[decodeBlockSize];
+
+    for (uint64_t blockStart = start; blockStart < numPackets;
+         blockStart += decodeBlockSize) {
+      const uint64_t* block = packets + blockStart;
+      uint64_t count = std::min(decodeBlockSize, numPackets - blockStart);
+
+      classifyPackets(block, count, kinds);
+
+      // Clock training packets change the conversion of device
+      //  timestamps, so convert the runs of packets between them
+      uint64_t runStart = 0;
+      while (runStart < count) {
+        uint64_t runEnd = runStart;
+        while (runEnd < count && !(kinds[runEnd] & TRAINING_PACKET))
+          ++runEnd;
+
+        convertTimestamps(block + runStart, runEnd - runStart,
+                          hostTimestamps + runStart);
+
+        for (uint64_t i = runStart; i < runEnd; ++i) {
+          auto kind = kinds[i];
+          if (kind == 0)
+            continue;
+
+          if (kind & AM_PACKET)
+            addAMEvent(block[i], hostTimestamps[i]);
+          if (kind & AIM_PACKET)
+            addAIMEvent(block[i], hostTimestamps[i]);
+          if (kind & ASM_PACKET)
+            addASMEvent(block[i], hostTimestamps[i]);
+
+          // keep track of latest timestamp that comes through trace
+          mLatestHostTimestampMs = hostTimestamps[i];
         }
-        if (found)
-          break;
-      }
-    }
-
-    // Clock Training state is preserved across calls
-    static uint32_t modulus = 0;
-    static uint64_t clockTrainingHostTimestamp = 0;
-
-    for (uint64_t i = start ; i < numPackets ; ++i) {
-      uint64_t packet = (static_cast<uint64_t*>(data))[i];
-      auto deviceTimestamp = getDeviceTimestamp(packet);
-      auto traceId = getTraceId(packet);
-      auto clockTrainingDeviceTimestamp = deviceTimestamp;
 
-      /*
-      if (i == start && firstTimestamp == 0) {
-        firstTimestamp = deviceTimestamp ;
+        if (runEnd < count)
+          processClockTraining(block[runEnd]);
+        runStart = runEnd + 1;
       }
-      */
-
-      if (isClockTraining(packet)) {
-        if (modulus == 0) {
-          if (clockTrainingDeviceTimestamp >= firstTimestamp) {
-            clockTrainingDeviceTimestamp =
-              clockTrainingDeviceTimestamp - firstTimestamp;
-          }
-          else {
-            clockTrainingDeviceTimestamp =
-              clockTrainingDeviceTimestamp + (0x1FFFFFFFFFFF - firstTimestamp);
-          }
-        }
-        clockTrainingHostTimestamp |= ((packet >> 45) & 0xFFFF) << (16 * modulus);
-        ++modulus;
-        if (modulus == 4) {
-          // It requires four complete clock training packets before
-          //  we can perform the clock training algorithm
-          trainDeviceHostTimestamps(clockTrainingDeviceTimestamp,
-                                    clockTrainingHostTimestamp);
-          clockTrainingHostTimestamp = 0;
-          clockTrainingDeviceTimestamp = 0;
-          modulus = 0;
-        }
-        continue;
-      }
-
-      bool AMPacket  = (traceId >= util::min_trace_id_am &&
-                        traceId <= util::max_trace_id_am);
-      bool AIMPacket = (traceId <= util::max_trace_id_aim); // min trace id aim == 0
-      bool ASMPacket = (traceId >= util::min_trace_id_asm &&
-                        traceId <  util::max_trace_id_asm);
-      if (!AMPacket && !AIMPacket && !ASMPacket) {
-        continue;
-      }
-
-      double hostTimestamp = convertDeviceToHostTimestamp(deviceTimestamp);
-      if (AMPacket) {
-        addAMEvent(packet, hostTimestamp);
-      }
-      if (AIMPacket) {
-        addAIMEvent(packet, hostTimestamp);
-      }
-      if (ASMPacket) {
-        addASMEvent(packet, hostTimestamp);
-      }
-
-      // keep track of latest timestamp that comes through trace
-      mLatestHostTimestampMs = hostTimestamp;
     }
+  }
 
+  std::vector<VTFEvent*> PLDeviceTraceLogger::takeEvents()
+  {
+    std::vector<VTFEvent*> events;
+    events.swap(pendingEvents);
+    return events;
+  }
+
+  // When the trace of a device is split over several streams, each
+  //  stream is decoded by its own logger.  At the end of the trace the
+  //  state of the other loggers is merged into this one, so the
+  //  approximate end events are added once and with the complete view
+  //  of every monitor.
+  void PLDeviceTraceLogger::mergeStreamState(PLDeviceTraceLogger& other)
+  {
+    auto mergeLast = [](std::vector<uint64_t>& mine,
+                        const std::vector<uint64_t>& theirs)
+    {
+      for (size_t i = 0; i < mine.size() && i < theirs.size(); ++i)
+        mine[i] = std::max(mine[i], theirs[i]);
+    };
+    mergeLast(amLastTrans, other.amLastTrans);
+    mergeLast(aimLastTrans, other.aimLastTrans);
+    mergeLast(asmLastTrans, other.asmLastTrans);
+
+    for (size_t i = 0; i < traceIDs.size() && i < other.traceIDs.size(); ++i)
+      traceIDs[i] |= other.traceIDs[i];
+    for (size_t i = 0; i < cuStarts.size() && i < other.cuStarts.size(); ++i)
+      cuStarts[i].splice(cuStarts[i].end(), other.cuStarts[i]);
+
+    mLatestHostTimestampMs =
+      std::max(mLatestHostTimestampMs, other.mLatestHostTimestampMs);
+
+    auto events = other.takeEvents();
+    pendingEvents.insert(pendingEvents.end(), events.begin(), events.end());
   }
 
   void PLDeviceTraceLogger::endProcessTraceData()
@@ -835,6 +939,7 @@ namespace xdp {
     addApproximateCUEndEvents();
     addApproximateDataTransferEndEvents();
     addApproximateStreamEndEvents();
+    flushEvents();
   }
 
   void PLDeviceTraceLogger::addEventMarkers(bool isFIFOFull, bool isTS2MMFull)
@@ -62,6 +62,38 @@ namespace xdp {
     double traceClockRateMHz;
     double clockTrainSlope;
 
+    // Clock training state is preserved across calls for each device.
+    //  Clock training information is spread over four packets, and
+    //  two trainings are needed to compute the slope.
+    bool clockTrainingFound = false;
+    uint32_t clockTrainingModulus = 0;
+    uint64_t clockTrainingHostTimestamp = 0;
+    double clockTrainingX1 = 0.0;
+    double clockTrainingY1 = 0.0;
+
+    // Packets are decoded in blocks.  Each block is first classified
+    //  and timestamp converted in loops without branches or calls, and
+    //  the events created from the block are added to the database in
+    //  bulk at the end of every buffer.
+    static constexpr uint64_t decodeBlockSize = 256;
+    enum PacketKind : uint32_t {
+      AM_PACKET       = 0x1,
+      AIM_PACKET      = 0x2,
+      ASM_PACKET      = 0x4,
+      TRAINING_PACKET = 0x8
+    };
+    std::vector<VTFEvent*> pendingEvents;
+
+    static void classifyPackets(const uint64_t* packets, uint64_t count,
+                                uint32_t* kinds);
+    void convertTimestamps(const uint64_t* packets, uint64_t count,
+                           double* hostTimestamps);
+    uint64_t findClockTrainingStart(const uint64_t* packets,
+                                    uint64_t numPackets);
+    void processClockTraining(uint64_t packet);
+    void logEvent(VTFEvent* event);
+    void flushEvents();
+
     bool warnCUIncomplete=false;
 
     void trainDeviceHostTimestamps(uint64_t deviceTimestamp, uint64_t hostTimestamp);
@@ -113,7 +145,16 @@ namespace xdp {
     XDP_CORE_EXPORT PLDeviceTraceLogger(uint64_t devId);
     XDP_CORE_EXPORT ~PLDeviceTraceLogger() = default;
 
+    inline uint64_t getDeviceId() const { return deviceId; }
+
     XDP_CORE_EXPORT void processTraceData(void* data, uint64_t numBytes);
+
+    // Decode without adding the events to the database.  The caller
+    //  takes the decoded events and adds them itself.
+    XDP_CORE_EXPORT void decodeTraceData(void* data, uint64_t numBytes);
+    XDP_CORE_EXPORT std::vector<VTFEvent*> takeEvents();
+    XDP_CORE_EXPORT void mergeStreamState(PLDeviceTraceLogger& other);
+
     XDP_CORE_EXPORT void endProcessTraceData();
     XDP_CORE_EXPORT void addEventMarkers(bool isFIFOFull, bool isTS2MMFull);
   } ;
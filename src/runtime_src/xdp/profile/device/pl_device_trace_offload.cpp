@@ -29,13 +29,13 @@ PLDeviceTraceOffload
   , PLDeviceTraceLogger* dTraceLogger
   , uint64_t sleep_interval_ms
   , uint64_t trbuf_sz
+  , unsigned int decode_threads
   )
   : dev_intf(dInt)
   , deviceTraceLogger(dTraceLogger)
+  , decode_threads(decode_threads)
   , sleep_interval_ms(sleep_interval_ms)
   , m_prev_clk_train_time(std::chrono::system_clock::now())
-  , m_process_trace(false)
-  , m_process_trace_done(false)
 {
   // Select appropriate reader
   if (has_fifo()) {
@@ -55,9 +55,6 @@ PLDeviceTraceOffload::
   if (offload_thread.joinable()) {
     offload_thread.join();
   }
-  if (process_thread.joinable()) {
-    process_thread.join();
-  }
 }
 
 void PLDeviceTraceOffload::
@@ -79,11 +76,7 @@ offload_device_continuous()
   // Note : Passing "true" also flushes and resets the datamover
   m_read_trace(true);
 
-  // Stop processing thread
-  m_process_trace = false;
-  while (!m_process_trace_done);
-
-  // Clear all state and add approximations
+  // Wait for the decode, clear all state and add approximations
   read_trace_end();
 
   // Tell external plugin that offload has finished
@@ -101,59 +94,13 @@ train_clock_continuous()
   offload_finished();
 }
 
-void PLDeviceTraceOffload::
-process_trace_continuous()
-{
-  if (!has_ts2mm())
-    return;
-
-  m_process_trace = true;
-  m_process_trace_done = false;
-  while (m_process_trace)
-  {
-    process_trace();
-    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_interval_ms));
-  }
-  // One last time
-  process_trace();
-  m_process_trace_done = true;
-}
-
 void PLDeviceTraceOffload::
 process_trace()
 {
-  if (!has_ts2mm())
+  if (!has_ts2mm() || !decode_pipeline)
     return;
 
-  bool q_read = false;
-  bool q_empty = true;
-  std::unique_ptr<unsigned char[]> buf;
-  uint64_t size = 0;
-  do {
-    q_read=false;
-    ts2mm_info.process_queue_lock.lock();
-    if (!ts2mm_info.data_queue.empty()) {
-      buf = std::move(ts2mm_info.data_queue.front());
-      size = ts2mm_info.size_queue.front();
-      ts2mm_info.data_queue.pop();
-      ts2mm_info.size_queue.pop();
-      q_read = true;
-      q_empty = ts2mm_info.data_queue.empty();
-    }
-    if (ts2mm_info.size_queue.size() > TS2MM_QUEUE_SZ_WARN_THRESHOLD) {
-      std::call_once(ts2mm_queue_warning_flag, [](){
-        xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", TS2MM_WARN_MSG_QUEUE_SZ);
-      });
-    }
-    ts2mm_info.process_queue_lock.unlock();
-
-    // Processing takes a lot more time compared to everything else
-    if (q_read) {
-      debug_stream << "Process " << size << " bytes of trace" << std::endl;
-      deviceTraceLogger->processTraceData(buf.get(), size) ;
-      buf.reset();
-    }
-  } while (!q_empty);
+  decode_pipeline->drain();
 }
 
 bool PLDeviceTraceOffload::
@@ -173,8 +120,9 @@ start_offload(OffloadThreadType type)
   status = OffloadThreadStatus::RUNNING;
 
   if (type == OffloadThreadType::TRACE) {
+    if (decode_pipeline)
+      decode_pipeline->start();
     offload_thread = std::thread(&PLDeviceTraceOffload::offload_device_continuous, this);
-    process_thread = std::thread(&PLDeviceTraceOffload::process_trace_continuous, this);
   } else if (type == OffloadThreadType::CLOCK_TRAIN) {
     offload_thread = std::thread(&PLDeviceTraceOffload::train_clock_continuous, this);
   }
@@ -272,7 +220,10 @@ read_trace_end()
 {
   // Trace logger will clear it's state and add approximations 
   // for pending events
-  deviceTraceLogger->endProcessTraceData();
+  if (decode_pipeline)
+    decode_pipeline->finish();
+  else
+    deviceTraceLogger->endProcessTraceData();
 
   // Add event markers at end of trace data
   bool isFIFOFull = fifo_full;
@@ -395,11 +346,8 @@ sync_and_log(uint64_t index)
 
   auto tmp = std::make_unique<unsigned char[]>(nBytes);
   std::memcpy(tmp.get(), host_buf, nBytes);
-  // Push new data into queue for processing
-  ts2mm_info.process_queue_lock.lock();
-  ts2mm_info.data_queue.push(std::move(tmp));
-  ts2mm_info.size_queue.push(nBytes);
-  ts2mm_info.process_queue_lock.unlock();
+  // Push new data into the pipeline for decoding
+  decode_pipeline->push(index, std::move(tmp), nBytes);
 
   // Print warning if processing large amount of trace
   if (nBytes > TS2MM_WARN_BIG_BUF_SIZE && !bd.big_trace_warn_done) {
@@ -426,6 +374,12 @@ init_s2mm(bool circ_buf, const std::vector<uint64_t> &buf_sizes)
   if (buf_sizes.empty())
     return false;
 
+  decode_pipeline =
+    std::make_unique<PLTraceDecodePipeline>(deviceTraceLogger,
+                                            ts2mm_info.num_ts2mm,
+                                            decode_threads,
+                                            TS2MM_DECODE_QUEUE_DEPTH);
+
   // Check if allocated buffer and sleep interval can keep up with offload
   if (dev_intf->supportsCircBufPL() && circ_buf) {
     if (sleep_interval_ms != 0) {
@@ -473,6 +427,7 @@ reset_s2mm()
     ts2mm_info.buffers[i].bufId = 0;
   }
   ts2mm_info.buffers.clear();
+  decode_pipeline.reset();
 }
 
 bool PLDeviceTraceOffload::
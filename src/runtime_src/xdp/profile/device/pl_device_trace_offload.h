@@ -22,6 +22,7 @@
 #include "xdp/config.h"
 #include "xdp/profile/device/pl_device_intf.h"
 #include "xdp/profile/device/pl_device_trace_logger.h"
+#include "xdp/profile/device/pl_trace_decode_pipeline.h"
 #include "xdp/profile/device/tracedefs.h"
 #include "xdp/profile/plugin/vp_base/utility.h"
 
@@ -89,10 +90,6 @@ struct Ts2mmInfo {
   uint64_t circ_buf_min_rate = TS2MM_DEF_BUF_SIZE * 100;
   uint64_t circ_buf_cur_rate;
 
-  std::queue<std::unique_ptr<unsigned char[]>> data_queue;
-  std::queue<uint64_t> size_queue;
-  std::mutex process_queue_lock;
-
   Ts2mmInfo()
     : num_ts2mm(0),
       full_buf_size(0),
@@ -111,7 +108,8 @@ class PLDeviceTraceOffload {
 public:
   XDP_CORE_EXPORT
   PLDeviceTraceOffload(PLDeviceIntf* dInt, PLDeviceTraceLogger* dTraceLogger,
-                       uint64_t offload_sleep_ms, uint64_t trbuf_sz);
+                       uint64_t offload_sleep_ms, uint64_t trbuf_sz,
+                       unsigned int decode_threads = 1);
   XDP_CORE_EXPORT
   virtual ~PLDeviceTraceOffload();
   XDP_CORE_EXPORT
@@ -167,7 +165,6 @@ private:
   void train_clock_continuous();
   void offload_device_continuous();
   void offload_finished();
-  void process_trace_continuous();
   bool sync_and_log(uint64_t index);
 
 protected:
@@ -180,6 +177,11 @@ private:
   std::function<void(bool)> m_read_trace;
   Ts2mmInfo ts2mm_info;
 
+  // Decodes the trace offloaded from the TS2MMs.  There is one stream
+  //  per TS2MM.  The decode workers only run during continuous offload.
+  std::unique_ptr<PLTraceDecodePipeline> decode_pipeline;
+  unsigned int decode_threads;
+
   // fifo doesn't support circular buffer mode
   bool fifo_full = false;
 
@@ -188,19 +190,13 @@ private:
   uint64_t sleep_interval_ms;
   OffloadThreadStatus status = OffloadThreadStatus::IDLE;
   std::thread offload_thread;
-  std::thread process_thread;
   bool continuous = false;
 
   // Clock Training Params
   bool m_force_clk_train = true;
   std::chrono::time_point<std::chrono::system_clock> m_prev_clk_train_time;
 
-  // Internal flags to end trace processing thread
-  std::atomic<bool> m_process_trace;
-  std::atomic<bool> m_process_trace_done;
-
   // Internal flags to keep track of warnings
-  std::once_flag ts2mm_queue_warning_flag;
   std::once_flag fifo_full_warning_flag;
   std::once_flag ts2mm_full_warning_flag;
 };
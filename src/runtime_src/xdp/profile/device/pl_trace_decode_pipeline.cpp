@@ -0,0 +1,206 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include <algorithm>
+
+#include "core/common/message.h"
+#include "xdp/profile/database/database.h"
+#include "xdp/profile/device/pl_device_trace_logger.h"
+#include "xdp/profile/device/pl_trace_decode_pipeline.h"
+#include "xdp/profile/device/tracedefs.h"
+
+namespace xdp {
+
+  PLTraceDecodePipeline::PLTraceDecodePipeline(PLDeviceTraceLogger* logger,
+                                               size_t numStreams,
+                                               size_t numWorkers,
+                                               size_t queueDepth)
+    : deviceId(logger->getDeviceId())
+    , db(VPDatabase::Instance())
+  {
+    numStreams = (std::max)(numStreams, static_cast<size_t>(1));
+    numWorkers = (std::clamp)(numWorkers, static_cast<size_t>(1), numStreams);
+
+    for (size_t s = 0; s < numStreams; ++s) {
+      auto stream = std::make_unique<Stream>(logger, queueDepth);
+      if (s != 0) {
+        stream->ownedLogger = std::make_unique<PLDeviceTraceLogger>(deviceId);
+        stream->logger = stream->ownedLogger.get();
+      }
+      streams.push_back(std::move(stream));
+    }
+
+    // Every chunk queued for a worker can become one batch
+    for (size_t w = 0; w < numWorkers; ++w) {
+      size_t workerStreams = (numStreams - w + numWorkers - 1) / numWorkers;
+      workers.push_back(std::make_unique<Worker>(queueDepth * workerStreams));
+    }
+    for (size_t s = 0; s < numStreams; ++s)
+      workers[s % numWorkers]->streams.push_back(s);
+  }
+
+  PLTraceDecodePipeline::~PLTraceDecodePipeline()
+  {
+    stop();
+  }
+
+  std::vector<VTFEvent*>
+  PLTraceDecodePipeline::decode(Stream& stream, Chunk& chunk)
+  {
+    stream.logger->decodeTraceData(chunk.data.get(), chunk.size);
+    chunk.data.reset();
+    return stream.logger->takeEvents();
+  }
+
+  void PLTraceDecodePipeline::insert(std::vector<VTFEvent*>& batch)
+  {
+    if (!batch.empty())
+      db->getDynamicInfo().addDeviceEvents(deviceId, batch);
+    chunksInserted.fetch_add(1, std::memory_order_release);
+  }
+
+  // Without threads, the thread pushing decodes and inserts the chunks
+  void PLTraceDecodePipeline::decodeQueued(Stream& stream)
+  {
+    Chunk chunk;
+    while (stream.chunks.tryPop(chunk)) {
+      auto batch = decode(stream, chunk);
+      insert(batch);
+    }
+  }
+
+  void PLTraceDecodePipeline::decodeLoop(Worker& worker)
+  {
+    while (true) {
+      bool idle = true;
+      for (auto s : worker.streams) {
+        Chunk chunk;
+        if (!streams[s]->chunks.tryPop(chunk))
+          continue;
+        idle = false;
+
+        auto batch = decode(*streams[s], chunk);
+        while (!worker.batches.tryPush(std::move(batch)))
+          std::this_thread::sleep_for(idleWait);
+      }
+
+      // All chunks have been drained before running is cleared
+      if (idle) {
+        if (!running.load(std::memory_order_acquire))
+          break;
+        std::this_thread::sleep_for(idleWait);
+      }
+    }
+  }
+
+  void PLTraceDecodePipeline::insertLoop()
+  {
+    while (true) {
+      bool idle = true;
+      for (auto& worker : workers) {
+        std::vector<VTFEvent*> batch;
+        while (worker->batches.tryPop(batch)) {
+          idle = false;
+          insert(batch);
+        }
+      }
+
+      if (idle) {
+        if (!running.load(std::memory_order_acquire))
+          break;
+        std::this_thread::sleep_for(idleWait);
+      }
+    }
+  }
+
+  void PLTraceDecodePipeline::start()
+  {
+    if (running)
+      return;
+
+    running = true;
+    for (auto& worker : workers)
+      worker->thread = std::thread(&PLTraceDecodePipeline::decodeLoop, this,
+                                   std::ref(*worker));
+    inserter = std::thread(&PLTraceDecodePipeline::insertLoop, this);
+  }
+
+  void PLTraceDecodePipeline::push(size_t stream,
+                                   std::unique_ptr<unsigned char[]> data,
+                                   uint64_t size)
+  {
+    if (stream >= streams.size() || !data || size == 0)
+      return;
+
+    auto& s = *streams[stream];
+    Chunk chunk{std::move(data), size};
+    while (!s.chunks.tryPush(std::move(chunk))) {
+      if (!running) {
+        decodeQueued(s);
+        continue;
+      }
+
+      // The decode cannot keep up, so hold the offload back
+      std::call_once(queueFullWarning, []() {
+        xrt_core::message::send(xrt_core::message::severity_level::warning,
+                                "XRT", TS2MM_WARN_MSG_QUEUE_SZ);
+      });
+      std::this_thread::sleep_for(idleWait);
+    }
+    chunksPushed.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void PLTraceDecodePipeline::drain()
+  {
+    if (!running) {
+      for (auto& stream : streams)
+        decodeQueued(*stream);
+      return;
+    }
+
+    while (chunksInserted.load(std::memory_order_acquire) !=
+           chunksPushed.load(std::memory_order_relaxed))
+      std::this_thread::sleep_for(idleWait);
+  }
+
+  void PLTraceDecodePipeline::stop()
+  {
+    drain();
+    if (!running)
+      return;
+
+    running.store(false, std::memory_order_release);
+    for (auto& worker : workers) {
+      if (worker->thread.joinable())
+        worker->thread.join();
+    }
+    if (inserter.joinable())
+      inserter.join();
+  }
+
+  void PLTraceDecodePipeline::finish()
+  {
+    stop();
+
+    auto logger = streams[0]->logger;
+    for (size_t s = 1; s < streams.size(); ++s)
+      logger->mergeStreamState(*(streams[s]->logger));
+    logger->endProcessTraceData();
+  }
+
+} // end namespace xdp
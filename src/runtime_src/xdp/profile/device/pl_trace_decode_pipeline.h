@@ -0,0 +1,137 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef XDP_PROFILE_DEVICE_PL_TRACE_DECODE_PIPELINE_H_
+#define XDP_PROFILE_DEVICE_PL_TRACE_DECODE_PIPELINE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "xdp/config.h"
+#include "xdp/profile/device/spsc_queue.h"
+
+namespace xdp {
+
+  // Forward declarations
+  class PLDeviceTraceLogger;
+  class VPDatabase;
+  class VTFEvent;
+
+  // The PL trace of a device is decoded in three stages.  The reader
+  //  (the offload thread, or a recorded trace dump) pushes raw chunks of
+  //  every stream (one stream per TS2MM), decode workers turn the chunks
+  //  into events, and a single inserter adds the events to the database
+  //  in bulk.  The stages are connected by bounded lock free queues, so a
+  //  reader that gets too far ahead waits for the decode instead of
+  //  growing the memory used without limit.
+  //
+  // Each stream comes from its own trace funnel with its own clock
+  //  training, so the packets of a stream have to be decoded in order by
+  //  one logger.  Streams are assigned to the workers round robin, so
+  //  more workers than streams are never used.
+  //
+  // Until start() is called there are no threads and all of the work is
+  //  done by the thread calling push() and drain().
+  class PLTraceDecodePipeline
+  {
+  private:
+    struct Chunk
+    {
+      std::unique_ptr<unsigned char[]> data;
+      uint64_t size = 0;
+    };
+
+    struct Stream
+    {
+      PLDeviceTraceLogger* logger;
+      std::unique_ptr<PLDeviceTraceLogger> ownedLogger;
+      SPSCQueue<Chunk> chunks;
+
+      Stream(PLDeviceTraceLogger* l, size_t depth) : logger(l), chunks(depth) {}
+    };
+
+    struct Worker
+    {
+      std::vector<size_t> streams;
+      SPSCQueue<std::vector<VTFEvent*>> batches;
+      std::thread thread;
+
+      explicit Worker(size_t depth) : batches(depth) {}
+    };
+
+    static constexpr std::chrono::microseconds idleWait{500};
+
+    uint64_t deviceId;
+    VPDatabase* db;
+    std::vector<std::unique_ptr<Stream>> streams;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::thread inserter;
+
+    std::atomic<bool> running{false};
+    // Every chunk pushed is inserted as one batch of events, which
+    //  may be empty
+    std::atomic<uint64_t> chunksPushed{0};
+    std::atomic<uint64_t> chunksInserted{0};
+
+    std::once_flag queueFullWarning;
+
+    std::vector<VTFEvent*> decode(Stream& stream, Chunk& chunk);
+    void insert(std::vector<VTFEvent*>& batch);
+    void decodeQueued(Stream& stream);
+    void decodeLoop(Worker& worker);
+    void insertLoop();
+
+  public:
+    // The first stream is decoded by logger, a logger is created
+    //  for each additional stream
+    XDP_CORE_EXPORT
+    PLTraceDecodePipeline(PLDeviceTraceLogger* logger, size_t numStreams,
+                          size_t numWorkers, size_t queueDepth);
+    XDP_CORE_EXPORT ~PLTraceDecodePipeline();
+
+    PLTraceDecodePipeline(const PLTraceDecodePipeline&) = delete;
+    PLTraceDecodePipeline& operator=(const PLTraceDecodePipeline&) = delete;
+
+    // Start the decode workers and the inserter
+    XDP_CORE_EXPORT void start();
+
+    // Read stage.  Only one thread at a time may push.
+    XDP_CORE_EXPORT void push(size_t stream, std::unique_ptr<unsigned char[]> data,
+                              uint64_t size);
+
+    // Wait until every chunk pushed so far is in the database.  Must be
+    //  called by the thread that pushes.
+    XDP_CORE_EXPORT void drain();
+
+    // Drain and stop the threads
+    XDP_CORE_EXPORT void stop();
+
+    // Stop, then merge the state of all streams into the first logger
+    //  and add approximate events for anything left unfinished
+    XDP_CORE_EXPORT void finish();
+
+    inline size_t getNumStreams() const { return streams.size(); }
+    inline size_t getNumWorkers() const { return workers.size(); }
+  };
+
+} // end namespace xdp
+
+#endif
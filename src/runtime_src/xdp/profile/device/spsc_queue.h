@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef XDP_PROFILE_DEVICE_SPSC_QUEUE_H_
+#define XDP_PROFILE_DEVICE_SPSC_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace xdp {
+
+  // A bounded, lock free queue with exactly one thread pushing and one
+  //  thread popping.  The positions only ever increase, so the queue is
+  //  full when the producer is a whole capacity ahead of the consumer.
+  template <typename T>
+  class SPSCQueue
+  {
+  private:
+    std::vector<T> slots;
+
+    // Each position is written by one side only, keep them on separate
+    //  cache lines so the producer and consumer do not share one
+    alignas(64) std::atomic<size_t> head{0}; // Next position to pop
+    alignas(64) std::atomic<size_t> tail{0}; // Next position to push
+
+  public:
+    explicit SPSCQueue(size_t capacity)
+      : slots((std::max)(capacity, static_cast<size_t>(1)))
+    {}
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    // Only called by the producer.  Returns false if the queue is full,
+    //  in which case value is left untouched.
+    bool tryPush(T&& value)
+    {
+      size_t t = tail.load(std::memory_order_relaxed);
+      if (t - head.load(std::memory_order_acquire) == slots.size())
+        return false;
+      slots[t % slots.size()] = std::move(value);
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Only called by the consumer.  Returns false if the queue is empty.
+    bool tryPop(T& value)
+    {
+      size_t h = head.load(std::memory_order_relaxed);
+      if (h == tail.load(std::memory_order_acquire))
+        return false;
+      value = std::move(slots[h % slots.size()]);
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Can be called from either side, but is only exact when the other
+    //  side is not running
+    size_t size() const
+    {
+      // Read head first, the tail can only be further ahead of it
+      size_t h = head.load(std::memory_order_acquire);
+      return tail.load(std::memory_order_acquire) - h;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return slots.size(); }
+  };
+
+} // end namespace xdp
+
+#endif
@@ -51,9 +51,9 @@
 // Read data only if it's more than 512B unless forced
 #define TS2MM_MIN_READ_SIZE      0x200
 #define DEFAULT_TRACE_OFFLOAD_INTERVAL_MS 10
-// Throw warning when too much trace in processing pipeline
-// Use some arbitrary large number here
-#define TS2MM_QUEUE_SZ_WARN_THRESHOLD 5000
+// Number of offloaded chunks of each TS2MM waiting to be decoded.
+// The offload waits for the decode once this many are queued.
+#define TS2MM_DECODE_QUEUE_DEPTH 64
 
 // In some cases, we cannot use coarse mode
 #define COARSE_MODE_UNSUPPORTED "Coarse mode cannot be enabled. Defaulting to fine mode. Please check compilation for details."
@@ -74,8 +74,8 @@ Please increase trace_buffer_size or use 'coarse' option for device_trace or tur
 buffer size and/or reduce trace_buffer_offload_interval."
 #define TS2MM_WARN_MSG_CIRC_BUF_OVERWRITE   "Circular buffer overwrite was detected in device trace. Timeline trace could be incomplete."
 #define TS2MM_WARN_MSG_BIG_BUF         "Processing large amount of device trace. It could take a while before application ends."
-#define TS2MM_WARN_MSG_QUEUE_SZ        "Too much trace in processing queue. This could have negative impact on host memory utilization. \
-Please increase trace_buffer_size and trace_buffer_offload_interval together or use 'coarse' option for device_trace."
+#define TS2MM_WARN_MSG_QUEUE_SZ        "Too much trace in processing queue. Trace offload is delayed until the trace is decoded. \
+Please increase trace_decode_threads or trace_buffer_size and trace_buffer_offload_interval together or use 'coarse' option for device_trace."
 
 // Throw warning if following thresholds aren't met for reuse_buffer
 #define AIE_MIN_SIZE_CIRCULAR_BUF 0x800000
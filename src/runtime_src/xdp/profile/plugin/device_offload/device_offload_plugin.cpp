@@ -88,7 +88,8 @@ namespace xdp {
 
   PLDeviceOffloadPlugin::PLDeviceOffloadPlugin() :
     XDPPlugin(),
-    device_trace(false), continuous_trace(false), trace_buffer_offload_interval_ms(10)
+    device_trace(false), continuous_trace(false), trace_buffer_offload_interval_ms(10),
+    trace_decode_threads(1)
   {
     db->registerPlugin(this) ;
 
@@ -109,6 +110,8 @@ namespace xdp {
       trace_buffer_offload_interval_ms =
         xrt_core::config::get_trace_buffer_offload_interval_ms();
 
+      trace_decode_threads = xrt_core::config::get_trace_decode_threads();
+
       m_enable_circular_buffer = continuous_trace;
     }
     else {
@@ -143,7 +146,8 @@ namespace xdp {
                                              xrtVersion,
                                              toolVersion);
     writers.push_back(writer);
-    (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(), "VP_TRACE") ;
+    (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(),
+                                        writer->getFileType("VP_TRACE")) ;
 
     if (continuous_trace)
       XDPPlugin::startWriteThread(XDPPlugin::get_trace_file_dump_int_s(), "VP_TRACE");
@@ -242,7 +246,8 @@ namespace xdp {
     PLDeviceTraceOffload* offloader = 
       new PLDeviceTraceOffload(devInterface, logger,
                                trace_buffer_offload_interval_ms, // offload_sleep_ms
-                               trace_buffer_size);           // trace buffer size
+                               trace_buffer_size,            // trace buffer size
+                               trace_decode_threads);
 
     // If trace is enabled, set up trace.  Otherwise just keep the offloader
     //  for reading the counters.
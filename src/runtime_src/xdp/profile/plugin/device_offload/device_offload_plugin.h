@@ -49,6 +49,7 @@ namespace xdp {
     bool device_trace;
     bool continuous_trace ;
     unsigned int trace_buffer_offload_interval_ms ;
+    unsigned int trace_decode_threads ;
     bool m_enable_circular_buffer = false;
 
   protected:
@@ -138,7 +138,8 @@ namespace xdp {
     VPWriter* writer = new LowOverheadTraceWriter("lop_trace.csv") ;
     writers.push_back(writer) ;
 
-    (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(), "VP_TRACE") ;
+    (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(),
+                                        writer->getFileType("VP_TRACE")) ;
 
     // In order to avoid overhead later, preallocate the string table
     //  in the dynamic database with all of the strings we will store
@@ -0,0 +1,159 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_PLUGIN_SOURCE
+
+#include <algorithm>
+
+#include "xdp/profile/database/database.h"
+#include "xdp/profile/database/events/native_events.h"
+#include "xdp/profile/database/thread_local_state.h"
+#include "xdp/profile/plugin/native/flight_recorder.h"
+
+namespace {
+
+  std::atomic<uint64_t> nextRecorderId{1};
+
+} // end anonymous namespace
+
+namespace xdp {
+
+  FlightRecorder::FlightRecorder(VPDatabase* d, uint64_t durationNs,
+                                 size_t numRecords)
+    : db(d)
+    , instanceId(nextRecorderId++)
+    , duration(durationNs)
+    , capacity((std::max)(numRecords, static_cast<size_t>(1)))
+  {
+  }
+
+  // Get the ring of the calling thread, the ring is created and
+  // registered with this recorder when the thread records its first call
+  FlightRecorder::ThreadRing& FlightRecorder::getThreadRing(uint64_t now)
+  {
+    return ThreadLocalState<ThreadRing>::get(instanceId,
+      [this, now](const std::shared_ptr<ThreadRing>& ring)
+      {
+        ring->records.reserve(capacity);
+        std::lock_guard<std::mutex> lock(ringsLock);
+        releaseRetiredRings(oldestTimestamp(now));
+        rings.push_back(ring);
+      });
+  }
+
+  void FlightRecorder::start(uint64_t functionName, FlightRecord::Type type,
+                             uint64_t timestamp)
+  {
+    auto& ring = getThreadRing(timestamp);
+    std::lock_guard<std::mutex> lock(ring.lock);
+
+    if (ring.openCalls.size() == maxOpenCalls)
+      ring.openCalls.erase(ring.openCalls.begin());
+    ring.openCalls.push_back({functionName, timestamp, 0, type});
+  }
+
+  uint64_t FlightRecorder::end(uint64_t functionName, uint64_t timestamp)
+  {
+    auto& ring = getThreadRing(timestamp);
+    std::lock_guard<std::mutex> lock(ring.lock);
+
+    auto call = std::find_if(ring.openCalls.rbegin(), ring.openCalls.rend(),
+                             [functionName](const FlightRecord& record)
+                             { return record.functionName == functionName; });
+    if (call == ring.openCalls.rend())
+      return 0;
+
+    FlightRecord record = *call;
+    record.end = timestamp;
+    ring.openCalls.erase(std::next(call).base());
+
+    // Overwrite the oldest call once the ring is full
+    if (ring.records.size() < capacity)
+      ring.records.push_back(record);
+    else {
+      ring.records[ring.next] = record;
+      ring.next = (ring.next + 1) % capacity;
+    }
+    return record.start;
+  }
+
+  // Release the rings of threads that have exited and have no calls
+  // that ended after oldest.  Must be called with ringsLock held.
+  void FlightRecorder::releaseRetiredRings(uint64_t oldest)
+  {
+    auto isStale = [oldest](const std::shared_ptr<ThreadRing>& ring)
+    {
+      if (!ring->retired)
+        return false;
+      std::lock_guard<std::mutex> lock(ring->lock);
+      return std::none_of(ring->records.begin(), ring->records.end(),
+                          [oldest](const FlightRecord& record)
+                          { return record.end >= oldest; });
+    };
+    rings.erase(std::remove_if(rings.begin(), rings.end(), isStale),
+                rings.end());
+  }
+
+  size_t FlightRecorder::addEvents(uint64_t now)
+  {
+    uint64_t oldest = oldestTimestamp(now);
+
+    std::vector<FlightRecord> calls;
+    {
+      std::lock_guard<std::mutex> lock(ringsLock);
+      releaseRetiredRings(oldest);
+      for (auto& ring : rings) {
+        std::lock_guard<std::mutex> ringLock(ring->lock);
+        for (auto& record : ring->records) {
+          if (record.end >= oldest)
+            calls.push_back(record);
+        }
+        for (auto record : ring->openCalls) {
+          record.end = now;
+          calls.push_back(record);
+        }
+      }
+    }
+
+    // Each call becomes a start and an end event on the API row.  Syncs
+    // have a second pair of events on the read or write row.
+    auto& dynamicInfo = db->getDynamicInfo();
+    for (auto& call : calls) {
+      auto start = static_cast<double>(call.start);
+      auto end   = static_cast<double>(call.end);
+
+      VTFEvent* APIStart = new NativeAPICall(0, start, call.functionName);
+      dynamicInfo.addUnsortedEvent(APIStart);
+      dynamicInfo.addUnsortedEvent(new NativeAPICall(APIStart->getEventId(),
+                                                     end, call.functionName));
+
+      if (call.type == FlightRecord::SYNC_READ) {
+        VTFEvent* transferStart = new NativeSyncRead(0, start, call.functionName);
+        dynamicInfo.addUnsortedEvent(transferStart);
+        dynamicInfo.addUnsortedEvent(new NativeSyncRead(transferStart->getEventId(),
+                                                        end, call.functionName));
+      }
+      else if (call.type == FlightRecord::SYNC_WRITE) {
+        VTFEvent* transferStart = new NativeSyncWrite(0, start, call.functionName);
+        dynamicInfo.addUnsortedEvent(transferStart);
+        dynamicInfo.addUnsortedEvent(new NativeSyncWrite(transferStart->getEventId(),
+                                                         end, call.functionName));
+      }
+    }
+    return calls.size();
+  }
+
+} // end namespace xdp
@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FLIGHT_RECORDER_DOT_H
+#define FLIGHT_RECORDER_DOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace xdp {
+
+  // Forward declarations
+  class VPDatabase ;
+
+  // One completed (or still running) Native XRT API call
+  struct FlightRecord
+  {
+    enum Type : uint8_t { API, SYNC_READ, SYNC_WRITE } ;
+
+    uint64_t functionName ; // String table id
+    uint64_t start ;        // In ns
+    uint64_t end ;          // In ns, 0 while the call is running
+    Type type ;
+  } ;
+
+  // The flight recorder keeps the Native XRT API calls of the last
+  //  duration in bounded per thread ring buffers instead of the
+  //  database.  Only when a dump is triggered are the recorded calls
+  //  turned into events and added to the database so the native trace
+  //  writer can write them.  Memory used is bounded by the number of
+  //  threads times the capacity of a ring.
+  class FlightRecorder
+  {
+  private:
+    // Bound on the number of calls waiting for their end, in case
+    //  some end is never logged
+    static constexpr size_t maxOpenCalls = 256 ;
+
+    // The calls of one thread.  Only the owning thread records calls,
+    //  the lock is only contended while a dump collects the calls.
+    struct ThreadRing
+    {
+      std::mutex lock ;
+      std::vector<FlightRecord> records ; // Ring of completed calls
+      size_t next = 0 ;                   // Index of the oldest record
+      std::vector<FlightRecord> openCalls ;
+      std::atomic<bool> retired{false} ;
+    } ;
+
+    VPDatabase* db ;
+    const uint64_t instanceId ;
+    const uint64_t duration ; // In ns
+    const size_t capacity ;
+
+    std::mutex ringsLock ; // Protects the "rings" vector
+    std::vector<std::shared_ptr<ThreadRing>> rings ;
+
+    ThreadRing& getThreadRing(uint64_t now) ;
+    void releaseRetiredRings(uint64_t oldest) ;
+
+    inline uint64_t oldestTimestamp(uint64_t now)
+      { return (now > duration) ? now - duration : 0 ; }
+
+  public:
+    FlightRecorder(VPDatabase* d, uint64_t durationNs, size_t numRecords) ;
+    ~FlightRecorder() = default ;
+
+    FlightRecorder(const FlightRecorder&) = delete ;
+    FlightRecorder& operator=(const FlightRecorder&) = delete ;
+
+    void start(uint64_t functionName, FlightRecord::Type type,
+               uint64_t timestamp) ;
+
+    // Calls on a thread end in the reverse order they started, so the
+    //  end matches the latest open call of the same function.  Returns
+    //  the start time of the call, or 0 if the start was not recorded.
+    uint64_t end(uint64_t functionName, uint64_t timestamp) ;
+
+    // Add native events for all calls that were running during the
+    //  last duration before now to the database.  Calls still running
+    //  end at now.  Returns the number of calls added.
+    size_t addEvents(uint64_t now) ;
+  } ;
+
+} // end namespace xdp
+
+#endif
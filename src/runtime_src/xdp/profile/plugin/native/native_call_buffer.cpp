@@ -0,0 +1,167 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_PLUGIN_SOURCE
+
+#include <algorithm>
+
+#include "core/common/api/native_api_ids.h"
+#include "core/common/time.h"
+#include "xdp/profile/database/database.h"
+#include "xdp/profile/database/thread_local_state.h"
+#include "xdp/profile/database/events/native_events.h"
+#include "xdp/profile/plugin/native/native_call_buffer.h"
+
+namespace {
+
+  std::atomic<uint64_t> nextBufferId{1};
+
+} // end anonymous namespace
+
+namespace xdp {
+
+  NativeCallBuffer::NativeCallBuffer(VPDatabase* d,
+                                     std::vector<uint64_t> strings,
+                                     size_t numRecords)
+    : db(d)
+    , instanceId(nextBufferId++)
+    , capacity((std::max)(numRecords, static_cast<size_t>(1)))
+    , apiStrings(std::move(strings))
+  {
+  }
+
+  // Get the buffer of the calling thread, the buffer is created and
+  // registered when the thread logs its first call
+  NativeCallBuffer::ThreadBuffer& NativeCallBuffer::getThreadBuffer()
+  {
+    return ThreadLocalState<ThreadBuffer>::get(instanceId,
+      [this](const std::shared_ptr<ThreadBuffer>& buffer)
+      {
+        buffer->records.reserve(capacity);
+        std::lock_guard<std::mutex> lock(buffersLock);
+        buffers.push_back(buffer);
+      });
+  }
+
+  // The start time is taken last, so the time spent here is not
+  // counted as part of the call
+  void NativeCallBuffer::start(uint16_t apiId, FlightRecord::Type type)
+  {
+    auto& buffer = getThreadBuffer();
+    if (buffer.depth < maxDepth) {
+      auto& call = buffer.openCalls[buffer.depth];
+      call.apiId = apiId;
+      call.type  = type;
+      call.start = xrt_core::time_ns();
+    }
+    ++buffer.depth;
+  }
+
+  void NativeCallBuffer::end(uint16_t apiId, uint64_t timestamp, uint64_t size)
+  {
+    auto& buffer = getThreadBuffer();
+    if (buffer.depth == 0)
+      return;
+    if (--buffer.depth >= maxDepth)
+      return;
+
+    NativeCallRecord call = buffer.openCalls[buffer.depth];
+    if (call.apiId != apiId)
+      return;
+    call.end  = timestamp;
+    call.size = size;
+
+    // A full buffer is handed to the next flush, so the thread that
+    // filled it only swaps in an empty buffer
+    std::vector<NativeCallRecord> full;
+    {
+      std::lock_guard<std::mutex> lock(buffer.lock);
+      buffer.records.push_back(call);
+      if (buffer.records.size() < capacity)
+        return;
+      full.swap(buffer.records);
+      buffer.records.reserve(capacity);
+    }
+    std::lock_guard<std::mutex> lock(buffersLock);
+    fullBuffers.push_back(std::move(full));
+  }
+
+  void NativeCallBuffer::flush()
+  {
+    std::vector<std::shared_ptr<ThreadBuffer>> current;
+    std::vector<std::vector<NativeCallRecord>> full;
+    {
+      std::lock_guard<std::mutex> lock(buffersLock);
+      current = buffers;
+      full.swap(fullBuffers);
+      // The calls of exited threads are added below, for the last time
+      buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                   [](const std::shared_ptr<ThreadBuffer>& b)
+                                   { return b->retired.load(); }),
+                    buffers.end());
+    }
+
+    for (auto& calls : full)
+      addToDatabase(calls);
+
+    for (auto& buffer : current) {
+      std::vector<NativeCallRecord> calls;
+      {
+        std::lock_guard<std::mutex> lock(buffer->lock);
+        calls.swap(buffer->records);
+        if (!buffer->retired)
+          buffer->records.reserve(capacity);
+      }
+      addToDatabase(calls);
+    }
+  }
+
+  // Each call becomes a start and an end event on the API row.  Syncs
+  // have a second pair of events on the read or write row.
+  void NativeCallBuffer::addToDatabase(const std::vector<NativeCallRecord>& calls)
+  {
+    auto& dynamicInfo = db->getDynamicInfo();
+    auto& stats = db->getStats();
+
+    for (auto& call : calls) {
+      auto name  = apiStrings[call.apiId];
+      auto start = static_cast<double>(call.start);
+      auto end   = static_cast<double>(call.end);
+
+      VTFEvent* APIStart = new NativeAPICall(0, start, name);
+      dynamicInfo.addUnsortedEvent(APIStart);
+      dynamicInfo.addUnsortedEvent(new NativeAPICall(APIStart->getEventId(),
+                                                     end, name));
+      stats.logFunctionCall(native::api_name(call.apiId), start, end);
+
+      if (call.type == FlightRecord::SYNC_READ) {
+        VTFEvent* transferStart = new NativeSyncRead(0, start, name);
+        dynamicInfo.addUnsortedEvent(transferStart);
+        dynamicInfo.addUnsortedEvent(new NativeSyncRead(transferStart->getEventId(),
+                                                        end, name));
+        stats.logHostRead(0, 0, call.size, call.start, call.end - call.start, 0, 0);
+      }
+      else if (call.type == FlightRecord::SYNC_WRITE) {
+        VTFEvent* transferStart = new NativeSyncWrite(0, start, name);
+        dynamicInfo.addUnsortedEvent(transferStart);
+        dynamicInfo.addUnsortedEvent(new NativeSyncWrite(transferStart->getEventId(),
+                                                         end, name));
+        stats.logHostWrite(0, 0, call.size, call.start, call.end - call.start, 0, 0);
+      }
+    }
+  }
+
+} // end namespace xdp
@@ -0,0 +1,105 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef NATIVE_CALL_BUFFER_DOT_H
+#define NATIVE_CALL_BUFFER_DOT_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "xdp/profile/plugin/native/flight_recorder.h"
+
+namespace xdp {
+
+  // Forward declarations
+  class VPDatabase ;
+
+  // One Native XRT API call, identified by its id in the Native
+  //  XRT API name table
+  struct NativeCallRecord
+  {
+    uint64_t start ; // In ns
+    uint64_t end ;   // In ns
+    uint64_t size ;  // Bytes transferred by a sync
+    uint16_t apiId ;
+    FlightRecord::Type type ;
+  } ;
+
+  // Keeps the Native XRT API calls of every thread in a fixed size
+  //  per thread buffer, so logging a call needs no map lookups, string
+  //  table lookups or shared locks.  Calls on a thread end in the
+  //  reverse order they start, so starts wait on a per thread stack
+  //  until their end.  The calls only become events and statistics in
+  //  the database when the buffers are flushed before writing.  A thread
+  //  that fills its buffer hands it over to the next flush.
+  class NativeCallBuffer
+  {
+  private:
+    // Deeper calls are not logged
+    static constexpr size_t maxDepth = 64 ;
+
+    struct ThreadBuffer
+    {
+      // Only used by the owning thread
+      std::array<NativeCallRecord, maxDepth> openCalls ;
+      size_t depth = 0 ;
+
+      // Only contended while the buffers are flushed
+      std::mutex lock ;
+      std::vector<NativeCallRecord> records ;
+      std::atomic<bool> retired{false} ;
+    } ;
+
+    VPDatabase* db ;
+    const uint64_t instanceId ;
+    const size_t capacity ;
+
+    // The string table id of every Native XRT API
+    std::vector<uint64_t> apiStrings ;
+
+    // Protects the "buffers" and "fullBuffers" vectors
+    std::mutex buffersLock ;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers ;
+
+    // Buffers filled by a thread since the last flush
+    std::vector<std::vector<NativeCallRecord>> fullBuffers ;
+
+    ThreadBuffer& getThreadBuffer() ;
+    void addToDatabase(const std::vector<NativeCallRecord>& calls) ;
+
+  public:
+    // The string table id of every Native XRT API is passed in strings
+    NativeCallBuffer(VPDatabase* d, std::vector<uint64_t> strings,
+                     size_t numRecords) ;
+    ~NativeCallBuffer() = default ;
+
+    NativeCallBuffer(const NativeCallBuffer&) = delete ;
+    NativeCallBuffer& operator=(const NativeCallBuffer&) = delete ;
+
+    void start(uint16_t apiId, FlightRecord::Type type) ;
+    void end(uint16_t apiId, uint64_t timestamp, uint64_t size) ;
+
+    // Add the calls of all threads to the database
+    void flush() ;
+  } ;
+
+} // end namespace xdp
+
+#endif
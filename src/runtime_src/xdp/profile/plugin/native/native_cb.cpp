@@ -1,6 +1,6 @@
 /**
  * Copyright (C) 2016-2022 Xilinx, Inc
- * Copyright (C) 2022-2023 Advanced Micro Devices, Inc. - All rights reserved
+ * Copyright (C) 2022-2024 Advanced Micro Devices, Inc. - All rights reserved
  *
  * Licensed under the Apache License, Version 2.0 (the "License"). You may
  * not use this file except in compliance with the License. A copy of the
@@ -15,14 +15,10 @@
  * under the License.
  */
 
-#include <map>
-#include <mutex>
-
 #define XDP_PLUGIN_SOURCE
 
+#include "core/common/api/native_api_ids.h"
 #include "core/common/time.h"
-#include "xdp/profile/database/dynamic_info/types.h"
-#include "xdp/profile/database/events/native_events.h"
 #include "xdp/profile/plugin/native/native_cb.h"
 #include "xdp/profile/plugin/native/native_plugin.h"
 
@@ -33,166 +29,103 @@ namespace xdp {
   // functions below.
   static NativeProfilingPlugin nativePluginInstance;
 
-  // For logging statistics: Function ID to start timestamp
-  static std::mutex timestampLock;
-  static std::map<uint64_t, uint64_t> nativeTimestamps;
+  static void logCallStart(unsigned int apiId, FlightRecord::Type type)
+  {
+    if (!VPDatabase::alive() || !NativeProfilingPlugin::alive() ||
+        apiId >= native::num_apis)
+      return;
+
+    auto id = static_cast<uint16_t>(apiId);
+
+    // In flight recorder mode the call is only kept in the recorder
+    if (auto recorder = nativePluginInstance.getFlightRecorder()) {
+      recorder->start(nativePluginInstance.getAPIString(id), type,
+                      xrt_core::time_ns());
+      return;
+    }
+
+    // Don't include the profiling overhead in the time that we show.
+    // That means there will be "empty gaps" in the timeline trace when
+    // the profiling overhead exists.  The call buffer takes the start
+    // timestamp as close as possible to the true start of the observed
+    // function.
+    nativePluginInstance.getCallBuffer()->start(id, type);
+  }
+
+  // In order to not show profiling overhead in the timeline, we have
+  // already captured the timestamp when the observed function ended
+  // so any of the events we record do not take the local overhead into
+  // consideration.  The timestamp is as close to the true end of the
+  // observed function as possible.
+  static void logCallEnd(unsigned int apiId, FlightRecord::Type type,
+                         uint64_t timestamp, uint64_t size)
+  {
+    if (!VPDatabase::alive() || !NativeProfilingPlugin::alive() ||
+        apiId >= native::num_apis)
+      return;
+
+    auto id = static_cast<uint16_t>(apiId);
+    auto recorder = nativePluginInstance.getFlightRecorder();
+    if (!recorder) {
+      nativePluginInstance.getCallBuffer()->end(id, timestamp, size);
+      return;
+    }
+
+    // The flight recorder keeps the start time of the call, and the
+    // statistics are kept as the calls end
+    uint64_t start = recorder->end(nativePluginInstance.getAPIString(id),
+                                   timestamp);
+    if (start == 0)
+      return;
+
+    auto& stats = nativePluginInstance.getDatabase()->getStats();
+    stats.logFunctionCall(native::api_name(id), static_cast<double>(start),
+                          static_cast<double>(timestamp));
+    if (type == FlightRecord::SYNC_WRITE)
+      stats.logHostWrite(0, 0, size, start, timestamp - start, 0, 0);
+    else if (type == FlightRecord::SYNC_READ)
+      stats.logHostRead(0, 0, size, start, timestamp - start, 0, 0);
+  }
 
 } // end namespace xdp
 
-// The functionID is the unique identifier from the XRT side that we
-// can use to match start events with stop events.
 extern "C"
-void native_function_start(const char* functionName,
-                           unsigned long long int functionID)
+void native_api_start(unsigned int apiId)
 {
-  if (!xdp::VPDatabase::alive() || !xdp::NativeProfilingPlugin::alive())
-    return;
-
-  // Don't include the profiling overhead in the time that we show.
-  // That means there will be "empty gaps" in the timeline trace when
-  // the profiling overhead exists.  That means we create the event
-  // and add it to the database first, and set the timestamp as close as
-  // possible to the true start of the observed function.
-  xdp::VPDatabase* db = xdp::nativePluginInstance.getDatabase();
-
-  xdp::VTFEvent* event =
-    new xdp::NativeAPICall(0,
-                           0,
-                           db->getDynamicInfo().addString(functionName));
-  db->getDynamicInfo().addUnsortedEvent(event);
-  db->getDynamicInfo().markStart(static_cast<uint64_t>(functionID),
-                                 event->getEventId());
-
-  db->getStats().logFunctionCallStart(functionName,
-                                      static_cast<double>(xrt_core::time_ns()));
-  event->setTimestamp(static_cast<double>(xrt_core::time_ns()));
+  xdp::logCallStart(apiId, xdp::FlightRecord::API);
 }
 
-// In order to not show profiling overhead in the timeline, we have
-// already captured the timestamp when the observed function ended
-// so any of the events we record do not take the local overhead into
-// consideration.  The timestamp is as close to the true end of the
-// observed function as possible.
 extern "C"
-void native_function_end(const char* functionName,
-                         unsigned long long int functionID,
-                         unsigned long long int timestamp)
+void native_api_end(unsigned int apiId, unsigned long long int timestamp)
 {
-  if (!xdp::VPDatabase::alive() || !xdp::NativeProfilingPlugin::alive())
-    return;
-
-  xdp::VPDatabase* db = xdp::nativePluginInstance.getDatabase();
-  db->getStats().logFunctionCallEnd(functionName,
-                                    static_cast<double>(timestamp));
-
-  uint64_t start =
-    db->getDynamicInfo().matchingStart(static_cast<uint64_t>(functionID));
-
-  xdp::VTFEvent* event =
-    new xdp::NativeAPICall(start,
-                           static_cast<double>(timestamp),
-                           db->getDynamicInfo().addString(functionName));
-  db->getDynamicInfo().addUnsortedEvent(event);
+  xdp::logCallEnd(apiId, xdp::FlightRecord::API, timestamp, 0);
 }
 
-// Callbacks for sync functions will create two separate events to be displayed
-// on the visualization.  One that is put on the API row to show that
-// xrt::sync was called, and one on the data transfer rows to show when
-// reads and writes were occurring.
+// Sync calls are displayed on the API row to show that xrt::sync was
+// called, and on the data transfer rows to show when reads and writes
+// were occurring.
 extern "C"
-void native_sync_start(const char* functionName,
-                       unsigned long long int functionID,
-                       bool isWrite)
+void native_api_sync_start(unsigned int apiId, bool isWrite)
 {
-  if (!xdp::VPDatabase::alive() || !xdp::NativeProfilingPlugin::alive())
-    return;
-
-  // Don't include the profiling overhead in the time that we show.
-  // That means there will be "empty gaps" in the timeline trace when
-  // the profiling overhead exists.  We do this by capturing the
-  // timestamp as close to the end of this function as possible
-  xdp::VPDatabase* db = xdp::nativePluginInstance.getDatabase();
-
-  // Create two different events.  One for capturing the API to be put
-  // on the API row, and one for the read/write data transfer rows.
-  xdp::VTFEvent* APIEvent      = nullptr;
-  xdp::VTFEvent* transferEvent = nullptr;
-
-  auto functionStr = db->getDynamicInfo().addString(functionName);
-  APIEvent = new xdp::NativeAPICall(0, 0, functionStr);
-  if (isWrite)
-    transferEvent = new xdp::NativeSyncWrite(0, 0, functionStr);
-  else
-    transferEvent = new xdp::NativeSyncRead(0, 0, functionStr);
-
-  db->getDynamicInfo().addUnsortedEvent(APIEvent);
-  db->getDynamicInfo().addUnsortedEvent(transferEvent);
-
-  // We need to store both events for lookup as we will only get one
-  // "stop" event from the XRT side for this particular functionID.
-  xdp::EventPair events = { APIEvent->getEventId(), transferEvent->getEventId() };
-  db->getDynamicInfo().markEventPairStart(static_cast<uint64_t>(functionID), events);
-
-  {
-    // For statistics, also keep track of the start time associated with
-    // this data transfer.
-    std::lock_guard<std::mutex> lock(xdp::timestampLock);
-    xdp::nativeTimestamps[static_cast<uint64_t>(functionID)] = xrt_core::time_ns();
-  }
+  xdp::logCallStart(apiId, isWrite ? xdp::FlightRecord::SYNC_WRITE
+                                   : xdp::FlightRecord::SYNC_READ);
+}
 
-  db->getStats().logFunctionCallStart(functionName, static_cast<double>(xrt_core::time_ns()));
-  APIEvent->setTimestamp(static_cast<double>(xrt_core::time_ns()));
-  transferEvent->setTimestamp(static_cast<double>(xrt_core::time_ns()));
+extern "C"
+void native_api_sync_end(unsigned int apiId, unsigned long long int timestamp,
+                         bool isWrite, unsigned long long int size)
+{
+  xdp::logCallEnd(apiId,
+                  isWrite ? xdp::FlightRecord::SYNC_WRITE
+                          : xdp::FlightRecord::SYNC_READ,
+                  timestamp, size);
 }
 
 extern "C"
-void native_sync_end(const char* functionName, unsigned long long int functionID, unsigned long long int timestamp, bool isWrite, unsigned long long int size)
+void native_flight_recorder_dump(const char* reason)
 {
   if (!xdp::VPDatabase::alive() || !xdp::NativeProfilingPlugin::alive())
     return;
 
-  xdp::VPDatabase* db = xdp::nativePluginInstance.getDatabase();
-  db->getStats().logFunctionCallEnd(functionName, static_cast<double>(timestamp));
-
-  uint64_t startTimestamp = 0;
-  uint64_t transferTime = 0;
-  {
-    std::lock_guard<std::mutex> lock(xdp::timestampLock);
-    startTimestamp = xdp::nativeTimestamps[static_cast<uint64_t>(functionID)];
-    transferTime = timestamp - startTimestamp;
-    xdp::nativeTimestamps.erase(functionID);
-  }
-
-  // Retrieve the pair of events for this particular functionID.
-  auto startEvents =
-    db->getDynamicInfo().matchingEventPairStart(static_cast<uint64_t>(functionID));
-
-  xdp::VTFEvent* APIEvent = nullptr;
-  xdp::VTFEvent* transferEvent = nullptr;
-
-  auto functionStr = db->getDynamicInfo().addString(functionName);
-
-  APIEvent = new xdp::NativeAPICall(startEvents.APIEventId,
-                                    static_cast<double>(timestamp),
-                                    functionStr);
-
-  if (isWrite) {
-    transferEvent =
-      new xdp::NativeSyncWrite(startEvents.transferEventId,
-                               static_cast<double>(timestamp),
-                               functionStr);
-  }
-  else {
-    transferEvent =
-      new xdp::NativeSyncRead(startEvents.transferEventId,
-                              static_cast<double>(timestamp),
-                              db->getDynamicInfo().addString(functionName));
-  }
-  db->getDynamicInfo().addUnsortedEvent(APIEvent);
-  db->getDynamicInfo().addUnsortedEvent(transferEvent);
-
-  if (isWrite)
-    db->getStats().logHostWrite(0, 0, size, startTimestamp, transferTime, 0, 0);
-  else
-    db->getStats().logHostRead(0, 0, size, startTimestamp, transferTime, 0, 0);
+  xdp::nativePluginInstance.dumpFlightRecorder(reason ? reason : "");
 }
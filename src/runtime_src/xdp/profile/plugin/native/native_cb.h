@@ -1,6 +1,6 @@
 /**
  * Copyright (C) 2016-2021 Xilinx, Inc
- * Copyright (C) 2022-2023 Advanced Micro Devices, Inc. - All rights reserved
+ * Copyright (C) 2022-2024 Advanced Micro Devices, Inc. - All rights reserved
  *
  * Licensed under the Apache License, Version 2.0 (the "License"). You may
  * not use this file except in compliance with the License. A copy of the
@@ -22,20 +22,27 @@
 
 // These are the functions that are visible when the plugin is dynamically
 //  linked in.  XRT should call them directly
+// The Native XRT APIs are identified by their id in the name table
+//  in core/common/api/native_api_ids.h
 extern "C"
 XDP_PLUGIN_EXPORT
-void native_function_start(const char* functionName, unsigned long long int functionID) ;
+void native_api_start(unsigned int apiId) ;
 
 extern "C"
 XDP_PLUGIN_EXPORT
-void native_function_end(const char* functionName, unsigned long long int functionID, unsigned long long int timestamp) ;
+void native_api_end(unsigned int apiId, unsigned long long int timestamp) ;
 
 extern "C"
 XDP_PLUGIN_EXPORT
-void native_sync_start(const char* functionName, unsigned long long int functionID, bool isWrite) ;
+void native_api_sync_start(unsigned int apiId, bool isWrite) ;
 
 extern "C"
 XDP_PLUGIN_EXPORT
-void native_sync_end(const char* functionName, unsigned long long int functionID, unsigned long long int timestamp, bool isWrite, unsigned long long int size);
+void native_api_sync_end(unsigned int apiId, unsigned long long int timestamp, bool isWrite, unsigned long long int size) ;
+
+// Write the events kept by the flight recorder to a trace file
+extern "C"
+XDP_PLUGIN_EXPORT
+void native_flight_recorder_dump(const char* reason) ;
 
 #endif
@@ -17,6 +17,15 @@
 
 #define XDP_PLUGIN_SOURCE
 
+#include <chrono>
+#include <csignal>
+#include <sstream>
+
+#include "core/common/api/native_api_ids.h"
+#include "core/common/config_reader.h"
+#include "core/common/message.h"
+#include "core/common/time.h"
+
 #include "xdp/profile/plugin/native/native_plugin.h"
 #include "xdp/profile/writer/native/native_writer.h"
 #include "xdp/profile/plugin/vp_base/info.h"
@@ -24,6 +33,7 @@
 namespace xdp {
 
   bool NativeProfilingPlugin::live = false;
+  std::atomic<bool> NativeProfilingPlugin::signalReceived{false};
 
   NativeProfilingPlugin::NativeProfilingPlugin() : XDPPlugin()
   {
@@ -32,27 +42,144 @@ namespace xdp {
     db->registerPlugin(this) ;
     db->registerInfo(info::native) ;
 
-    VPWriter* writer = new NativeTraceWriter("native_trace.csv") ;
-    writers.push_back(writer) ;
+    traceWriter = new NativeTraceWriter("native_trace.csv") ;
+    writers.push_back(traceWriter) ;
+
+    // The names of all APIs are added up front, so logging a call only
+    //  needs the id of the API
+    for (uint16_t id = 0 ; id < native::num_apis ; ++id)
+      apiStrings.push_back(db->getDynamicInfo().addStaticString(native::api_name(id))) ;
+
+    if (!xrt_core::config::get_flight_recorder()) {
+      constexpr size_t callBufferRecords = 4096 ;
+      callBuffer = std::make_unique<NativeCallBuffer>(db, apiStrings,
+                                                      callBufferRecords) ;
+      (db->getStaticInfo()).addOpenedFile(traceWriter->getcurrentFileName(),
+                                          traceWriter->getFileType("VP_TRACE")) ;
+      return ;
+    }
 
-    (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(), "VP_TRACE") ;
+    // In flight recorder mode, trace files are added to the list of
+    //  opened files as they are written by a dump
+    constexpr uint64_t one_billion = 1000000000 ;
+    flightRecorder = std::make_unique<FlightRecorder>(db,
+      xrt_core::config::get_flight_recorder_duration_s() * one_billion,
+      xrt_core::config::get_flight_recorder_events()) ;
+
+    dumpSignal = static_cast<int>(xrt_core::config::get_flight_recorder_signal()) ;
+    if (dumpSignal != 0)
+      startSignalThread() ;
   }
 
   NativeProfilingPlugin::~NativeProfilingPlugin()
   {
+    endSignalThread() ;
+
     if (VPDatabase::alive()) {
       // Applications using the Native API may be running hardware emulation,
       //  so be sure to account for any emulation specific information
       emulationSetup() ;
 
       // We were destroyed before the database, so write the writers
-      //  and unregister ourselves from the database
-      for (auto w : writers) {
-        w->write(false) ;
+      //  and unregister ourselves from the database.  The flight recorder
+      //  only writes when triggered, but has to wait for a running dump.
+      if (flightRecorder) {
+        std::lock_guard<std::mutex> lock(dumpLock) ;
+      }
+      else {
+        callBuffer->flush() ;
+        for (auto w : writers) {
+          w->write(false) ;
+        }
       }
       db->unregisterPlugin(this) ;
     }
     NativeProfilingPlugin::live = false;
   }
 
+  void NativeProfilingPlugin::writeAll(bool openNewFiles)
+  {
+    // The flight recorder only writes when triggered
+    if (flightRecorder)
+      return ;
+    callBuffer->flush() ;
+    XDPPlugin::writeAll(openNewFiles) ;
+  }
+
+  void NativeProfilingPlugin::dumpFlightRecorder(const std::string& reason)
+  {
+    if (!flightRecorder)
+      return ;
+
+    std::lock_guard<std::mutex> lock(dumpLock) ;
+
+    auto numCalls = flightRecorder->addEvents(xrt_core::time_ns()) ;
+
+    // The reason is written as a value in the trace file header
+    std::string headerReason = reason.empty() ? "API" : reason ;
+    for (auto& c : headerReason) {
+      if (c == ',' || c == '\n')
+        c = ' ' ;
+    }
+    traceWriter->setTriggerReason(headerReason) ;
+
+    std::string fileName = traceWriter->getcurrentFileName() ;
+    if (traceWriter->write(true))
+      (db->getStaticInfo()).addOpenedFile(fileName, traceWriter->getFileType("VP_TRACE")) ;
+
+    std::stringstream msg ;
+    msg << "Flight recorder triggered by " << headerReason << " wrote "
+        << numCalls << " Native XRT API calls to " << fileName ;
+    xrt_core::message::send(xrt_core::message::severity_level::info, "XRT",
+                            msg.str()) ;
+  }
+
+  void NativeProfilingPlugin::signalHandler(int /*signal*/)
+  {
+    signalReceived = true ;
+  }
+
+  void NativeProfilingPlugin::startSignalThread()
+  {
+    previousHandler = std::signal(dumpSignal, &NativeProfilingPlugin::signalHandler) ;
+    if (previousHandler == SIG_ERR) {
+      previousHandler = nullptr ;
+      std::stringstream msg ;
+      msg << "Unable to install the flight recorder handler for signal "
+          << dumpSignal ;
+      xrt_core::message::send(xrt_core::message::severity_level::warning,
+                              "XRT", msg.str()) ;
+      return ;
+    }
+
+    signalThread = std::thread([this]
+    {
+      std::unique_lock<std::mutex> lock(signalThreadLock) ;
+      while (!signalThreadCondition.wait_for(lock,
+                                             std::chrono::milliseconds(100),
+                                             [this] { return stopSignalThread ; })) {
+        if (!signalReceived.exchange(false))
+          continue ;
+        lock.unlock() ;
+        dumpFlightRecorder("signal " + std::to_string(dumpSignal)) ;
+        lock.lock() ;
+      }
+    }) ;
+  }
+
+  void NativeProfilingPlugin::endSignalThread()
+  {
+    if (!signalThread.joinable())
+      return ;
+
+    {
+      std::lock_guard<std::mutex> lock(signalThreadLock) ;
+      stopSignalThread = true ;
+    }
+    signalThreadCondition.notify_one() ;
+    signalThread.join() ;
+
+    std::signal(dumpSignal, previousHandler ? previousHandler : SIG_DFL) ;
+  }
+
 } // end namespace xdp
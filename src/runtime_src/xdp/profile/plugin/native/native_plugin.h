@@ -17,19 +17,68 @@
 #ifndef NATIVE_PLUGIN_DOT_H
 #define NATIVE_PLUGIN_DOT_H
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "xdp/profile/plugin/native/flight_recorder.h"
+#include "xdp/profile/plugin/native/native_call_buffer.h"
 #include "xdp/profile/plugin/vp_base/vp_base_plugin.h"
 
 namespace xdp {
 
+  // Forward declarations
+  class NativeTraceWriter ;
+
   class NativeProfilingPlugin : public XDPPlugin
   {
   private:
     static bool live;
+
+    NativeTraceWriter* traceWriter = nullptr ;
+
+    // The string table id of every Native XRT API, by API id
+    std::vector<uint64_t> apiStrings ;
+
+    // Calls are kept per thread and added to the database in bulk
+    std::unique_ptr<NativeCallBuffer> callBuffer ;
+
+    // In flight recorder mode, native events are kept in the recorder
+    //  and only written to a trace file when a dump is triggered
+    std::unique_ptr<FlightRecorder> flightRecorder ;
+    std::mutex dumpLock ;
+
+    // A dump requested by a signal is done by the signal thread, as
+    //  the signal handler itself can only set a flag
+    static std::atomic<bool> signalReceived ;
+    int dumpSignal = 0 ;
+    void (*previousHandler)(int) = nullptr ;
+    std::thread signalThread ;
+    bool stopSignalThread = false ;
+    std::mutex signalThreadLock ;
+    std::condition_variable signalThreadCondition ;
+
+    static void signalHandler(int signal) ;
+    void startSignalThread() ;
+    void endSignalThread() ;
+
   public:
     NativeProfilingPlugin() ;
     ~NativeProfilingPlugin() ;
 
     static bool alive() { return NativeProfilingPlugin::live; }
+
+    inline uint64_t getAPIString(uint16_t apiId) const
+      { return apiStrings[apiId] ; }
+    inline NativeCallBuffer* getCallBuffer() { return callBuffer.get() ; }
+    inline FlightRecorder* getFlightRecorder() { return flightRecorder.get() ; }
+    void dumpFlightRecorder(const std::string& reason) ;
+
+    virtual void writeAll(bool openNewFiles) override ;
   } ;
 
 } // end namespace xdp
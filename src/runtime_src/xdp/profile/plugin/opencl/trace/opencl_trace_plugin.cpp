@@ -39,7 +39,8 @@ namespace xdp {
     // Add a single writer for the OpenCL host trace
     VPWriter* writer = new OpenCLTraceWriter("opencl_trace.csv") ;
     writers.push_back(writer) ;
-    (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(), "VP_TRACE") ;
+    (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(),
+                                        writer->getFileType("VP_TRACE")) ;
 
     // Continuous writing of opencl trace
     if (xrt_core::config::get_continuous_trace()) 
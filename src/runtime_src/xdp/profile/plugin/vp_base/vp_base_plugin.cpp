@@ -22,6 +22,7 @@
 #include "xdp/profile/plugin/vp_base/vp_base_plugin.h"
 #include "xdp/profile/writer/vp_base/vp_run_summary.h"
 #include "xdp/profile/database/database.h"
+#include "xdp/profile/database/events/event_allocator.h"
 #include "xdp/profile/device/tracedefs.h"
 #include "core/common/config_reader.h"
 #include "core/common/message.h"
@@ -123,6 +124,9 @@ namespace xdp {
     for (auto w : writers)
       w->write(false);
     mtx_writer_list.unlock();
+
+    // Release event memory freed by the writers
+    EventAllocator::trim();
   }
 
   void XDPPlugin::startWriteThread(unsigned int interval, std::string type, bool openNewFiles)
@@ -145,6 +149,9 @@ namespace xdp {
       is_write_thread_active = false;
     } else {
       trySafeWrite(std::string(), false);
+
+      // Release event memory after the final write
+      EventAllocator::trim();
     }
   }
 
@@ -158,9 +165,14 @@ namespace xdp {
       for (auto w : writers) {
         bool success = w->write(openNewFiles);
         if (openNewFiles && success)
-          (db->getStaticInfo()).addOpenedFile(w->getcurrentFileName().c_str(), type);
+          (db->getStaticInfo()).addOpenedFile(w->getcurrentFileName().c_str(),
+                                              w->getFileType(type));
       }
       mtx_writer_list.unlock();
+
+      // Release event memory freed by the writers if it has grown
+      // large, the final write releases it regardless
+      EventAllocator::trim(EventAllocator::trimHighWater);
     }
   }
 
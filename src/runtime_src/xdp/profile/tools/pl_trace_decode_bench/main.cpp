@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+// Decode throughput of the PL device trace logger on a recorded raw
+// trace buffer.  The buffer is handed to a new logger in chunks the
+// size of an offload read on every iteration, and the events decoded
+// are dropped from the database before the next iteration.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "xdp/profile/database/database.h"
+#include "xdp/profile/device/pl_device_trace_logger.h"
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3 || argc > 5) {
+    std::cout << "Usage: " << argv[0]
+              << " <Raw Trace File> <Xclbin> [<Iterations> [<Chunk Bytes>]]\n";
+    return 0;
+  }
+
+  std::string traceFile  = argv[1];
+  std::string xclbinFile = argv[2];
+  uint64_t iterations    = (argc > 3) ? std::stoull(argv[3]) : 10;
+  iterations = std::max<uint64_t>(iterations, 1);
+  uint64_t chunkBytes    = (argc > 4) ? std::stoull(argv[4]) : 0x100000;
+
+  // Chunks hold whole packets
+  chunkBytes = std::max<uint64_t>(chunkBytes / sizeof(uint64_t), 1) * sizeof(uint64_t);
+
+  std::ifstream fin(traceFile, std::ios::binary|std::ios::in);
+  if (!fin) {
+    std::cerr << "Cannot open raw trace file " << traceFile << std::endl;
+    return 0;
+  }
+
+  std::vector<uint64_t> traceData;
+  uint64_t packet = 0;
+  char* ch = reinterpret_cast<char*>(&packet);
+  while (fin.read(ch, 8))
+    traceData.push_back(packet);
+  fin.close();
+
+  uint64_t numBytes = sizeof(uint64_t)*traceData.size();
+  if (numBytes == 0) {
+    std::cerr << "Raw trace file " << traceFile << " has no packets" << std::endl;
+    return 0;
+  }
+
+  xdp::VPDatabase* db = xdp::VPDatabase::Instance();
+  auto deviceId = db->addDevice("local");
+  db->getStaticInfo().updateDevice(deviceId, xclbinFile);
+
+  auto buffer = reinterpret_cast<char*>(traceData.data());
+  double totalSeconds = 0.0;
+  size_t numEvents = 0;
+
+  for (uint64_t i = 0; i < iterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    {
+      xdp::PLDeviceTraceLogger logger(deviceId);
+      for (uint64_t offset = 0; offset < numBytes; offset += chunkBytes)
+        logger.processTraceData(buffer + offset,
+                                std::min(chunkBytes, numBytes - offset));
+      logger.endProcessTraceData();
+    }
+    auto end = std::chrono::steady_clock::now();
+    totalSeconds += std::chrono::duration<double>(end - start).count();
+
+    // Not timed, the events are only decoded to be thrown away
+    numEvents = db->getDynamicInfo().moveDeviceEvents(deviceId).size();
+  }
+
+  double totalBytes = static_cast<double>(numBytes) * iterations;
+  std::cout << std::fixed << std::setprecision(3)
+            << "Packets:       " << traceData.size() << "\n"
+            << "Events:        " << numEvents << "\n"
+            << "Trace size:    " << numBytes / 1e6 << " MB\n"
+            << "Iterations:    " << iterations << "\n"
+            << "Decode time:   " << totalSeconds << " s\n"
+            << "Throughput:    " << totalBytes / totalSeconds / 1e9 << " GB/s\n";
+
+  return 0;
+}
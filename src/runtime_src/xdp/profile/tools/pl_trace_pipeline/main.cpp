@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+// Replay recorded raw trace dumps through the same decode pipeline the
+// continuous device trace offload uses.  Every dump is one TS2MM stream
+// and is pushed in chunks the size of the default trace buffer, taking
+// turns between the streams like the offload does.  The decoded trace
+// is written to output.csv.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "xdp/profile/database/database.h"
+#include "xdp/profile/device/pl_device_trace_logger.h"
+#include "xdp/profile/device/pl_trace_decode_pipeline.h"
+#include "xdp/profile/device/tracedefs.h"
+#include "xdp/profile/writer/device_trace/device_trace_writer.h"
+
+int main(int argc, char* argv[])
+{
+  if (argc < 4) {
+    std::cout << "Usage: " << argv[0]
+              << " <Xclbin> <Decode Threads> <Raw Trace File> [<Raw Trace File> ...]\n";
+    return 0;
+  }
+
+  std::string xclbinFile = argv[1];
+  size_t numWorkers      = std::stoul(argv[2]);
+
+  std::vector<std::vector<char>> streams;
+  for (int i = 3; i < argc; ++i) {
+    std::ifstream fin(argv[i], std::ios::binary|std::ios::in);
+    if (!fin) {
+      std::cerr << "Cannot open raw trace file " << argv[i] << std::endl;
+      return 0;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(fin)),
+                           std::istreambuf_iterator<char>());
+    // Only whole packets
+    data.resize(data.size() - (data.size() % sizeof(uint64_t)));
+    streams.push_back(std::move(data));
+  }
+
+  xdp::VPDatabase* db = xdp::VPDatabase::Instance();
+  auto deviceId = db->addDevice("local");
+  db->getStaticInfo().updateDevice(deviceId, xclbinFile);
+
+  xdp::PLDeviceTraceLogger logger(deviceId);
+  xdp::PLTraceDecodePipeline pipeline(&logger, streams.size(), numWorkers,
+                                      TS2MM_DECODE_QUEUE_DEPTH);
+
+  const uint64_t chunkSize = TS2MM_DEF_BUF_SIZE;
+  uint64_t totalBytes = 0;
+  std::vector<uint64_t> offsets(streams.size(), 0);
+
+  auto start = std::chrono::steady_clock::now();
+  pipeline.start();
+
+  bool pushed = true;
+  while (pushed) {
+    pushed = false;
+    for (size_t s = 0; s < streams.size(); ++s) {
+      auto& data = streams[s];
+      if (offsets[s] >= data.size())
+        continue;
+
+      uint64_t size = std::min(chunkSize, data.size() - offsets[s]);
+      auto chunk = std::make_unique<unsigned char[]>(size);
+      std::memcpy(chunk.get(), data.data() + offsets[s], size);
+      pipeline.push(s, std::move(chunk), size);
+
+      offsets[s] += size;
+      totalBytes += size;
+      pushed = true;
+    }
+  }
+
+  pipeline.finish();
+  auto end = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(end - start).count();
+
+  std::cout << std::fixed << std::setprecision(3)
+            << "Streams:        " << pipeline.getNumStreams() << "\n"
+            << "Decode threads: " << pipeline.getNumWorkers() << "\n"
+            << "Trace size:     " << totalBytes / 1e6 << " MB\n"
+            << "Decode time:    " << seconds << " s\n"
+            << "Throughput:     " << totalBytes / seconds / 1e9 << " GB/s\n";
+
+  xdp::DeviceTraceWriter writer("output.csv", deviceId, "1.1", xdp::getCurrentDateTime(), xdp::getXRTVersion(), xdp::getToolVersion());
+  writer.write(false);
+
+  return 0;
+}
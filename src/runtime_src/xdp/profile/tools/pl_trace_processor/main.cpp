@@ -14,60 +14,108 @@
  * under the License.
  */
 
-#include <fstream>
+#include <chrono>
+#include <exception>
+#include <iomanip>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "trace_processor.h"
+
+#include "core/common/config_reader.h"
+#include "experimental/xrt_ini.h"
 #include "xdp/profile/database/database.h"
 #include "xdp/profile/device/pl_device_trace_logger.h"
 #include "xdp/profile/writer/device_trace/device_trace_writer.h"
 
+namespace {
+
+  void usage(const char* name)
+  {
+    std::cout << "Usage: " << name
+              << " [-j <Threads>] [-o <Output File>]"
+              << " [-f csv|binary|binary_compressed] <Raw Trace File> <Xclbin>\n";
+  }
+
+} // end anonymous namespace
+
 int main(int argc, char* argv[])
 {
-  if (argc != 3) {
-    std::cout << "Usage: " << argv[0] << " <Raw Trace File> <Xclbin>\n";
-    return 0;
+  unsigned int numThreads = std::thread::hardware_concurrency();
+  std::string outputFile;
+  std::string format;
+  std::vector<std::string> files;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if ((arg == "-j" || arg == "-o" || arg == "-f") && i + 1 < argc) {
+      std::string value = argv[++i];
+      if (arg == "-j")
+        numThreads = std::stoul(value);
+      else if (arg == "-o")
+        outputFile = value;
+      else
+        format = value;
+    }
+    else
+      files.push_back(arg);
   }
 
-  std::string traceFile  = argv[1];
-  std::string xclbinFile = argv[2];
-
-  std::ifstream fin(traceFile, std::ios::binary|std::ios::in);
-  if (!fin) {
-    std::cerr << "Cannot open raw trace file " << traceFile << std::endl;
+  if (files.size() != 2) {
+    usage(argv[0]);
     return 0;
   }
 
-  // Create a database to store and interpret the events
-  xdp::VPDatabase* db = xdp::VPDatabase::Instance();
-
-  // Add metadata to the database from the xclbin
-  auto deviceId = db->addDevice("local");
-
-  db->getStaticInfo().updateDevice(deviceId, xclbinFile);
-
-  std::vector<uint64_t> traceData;
-
-  uint64_t packet = 0;
-  char* ch = reinterpret_cast<char*>(&packet);
-
-  while(fin.read(ch, 8)) {
-    traceData.push_back(packet);
+  std::string traceFile  = files[0];
+  std::string xclbinFile = files[1];
+
+  try {
+    // The trace writer picks up the format from the configuration
+    if (!format.empty())
+      xrt::ini::set("Debug.trace_file_format", format);
+
+    // Binary trace files get the binary extension from the writer,
+    //  so the default name only needs to match the format
+    if (outputFile.empty()) {
+      auto fileFormat = xrt_core::config::get_trace_file_format();
+      bool binary = (fileFormat == "binary" || fileFormat == "binary_compressed");
+      outputFile = std::string("output") + (binary ? xdp::VPTraceWriter::binaryExtension : ".csv");
+    }
+
+    xdp::MappedTraceFile trace(traceFile);
+
+    // Create a database to store and interpret the events
+    xdp::VPDatabase* db = xdp::VPDatabase::Instance();
+
+    // Add metadata to the database from the xclbin
+    auto deviceId = db->addDevice("local");
+    db->getStaticInfo().updateDevice(deviceId, xclbinFile);
+
+    // Add all of the events to the database
+    auto start = std::chrono::steady_clock::now();
+    xdp::PLDeviceTraceLogger logger(deviceId);
+    xdp::PLTraceProcessor processor(deviceId, numThreads);
+    processor.process(logger, trace.getPackets(), trace.getNumPackets());
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double megabytes = trace.getNumPackets() * sizeof(uint64_t) / 1e6;
+    std::cout << std::fixed << std::setprecision(3)
+              << "Decoded " << megabytes << " MB of trace from "
+              << processor.getNumGroups() << " monitor groups in "
+              << seconds << " s (" << megabytes / seconds << " MB/s)\n";
+
+    // Create a writer and have it write.
+    xdp::DeviceTraceWriter writer(outputFile.c_str(), deviceId, "1.1", xdp::getCurrentDateTime(), xdp::getXRTVersion(), xdp::getToolVersion());
+    writer.write(false);
+    std::cout << "Wrote " << writer.getcurrentFileName() << "\n";
+  }
+  catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
   }
-  fin.close();
-
-  // Add all of the events to the database
-  xdp::PLDeviceTraceLogger logger(deviceId);
-  uint64_t numBytes = sizeof(uint64_t)*traceData.size();
-  logger.processTraceData(traceData.data(), numBytes);
-
-  // Create a writer and have it write.
-  xdp::DeviceTraceWriter writer("output.csv", deviceId, "1.1", xdp::getCurrentDateTime(), xdp::getXRTVersion(), xdp::getToolVersion());
-  writer.write(false);
-
-  fin.close();
 
   return 0;
 }
-
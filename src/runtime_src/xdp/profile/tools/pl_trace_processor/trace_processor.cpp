@@ -0,0 +1,277 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "trace_processor.h"
+
+#include "xdp/profile/database/database.h"
+#include "xdp/profile/database/static_info/pl_constructs.h"
+#include "xdp/profile/database/static_info/xclbin_info.h"
+#include "xdp/profile/device/pl_device_trace_logger.h"
+#include "xdp/profile/device/utility.h"
+
+namespace {
+
+  inline uint64_t getTraceId(uint64_t packet)
+    { return (packet >> 49) & 0xFFF; }
+  inline bool isClockTraining(uint64_t packet)
+    { return (packet >> 63) == 1; }
+
+  // Run f(begin, end, index) for numRanges equal ranges of [0, count)
+  //  on separate threads
+  template <typename Function>
+  void forEachRange(uint64_t count, size_t numRanges, Function f)
+  {
+    std::vector<std::thread> threads;
+    uint64_t rangeSize = (count + numRanges - 1) / numRanges;
+    for (size_t i = 0; i < numRanges; ++i) {
+      uint64_t begin = std::min(count, i * rangeSize);
+      uint64_t end   = std::min(count, begin + rangeSize);
+      threads.emplace_back(f, begin, end, i);
+    }
+    for (auto& t : threads)
+      t.join();
+  }
+
+} // end anonymous namespace
+
+namespace xdp {
+
+  MappedTraceFile::MappedTraceFile(const std::string& filename)
+  {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("Cannot open raw trace file " + filename);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+      close(fd);
+      throw std::runtime_error("Cannot read size of raw trace file " + filename);
+    }
+
+    length = static_cast<uint64_t>(info.st_size);
+    if (length != 0) {
+      base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (base == MAP_FAILED) {
+        base = nullptr;
+        close(fd);
+        throw std::runtime_error("Cannot map raw trace file " + filename);
+      }
+      // Every thread reads the whole file from front to back
+      madvise(base, length, MADV_SEQUENTIAL);
+    }
+    close(fd);
+  }
+
+  MappedTraceFile::~MappedTraceFile()
+  {
+    if (base)
+      munmap(base, length);
+  }
+
+  PLTraceProcessor::PLTraceProcessor(uint64_t devId, unsigned int threads)
+    : deviceId(devId)
+    , numThreads(std::max(threads, 1u))
+  {
+    buildGroups();
+  }
+
+  // Group the trace IDs of all monitors by the compute unit they are
+  //  attached to.  The slots are computed from the trace IDs the same
+  //  way PLDeviceTraceLogger does.
+  void PLTraceProcessor::buildGroups()
+  {
+    traceIdGroups.assign(numTraceIds, noGroup);
+
+    auto db = VPDatabase::Instance();
+    ConfigInfo* config = db->getStaticInfo().getCurrentlyLoadedConfig(deviceId);
+    XclbinInfo* xclbin = config ? config->getPlXclbin() : nullptr;
+    if (!xclbin)
+      return;
+
+    std::map<int32_t, int32_t> cuGroups;
+    auto groupOf = [&](Monitor* mon) {
+      if (mon->cuIndex == -1)
+        return static_cast<int32_t>(numGroups++);
+      auto group = cuGroups.find(mon->cuIndex);
+      if (group != cuGroups.end())
+        return group->second;
+      return cuGroups[mon->cuIndex] = static_cast<int32_t>(numGroups++);
+    };
+    auto setGroup = [this](uint64_t first, uint64_t last, uint64_t max,
+                           int32_t group) {
+      for (uint64_t id = first; id <= last && id <= max; ++id)
+        traceIdGroups[id] = group;
+    };
+
+    auto& staticInfo = db->getStaticInfo();
+    for (uint64_t slot = 0; slot < staticInfo.getNumAM(deviceId, xclbin); ++slot) {
+      Monitor* mon = staticInfo.getAMonitor(deviceId, xclbin, slot);
+      if (!mon)
+        continue;
+      uint64_t first = util::min_trace_id_am + slot * util::num_trace_id_per_am;
+      setGroup(first, first + util::num_trace_id_per_am - 1,
+               util::max_trace_id_am, groupOf(mon));
+    }
+    for (uint64_t slot = 0; slot < staticInfo.getNumAIM(deviceId, xclbin); ++slot) {
+      Monitor* mon = staticInfo.getAIMonitor(deviceId, xclbin, slot);
+      if (!mon)
+        continue;
+      uint64_t first = util::min_trace_id_aim + slot * util::num_trace_id_per_aim;
+      setGroup(first, first + util::num_trace_id_per_aim - 1,
+               util::max_trace_id_aim, groupOf(mon));
+    }
+    for (uint64_t slot = 0; slot < staticInfo.getNumASM(deviceId, xclbin); ++slot) {
+      Monitor* mon = staticInfo.getASMonitor(deviceId, xclbin, slot);
+      if (!mon)
+        continue;
+      uint64_t first = util::min_trace_id_asm + slot;
+      setGroup(first, first, util::max_trace_id_asm - 1, groupOf(mon));
+    }
+  }
+
+  // Anything before the first 8 contiguous clock training packets is
+  //  garbage from the previous run
+  uint64_t PLTraceProcessor::findClockTrainingStart(const uint64_t* packets,
+                                                    uint64_t numPackets)
+  {
+    uint64_t contiguous = 0;
+    for (uint64_t i = 0; i < numPackets; ++i) {
+      contiguous = isClockTraining(packets[i]) ? contiguous + 1 : 0;
+      if (contiguous == 8)
+        return i - 7;
+    }
+    return 0;
+  }
+
+  std::vector<uint64_t> PLTraceProcessor::countPackets(const uint64_t* packets,
+                                                       uint64_t numPackets)
+  {
+    std::vector<std::vector<uint64_t>> partial(numThreads,
+                                               std::vector<uint64_t>(numGroups, 0));
+    forEachRange(numPackets, numThreads,
+                 [&](uint64_t begin, uint64_t end, size_t index) {
+                   auto& counts = partial[index];
+                   for (uint64_t i = begin; i < end; ++i) {
+                     if (isClockTraining(packets[i]))
+                       continue;
+                     int32_t group = traceIdGroups[getTraceId(packets[i])];
+                     if (group != noGroup)
+                       ++counts[group];
+                   }
+                 });
+
+    std::vector<uint64_t> counts(numGroups, 0);
+    for (auto& p : partial)
+      for (size_t g = 0; g < numGroups; ++g)
+        counts[g] += p[g];
+    return counts;
+  }
+
+  // Largest groups first, each to the worker with the fewest packets
+  std::vector<int32_t>
+  PLTraceProcessor::assignGroups(const std::vector<uint64_t>& counts,
+                                 size_t numWorkers)
+  {
+    std::vector<size_t> order(counts.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&counts](size_t a, size_t b) { return counts[a] > counts[b]; });
+
+    std::vector<uint64_t> load(numWorkers, 0);
+    std::vector<int32_t> groupWorkers(counts.size(), noGroup);
+    for (auto g : order) {
+      if (counts[g] == 0)
+        continue;
+      auto worker = std::min_element(load.begin(), load.end()) - load.begin();
+      groupWorkers[g] = static_cast<int32_t>(worker);
+      load[worker] += counts[g];
+    }
+    return groupWorkers;
+  }
+
+  // Decode the clock training packets and the packets of the groups
+  //  assigned to worker, in trace order
+  void PLTraceProcessor::decode(PLDeviceTraceLogger* logger,
+                                const uint64_t* packets, uint64_t numPackets,
+                                const std::vector<int32_t>& traceIdWorkers,
+                                int32_t worker)
+  {
+    std::vector<uint64_t> block;
+    block.reserve(blockSize);
+
+    for (uint64_t i = 0; i < numPackets; ++i) {
+      uint64_t packet = packets[i];
+      if (isClockTraining(packet) || traceIdWorkers[getTraceId(packet)] == worker)
+        block.push_back(packet);
+
+      if (block.size() == blockSize || (i + 1 == numPackets && !block.empty())) {
+        logger->processTraceData(block.data(), block.size() * sizeof(uint64_t));
+        block.clear();
+      }
+    }
+  }
+
+  void PLTraceProcessor::process(PLDeviceTraceLogger& logger,
+                                 const uint64_t* packets, uint64_t numPackets)
+  {
+    uint64_t start = findClockTrainingStart(packets, numPackets);
+    packets    += start;
+    numPackets -= start;
+
+    auto counts = countPackets(packets, numPackets);
+    size_t usedGroups = std::count_if(counts.begin(), counts.end(),
+                                      [](uint64_t c) { return c != 0; });
+    size_t numWorkers = std::max<size_t>(1, std::min<size_t>(numThreads, usedGroups));
+    auto groupWorkers = assignGroups(counts, numWorkers);
+
+    std::vector<int32_t> traceIdWorkers(numTraceIds, noGroup);
+    for (uint64_t id = 0; id < numTraceIds; ++id) {
+      if (traceIdGroups[id] != noGroup)
+        traceIdWorkers[id] = groupWorkers[traceIdGroups[id]];
+    }
+
+    // The first worker decodes into the logger passed in
+    std::vector<std::unique_ptr<PLDeviceTraceLogger>> loggers;
+    for (size_t w = 1; w < numWorkers; ++w)
+      loggers.push_back(std::make_unique<PLDeviceTraceLogger>(deviceId));
+
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < numWorkers; ++w) {
+      auto workerLogger = (w == 0) ? &logger : loggers[w - 1].get();
+      workers.emplace_back(&PLTraceProcessor::decode, workerLogger, packets,
+                           numPackets, std::cref(traceIdWorkers),
+                           static_cast<int32_t>(w));
+    }
+    for (auto& w : workers)
+      w.join();
+
+    for (auto& l : loggers)
+      logger.mergeStreamState(*l);
+    logger.endProcessTraceData();
+  }
+
+} // end namespace xdp
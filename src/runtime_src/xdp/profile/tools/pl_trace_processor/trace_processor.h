@@ -0,0 +1,104 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef PL_TRACE_PROCESSOR_DOT_H
+#define PL_TRACE_PROCESSOR_DOT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xdp {
+
+  class PLDeviceTraceLogger;
+
+  // A raw trace dump mapped into memory, so dumps larger than the
+  //  host memory can be processed
+  class MappedTraceFile
+  {
+  private:
+    void* base = nullptr;
+    uint64_t length = 0;
+
+  public:
+    explicit MappedTraceFile(const std::string& filename);
+    ~MappedTraceFile();
+
+    MappedTraceFile(const MappedTraceFile&) = delete;
+    MappedTraceFile& operator=(const MappedTraceFile&) = delete;
+
+    inline const uint64_t* getPackets() const
+      { return static_cast<const uint64_t*>(base); }
+    inline uint64_t getNumPackets() const
+      { return length / sizeof(uint64_t); }
+  };
+
+  // Decodes the raw PL trace of one device on several threads.
+  //
+  // The decode of a packet depends on all earlier packets of the same
+  //  compute unit (start and end matching, stall state, approximations
+  //  when a compute unit ends), so the trace cannot be cut into pieces
+  //  that are decoded independently.  Packets of different compute
+  //  units do not depend on each other though.  The monitors are grouped
+  //  by compute unit, with every floating monitor in a group of its own,
+  //  and the groups are spread over the threads by their packet counts.
+  //  Each thread decodes the packets of its groups in order, along with
+  //  all clock training packets, so the result is the same as decoding
+  //  the whole trace on one thread.
+  class PLTraceProcessor
+  {
+  private:
+    static constexpr int32_t noGroup = -1;
+    static constexpr uint64_t numTraceIds = 4096;
+
+    // Packets filtered and decoded at a time by every thread
+    static constexpr uint64_t blockSize = 0x10000;
+
+    uint64_t deviceId;
+    unsigned int numThreads;
+
+    // The group of each trace ID, or noGroup for packets that are ignored
+    std::vector<int32_t> traceIdGroups;
+    size_t numGroups = 0;
+
+    void buildGroups();
+    uint64_t findClockTrainingStart(const uint64_t* packets,
+                                    uint64_t numPackets);
+    std::vector<uint64_t> countPackets(const uint64_t* packets,
+                                       uint64_t numPackets);
+    std::vector<int32_t> assignGroups(const std::vector<uint64_t>& counts,
+                                      size_t numWorkers);
+    static void decode(PLDeviceTraceLogger* logger,
+                       const uint64_t* packets, uint64_t numPackets,
+                       const std::vector<int32_t>& traceIdWorkers,
+                       int32_t worker);
+
+  public:
+    PLTraceProcessor(uint64_t deviceId, unsigned int numThreads);
+
+    // Decode the packets into the database.  All events are added and
+    //  any unfinished events are approximated, as if logger had
+    //  decoded the trace by itself.
+    void process(PLDeviceTraceLogger& logger,
+                 const uint64_t* packets, uint64_t numPackets);
+
+    inline size_t getNumGroups() const { return numGroups; }
+  };
+
+} // end namespace xdp
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+// Microbenchmark of string interning in the xdp::StringTable as done by
+// the native XRT API callbacks.  Every thread repeatedly interns the
+// same set of function names, which is compared against a single
+// std::map protected by a global mutex (the previous implementation).
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "xdp/profile/database/dynamic_info/string_table.h"
+
+namespace {
+
+  // Function names as passed to the native callbacks
+  const char* functionNames[] = {
+    "xrt::bo::bo", "xrt::bo::size", "xrt::bo::address", "xrt::bo::sync",
+    "xrt::bo::write", "xrt::bo::read", "xrt::bo::map", "xrt::bo::copy",
+    "xrt::kernel::kernel", "xrt::kernel::group_id", "xrt::run::run",
+    "xrt::run::start", "xrt::run::wait", "xrt::run::set_arg",
+    "xrt::device::device", "xrt::device::load_xclbin"
+  };
+  constexpr size_t numNames = sizeof(functionNames) / sizeof(functionNames[0]);
+
+  // Keeps the results of the lookups alive
+  std::atomic<uint64_t> sink{0};
+
+  class LockedMapTable
+  {
+  private:
+    std::map<std::string, uint64_t> table;
+    uint64_t currentId = 1;
+    std::mutex dataLock;
+
+  public:
+    uint64_t addString(const std::string& value)
+    {
+      std::lock_guard<std::mutex> lock(dataLock);
+      if (table.find(value) == table.end())
+        table[value] = currentId++;
+      return table[value];
+    }
+  };
+
+  template <typename Function>
+  double run(unsigned int threads, uint64_t iterations, Function f)
+  {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; ++t) {
+      workers.emplace_back([&f, iterations]
+                           {
+                             uint64_t sum = 0;
+                             for (uint64_t i = 0; i < iterations; ++i)
+                               sum += f(functionNames[i % numNames]);
+                             sink += sum;
+                           });
+    }
+    for (auto& w : workers)
+      w.join();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count()
+      / (static_cast<double>(iterations) * threads);
+  }
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  if (argc > 3) {
+    std::cout << "Usage: " << argv[0] << " [<Max Threads> [<Iterations>]]\n";
+    return 0;
+  }
+
+  unsigned int maxThreads = (argc > 1) ? std::stoul(argv[1]) : 8;
+  uint64_t iterations     = (argc > 2) ? std::stoull(argv[2]) : 1000000;
+
+  std::cout << std::setw(8) << "threads"
+            << std::setw(14) << "map(ns)"
+            << std::setw(14) << "sharded(ns)"
+            << std::setw(14) << "static(ns)" << "\n";
+
+  for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+    LockedMapTable mapTable;
+    xdp::StringTable table;
+
+    double mapNs =
+      run(threads, iterations,
+          [&mapTable](const char* name) { return mapTable.addString(name); });
+    double shardedNs =
+      run(threads, iterations,
+          [&table](const char* name) { return table.addString(name); });
+    double staticNs =
+      run(threads, iterations,
+          [&table](const char* name) { return table.addStaticString(name); });
+
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(8) << threads
+              << std::setw(14) << mapNs
+              << std::setw(14) << shardedNs
+              << std::setw(14) << staticNs << "\n";
+  }
+
+  return 0;
+}
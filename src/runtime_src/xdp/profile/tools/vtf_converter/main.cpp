@@ -0,0 +1,65 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+// Convert a .vtfb trace file written with xrt.ini Debug.trace_file_format
+// set to binary or binary_compressed back to the CSV trace file that
+// existing viewers read.
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "xdp/profile/writer/vp_base/vp_binary_trace.h"
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3) {
+    std::cout << "Usage: " << argv[0] << " <Binary Trace File> <CSV Trace File>\n";
+    return 0;
+  }
+
+  std::string binaryFile = argv[1];
+  std::string csvFile    = argv[2];
+
+  std::ifstream fin(binaryFile, std::ios::binary|std::ios::in);
+  if (!fin) {
+    std::cerr << "Cannot open binary trace file " << binaryFile << std::endl;
+    return 1;
+  }
+
+  if (!xdp::BinaryTraceDecoder::isBinaryTrace(fin)) {
+    std::cerr << binaryFile << " is not a binary trace file" << std::endl;
+    return 1;
+  }
+
+  std::ofstream fout(csvFile, std::ios::binary|std::ios::out);
+  if (!fout) {
+    std::cerr << "Cannot open CSV trace file " << csvFile << std::endl;
+    return 1;
+  }
+
+  try {
+    xdp::BinaryTraceDecoder decoder(fin);
+    decoder.writeCSV(fout);
+  }
+  catch (const std::exception& ex) {
+    std::cerr << "Failed to convert " << binaryFile << ": " << ex.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+// Write the same events as CSV and in both binary trace file formats,
+// convert the binary files back to CSV, and check that the result is
+// identical to the CSV file.  The events span several binary blocks
+// and use hex fields, ranges, and events without fields.
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "xdp/profile/database/events/opencl_host_events.h"
+#include "xdp/profile/database/events/user_events.h"
+#include "xdp/profile/database/events/vtf_event.h"
+#include "xdp/profile/writer/vp_base/vp_binary_trace.h"
+
+namespace {
+
+  std::vector<std::unique_ptr<xdp::VTFEvent>> makeEvents(uint64_t count)
+  {
+    std::vector<std::unique_ptr<xdp::VTFEvent>> events ;
+    double ts = 1234567.0 ;
+    for (uint64_t id = 1 ; id <= count ; ++id) {
+      ts += 1337.0 + static_cast<double>(id % 7) ;
+      std::unique_ptr<xdp::VTFEvent> e ;
+      switch (id % 4) {
+      case 0:
+        e = std::make_unique<xdp::UserMarker>(0, ts, id % 3 ? id : 0) ;
+        break ;
+      case 1:
+        e = std::make_unique<xdp::UserRange>(0, ts, true, id, id + 1) ;
+        break ;
+      case 2:
+        e = std::make_unique<xdp::UserRange>(id - 1, ts, false) ;
+        break ;
+      default:
+        e = std::make_unique<xdp::OpenCLBufferTransfer>(0, ts, xdp::READ_BUFFER,
+                                                        0x4000000000 + id * 64,
+                                                        id % 5, id * 4096) ;
+        break ;
+      }
+      e->setEventId(id) ;
+      events.push_back(std::move(e)) ;
+    }
+    return events ;
+  }
+
+  std::string readFile(const std::string& name)
+  {
+    std::ifstream fin(name, std::ios::binary) ;
+    std::stringstream content ;
+    content << fin.rdbuf() ;
+    return content.str() ;
+  }
+
+  void roundTrip(const std::vector<std::unique_ptr<xdp::VTFEvent>>& events,
+                 bool compressed)
+  {
+    const std::string csvFile = "roundtrip_test.csv" ;
+    const std::string binaryFile = "roundtrip_test.vtfb" ;
+
+    {
+      std::ofstream fout(csvFile) ;
+      fout << "EVENTS\n" ;
+      for (auto& e : events)
+        e->dump(fout, 1) ;
+    }
+
+    {
+      std::ofstream fout(binaryFile, std::ios::out | std::ios::binary) ;
+      xdp::BinaryTraceEncoder encoder(compressed) ;
+      encoder.writeFileHeader(fout) ;
+      fout << "EVENTS\n" ;
+      for (auto& e : events)
+        e->dumpBinary(encoder.addRecord(fout), 1) ;
+      encoder.flush(fout) ;
+    }
+
+    std::string expected = readFile(csvFile) ;
+    std::stringstream decoded ;
+    {
+      std::ifstream fin(binaryFile, std::ios::in | std::ios::binary) ;
+      xdp::BinaryTraceDecoder decoder(fin) ;
+      decoder.writeCSV(decoded) ;
+    }
+    std::remove(csvFile.c_str()) ;
+    std::remove(binaryFile.c_str()) ;
+
+    if (decoded.str() == expected)
+      return ;
+
+    std::stringstream expectedLines(expected) ;
+    std::string expectedLine, decodedLine ;
+    for (unsigned int line = 1 ; ; ++line) {
+      bool moreExpected = static_cast<bool>(std::getline(expectedLines, expectedLine)) ;
+      bool moreDecoded = static_cast<bool>(std::getline(decoded, decodedLine)) ;
+      if (!moreExpected && !moreDecoded)
+        break ;
+      if (moreExpected != moreDecoded || expectedLine != decodedLine)
+        throw std::runtime_error(std::string(compressed ? "binary_compressed" : "binary")
+                                 + " line " + std::to_string(line) + ": expected '"
+                                 + expectedLine + "', decoded '" + decodedLine + "'") ;
+    }
+    throw std::runtime_error("decoded file differs from CSV file") ;
+  }
+
+  void tooManyFields()
+  {
+    xdp::VTFRecord record ;
+    for (uint32_t i = 0 ; i < xdp::VTFRecord::maxFields ; ++i)
+      record.addField(i) ;
+    try {
+      record.addField(xdp::VTFRecord::maxFields) ;
+    }
+    catch (const std::length_error&) {
+      return ;
+    }
+    throw std::runtime_error("adding too many fields to a record did not fail") ;
+  }
+
+} // end anonymous namespace
+
+int main()
+{
+  try {
+    // More than two blocks of events, with the last block partly full
+    auto events = makeEvents(2 * xdp::BinaryTraceEncoder::blockSize + 123) ;
+    roundTrip(events, false) ;
+    roundTrip(events, true) ;
+    tooManyFields() ;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n" ;
+    return 1 ;
+  }
+
+  std::cout << "TEST PASSED\n" ;
+  return 0 ;
+}
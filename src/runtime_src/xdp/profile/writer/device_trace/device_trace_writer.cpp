@@ -36,6 +36,7 @@ namespace xdp {
       toolVersion(toolV),
       deviceId(devId)
   {
+    enableBinaryFormat();
   }
 
   DeviceTraceWriter::~DeviceTraceWriter()
@@ -316,7 +317,7 @@ namespace xdp {
   void DeviceTraceWriter::writeStringTable()
   {
     fout << "MAPPING\n";
-    (db->getDynamicInfo()).dumpStringTable(fout);
+    dumpStringTable();
   }
 
   void DeviceTraceWriter::writeTraceEvents()
@@ -358,29 +359,37 @@ namespace xdp {
           continue; // Coverity - In case dynamic cast fails
         std::pair<XclbinInfo*, int32_t> index =
           std::make_pair(xclbin, cuId);
-        kernelEvent->dump(fout, cuBucketIdMap[index] + eventType - KERNEL);
+        VTFRecord* record =
+          dumpEvent(kernelEvent, cuBucketIdMap[index] + eventType - KERNEL);
         // Also output the tool tips
         for (const auto& iter : xclbin->pl.cus) {
           ComputeUnitInstance* cu = iter.second;
           if (cu->getAccelMon() == cuId) {
-            fout << "," << db->getDynamicInfo().addString(cu->getKernelName());
-            fout << "," << db->getDynamicInfo().addString(cu->getName());
+            uint64_t kernelName = db->getDynamicInfo().addString(cu->getKernelName());
+            uint64_t cuName = db->getDynamicInfo().addString(cu->getName());
+            if (record) {
+              record->addField(kernelName);
+              record->addField(cuName);
+            }
+            else
+              fout << "," << kernelName << "," << cuName;
           }
         }
-        fout << "\n";
+        if (!record)
+          fout << "\n";
       } else if(KERNEL_STALL_EXT_MEM == eventType
                 || KERNEL_STALL_DATAFLOW == eventType
                 || KERNEL_STALL_PIPE == eventType) {
         std::pair<XclbinInfo*, int32_t> index =
           std::make_pair(xclbin, cuId);
-        deviceEvent->dump(fout, cuBucketIdMap[index] + eventType - KERNEL);
+        dumpEvent(deviceEvent, cuBucketIdMap[index] + eventType - KERNEL);
       } else {
         // Memory or Stream Acceses
         uint32_t monId = deviceEvent->getMonitorId();
         DeviceMemoryAccess* memoryEvent = dynamic_cast<DeviceMemoryAccess*>(e.get());
         if (memoryEvent) {
           std::pair<XclbinInfo*, uint32_t> index =std::make_pair(xclbin, monId);
-          deviceEvent->dump(fout, aimBucketIdMap[index] + eventType - KERNEL_READ);
+          dumpEvent(deviceEvent, aimBucketIdMap[index] + eventType - KERNEL_READ);
           continue;
         }
         DeviceStreamAccess* streamEvent = dynamic_cast<DeviceStreamAccess*>(e.get());
@@ -388,15 +397,16 @@ namespace xdp {
           std::pair<XclbinInfo*, uint32_t> index = std::make_pair(xclbin, monId);
           if (KERNEL_STREAM_READ == eventType || KERNEL_STREAM_READ_STALL == eventType
                                               || KERNEL_STREAM_READ_STARVE == eventType) {
-            deviceEvent->dump(fout, asmBucketIdMap[index] + eventType - KERNEL_STREAM_READ);
+            dumpEvent(deviceEvent, asmBucketIdMap[index] + eventType - KERNEL_STREAM_READ);
           } else {
-            deviceEvent->dump(fout, asmBucketIdMap[index] + eventType - KERNEL_STREAM_WRITE);
+            dumpEvent(deviceEvent, asmBucketIdMap[index] + eventType - KERNEL_STREAM_WRITE);
           }
           continue;
         }
         // host read/write ??
       }
     }
+    flushEvents();
 
   }
 
@@ -433,7 +443,7 @@ namespace xdp {
 
     if (openNewFile) {
       switchFiles();
-      db->getStaticInfo().addOpenedFile(getcurrentFileName(), "VP_TRACE");
+      db->getStaticInfo().addOpenedFile(getcurrentFileName(), getFileType("VP_TRACE"));
     }
     return true;
   }
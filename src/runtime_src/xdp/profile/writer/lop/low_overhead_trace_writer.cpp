@@ -32,6 +32,7 @@ namespace xdp {
                    9 /* ns */),
     generalAPIBucket(-1), readBucket(-1), writeBucket(-1), enqueueBucket(-1)
   {
+    enableBinaryFormat() ;
   }
 
   LowOverheadTraceWriter::~LowOverheadTraceWriter()
@@ -92,7 +93,7 @@ namespace xdp {
   void LowOverheadTraceWriter::writeStringTable()
   {
     fout << "MAPPING\n";
-    (db->getDynamicInfo()).dumpStringTable(fout) ;
+    dumpStringTable() ;
   }
 
   void LowOverheadTraceWriter::writeTraceEvents()
@@ -120,8 +121,9 @@ namespace xdp {
       else if (e->isKernelEnqueue())
         bucket = enqueueBucket ;
 
-      e->dump(fout, bucket) ;
+      dumpEvent(e.get(), bucket) ;
     }
+    flushEvents() ;
   }
 
   void LowOverheadTraceWriter::writeDependencies()
@@ -27,6 +27,7 @@ namespace xdp {
   NativeTraceWriter::NativeTraceWriter(const char* filename) :
     VPTraceWriter(filename, "1.0", getCurrentDateTime(), 9 /* ns */)
   {
+    enableBinaryFormat() ;
   }
 
   NativeTraceWriter::~NativeTraceWriter()
@@ -37,6 +38,8 @@ namespace xdp {
   {
     VPTraceWriter::writeHeader() ;
     fout << "XRT Version," << getToolVersion() << "\n" ;
+    if (!triggerReason.empty())
+      fout << "Flight Recorder Trigger," << triggerReason << "\n" ;
   }
 
   void NativeTraceWriter::writeStructure()
@@ -55,7 +58,7 @@ namespace xdp {
   void NativeTraceWriter::writeStringTable()
   {
     fout << "MAPPING" << "\n" ;
-    (db->getDynamicInfo()).dumpStringTable(fout) ;
+    dumpStringTable() ;
   }
 
   void NativeTraceWriter::writeTraceEvents()
@@ -78,12 +81,13 @@ namespace xdp {
     for (auto& e : APIEvents) {
       // If this is a read/write, then dump the event in the other bucket
       if (e->isNativeRead())
-        e->dumpSync(fout, readBucket);
+        dumpSyncEvent(e, readBucket);
       else if (e->isNativeWrite())
-        e->dumpSync(fout, writeBucket);
+        dumpSyncEvent(e, writeBucket);
       else
-        e->dump(fout, APIBucket);
+        dumpEvent(e, APIBucket);
     }
+    flushEvents();
 
     for (auto& e : APIEvents)
       delete e;
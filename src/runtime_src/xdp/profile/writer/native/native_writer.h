@@ -17,6 +17,8 @@
 #ifndef NATIVE_WRITER_DOT_H
 #define NATIVE_WRITER_DOT_H
 
+#include <string>
+
 #include "xdp/profile/writer/vp_base/vp_trace_writer.h"
 
 namespace xdp {
@@ -30,6 +32,9 @@ namespace xdp {
     const uint32_t readBucket = 2 ;
     const uint32_t writeBucket = 3 ;
 
+    // When written by the flight recorder, what triggered the dump
+    std::string triggerReason ;
+
   protected:
     virtual void writeHeader() ;
     virtual void writeStructure() ;
@@ -44,6 +49,9 @@ namespace xdp {
     ~NativeTraceWriter() ;
 
     virtual bool write(bool openNewFile) ;
+
+    inline void setTriggerReason(const std::string& reason)
+      { triggerReason = reason ; }
   } ;
 
 } // end namespace xdp
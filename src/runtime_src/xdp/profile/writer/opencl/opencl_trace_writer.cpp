@@ -33,6 +33,7 @@ namespace xdp {
                    9 /* ns */),
     generalAPIBucket(-1), readBucket(-1), writeBucket(-1), copyBucket(-1)
   {
+    enableBinaryFormat() ;
   }
 
   OpenCLTraceWriter::~OpenCLTraceWriter()
@@ -106,7 +107,7 @@ namespace xdp {
   void OpenCLTraceWriter::writeStringTable()
   {
     fout << "MAPPING\n";
-    (db->getDynamicInfo()).dumpStringTable(fout) ;
+    dumpStringTable() ;
   }
 
   void OpenCLTraceWriter::writeTraceEvents()
@@ -140,8 +141,9 @@ namespace xdp {
         else
           bucket = generalAPIBucket; // Should never happen
       }
-      e->dump(fout, bucket) ;
+      dumpEvent(e.get(), bucket) ;
     }
+    flushEvents() ;
   }
 
   void OpenCLTraceWriter::writeDependencies()
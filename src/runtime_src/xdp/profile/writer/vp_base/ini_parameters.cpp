@@ -34,6 +34,17 @@ namespace xdp {
                  "Enable the top level of host trace");
     addParameter("native_xrt_trace", xrt_core::config::get_native_xrt_trace(),
                  "Generation of Native XRT API function trace");
+    addParameter("flight_recorder", xrt_core::config::get_flight_recorder(),
+                 "Keep recent Native XRT API events and only write them to a trace file when triggered");
+    addParameter("flight_recorder_duration_s",
+                 xrt_core::config::get_flight_recorder_duration_s(),
+                 "Duration of Native XRT API events kept by the flight recorder (in s)");
+    addParameter("flight_recorder_events",
+                 xrt_core::config::get_flight_recorder_events(),
+                 "Maximum number of Native XRT API calls kept by the flight recorder per thread");
+    addParameter("flight_recorder_signal",
+                 xrt_core::config::get_flight_recorder_signal(),
+                 "Signal that triggers a flight recorder dump (0 for none)");
     addParameter("xrt_trace", xrt_core::config::get_xrt_trace(),
                  "Generation of hardware SHIM function trace");
     addParameter("device_trace",
@@ -56,9 +67,15 @@ namespace xdp {
     addParameter("trace_buffer_offload_interval_ms",
                  xrt_core::config::get_trace_buffer_offload_interval_ms(),
                  "Interval for reading of device data to host (in ms)");
+    addParameter("trace_decode_threads",
+                 xrt_core::config::get_trace_decode_threads(),
+                 "Number of threads decoding device trace during continuous offload");
     addParameter("trace_file_dump_interval_s",
                  xrt_core::config::get_trace_file_dump_interval_s(),
                  "Interval for dumping files to host (in s)");              
+    addParameter("trace_file_format",
+                 xrt_core::config::get_trace_file_format(),
+                 "Format of trace files (csv, binary, or binary_compressed). Binary trace files are written as .vtfb files.");
     addParameter("lop_trace", xrt_core::config::get_lop_trace(),
                  "Generation of lower overhead OpenCL trace. Should not be used with other OpenCL options.");
     addParameter("debug_mode", xrt_core::config::get_launch_waveform(),
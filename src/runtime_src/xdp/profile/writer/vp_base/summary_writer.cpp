@@ -190,21 +190,13 @@ namespace xdp {
   void
   SummaryWriter::writeAPICalls(APIType type)
   {
-    // For each function call, across all of the threads,
-    //  consolidate all the information into what we need
-    std::map<std::string,
-             std::tuple<uint64_t,
-                        double,
-                        double,
-                        double> > rows ;
-
-    std::map<std::pair<std::string, std::thread::id>,
-             std::vector<std::pair<double, double>>> callCount =
-      (db->getStats()).getCallCount() ;
-
-    for (const auto& call : callCount) {
-      auto callAndThread = call.first ;
-      auto APIName = callAndThread.first ;
+    // The statistics on each function call are already consolidated
+    //  across all of the threads
+    std::map<std::string, StreamingStatistics> callStats =
+      (db->getStats()).getCallStatistics() ;
+
+    for (const auto& call : callStats) {
+      auto APIName = call.first ;
 
       switch (type) {
       case OPENCL:
@@ -221,47 +213,47 @@ namespace xdp {
         break ;
       }
 
-      std::vector<std::pair<double, double>> timesOfCalls = call.second ;
-
-      if (rows.find(APIName) == rows.end()) {
-        std::tuple<uint64_t, double, double, double> blank =
-          std::make_tuple<uint64_t, double, double, double>(0,0,std::numeric_limits<double>::max(),0) ;
-
-        rows[APIName] = blank ;
-      }
-
-      for (const auto& executionTime : timesOfCalls) {
-        auto timeTaken = executionTime.second - executionTime.first ;
-
-        ++(std::get<0>(rows[APIName])) ;
-        std::get<1>(rows[APIName]) += timeTaken ;
-        if (timeTaken < std::get<2>(rows[APIName]))
-          std::get<2>(rows[APIName]) = timeTaken ;
-        if (timeTaken > std::get<3>(rows[APIName]))
-          std::get<3>(rows[APIName]) = timeTaken ;
-      }
-    }
+      const StreamingStatistics& stats = call.second ;
+      if (stats.getCount() == 0)
+        continue ;
 
-    for (const auto& row : rows) {
-      auto averageTime =
-        static_cast<double>(std::get<1>(row.second)) / static_cast<double>(std::get<0>(row.second)) ;
       if (type != OPENCL) fout << "ENTRY:" ;
-      fout << row.first                      << ","     // API Name
-           << std::get<0>(row.second)        << ","     // Number of calls
-           << (std::get<1>(row.second)/one_million) << ","     // Total time
-           << (std::get<2>(row.second)/one_million) << ","     // Minimum time
-           << (averageTime/one_million)             << ","     // Average time
-           << (std::get<3>(row.second)/one_million) << ",\n" ; // Maximum time
+      fout << APIName                                          << ","  // API Name
+           << stats.getCount()                                 << ","  // Number of calls
+           << (static_cast<double>(stats.getTotal())/one_million) << ","  // Total time
+           << (static_cast<double>(stats.getMin())/one_million)   << ","  // Minimum time
+           << (stats.getAverage()/one_million)                    << ","  // Average time
+           << (static_cast<double>(stats.getMax())/one_million)   << "," ; // Maximum time
+      writePercentiles(stats) ;
+      fout << "\n" ;
     }
   }
 
+  void SummaryWriter::writePercentiles(const StreamingStatistics& stats)
+  {
+    fout << (static_cast<double>(stats.getPercentile(50.0))/one_million)  << ","
+         << (static_cast<double>(stats.getPercentile(99.0))/one_million)  << ","
+         << (static_cast<double>(stats.getPercentile(99.9))/one_million)  << "," ;
+  }
+
+  void SummaryWriter::writePercentileColumns()
+  {
+    fout << "COLUMN:<html>P50<br>Time (ms)</html>,float,"
+         << "Median execution time (in ms),\n" ;
+    fout << "COLUMN:<html>P99<br>Time (ms)</html>,float,"
+         << "99th percentile execution time (in ms),\n" ;
+    fout << "COLUMN:<html>P99.9<br>Time (ms)</html>,float,"
+         << "99.9th percentile execution time (in ms),\n" ;
+  }
+
   void SummaryWriter::writeOpenCLAPICalls()
   {
     // Title
     fout << "OpenCL API Calls\n" ;
     // Columns
     fout << "API Name,Number Of Calls,Total Time (ms),Minimum Time (ms),"
-         << "Average Time (ms),Maximum Time (ms),\n" ;
+         << "Average Time (ms),Maximum Time (ms),P50 Time (ms),"
+         << "P99 Time (ms),P99.9 Time (ms),\n" ;
     writeAPICalls(OPENCL) ;
   }
 
@@ -280,6 +272,7 @@ namespace xdp {
          << "Average execution time (in ms),\n";
     fout << "COLUMN:<html>Maximum<br>Time (ms)</html>,float,"
          << "Maximum execution time (in ms),\n";
+    writePercentileColumns() ;
     writeAPICalls(NATIVE) ;
   }
 
@@ -298,6 +291,7 @@ namespace xdp {
          << "Average execution time (in ms),\n";
     fout << "COLUMN:<html>Maximum<br>Time (ms)</html>,float,"
          << "Maximum execution time (in ms),\n";
+    writePercentileColumns() ;
     writeAPICalls(HAL) ;
   }
 
@@ -341,7 +335,7 @@ namespace xdp {
       return;
 
     // We can get kernel executions from purely host information
-    std::map<std::string, TimeStatistics> kernelExecutions =
+    const std::map<std::string, StreamingStatistics>& kernelExecutions =
       (db->getStats()).getKernelExecutionStats() ;
 
     if (kernelExecutions.size() == 0)
@@ -355,15 +349,19 @@ namespace xdp {
 
     // Column headers
     fout << "Kernel,Number Of Enqueues,Total Time (ms),Minimum Time (ms),"
-         << "Average Time (ms),Maximum Time (ms),\n" ;
+         << "Average Time (ms),Maximum Time (ms),P50 Time (ms),"
+         << "P99 Time (ms),P99.9 Time (ms),\n" ;
 
     for (const auto& execution : kernelExecutions) {
-      fout << execution.first                         << ","
-           << (execution.second).numExecutions        << ","
-           << ((execution.second).totalTime / one_million)   << ","
-           << ((execution.second).minTime / one_million)     << ","
-           << ((execution.second).averageTime / one_million) << ","
-           << ((execution.second).maxTime / one_million)     << ",\n" ;
+      const StreamingStatistics& stats = execution.second ;
+      fout << execution.first                                   << ","
+           << stats.getCount()                                  << ","
+           << (static_cast<double>(stats.getTotal()) / one_million) << ","
+           << (static_cast<double>(stats.getMin()) / one_million)   << ","
+           << (stats.getAverage() / one_million)                    << ","
+           << (static_cast<double>(stats.getMax()) / one_million)   << "," ;
+      writePercentiles(stats) ;
+      fout << "\n" ;
     }
   }
 
@@ -26,6 +26,7 @@
 #include <set>
 
 #include "xdp/config.h"
+#include "xdp/profile/database/streaming_statistics.h"
 #include "xdp/profile/writer/vp_base/vp_summary_writer.h"
 #include "xdp/profile/writer/vp_base/guidance_rules.h"
 
@@ -55,6 +56,8 @@ namespace xdp {
     // Generic host tables
     enum APIType { OPENCL, NATIVE, HAL, ALL } ;
     void writeAPICalls(APIType type) ;
+    void writePercentiles(const StreamingStatistics& stats) ;
+    void writePercentileColumns() ;
 
     // OpenCL specific device tables
     void writeSoftwareEmulationComputeUnitUtilization() ;
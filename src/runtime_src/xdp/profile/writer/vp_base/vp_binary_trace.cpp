@@ -0,0 +1,434 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+
+#include "xdp/profile/database/database.h"
+#include "xdp/profile/database/events/vtf_event.h"
+#include "xdp/profile/writer/vp_base/vp_binary_trace.h"
+
+namespace {
+
+  constexpr char magic[] = { 'V', 'T', 'F', 'B' } ;
+
+  template <typename T>
+  void putValue(std::string& buf, T value)
+  {
+    buf.append(reinterpret_cast<const char*>(&value), sizeof(T)) ;
+  }
+
+  void putVarint(std::string& buf, uint64_t value)
+  {
+    while (value >= 0x80) {
+      buf.push_back(static_cast<char>((value & 0x7f) | 0x80)) ;
+      value >>= 7 ;
+    }
+    buf.push_back(static_cast<char>(value)) ;
+  }
+
+  inline uint64_t zigzag(int64_t value)
+  {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63) ;
+  }
+
+  inline int64_t unzigzag(uint64_t value)
+  {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1) ;
+  }
+
+  // Bounds checked reads from a block payload
+  class Cursor
+  {
+  private:
+    const char* ptr ;
+    const char* end ;
+
+  public:
+    explicit Cursor(const std::string& buf)
+      : ptr(buf.data()), end(buf.data() + buf.size())
+    {}
+
+    template <typename T>
+    T getValue()
+    {
+      if (static_cast<size_t>(end - ptr) < sizeof(T))
+        throw std::runtime_error("Truncated binary trace block") ;
+      T value ;
+      std::memcpy(&value, ptr, sizeof(T)) ;
+      ptr += sizeof(T) ;
+      return value ;
+    }
+
+    uint64_t getVarint()
+    {
+      uint64_t value = 0 ;
+      for (unsigned int shift = 0 ; shift < 64 ; shift += 7) {
+        auto byte = static_cast<uint8_t>(getValue<char>()) ;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift ;
+        if (!(byte & 0x80))
+          return value ;
+      }
+      throw std::runtime_error("Invalid varint in binary trace block") ;
+    }
+
+    std::string getString(size_t size)
+    {
+      if (static_cast<size_t>(end - ptr) < size)
+        throw std::runtime_error("Truncated binary trace block") ;
+      std::string value(ptr, size) ;
+      ptr += size ;
+      return value ;
+    }
+  } ;
+
+} // end anonymous namespace
+
+namespace xdp {
+
+  // **************************
+  // Encoder
+  // **************************
+
+  BinaryTraceEncoder::BinaryTraceEncoder(bool compress) : compressed(compress)
+  {
+    records.reserve(blockSize) ;
+  }
+
+  void BinaryTraceEncoder::writeBlock(std::ofstream& fout, BinaryTraceBlock kind)
+  {
+    fout.put('\0') ;
+    fout.put(static_cast<char>(kind)) ;
+    uint64_t size = payload.size() ;
+    fout.write(reinterpret_cast<const char*>(&size), sizeof(size)) ;
+    fout.write(payload.data(), payload.size()) ;
+    payload.clear() ;
+  }
+
+  void BinaryTraceEncoder::writeFileHeader(std::ofstream& fout)
+  {
+    records.clear() ;
+    writtenTypes.clear() ;
+
+    payload.clear() ;
+    payload.append(magic, sizeof(magic)) ;
+    putValue<uint32_t>(payload, version) ;
+    putValue<uint8_t>(payload, compressed ? 1 : 0) ;
+    writeBlock(fout, BinaryTraceBlock::FILE) ;
+  }
+
+  void BinaryTraceEncoder::writeStringTable(std::ofstream& fout, VPDatabase* db)
+  {
+    uint64_t count = 0 ;
+    payload.clear() ;
+    putValue<uint64_t>(payload, 0) ; // Patched with the count below
+    db->getDynamicInfo().forEachString(
+      [this, &count](uint64_t id, const std::string& value)
+      {
+        putValue<uint64_t>(payload, id) ;
+        putValue<uint32_t>(payload, static_cast<uint32_t>(value.size())) ;
+        payload.append(value) ;
+        ++count ;
+      }) ;
+    std::memcpy(&payload[0], &count, sizeof(count)) ;
+    writeBlock(fout, BinaryTraceBlock::STRINGS) ;
+  }
+
+  VTFRecord& BinaryTraceEncoder::addRecord(std::ofstream& fout)
+  {
+    if (records.size() == blockSize)
+      flush(fout) ;
+    records.emplace_back() ;
+    return records.back() ;
+  }
+
+  void BinaryTraceEncoder::writeTypes(std::ofstream& fout)
+  {
+    std::set<uint16_t> newTypes ;
+    for (auto& record : records) {
+      if (writtenTypes.find(record.type) == writtenTypes.end())
+        newTypes.insert(record.type) ;
+    }
+    if (newTypes.empty())
+      return ;
+
+    payload.clear() ;
+    putValue<uint32_t>(payload, static_cast<uint32_t>(newTypes.size())) ;
+    for (auto type : newTypes) {
+      std::string name = VTFEvent::getTypeName(static_cast<VTFEventType>(type)) ;
+      putValue<uint16_t>(payload, type) ;
+      putValue<uint32_t>(payload, static_cast<uint32_t>(name.size())) ;
+      payload.append(name) ;
+      writtenTypes.insert(type) ;
+    }
+    writeBlock(fout, BinaryTraceBlock::TYPES) ;
+  }
+
+  void BinaryTraceEncoder::encodeFixed()
+  {
+    for (auto& r : records) putValue(payload, r.id) ;
+    for (auto& r : records) putValue(payload, r.startId) ;
+    for (auto& r : records) putValue(payload, r.timestamp) ;
+    for (auto& r : records) putValue(payload, r.bucket) ;
+    for (auto& r : records) putValue(payload, r.type) ;
+    for (auto& r : records) putValue(payload, r.numFields) ;
+    for (auto& r : records) putValue(payload, r.hexFields) ;
+    for (auto& r : records)
+      payload.append(reinterpret_cast<const char*>(r.fields),
+                     r.numFields * sizeof(uint64_t)) ;
+  }
+
+  void BinaryTraceEncoder::encodeCompressed()
+  {
+    // Ids and timestamps increase slowly from event to event, so only
+    // the differences are stored.  End events refer to a start event
+    // shortly before them, so the distance to the start is stored.
+    int64_t previous = 0 ;
+    for (auto& r : records) {
+      putVarint(payload, zigzag(static_cast<int64_t>(r.id) - previous)) ;
+      previous = static_cast<int64_t>(r.id) ;
+    }
+    for (auto& r : records) {
+      putVarint(payload, r.startId == 0 ? 0
+                : zigzag(static_cast<int64_t>(r.id - r.startId)) + 1) ;
+    }
+    previous = 0 ;
+    for (auto& r : records) {
+      auto ns = static_cast<int64_t>(std::llround(r.timestamp * 1.0e6)) ;
+      putVarint(payload, zigzag(ns - previous)) ;
+      previous = ns ;
+    }
+    for (auto& r : records) putVarint(payload, r.bucket) ;
+    for (auto& r : records) putVarint(payload, r.type) ;
+    for (auto& r : records) putValue(payload, r.numFields) ;
+    for (auto& r : records) putValue(payload, r.hexFields) ;
+    for (auto& r : records) {
+      for (uint8_t i = 0 ; i < r.numFields ; ++i)
+        putVarint(payload, r.fields[i]) ;
+    }
+  }
+
+  void BinaryTraceEncoder::flush(std::ofstream& fout)
+  {
+    if (records.empty())
+      return ;
+
+    writeTypes(fout) ;
+
+    payload.clear() ;
+    putValue<uint32_t>(payload, static_cast<uint32_t>(records.size())) ;
+    if (compressed)
+      encodeCompressed() ;
+    else
+      encodeFixed() ;
+    writeBlock(fout, BinaryTraceBlock::EVENTS) ;
+
+    records.clear() ;
+  }
+
+  // **************************
+  // Decoder
+  // **************************
+
+  BinaryTraceDecoder::BinaryTraceDecoder(std::istream& in) : fin(in)
+  {
+  }
+
+  bool BinaryTraceDecoder::isBinaryTrace(std::istream& in)
+  {
+    char header[2 + sizeof(uint64_t) + sizeof(magic)] = {} ;
+    auto pos = in.tellg() ;
+    in.read(header, sizeof(header)) ;
+    bool result = in.gcount() == sizeof(header)
+      && header[0] == '\0'
+      && header[1] == static_cast<char>(BinaryTraceBlock::FILE)
+      && std::memcmp(header + 2 + sizeof(uint64_t), magic, sizeof(magic)) == 0 ;
+    in.clear() ;
+    in.seekg(pos) ;
+    return result ;
+  }
+
+  void BinaryTraceDecoder::decodeStrings(const std::string& block,
+                                         std::ostream& out)
+  {
+    Cursor cursor(block) ;
+    auto count = cursor.getValue<uint64_t>() ;
+    for (uint64_t i = 0 ; i < count ; ++i) {
+      auto id = cursor.getValue<uint64_t>() ;
+      auto size = cursor.getValue<uint32_t>() ;
+      out << id << "," << cursor.getString(size) << "\n" ;
+    }
+  }
+
+  void BinaryTraceDecoder::decodeTypes(const std::string& block)
+  {
+    Cursor cursor(block) ;
+    auto count = cursor.getValue<uint32_t>() ;
+    for (uint32_t i = 0 ; i < count ; ++i) {
+      auto type = cursor.getValue<uint16_t>() ;
+      auto size = cursor.getValue<uint32_t>() ;
+      if (type >= typeNames.size())
+        typeNames.resize(type + 1) ;
+      typeNames[type] = cursor.getString(size) ;
+    }
+  }
+
+  void BinaryTraceDecoder::writeRecord(const VTFRecord& r, int64_t timestampNs,
+                                       std::ostream& out)
+  {
+    out << r.id << "," << r.startId << "," ;
+    if (compressed) {
+      // Print the stored integer exactly as the fixed point value
+      if (timestampNs < 0) {
+        out << "-" ;
+        timestampNs = -timestampNs ;
+      }
+      auto fill = out.fill('0') ;
+      out << (timestampNs / 1000000) << "."
+          << std::setw(6) << (timestampNs % 1000000) ;
+      out.fill(fill) ;
+    }
+    else {
+      std::ios_base::fmtflags flags = out.flags() ;
+      out << std::fixed << std::setprecision(6) << r.timestamp ;
+      out.flags(flags) ;
+    }
+    out << "," << r.bucket << "," ;
+    if (r.type < typeNames.size() && !typeNames[r.type].empty())
+      out << typeNames[r.type] ;
+    else
+      out << "UNKNOWN" ;
+
+    for (uint8_t i = 0 ; i < r.numFields ; ++i) {
+      if (r.hexFields & (1 << i))
+        out << ",0x" << std::hex << r.fields[i] << std::dec ;
+      else
+        out << "," << r.fields[i] ;
+    }
+    out << "\n" ;
+  }
+
+  void BinaryTraceDecoder::decodeEvents(const std::string& block,
+                                        std::ostream& out)
+  {
+    Cursor cursor(block) ;
+    auto count = cursor.getValue<uint32_t>() ;
+    if (count > BinaryTraceEncoder::blockSize)
+      throw std::runtime_error("Too many events in binary trace block") ;
+
+    std::vector<VTFRecord> records(count) ;
+    std::vector<int64_t> timestamps(compressed ? count : 0) ;
+    if (compressed) {
+      int64_t previous = 0 ;
+      for (auto& r : records) {
+        previous += unzigzag(cursor.getVarint()) ;
+        r.id = static_cast<uint64_t>(previous) ;
+      }
+      for (auto& r : records) {
+        auto distance = cursor.getVarint() ;
+        r.startId = distance == 0 ? 0 : r.id - unzigzag(distance - 1) ;
+      }
+      previous = 0 ;
+      for (auto& ts : timestamps) {
+        previous += unzigzag(cursor.getVarint()) ;
+        ts = previous ;
+      }
+      for (auto& r : records)
+        r.bucket = static_cast<uint32_t>(cursor.getVarint()) ;
+      for (auto& r : records)
+        r.type = static_cast<uint16_t>(cursor.getVarint()) ;
+    }
+    else {
+      for (auto& r : records) r.id = cursor.getValue<uint64_t>() ;
+      for (auto& r : records) r.startId = cursor.getValue<uint64_t>() ;
+      for (auto& r : records) r.timestamp = cursor.getValue<double>() ;
+      for (auto& r : records) r.bucket = cursor.getValue<uint32_t>() ;
+      for (auto& r : records) r.type = cursor.getValue<uint16_t>() ;
+    }
+    for (auto& r : records) {
+      r.numFields = cursor.getValue<uint8_t>() ;
+      if (r.numFields > VTFRecord::maxFields)
+        throw std::runtime_error("Too many fields in binary trace event") ;
+    }
+    for (auto& r : records) r.hexFields = cursor.getValue<uint8_t>() ;
+    for (auto& r : records) {
+      for (uint8_t i = 0 ; i < r.numFields ; ++i)
+        r.fields[i] = compressed ? cursor.getVarint()
+                                 : cursor.getValue<uint64_t>() ;
+    }
+
+    for (uint32_t i = 0 ; i < count ; ++i)
+      writeRecord(records[i], compressed ? timestamps[i] : 0, out) ;
+  }
+
+  void BinaryTraceDecoder::writeCSV(std::ostream& out)
+  {
+    if (!isBinaryTrace(fin))
+      throw std::runtime_error("Not a binary trace file") ;
+
+    std::string block ;
+    while (true) {
+      // Copy the text up to the next block
+      if (fin.peek() != '\0') {
+        fin.get(*out.rdbuf(), '\0') ;
+        fin.clear() ;
+      }
+      if (fin.get() == std::char_traits<char>::eof())
+        break ;
+
+      auto kind = fin.get() ;
+      uint64_t size = 0 ;
+      fin.read(reinterpret_cast<char*>(&size), sizeof(size)) ;
+      if (!fin)
+        throw std::runtime_error("Truncated binary trace block header") ;
+      block.resize(size) ;
+      fin.read(&block[0], size) ;
+      if (static_cast<uint64_t>(fin.gcount()) != size)
+        throw std::runtime_error("Truncated binary trace block") ;
+
+      switch (static_cast<BinaryTraceBlock>(kind)) {
+      case BinaryTraceBlock::FILE:
+      {
+        Cursor cursor(block) ;
+        if (cursor.getString(sizeof(magic)) != std::string(magic, sizeof(magic)))
+          throw std::runtime_error("Invalid binary trace file header") ;
+        if (cursor.getValue<uint32_t>() > BinaryTraceEncoder::version)
+          throw std::runtime_error("Unsupported binary trace file version") ;
+        compressed = cursor.getValue<uint8_t>() != 0 ;
+        typeNames.clear() ;
+        break ;
+      }
+      case BinaryTraceBlock::STRINGS:
+        decodeStrings(block, out) ;
+        break ;
+      case BinaryTraceBlock::TYPES:
+        decodeTypes(block) ;
+        break ;
+      case BinaryTraceBlock::EVENTS:
+        decodeEvents(block, out) ;
+        break ;
+      default:
+        throw std::runtime_error("Unknown binary trace block") ;
+      }
+    }
+    out.flush() ;
+  }
+
+} // end namespace xdp
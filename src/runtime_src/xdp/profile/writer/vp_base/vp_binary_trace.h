@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef VP_BINARY_TRACE_DOT_H
+#define VP_BINARY_TRACE_DOT_H
+
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "xdp/config.h"
+#include "xdp/profile/database/events/vtf_record.h"
+
+namespace xdp {
+
+  // Forward declarations
+  class VPDatabase ;
+
+  // Binary VTF trace files hold the same sections as CSV trace files.
+  // The text parts (HEADER, STRUCTURE, DEPENDENCIES, and the section
+  // names) are written as is, while the string table and the events
+  // are written as binary blocks.  A block starts with a NUL byte,
+  // which never appears in the text parts:
+  //
+  //   NUL <uint8 kind> <uint64 payload size> <payload>
+  //
+  // Every file starts with a FILE block.  A STRINGS block holds the
+  // string table, a TYPES block the names of the event types that
+  // appear for the first time in the file, and an EVENTS block up to
+  // blockSize event records stored column by column.  Columns are
+  // fixed width, or delta and varint encoded when the file is
+  // compressed.  Compressed files keep timestamps at the precision of
+  // the CSV file (6 digits after the decimal point).
+  //
+  // Values are stored in the byte order of the host that wrote the
+  // file.  BinaryTraceDecoder converts a binary trace file back to
+  // the CSV trace file the writer would have produced.
+  enum class BinaryTraceBlock : uint8_t {
+    FILE    = 1,
+    STRINGS = 2,
+    TYPES   = 3,
+    EVENTS  = 4
+  } ;
+
+  class BinaryTraceEncoder
+  {
+  private:
+    bool compressed ;
+    std::vector<VTFRecord> records ;
+    std::set<uint16_t> writtenTypes ; // Types with names in current file
+    std::string payload ;             // Reused between blocks
+
+    void writeBlock(std::ofstream& fout, BinaryTraceBlock kind) ;
+    void writeTypes(std::ofstream& fout) ;
+    void encodeFixed() ;
+    void encodeCompressed() ;
+
+  public:
+    static constexpr uint32_t version = 1 ;
+    static constexpr size_t blockSize = 4096 ;
+
+    XDP_CORE_EXPORT explicit BinaryTraceEncoder(bool compress) ;
+
+    // Called at the beginning of every new file
+    XDP_CORE_EXPORT void writeFileHeader(std::ofstream& fout) ;
+
+    XDP_CORE_EXPORT void writeStringTable(std::ofstream& fout, VPDatabase* db) ;
+
+    // Returns the record for the next event.  The record is valid
+    // until the next call to addRecord or flush.
+    XDP_CORE_EXPORT VTFRecord& addRecord(std::ofstream& fout) ;
+
+    // Write all records that have been added
+    XDP_CORE_EXPORT void flush(std::ofstream& fout) ;
+  } ;
+
+  class BinaryTraceDecoder
+  {
+  private:
+    std::istream& fin ;
+    bool compressed = false ;
+    std::vector<std::string> typeNames ;
+
+    void decodeStrings(const std::string& block, std::ostream& out) ;
+    void decodeTypes(const std::string& block) ;
+    void decodeEvents(const std::string& block, std::ostream& out) ;
+    void writeRecord(const VTFRecord& record, int64_t timestampNs,
+                     std::ostream& out) ;
+
+  public:
+    XDP_CORE_EXPORT explicit BinaryTraceDecoder(std::istream& in) ;
+
+    // Returns true if the stream starts with a binary trace file header
+    XDP_CORE_EXPORT static bool isBinaryTrace(std::istream& in) ;
+
+    // Write the CSV form of the binary trace file.  Throws
+    // std::runtime_error if the file is not a valid binary trace file.
+    XDP_CORE_EXPORT void writeCSV(std::ostream& out) ;
+  } ;
+
+} // end namespace xdp
+
+#endif
@@ -19,7 +19,10 @@
 
 #include <iostream>
 
+#include "core/common/config_reader.h"
+#include "core/common/message.h"
 #include "xdp/profile/database/database.h"
+#include "xdp/profile/database/events/vtf_event.h"
 #include "xdp/profile/writer/vp_base/vp_trace_writer.h"
 
 namespace xdp {
@@ -65,4 +68,91 @@ namespace xdp {
     traceID = pid + traceIDCtr++;
   }
 
+  void VPTraceWriter::enableBinaryFormat()
+  {
+    std::string format = xrt_core::config::get_trace_file_format() ;
+    if (format == "csv")
+      return ;
+
+    if (format != "binary" && format != "binary_compressed") {
+      xrt_core::message::send(xrt_core::message::severity_level::warning,
+                              "XRT",
+                              "Unknown trace_file_format " + format +
+                              ", trace files will be written as csv.") ;
+      return ;
+    }
+
+    binaryEncoder =
+      std::make_unique<BinaryTraceEncoder>(format == "binary_compressed") ;
+    changeExtension(binaryExtension) ;
+    openBinaryFile() ;
+  }
+
+  std::string VPTraceWriter::getFileType(const std::string& type)
+  {
+    return binaryEncoder ? binaryFileType : type ;
+  }
+
+  // The file opened by VPWriter is reopened in binary mode so that
+  // the binary blocks are not changed by newline translation
+  void VPTraceWriter::openBinaryFile()
+  {
+    fout.close() ;
+    fout.clear() ;
+    fout.open(getcurrentFileName(), std::ios::out | std::ios::binary) ;
+    binaryEncoder->writeFileHeader(fout) ;
+  }
+
+  void VPTraceWriter::switchFiles()
+  {
+    VPWriter::switchFiles() ;
+    if (binaryEncoder)
+      openBinaryFile() ;
+  }
+
+  void VPTraceWriter::refreshFile()
+  {
+    VPWriter::refreshFile() ;
+    if (binaryEncoder)
+      openBinaryFile() ;
+  }
+
+  void VPTraceWriter::dumpStringTable()
+  {
+    if (binaryEncoder)
+      binaryEncoder->writeStringTable(fout, db) ;
+    else
+      (db->getDynamicInfo()).dumpStringTable(fout) ;
+  }
+
+  VTFRecord* VPTraceWriter::dumpEvent(VTFEvent* e, uint32_t bucket)
+  {
+    if (!binaryEncoder) {
+      e->dump(fout, bucket) ;
+      return nullptr ;
+    }
+
+    VTFRecord& record = binaryEncoder->addRecord(fout) ;
+    e->dumpBinary(record, bucket) ;
+    return &record ;
+  }
+
+  VTFRecord* VPTraceWriter::dumpSyncEvent(VTFEvent* e, uint32_t bucket)
+  {
+    if (!binaryEncoder) {
+      e->dumpSync(fout, bucket) ;
+      return nullptr ;
+    }
+
+    VTFRecord& record = binaryEncoder->addRecord(fout) ;
+    e->dumpSyncBinary(record, bucket) ;
+    return &record ;
+  }
+
+  void VPTraceWriter::flushEvents()
+  {
+    if (binaryEncoder)
+      binaryEncoder->flush(fout) ;
+  }
+
 }
@@ -20,11 +20,16 @@
 
 #include <string>
 #include <atomic>
+#include <memory>
 
+#include "xdp/profile/writer/vp_base/vp_binary_trace.h"
 #include "xdp/profile/writer/vp_base/vp_writer.h"
 #include "xdp/config.h"
 
 namespace xdp {
+
+  // Forward declarations
+  class VTFEvent ;
   
   class VPTraceWriter : public VPWriter
   {
@@ -37,6 +42,11 @@ namespace xdp {
     std::string creationTime ;
     uint16_t resolution ;
     static std::atomic<unsigned int> traceIDCtr;
+
+    // Set if trace files are written in the binary format
+    std::unique_ptr<BinaryTraceEncoder> binaryEncoder ;
+
+    void openBinaryFile() ;
     
   protected:
     // Each new trace CSV file has the following sections
@@ -57,10 +67,37 @@ namespace xdp {
     // Return a unique ID everytime we're called
     XDP_CORE_EXPORT void setUniqueTraceID();
 
+    // Writers that write the string table and all events through the
+    // functions below call this in their constructor to support the
+    // binary trace file format selected by xrt.ini trace_file_format.
+    // Binary trace files are written with the .vtfb extension.
+    XDP_CORE_EXPORT void enableBinaryFormat() ;
+    inline bool isBinaryFormat() { return binaryEncoder != nullptr ; }
+
+    XDP_CORE_EXPORT void dumpStringTable() ;
+
+    // Write an event in the selected format.  In binary format the
+    // record of the event is returned so the caller can add fields to
+    // it; the record is valid until the next event is dumped.  In CSV
+    // format nullptr is returned.
+    XDP_CORE_EXPORT VTFRecord* dumpEvent(VTFEvent* e, uint32_t bucket) ;
+    XDP_CORE_EXPORT VTFRecord* dumpSyncEvent(VTFEvent* e, uint32_t bucket) ;
+
+    // Must be called after the last event in the EVENTS section
+    XDP_CORE_EXPORT void flushEvents() ;
+
+    XDP_CORE_EXPORT virtual void switchFiles() override ;
+    XDP_CORE_EXPORT virtual void refreshFile() override ;
+
   public:
     XDP_CORE_EXPORT VPTraceWriter(const char* filename, const std::string& v,
                              const std::string& c, uint16_t r) ;
     XDP_CORE_EXPORT ~VPTraceWriter() ;
+
+    static constexpr const char* binaryExtension = ".vtfb" ;
+    static constexpr const char* binaryFileType = "VP_TRACE_BINARY" ;
+
+    XDP_CORE_EXPORT virtual std::string getFileType(const std::string& type) override ;
   } ;
   
 }
@@ -23,6 +23,8 @@
 #include "core/common/message.h"
 #include "core/common/config_reader.h"
 
+#include <cstdio>
+
 #ifdef _WIN32
 #else
 #include <sys/types.h>
@@ -145,6 +147,25 @@ namespace xdp {
     fout.open(currentFileName.c_str()) ;
   }
 
+  void VPWriter::changeExtension(const std::string& ext)
+  {
+    auto replace = [&ext](const std::string& name) {
+      auto dot = name.find_last_of('.') ;
+      auto sep = name.find_last_of("/\\") ;
+      if (dot == std::string::npos || (sep != std::string::npos && dot < sep))
+        return name + ext ;
+      return name.substr(0, dot) + ext ;
+    } ;
+
+    fout.close() ;
+    fout.clear() ;
+    std::remove(currentFileName.c_str()) ;
+
+    basename = replace(basename) ;
+    currentFileName = replace(currentFileName) ;
+    fout.open(currentFileName.c_str()) ;
+  }
+
   std::string VPWriter::getcurrentFileName()
   {
     return currentFileName ;
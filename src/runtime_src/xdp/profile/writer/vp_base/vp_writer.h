@@ -66,6 +66,9 @@ namespace xdp {
     VPWriter() = delete ;
 
     inline const char* getRawBasename() { return basename.c_str() ; } 
+    // Replace the extension of all files created by this writer.  The
+    // current file is removed and reopened under the new name.
+    XDP_CORE_EXPORT void changeExtension(const std::string& ext) ;
     XDP_CORE_EXPORT virtual void switchFiles() ;
     XDP_CORE_EXPORT virtual void refreshFile() ;
   public:
@@ -77,6 +80,11 @@ namespace xdp {
 
     XDP_CORE_EXPORT virtual std::string getcurrentFileName() ;
 
+    // The type the files of this writer are registered with in the
+    // run summary.  Writers that can write their files in a different
+    // format replace the type the plugin registers by default.
+    virtual std::string getFileType(const std::string& type) { return type ; }
+
     virtual bool isRunSummaryWriter() { return false ; }
     // Return false to indicate no data was written
     virtual bool write(bool openNewFile = true) = 0 ;
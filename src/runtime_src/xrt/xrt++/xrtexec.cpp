@@ -3,9 +3,9 @@
 // Copyright (C) 2022-2023 Advanced Micro Devices, Inc. All rights reserved.
 #include "xrtexec.hpp"
 #include "xrt/device/device.h"
-#include "core/common/bo_cache.h"
 #include "core/common/api/command.h"
 #include "core/common/api/hw_queue.h"
+#include "core/common/exec_buffer_pool.h"
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/hwctx_handle.h"
 
@@ -72,29 +72,18 @@ get_device_handle(const xrt_device* device)
 
 namespace exec {
 
-using execbuf_type = xrt_core::bo_cache::cmd_bo<ert_packet>;
-static std::mutex s_mutex;
-static std::map<const xrt_xocl::device*, std::unique_ptr<xrt_core::bo_cache>> s_ebocache;
+using execbuf_type = xrt_core::exec_buffer_pool::cmd_bo<ert_packet>;
 
 static execbuf_type
-create_exec_buf(xrt_xocl::device* device)
+create_exec_buf(const xrt_xocl::device* device)
 {
-  auto itr = s_ebocache.find(device);
-  if (itr == s_ebocache.end()) {
-    auto at_close = [] (const xrt_xocl::device* device) {
-      s_ebocache.erase(device);
-    };
-    device->add_close_callback(std::bind(at_close, device));
-    s_ebocache.emplace(device, std::make_unique<xrt_core::bo_cache>(device->get_xcl_handle(), 128));
-  }
-
-  return s_ebocache[device]->alloc<ert_packet>();
+  return device->get_core_device()->get_exec_buffer_pool().alloc<ert_packet>();
 }
 
 static void
 release_exec_buf(const xrt_xocl::device* device, execbuf_type&& ebo)
 {
-  s_ebocache[device]->release(std::move(ebo));
+  device->get_core_device()->get_exec_buffer_pool().release(std::move(ebo));
 }
 
 struct command::impl : xrt_core::command
@@ -103,7 +92,7 @@ struct command::impl : xrt_core::command
     : m_device(device)
     , m_hwqueue(device->get_core_device().get())
     , m_execbuf(create_exec_buf(m_device))
-    , ert_pkt(reinterpret_cast<ert_packet*>(m_execbuf.second))
+    , ert_pkt(reinterpret_cast<ert_packet*>(m_execbuf.cmd))
   {
     ert_pkt->state = ERT_CMD_STATE_NEW;
     ert_pkt->opcode = opcode & 0x1F; // [4:0]
@@ -188,7 +177,7 @@ struct command::impl : xrt_core::command
   virtual xrt_core::buffer_handle*
   get_exec_bo() const
   {
-    return m_execbuf.first.get();
+    return m_execbuf.bo.get();
   }
 
   virtual xrt_core::hwctx_handle*
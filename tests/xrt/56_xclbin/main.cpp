@@ -14,6 +14,7 @@
  * under the License.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -169,6 +170,15 @@ list_xclbins_in_repo()
     auto xclbin = (*itr);
     std::cout << "xsa(" << xclbin.get_xsa_name() << ")\n";
     std::cout << "uuid(" << xclbin.get_uuid().to_string() << ")\n";
+
+    // Lookup through repository catalog
+    if (repo.load(xclbin.get_uuid()).get_uuid() != xclbin.get_uuid())
+      throw std::runtime_error("repository lookup by uuid failed");
+    for (auto& kernel : xclbin.get_kernels()) {
+      auto paths = repo.find_kernel(kernel.get_name());
+      if (std::find(paths.begin(), paths.end(), itr.path()) == paths.end())
+        throw std::runtime_error("repository lookup of kernel " + kernel.get_name() + " failed");
+    }
   }
 }
 
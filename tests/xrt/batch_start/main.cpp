@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "experimental/xrt_kernel.h"
+
+// Verify batched start of independent run objects with
+// xrt::start(std::vector<xrt::run>).
+//
+// A batch mixing runs with and without completion callbacks must
+// complete all runs.  A batch with a run that is part of a runlist,
+// or with the same run listed twice, must throw without starting any
+// run, such that the runs can be started again.
+//
+// The test can be run without hardware using the noop shim
+// % XCL_EMULATION_MODE=noop batch_start -k verify.xclbin
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o batch_start.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] -k <bitstream>\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to start (default: hello)\n";
+  std::cout << "  [--runs <number>]: number of runs per batch (default: 16)\n";
+  std::cout << "  -h\n\n";
+  std::cout << "* Bitstream is required\n";
+}
+
+static std::atomic<size_t> s_notified {0};
+
+static void
+callback(const void*, ert_cmd_state, void*)
+{
+  ++s_notified;
+}
+
+static std::vector<xrt::run>
+create_runs(const xrt::kernel& kernel, const xrt::bo& bo, size_t count)
+{
+  std::vector<xrt::run> runs;
+  for (size_t i = 0; i < count; ++i) {
+    xrt::run run(kernel);
+    run.set_arg(0, bo);
+
+    // Every other run is managed by the command monitor
+    if (i % 2)
+      run.add_callback(ERT_CMD_STATE_COMPLETED, callback, nullptr);
+
+    runs.push_back(std::move(run));
+  }
+  return runs;
+}
+
+static void
+wait_all(const std::vector<xrt::run>& runs)
+{
+  for (const auto& run : runs) {
+    auto state = run.wait();
+    if (state != ERT_CMD_STATE_COMPLETED)
+      throw std::runtime_error("run completed with state " + std::to_string(state));
+  }
+}
+
+static std::vector<ert_cmd_state>
+get_states(const std::vector<xrt::run>& runs)
+{
+  std::vector<ert_cmd_state> states;
+  for (const auto& run : runs)
+    states.push_back(run.state());
+  return states;
+}
+
+// Start a batch that is expected to fail validation and verify that
+// none of the runs changed state
+static void
+start_invalid(const std::vector<xrt::run>& batch, const std::string& what)
+{
+  auto states = get_states(batch);
+  try {
+    xrt::start(batch);
+  }
+  catch (const std::exception&) {
+    if (get_states(batch) != states)
+      throw std::runtime_error("run state changed by invalid batch with " + what);
+    return;
+  }
+  throw std::runtime_error("no exception for batch with " + what);
+}
+
+static void
+run(const xrt::device& device, const xrt::uuid& uuid, const std::string& kname, size_t count)
+{
+  xrt::hw_context hwctx{device, uuid};
+  xrt::kernel kernel{hwctx, kname};
+  xrt::bo bo(device, 1024, kernel.group_id(0));
+
+  // Valid batch, started twice to verify runs can be restarted
+  auto runs = create_runs(kernel, bo, count);
+  size_t managed = count / 2;
+  for (int i = 0; i < 2; ++i) {
+    xrt::start(runs);
+    wait_all(runs);
+  }
+
+  // Callbacks are invoked after runs are marked done
+  while (s_notified < 2 * managed)
+    std::this_thread::yield();
+  if (s_notified != 2 * managed)
+    throw std::runtime_error("expected " + std::to_string(2 * managed) + " notifications, got "
+                             + std::to_string(s_notified));
+
+  // Batch with a run that belongs to a runlist, listed last such
+  // that all runs before it pass validation
+  {
+    auto batch = create_runs(kernel, bo, count);
+    xrt::run listed{kernel};
+    listed.set_arg(0, bo);
+    xrt::runlist runlist{hwctx};
+    runlist.add(listed);
+    batch.push_back(listed);
+    start_invalid(batch, "runlist run");
+
+    // The other runs were not started and can be started now
+    batch.pop_back();
+    xrt::start(batch);
+    wait_all(batch);
+  }
+
+  // Batch with the same run listed twice
+  {
+    auto batch = create_runs(kernel, bo, count);
+    batch.push_back(batch.front());
+    start_invalid(batch, "duplicate run");
+
+    batch.pop_back();
+    xrt::start(batch);
+    wait_all(batch);
+  }
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  std::string kname = "hello";
+  unsigned int device_index = 0;
+  size_t count = 16;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--kernel")
+      kname = arg;
+    else if (cur == "--runs")
+      count = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("No xclbin specified");
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+
+  run(device, uuid, kname, count);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}
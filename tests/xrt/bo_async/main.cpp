@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+
+// Verify asynchronous sync of regular buffers with xrt::bo::async().
+//
+// - Many buffers are synced to and from device concurrently, the
+//   buffers keep their content.
+// - Copies of a handle can be waited on more than once.
+// - A handle released without waiting waits for its transfer, such
+//   that the buffer can be released right after.
+// - A run that waits for transfers with xrt::run::submit_wait()
+//   completes when started.
+//
+// The test can be run without hardware using the noop shim
+// % XCL_EMULATION_MODE=noop bo_async -k verify.xclbin
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o bo_async.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] -k <bitstream>\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to run (default: hello)\n";
+  std::cout << "  [--buffers <number>]: number of buffers synced concurrently (default: 16)\n";
+  std::cout << "  -h\n\n";
+  std::cout << "* Bitstream is required\n";
+}
+
+static constexpr size_t buffer_size = 64 * 1024;
+
+static void
+fill(xrt::bo& bo, unsigned int seed)
+{
+  auto data = bo.map<unsigned int*>();
+  for (size_t i = 0; i < bo.size() / sizeof(unsigned int); ++i)
+    data[i] = seed + static_cast<unsigned int>(i);
+}
+
+static void
+check(xrt::bo& bo, unsigned int seed)
+{
+  auto data = bo.map<unsigned int*>();
+  for (size_t i = 0; i < bo.size() / sizeof(unsigned int); ++i)
+    if (data[i] != seed + static_cast<unsigned int>(i))
+      throw std::runtime_error("buffer " + std::to_string(seed) + " content changed at " + std::to_string(i));
+}
+
+static void
+run_round_trip(const xrt::device& device, const xrt::kernel& kernel, size_t count)
+{
+  std::vector<xrt::bo> bos;
+  for (size_t i = 0; i < count; ++i) {
+    bos.emplace_back(device, buffer_size, kernel.group_id(0));
+    fill(bos.back(), static_cast<unsigned int>(i));
+  }
+
+  std::vector<xrt::bo::async_handle> handles;
+  for (auto& bo : bos)
+    handles.push_back(bo.async(XCL_BO_SYNC_BO_TO_DEVICE));
+  for (auto& handle : handles)
+    handle.wait();
+
+  // Copies of a handle share the transfer, waiting again returns
+  // immediately
+  auto copies = handles;
+  handles.clear();
+  for (auto& handle : copies)
+    handle.wait();
+
+  for (size_t i = 0; i < count; ++i)
+    handles.push_back(bos[i].async(XCL_BO_SYNC_BO_FROM_DEVICE, buffer_size / 2, i % 2 ? buffer_size / 2 : 0));
+  for (auto& handle : handles)
+    handle.wait();
+
+  for (size_t i = 0; i < count; ++i)
+    check(bos[i], static_cast<unsigned int>(i));
+
+  // Handles released without wait, the buffers are released right after
+  for (auto& bo : bos)
+    bo.async(XCL_BO_SYNC_BO_TO_DEVICE);
+}
+
+static void
+run_submit_wait(const xrt::device& device, const xrt::kernel& kernel, size_t count)
+{
+  std::vector<xrt::bo> bos;
+  for (size_t i = 0; i < count; ++i)
+    bos.emplace_back(device, buffer_size, kernel.group_id(0));
+
+  xrt::run run(kernel);
+  for (size_t i = 0; i < count; ++i) {
+    // One transfer per start
+    run.set_arg(0, bos[i]);
+    run.submit_wait(bos[i].async(XCL_BO_SYNC_BO_TO_DEVICE));
+    run.start();
+    auto state = run.wait();
+    if (state != ERT_CMD_STATE_COMPLETED)
+      throw std::runtime_error("run completed with state " + std::to_string(state));
+  }
+
+  // All transfers for one start
+  for (auto& bo : bos)
+    run.submit_wait(bo.async(XCL_BO_SYNC_BO_TO_DEVICE));
+  run.start();
+  auto state = run.wait();
+  if (state != ERT_CMD_STATE_COMPLETED)
+    throw std::runtime_error("run completed with state " + std::to_string(state));
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  std::string kname = "hello";
+  unsigned int device_index = 0;
+  size_t count = 16;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--kernel")
+      kname = arg;
+    else if (cur == "--buffers")
+      count = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("No xclbin specified");
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+  auto kernel = xrt::kernel(device, uuid, kname);
+
+  run_round_trip(device, kernel, count);
+  run_submit_wait(device, kernel, count);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}
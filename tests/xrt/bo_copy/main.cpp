@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "experimental/xrt_ini.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+
+// Verify the content of xrt::bo::write(), xrt::bo::read(), and
+// xrt::bo::copy() of host buffers when the copies are split across
+// copy engine threads.  The copy engine threshold is lowered such
+// that all but the smallest copies are split.
+//
+// Offsets and sizes are deliberately not multiples of the page size
+// or of the vector store width.
+//
+// The test can be run without hardware using the noop shim
+// % XCL_EMULATION_MODE=noop bo_copy
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o bo_copy.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options]\n\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--threads <number>]: number of copy engine threads (default: 4)\n";
+  std::cout << "  [--size <MB>]: size of buffers (default: 16)\n";
+  std::cout << "  -h\n\n";
+}
+
+static void
+fill(std::vector<char>& data, unsigned int seed)
+{
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i * 7 + seed);
+}
+
+static void
+compare(const char* expect, const char* actual, size_t size, const std::string& what)
+{
+  if (std::memcmp(expect, actual, size))
+    throw std::runtime_error(what + ": data mismatch");
+}
+
+static void
+run(const xrt::device& device, size_t size)
+{
+  static const std::vector<std::pair<size_t, size_t>> ranges {
+    {0, 4096},                  // below threshold
+    {0, size},                  // entire buffer
+    {1, size - 1},              // unaligned start
+    {0, size - 3},              // unaligned end
+    {4093, size / 2 + 17},      // unaligned start and end
+    {size / 3 + 5, size / 3}    // unaligned middle
+  };
+
+  xrt::bo src(device, size, xrt::bo::flags::host_only, 0);
+  xrt::bo dst(device, size, xrt::bo::flags::host_only, 0);
+  std::vector<char> data(size);
+  std::vector<char> out(size);
+
+  unsigned int seed = 0;
+  for (auto [offset, bytes] : ranges) {
+    auto what = "offset " + std::to_string(offset) + " size " + std::to_string(bytes);
+
+    fill(data, ++seed);
+    src.write(data.data(), bytes, offset);
+    compare(data.data(), src.map<char*>() + offset, bytes, "write " + what);
+
+    // Bytes outside the range are not touched by read
+    std::memset(out.data(), 0, size);
+    src.read(out.data(), bytes, offset);
+    compare(data.data(), out.data(), bytes, "read " + what);
+    for (size_t i = bytes; i < size; ++i)
+      if (out[i])
+        throw std::runtime_error("read " + what + ": wrote past end of range");
+
+    dst.copy(src, bytes, offset, offset);
+    compare(src.map<char*>() + offset, dst.map<char*>() + offset, bytes, "copy " + what);
+  }
+}
+
+static int
+run(int argc, char** argv)
+{
+  unsigned int device_index = 0;
+  std::string threads = "4";
+  size_t size_mb = 16;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--threads")
+      threads = arg;
+    else if (cur == "--size")
+      size_mb = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (size_mb < 1)
+    throw std::runtime_error("size must be at least 1MB");
+
+  // Must be set before the first buffer is copied
+  xrt::ini::set("Runtime.copy_engine_threads", threads);
+  xrt::ini::set("Runtime.copy_engine_threshold", "65536");
+
+  auto device = xrt::device(device_index);
+  run(device, size_mb * 1024 * 1024);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}
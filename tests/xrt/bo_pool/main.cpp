@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+
+// Verify reuse of buffers allocated from an xrt::bo_pool.
+//
+// - A released buffer is reused by an allocation of the same flags,
+//   memory group, and size class, the reused buffer reports the
+//   requested size.
+// - Allocations of other flags or size class are not served by the
+//   released buffer.
+// - A buffer is not returned to the pool until its sub-buffers are
+//   released.
+// - Released buffers that exceed the high water mark are evicted.
+// - trim() frees cached buffers.
+// - Buffers allocated from the pool remain valid after the pool is
+//   released.
+//
+// The test can be run without hardware using the noop shim
+// % XCL_EMULATION_MODE=noop bo_pool
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o bo_pool.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options]\n\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  -h\n\n";
+}
+
+static constexpr size_t high_water = 64 * 1024;
+
+static void
+expect(bool cond, const std::string& what)
+{
+  if (!cond)
+    throw std::runtime_error(what);
+}
+
+static void
+expect_stats(const xrt::bo_pool& pool, uint64_t hits, uint64_t misses, size_t cached, const std::string& what)
+{
+  auto stats = pool.get_stats();
+  if (stats.hits != hits || stats.misses != misses || stats.cached != cached)
+    throw std::runtime_error(what + ": expected hits " + std::to_string(hits)
+                             + ", misses " + std::to_string(misses)
+                             + ", cached " + std::to_string(cached)
+                             + ", got " + std::to_string(stats.hits)
+                             + ", " + std::to_string(stats.misses)
+                             + ", " + std::to_string(stats.cached));
+}
+
+static void
+run(const xrt::device& device)
+{
+  xrt::bo_pool pool(device, high_water);
+  expect_stats(pool, 0, 0, 0, "new pool");
+
+  // Released buffer is cached and reused for same size class
+  {
+    xrt::bo bo(pool, 10000, xrt::bo::flags::normal, 0);
+    expect(bo.size() == 10000, "wrong size of new buffer");
+  }
+  expect_stats(pool, 0, 1, 1, "released buffer");
+  expect(pool.get_stats().cached_bytes >= 10000, "cached bytes less than released buffer");
+
+  xrt::bo reused(pool, 9000, xrt::bo::flags::normal, 0);
+  expect(reused.size() == 9000, "reused buffer does not report requested size");
+  expect_stats(pool, 1, 1, 0, "reused buffer");
+
+  // Buffer is usable after reuse
+  std::vector<char> data(reused.size(), 'x');
+  reused.write(data.data());
+  reused.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+  expect(!std::memcmp(reused.map<char*>(), data.data(), data.size()), "reused buffer content");
+
+  // Other flags and other size class are not served from the cache
+  {
+    xrt::bo other_flags(pool, 9000, xrt::bo::flags::cacheable, 0);
+    xrt::bo other_size(pool, 40000, xrt::bo::flags::normal, 0);
+    expect_stats(pool, 1, 3, 0, "other flags and size");
+  }
+  expect_stats(pool, 1, 3, 2, "released other flags and size");
+
+  // Buffer is returned to the pool when its sub-buffer is released
+  {
+    xrt::bo sub(reused, 1024, 0);
+    reused = xrt::bo{};
+    expect_stats(pool, 1, 3, 2, "released parent of sub-buffer");
+  }
+  expect_stats(pool, 1, 3, 3, "released sub-buffer");
+
+  // Releasing more than high water bytes evicts buffers
+  {
+    std::vector<xrt::bo> bos;
+    for (size_t i = 0; i < 4; ++i)
+      bos.emplace_back(pool, high_water / 2, xrt::bo::flags::normal, 0);
+  }
+  auto stats = pool.get_stats();
+  expect(stats.evictions > 0, "no evictions when exceeding high water");
+  expect(stats.cached_bytes <= high_water, "cached bytes exceed high water");
+  expect(stats.peak_bytes <= high_water, "peak bytes exceed high water");
+  expect(stats.peak_bytes >= stats.cached_bytes, "peak bytes less than cached bytes");
+
+  // Trim frees all cached buffers
+  pool.trim();
+  auto trimmed = pool.get_stats();
+  expect(trimmed.trimmed == stats.cached, "trimmed count is not number of cached buffers");
+  expect(trimmed.cached == 0 && trimmed.cached_bytes == 0, "buffers cached after trim");
+
+  // Buffers outlive the pool
+  xrt::bo survivor(pool, 4096, xrt::bo::flags::normal, 0);
+  pool = xrt::bo_pool{};
+  survivor.write(data.data(), 4096, 0);
+  survivor.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+  expect(!std::memcmp(survivor.map<char*>(), data.data(), 4096), "survivor buffer content");
+}
+
+static int
+run(int argc, char** argv)
+{
+  unsigned int device_index = 0;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  auto device = xrt::device(device_index);
+  run(device);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}
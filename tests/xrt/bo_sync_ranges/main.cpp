@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+
+// Verify that xrt::sync() of a batch of buffer ranges combines the
+// ranges that can be synced together and validates all ranges.
+//
+// The return value of xrt::sync() is the number of combined ranges,
+// each synced with one sync of the buffer the ranges belong to.
+//
+// The test can be run without hardware using the noop shim
+// % XCL_EMULATION_MODE=noop bo_sync_ranges
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o bo_sync_ranges.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options]\n\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--subs <number>]: number of sub-buffers (default: 16)\n";
+  std::cout << "  -h\n\n";
+}
+
+static constexpr size_t sub_size = 4096;
+static constexpr auto to_device = XCL_BO_SYNC_BO_TO_DEVICE;
+static constexpr auto from_device = XCL_BO_SYNC_BO_FROM_DEVICE;
+
+static void
+expect_calls(const std::vector<xrt::bo_sync_range>& ranges, size_t expected, const std::string& what)
+{
+  auto calls = xrt::sync(ranges);
+  if (calls != expected)
+    throw std::runtime_error(what + ": expected " + std::to_string(expected)
+                             + " syncs, got " + std::to_string(calls));
+}
+
+static void
+expect_throw(const std::vector<xrt::bo_sync_range>& ranges, const std::string& what)
+{
+  try {
+    xrt::sync(ranges);
+  }
+  catch (const std::exception&) {
+    return;
+  }
+  throw std::runtime_error(what + ": no exception");
+}
+
+static void
+run(const xrt::device& device, size_t subs)
+{
+  xrt::bo parent(device, subs * sub_size, 0);
+  std::vector<xrt::bo> bos;
+  for (size_t i = 0; i < subs; ++i)
+    bos.emplace_back(parent, sub_size, i * sub_size);
+
+  // Adjacent sub-buffers listed in reverse order are one range
+  {
+    std::vector<xrt::bo_sync_range> ranges;
+    for (size_t i = subs; i-- > 0;)
+      ranges.push_back({bos[i], 0, sub_size, to_device});
+    expect_calls(ranges, 1, "adjacent sub-buffers");
+  }
+
+  // Every other sub-buffer, the gaps are not synced
+  {
+    std::vector<xrt::bo_sync_range> ranges;
+    for (size_t i = 0; i < subs; i += 2)
+      ranges.push_back({bos[i], 0, sub_size, to_device});
+    expect_calls(ranges, (subs + 1) / 2, "sub-buffers with gaps");
+  }
+
+  // Same ranges in both directions are not combined
+  {
+    std::vector<xrt::bo_sync_range> ranges;
+    for (size_t i = 0; i < subs; ++i)
+      ranges.push_back({bos[i], 0, sub_size, (i % 2) ? to_device : from_device});
+    expect_calls(ranges, subs, "alternating directions");
+  }
+
+  // Overlapping ranges of the parent and its sub-buffers are one range
+  {
+    std::vector<xrt::bo_sync_range> ranges {
+      {parent, 0, 2 * sub_size, to_device},
+      {bos[1], 0, sub_size, to_device},
+      {bos[1], sub_size / 2, sub_size / 2, to_device},
+      {parent, sub_size, 2 * sub_size, to_device}
+    };
+    expect_calls(ranges, 1, "overlapping ranges");
+  }
+
+  // A sub-buffer of a sub-buffer resolves to the parent
+  {
+    xrt::bo sub(bos[0], sub_size / 2, sub_size / 2);
+    std::vector<xrt::bo_sync_range> ranges {
+      {sub, 0, sub_size / 2, to_device},
+      {bos[1], 0, sub_size, to_device}
+    };
+    expect_calls(ranges, 1, "nested sub-buffer");
+  }
+
+  // Ranges of different buffers are not combined
+  {
+    xrt::bo other(device, sub_size, 0);
+    std::vector<xrt::bo_sync_range> ranges {
+      {bos[0], 0, sub_size, to_device},
+      {other, 0, sub_size, to_device}
+    };
+    expect_calls(ranges, 2, "different buffers");
+  }
+
+  // Ranges of zero size are ignored
+  {
+    std::vector<xrt::bo_sync_range> ranges {
+      {bos[0], 0, 0, to_device},
+      {parent, subs * sub_size, 0, from_device}
+    };
+    expect_calls(ranges, 0, "zero size ranges");
+    expect_calls({}, 0, "no ranges");
+  }
+
+  // Invalid ranges throw, valid ranges listed before them are not synced
+  {
+    xrt::bo_sync_range valid {bos[0], 0, sub_size, to_device};
+    expect_throw({valid, {bos[1], 0, sub_size + 1, to_device}}, "range exceeds sub-buffer");
+    expect_throw({valid, {parent, sub_size, subs * sub_size, to_device}}, "range exceeds buffer");
+    expect_throw({valid, {bos[1], std::numeric_limits<size_t>::max(), 1, to_device}}, "offset overflow");
+    expect_throw({valid, {bos[1], 1, std::numeric_limits<size_t>::max(), to_device}}, "size overflow");
+    expect_throw({valid, {xrt::bo{}, 0, sub_size, to_device}}, "empty buffer object");
+  }
+}
+
+static int
+run(int argc, char** argv)
+{
+  unsigned int device_index = 0;
+  size_t subs = 16;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--subs")
+      subs = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (subs < 3)
+    throw std::runtime_error("at least 3 sub-buffers are required");
+
+  auto device = xrt::device(device_index);
+  run(device, subs);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "experimental/xrt_elf.h"
+#include "experimental/xrt_ext.h"
+#include "experimental/xrt_module.h"
+#include "experimental/xrt_xclbin.h"
+
+#ifdef _WIN32
+# pragma warning ( disable : 4267 )
+#endif
+
+// Verify patching of kernel arguments into the control code of a
+// kernel created from an ELF module.
+//
+// - A run with all arguments set completes.
+// - Buffer arguments set again to other buffers are patched again,
+//   and the run completes.
+// - With --aie2ps, a run that has not set all arguments fails to
+//   start, even if other arguments have been set more than once.
+//   Only control code of aie2ps ELFs checks that all arguments are
+//   patched.
+//
+// % ctrlcode_patch -k design.xclbin -e control.elf --kernel DPU
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o ctrlcode_patch.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] -k <bitstream> -e <elf>\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -e <elf>: ELF with control code for kernel\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to run (default: DPU)\n";
+  std::cout << "  [--iterations <number>]: number of runs with changed buffers (default: 10)\n";
+  std::cout << "  [--aie2ps]: ELF is aie2ps, check that runs with unset arguments fail\n";
+  std::cout << "  -h\n\n";
+  std::cout << "* Bitstream and ELF are required\n";
+}
+
+static bool
+is_buffer(const xrt::xclbin::arg& arg)
+{
+  return arg.get_host_type().find('*') != std::string::npos;
+}
+
+// Buffers per argument index, alternated between runs
+using buffer_map = std::map<size_t, std::pair<xrt::bo, xrt::bo>>;
+
+// Set arguments of run, except the argument with index skip
+static void
+set_args(xrt::run& run, const std::vector<xrt::xclbin::arg>& xargs, const buffer_map& bos,
+         size_t iteration, size_t skip = SIZE_MAX)
+{
+  for (const auto& xarg : xargs) {
+    auto idx = xarg.get_index();
+    if (idx == skip)
+      continue;
+
+    if (!is_buffer(xarg)) {
+      run.set_arg(idx, static_cast<uint32_t>(idx));
+      continue;
+    }
+
+    const auto& [first, second] = bos.at(idx);
+    run.set_arg(idx, (iteration & 1) ? first : second);
+  }
+}
+
+static void
+start_and_wait(xrt::run& run, const std::string& what)
+{
+  run.start();
+  auto state = run.wait();
+  if (state != ERT_CMD_STATE_COMPLETED)
+    throw std::runtime_error(what + ": run completed with state " + std::to_string(state));
+}
+
+static void
+run(const xrt::hw_context& hwctx, const xrt::xclbin& xclbin, const xrt::module& module,
+    const std::string& kname, size_t iterations, bool aie2ps)
+{
+  auto kernel = xrt::ext::kernel(hwctx, module, kname);
+  auto xargs = xclbin.get_kernel(kname).get_args();
+  if (xargs.empty())
+    throw std::runtime_error("kernel " + kname + " has no arguments");
+
+  buffer_map bos;
+  for (const auto& xarg : xargs)
+    if (is_buffer(xarg))
+      bos[xarg.get_index()] = {xrt::ext::bo(hwctx, 4096), xrt::ext::bo(hwctx, 4096)};
+
+  // All arguments set, then buffers changed per run
+  {
+    xrt::run run(kernel);
+    for (size_t it = 0; it < iterations; ++it) {
+      set_args(run, xargs, bos, it);
+      start_and_wait(run, "iteration " + std::to_string(it));
+    }
+  }
+
+  if (!aie2ps)
+    return;
+
+  // Last argument not set, the other arguments are set repeatedly
+  // to verify that an argument is counted once
+  auto skip = xargs.back().get_index();
+  xrt::run run(kernel);
+  for (size_t it = 0; it < 2; ++it)
+    set_args(run, xargs, bos, it, skip);
+
+  try {
+    run.start();
+  }
+  catch (const std::exception&) {
+    // Setting the last argument completes the run
+    set_args(run, xargs, bos, 0);
+    start_and_wait(run, "all arguments set after failed start");
+    return;
+  }
+  throw std::runtime_error("run with unset argument " + std::to_string(skip) + " was started");
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 5) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  std::string elf_fnm;
+  std::string kname = "DPU";
+  unsigned int device_index = 0;
+  size_t iterations = 10;
+  bool aie2ps = false;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+    else if (arg == "--aie2ps") {
+      aie2ps = true;
+      continue;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-e")
+      elf_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--kernel")
+      kname = arg;
+    else if (cur == "--iterations")
+      iterations = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("No xclbin specified");
+  if (elf_fnm.empty())
+    throw std::runtime_error("No ELF specified");
+
+  auto device = xrt::device(device_index);
+  auto xclbin = xrt::xclbin(xclbin_fnm);
+  auto uuid = device.register_xclbin(xclbin);
+  xrt::hw_context hwctx(device, uuid);
+  xrt::module module{xrt::elf{elf_fnm}};
+
+  run(hwctx, xclbin, module, kname, iterations, aie2ps);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+
+// Verify managed command execution.  Multiple threads start runs with
+// completion callbacks, which makes them monitored by the XRT command
+// monitor thread.  Every start must be notified exactly once with
+// completed state.
+//
+// The test can be run without hardware using the noop shim
+// % XCL_EMULATION_MODE=noop managed_launch -k verify.xclbin
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o managed_launch.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] -k <bitstream>\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to launch (default: hello)\n";
+  std::cout << "  [--threads <number>]: number of launching threads (default: 4)\n";
+  std::cout << "  [--jobs <number>]: number of runs in flight per thread (default: 8)\n";
+  std::cout << "  [--iterations <number>]: number of starts per run (default: 1000)\n";
+  std::cout << "  -h\n\n";
+  std::cout << "* Bitstream is required\n";
+}
+
+struct job_type
+{
+  xrt::bo bo;
+  xrt::run run;
+  std::atomic<size_t> notified {0};
+  std::atomic<size_t> errors {0};
+
+  job_type(const xrt::device& device, const xrt::kernel& kernel)
+    : bo(device, 1024, kernel.group_id(0))
+    , run(kernel)
+  {
+    run.set_arg(0, bo);
+    run.add_callback(ERT_CMD_STATE_COMPLETED, &job_type::callback, this);
+  }
+
+  static void
+  callback(const void*, ert_cmd_state state, void* data)
+  {
+    auto job = static_cast<job_type*>(data);
+    if (state != ERT_CMD_STATE_COMPLETED)
+      ++job->errors;
+    ++job->notified;
+  }
+
+  // Wait for run and for its callback to be invoked, the run is
+  // marked done before callbacks are invoked
+  void
+  wait(size_t expected)
+  {
+    auto state = run.wait();
+    if (state != ERT_CMD_STATE_COMPLETED)
+      throw std::runtime_error("run completed with state " + std::to_string(state));
+
+    while (notified < expected)
+      std::this_thread::yield();
+  }
+};
+
+static void
+run_thread(const xrt::device& device, const xrt::kernel& kernel, size_t num_jobs, size_t iterations)
+{
+  std::vector<std::unique_ptr<job_type>> jobs;
+  for (size_t i = 0; i < num_jobs; ++i)
+    jobs.emplace_back(std::make_unique<job_type>(device, kernel));
+
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    for (auto& job : jobs)
+      job->run.start();
+    for (auto& job : jobs)
+      job->wait(iter + 1);
+  }
+
+  for (auto& job : jobs) {
+    if (job->notified != iterations)
+      throw std::runtime_error("expected " + std::to_string(iterations) + " notifications, got "
+                               + std::to_string(job->notified));
+    if (job->errors)
+      throw std::runtime_error("callback notified with bad command state");
+  }
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  std::string kname = "hello";
+  unsigned int device_index = 0;
+  size_t threads = 4;
+  size_t jobs = 8;
+  size_t iterations = 1000;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--kernel")
+      kname = arg;
+    else if (cur == "--threads")
+      threads = std::stoul(arg);
+    else if (cur == "--jobs")
+      jobs = std::stoul(arg);
+    else if (cur == "--iterations")
+      iterations = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("No xclbin specified");
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+  auto kernel = xrt::kernel(device, uuid, kname);
+
+  std::vector<std::future<void>> futures;
+  for (size_t i = 0; i < threads; ++i)
+    futures.emplace_back(std::async(std::launch::async, run_thread, device, kernel, jobs, iterations));
+
+  for (auto& f : futures)
+    f.get();
+
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures how much of the time spent staging input
+// buffers can be hidden behind kernel execution with xrt::bo::async().
+//
+// The serial loop syncs the input buffer and then runs the kernel.
+// The overlapped loop uses two buffers and two runs.  While one run
+// executes, the input buffer of the next run is synced with
+// xrt::bo::async(), and the next run waits for the transfer with
+// xrt::run::submit_wait() before it is started.
+//
+// The test can be run without hardware using the noop or sw_emu shim
+//   % XCL_EMULATION_MODE=noop xrt_bo_async -k verify.xclbin
+////////////////////////////////////////////////////////////////
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+#include "perf_test.h"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using perf::clock_type;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_bo_async [options]\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to run (default: hello)\n";
+  std::cout << "  [--size <KB>]: size of input buffer (default: 1024)\n";
+  std::cout << "  [--iterations <number>]: number of runs (default: 1000)\n";
+  std::cout << "";
+  std::cout << "* Summary prints runs per second of the serial and the overlapped loop\n";
+}
+
+static double
+runs_per_second(size_t iterations, clock_type::time_point start)
+{
+  auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start).count();
+  return elapsed_us ? iterations * 1e6 / elapsed_us : 0.0;
+}
+
+// Sync input, then run, one iteration at a time
+static double
+run_serial(const xrt::kernel& kernel, xrt::bo& bo, size_t iterations)
+{
+  xrt::run run(kernel);
+  run.set_arg(0, bo);
+
+  auto start = clock_type::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    run.start();
+    run.wait();
+  }
+  return runs_per_second(iterations, start);
+}
+
+// Stage input of next run while current run executes
+static double
+run_overlapped(const xrt::kernel& kernel, std::array<xrt::bo, 2>& bos, size_t iterations)
+{
+  std::array<xrt::run, 2> runs {xrt::run(kernel), xrt::run(kernel)};
+  runs[0].set_arg(0, bos[0]);
+  runs[1].set_arg(0, bos[1]);
+
+  auto start = clock_type::now();
+  auto transfer = bos[0].async(XCL_BO_SYNC_BO_TO_DEVICE);
+  for (size_t i = 0; i < iterations; ++i) {
+    auto& run = runs[i % 2];
+    run.submit_wait(transfer);
+    run.start();
+
+    if (i + 1 == iterations)
+      break;
+
+    // The input of the next run is free once its previous run is done
+    auto& next = runs[(i + 1) % 2];
+    if (i > 0)
+      next.wait();
+    transfer = bos[(i + 1) % 2].async(XCL_BO_SYNC_BO_TO_DEVICE);
+  }
+
+  for (auto& run : runs)
+    run.wait();
+  return runs_per_second(iterations, start);
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::string xclbin_fnm;
+  unsigned int device_index = 0;
+  std::string kname = "hello";
+  size_t size_kb = 1024;
+  size_t iterations = 1000;
+
+  auto parsed = perf::parse_args(argc, argv, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--kernel")
+      kname = arg;
+    else if (cur == "--size")
+      size_kb = std::stoul(arg);
+    else if (cur == "--iterations")
+      iterations = std::stoul(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  if (!size_kb || !iterations)
+    throw std::runtime_error("size and iterations must be greater than 0");
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+  auto kernel = xrt::kernel(device, uuid, kname);
+
+  auto size = size_kb * 1024;
+  std::array<xrt::bo, 2> bos {
+    xrt::bo(device, size, kernel.group_id(0)),
+    xrt::bo(device, size, kernel.group_id(0))
+  };
+  for (auto& bo : bos)
+    std::memset(bo.map<char*>(), 0, size);
+
+  auto serial = run_serial(kernel, bos[0], iterations);
+  auto overlapped = run_overlapped(kernel, bos, iterations);
+
+  std::cout << "xrt_bo_async: size (KB) = " << size_kb << ", iterations = " << iterations << "\n";
+  std::cout << std::fixed << std::setprecision(1)
+            << "serial:     " << serial << " runs/s\n"
+            << "overlapped: " << overlapped << " runs/s\n";
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures the bandwidth of xrt::bo::write() and
+// xrt::bo::read() between application memory and the host side of a
+// host only buffer, for sizes from 64KB up to the max size.  A plain
+// single threaded memcpy to and from the mapped buffer is the
+// baseline.
+//
+// Large copies are done by the XRT copy engine.  The number of copy
+// threads and the size from which the copy engine is used are set
+// with --threads and --threshold, or in xrt.ini
+//   [Runtime]
+//   copy_engine_threads=8
+//   copy_engine_threshold=16777216
+//
+//   % XCL_EMULATION_MODE=noop xrt_bo_copy --threads 8
+////////////////////////////////////////////////////////////////
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "experimental/xrt_ini.h"
+#include "perf_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using perf::clock_type;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_bo_copy [options]\n\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--threads <number>]: number of copy engine threads (default: xrt.ini)\n";
+  std::cout << "  [--threshold <bytes>]: copy engine threshold (default: xrt.ini)\n";
+  std::cout << "  [--max-size <MB>]: largest copy (default: 1024)\n";
+  std::cout << "  [--iterations <number>]: copies per size (default: 10)\n";
+  std::cout << "";
+  std::cout << "* Summary prints GB/s of memcpy, bo.write(), and bo.read()\n";
+  std::cout << "* for 64KB, 256KB, ... up to max size.\n";
+}
+
+template <typename Copy>
+static double
+bandwidth(size_t size, size_t iterations, Copy&& copy)
+{
+  copy(); // warm up, fault in the pages
+  auto start = clock_type::now();
+  for (size_t i = 0; i < iterations; ++i)
+    copy();
+  auto end = clock_type::now();
+
+  auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  return static_cast<double>(size) * iterations / elapsed_ns;
+}
+
+static void
+run(xrt::bo& bo, std::vector<char>& src, std::vector<char>& dst, size_t size, size_t iterations)
+{
+  auto bo_data = bo.map<char*>();
+  auto memcpy_gbs = bandwidth(size, iterations, [&] {
+    std::memcpy(bo_data, src.data(), size);
+  });
+  auto write_gbs = bandwidth(size, iterations, [&] {
+    bo.write(src.data(), size, 0);
+  });
+  auto read_gbs = bandwidth(size, iterations, [&] {
+    bo.read(dst.data(), size, 0);
+  });
+
+  if (std::memcmp(src.data(), dst.data(), size))
+    throw std::runtime_error("data read does not match data written");
+
+  std::cout << std::setw(12) << size / 1024 << std::fixed << std::setprecision(2)
+            << std::setw(16) << memcpy_gbs
+            << std::setw(16) << write_gbs
+            << std::setw(16) << read_gbs << "\n";
+}
+
+static int
+run(int argc, char** argv)
+{
+  unsigned int device_index = 0;
+  std::string threads;
+  std::string threshold;
+  size_t max_size = 1024;
+  size_t iterations = 10;
+
+  auto parsed = perf::parse_args(argc, argv, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--threads")
+      threads = arg;
+    else if (cur == "--threshold")
+      threshold = arg;
+    else if (cur == "--max-size")
+      max_size = std::stoul(arg);
+    else if (cur == "--iterations")
+      iterations = std::stoul(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  if (!max_size || !iterations)
+    throw std::runtime_error("max size and iterations must be greater than 0");
+
+  // Must be set before the first buffer is copied
+  if (!threads.empty())
+    xrt::ini::set("Runtime.copy_engine_threads", threads);
+  if (!threshold.empty())
+    xrt::ini::set("Runtime.copy_engine_threshold", threshold);
+
+  auto device = xrt::device(device_index);
+
+  size_t max_bytes = max_size * 1024 * 1024;
+  xrt::bo bo(device, max_bytes, xrt::bo::flags::host_only, 0);
+  std::vector<char> src(max_bytes);
+  std::vector<char> dst(max_bytes);
+  for (size_t i = 0; i < max_bytes; ++i)
+    src[i] = static_cast<char>(i * 7);
+
+  std::cout << "xrt_bo_copy: iterations per size = " << iterations << "\n";
+  std::cout << std::setw(12) << "size(KB)" << std::setw(16) << "memcpy(GB/s)"
+            << std::setw(16) << "write(GB/s)" << std::setw(16) << "read(GB/s)" << "\n";
+  for (size_t size = 64 * 1024; size < max_bytes; size *= 4)
+    run(bo, src, dst, size, iterations);
+  run(bo, src, dst, max_bytes, iterations);
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures allocation of short lived buffer objects, as
+// done by applications that allocate buffers per request.  Each
+// iteration allocates a number of buffers of random sizes, writes
+// to them, and releases them.  Buffers are first allocated directly
+// from the device and then from an xrt::bo_pool.
+//
+//   % XCL_EMULATION_MODE=noop xrt_bo_pool --buffers 16 --max-size 1024
+////////////////////////////////////////////////////////////////
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "perf_test.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using perf::clock_type;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_bo_pool [options]\n\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--buffers <number>]: buffers allocated per iteration (default: 16)\n";
+  std::cout << "  [--max-size <KB>]: max size of a buffer (default: 1024)\n";
+  std::cout << "  [--high-water <MB>]: max bytes cached by the pool (default: 256)\n";
+  std::cout << "  [--iterations <number>]: number of iterations (default: 1000)\n";
+  std::cout << "";
+  std::cout << "* Summary prints time per iteration with and without pool, and pool stats\n";
+}
+
+template <typename Alloc>
+static double
+iteration_us(const std::vector<size_t>& sizes, size_t buffers, size_t iterations, Alloc&& alloc)
+{
+  auto start = clock_type::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    std::vector<xrt::bo> bos;
+    bos.reserve(buffers);
+    for (size_t b = 0; b < buffers; ++b) {
+      auto sz = sizes[(i * buffers + b) % sizes.size()];
+      bos.push_back(alloc(sz));
+      std::memset(bos.back().map<char*>(), static_cast<int>(b), sz);
+      bos.back().sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    }
+  }
+  auto end = clock_type::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() * 1e-3 / iterations;
+}
+
+static int
+run(int argc, char** argv)
+{
+  unsigned int device_index = 0;
+  size_t buffers = 16;
+  size_t max_size_kb = 1024;
+  size_t high_water_mb = 256;
+  size_t iterations = 1000;
+
+  auto parsed = perf::parse_args(argc, argv, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--buffers")
+      buffers = std::stoul(arg);
+    else if (cur == "--max-size")
+      max_size_kb = std::stoul(arg);
+    else if (cur == "--high-water")
+      high_water_mb = std::stoul(arg);
+    else if (cur == "--iterations")
+      iterations = std::stoul(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  if (!buffers || !max_size_kb || !iterations)
+    throw std::runtime_error("buffers, max size, and iterations must be greater than 0");
+
+  auto device = xrt::device(device_index);
+
+  // Same sequence of sizes for both runs
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<size_t> dist(1, max_size_kb * 1024);
+  std::vector<size_t> sizes(1024);
+  for (auto& sz : sizes)
+    sz = dist(gen);
+
+  auto direct_us = iteration_us(sizes, buffers, iterations, [&](size_t sz) {
+    return xrt::bo(device, sz, 0);
+  });
+
+  xrt::bo_pool pool(device, high_water_mb * 1024 * 1024);
+  auto pooled_us = iteration_us(sizes, buffers, iterations, [&](size_t sz) {
+    return xrt::bo(pool, sz, 0);
+  });
+
+  auto stats = pool.get_stats();
+  std::cout << "xrt_bo_pool: buffers per iteration = " << buffers
+            << ", max size (KB) = " << max_size_kb
+            << ", iterations = " << iterations << "\n";
+  std::cout << std::fixed << std::setprecision(2)
+            << "direct: " << direct_us << " us/iteration\n"
+            << "pooled: " << pooled_us << " us/iteration\n";
+  std::cout << "pool: hits = " << stats.hits
+            << ", misses = " << stats.misses
+            << ", evictions = " << stats.evictions
+            << ", cached = " << stats.cached
+            << ", cached (KB) = " << stats.cached_bytes / 1024
+            << ", peak (KB) = " << stats.peak_bytes / 1024 << "\n";
+
+  pool.trim();
+  if (pool.get_stats().cached_bytes)
+    throw std::runtime_error("trim did not free cached buffers");
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
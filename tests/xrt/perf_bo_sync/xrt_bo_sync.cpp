@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures syncing of many sub-buffers of one buffer, as
+// done per inference by pipelines that place all tensors in one
+// buffer.  Each sub-buffer is synced with xrt::bo::sync(), then all
+// sub-buffers are synced with one call to xrt::sync(), which
+// combines adjacent ranges.
+//
+// With --skip n, every n-th sub-buffer is not synced, which leaves
+// gaps that split the ranges that can be combined.
+//
+//   % XCL_EMULATION_MODE=noop xrt_bo_sync --subs 64 --skip 4
+////////////////////////////////////////////////////////////////
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "perf_test.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using perf::clock_type;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_bo_sync [options]\n\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--subs <number>]: number of sub-buffers (default: 64)\n";
+  std::cout << "  [--sub-size <KB>]: size of each sub-buffer (default: 64)\n";
+  std::cout << "  [--skip <number>]: do not sync every n-th sub-buffer (default: 0, sync all)\n";
+  std::cout << "  [--iterations <number>]: number of times all sub-buffers are synced (default: 1000)\n";
+  std::cout << "";
+  std::cout << "* Summary prints driver sync calls and latency per iteration\n";
+}
+
+template <typename Sync>
+static double
+latency_us(size_t iterations, Sync&& sync)
+{
+  sync(); // warm up
+  auto start = clock_type::now();
+  for (size_t i = 0; i < iterations; ++i)
+    sync();
+  auto end = clock_type::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() * 1e-3 / iterations;
+}
+
+static int
+run(int argc, char** argv)
+{
+  unsigned int device_index = 0;
+  size_t subs = 64;
+  size_t sub_size_kb = 64;
+  size_t skip = 0;
+  size_t iterations = 1000;
+
+  auto parsed = perf::parse_args(argc, argv, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--subs")
+      subs = std::stoul(arg);
+    else if (cur == "--sub-size")
+      sub_size_kb = std::stoul(arg);
+    else if (cur == "--skip")
+      skip = std::stoul(arg);
+    else if (cur == "--iterations")
+      iterations = std::stoul(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  if (!subs || !sub_size_kb || !iterations)
+    throw std::runtime_error("subs, sub-size, and iterations must be greater than 0");
+
+  auto device = xrt::device(device_index);
+  auto sub_size = sub_size_kb * 1024;
+  xrt::bo parent(device, subs * sub_size, 0);
+
+  std::vector<xrt::bo> bos;
+  std::vector<xrt::bo_sync_range> ranges;
+  for (size_t i = 0; i < subs; ++i) {
+    xrt::bo sub(parent, sub_size, i * sub_size);
+    if (!skip || (i + 1) % skip)
+      ranges.push_back({sub, 0, sub_size, XCL_BO_SYNC_BO_TO_DEVICE});
+    bos.push_back(std::move(sub));
+  }
+
+  auto single_us = latency_us(iterations, [&] {
+    for (auto& range : ranges)
+      range.bo.sync(range.dir, range.size, range.offset);
+  });
+
+  size_t batch_calls = 0;
+  auto batch_us = latency_us(iterations, [&] {
+    batch_calls = xrt::sync(ranges);
+  });
+
+  std::cout << "xrt_bo_sync: sub-buffers synced = " << ranges.size()
+            << ", sub-buffer size (KB) = " << sub_size_kb
+            << ", iterations = " << iterations << "\n";
+  std::cout << std::setw(16) << "" << std::setw(16) << "sync calls" << std::setw(16) << "latency(us)" << "\n";
+  std::cout << std::fixed << std::setprecision(2)
+            << std::setw(16) << "bo.sync()" << std::setw(16) << ranges.size() << std::setw(16) << single_us << "\n"
+            << std::setw(16) << "xrt::sync()" << std::setw(16) << batch_calls << std::setw(16) << batch_us << "\n";
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
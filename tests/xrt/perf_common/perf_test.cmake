@@ -0,0 +1,20 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Common build of the perf_* tests.  Include after ../../CMake/utils.cmake
+# with TESTNAME set to the name of the test directory.
+
+set(XRT_PERF_COMMON_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+# Build and install test executable NAME from SOURCE
+function(xrt_add_perf_test NAME SOURCE)
+  add_executable(${NAME} ${SOURCE})
+  target_include_directories(${NAME} PRIVATE ${XRT_PERF_COMMON_DIR})
+  target_link_libraries(${NAME} PRIVATE ${xrt_coreutil_LIBRARY})
+
+  if (NOT WIN32)
+    target_link_libraries(${NAME} PRIVATE ${uuid_LIBRARY} pthread)
+  endif(NOT WIN32)
+
+  install(TARGETS ${NAME} RUNTIME DESTINATION ${INSTALL_DIR}/${TESTNAME})
+endfunction()
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef xrt_tests_perf_test_h_
+#define xrt_tests_perf_test_h_
+
+////////////////////////////////////////////////////////////////
+// Boilerplate shared by the perf_* tests: command line parsing and
+// the failure reporting of main().
+////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace perf {
+
+using clock_type = std::chrono::high_resolution_clock;
+
+// Parse command line options of the form '<option> <value>', options
+// listed in flags take no value.  The handler is called with each
+// option and its value, or an empty value for a flag, and returns
+// false for an unknown option.  Returns false if -h is given, in
+// which case the test should print its usage.
+template <typename Handler>
+inline bool
+parse_args(int argc, char** argv, const std::vector<std::string>& flags, Handler&& handler)
+{
+  std::string cur;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-h")
+      return false;
+
+    if (std::find(flags.begin(), flags.end(), arg) != flags.end()) {
+      if (!handler(arg, std::string{}))
+        throw std::runtime_error("bad argument '" + arg + "'");
+      continue;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (!handler(cur, arg))
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  return true;
+}
+
+template <typename Handler>
+inline bool
+parse_args(int argc, char** argv, Handler&& handler)
+{
+  return parse_args(argc, argv, {}, std::forward<Handler>(handler));
+}
+
+// Body of main(), runs the test and reports failure
+inline int
+run_main(int argc, char** argv, int (*run)(int, char**))
+{
+  try {
+    return run(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return 1;
+}
+
+} // namespace perf
+
+#endif
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures the overhead of host trace when many threads
+// call XRT native APIs concurrently.  Each thread repeatedly calls
+// xrt::bo::size(), which with native API trace enabled records a
+// start and an end event in the profiling database per call.
+//
+// The test is intended to be run with the noop shim (no hardware)
+// and native API trace enabled in xrt.ini
+//   [Debug]
+//   native_xrt_trace=true
+//
+//   % XCL_EMULATION_MODE=noop xrt_host_trace --threads 32
+////////////////////////////////////////////////////////////////
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "perf_test.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
+using perf::clock_type;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_host_trace [options]\n\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--threads <number>]: max number of calling threads (default: 32)\n";
+  std::cout << "  [--calls <number>]: number of API calls per thread (default: 100000)\n";
+  std::cout << "";
+  std::cout << "* Summary prints API calls per second, time per call, and resident\n";
+  std::cout << "* memory growth for 1, 2, 4, ... up to max number of threads.\n";
+  std::cout << "* With native API trace each call records two trace events, use\n";
+  std::cout << "* --threads 1 --calls 5000000 for a 10M event run\n";
+}
+
+// Resident set size in KB
+static size_t
+get_rss_kb()
+{
+#ifndef _WIN32
+  std::ifstream statm("/proc/self/statm");
+  size_t size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+  return 0;
+#endif
+}
+
+static void
+run(const xrt::device& device, size_t threads, size_t calls)
+{
+  std::vector<xrt::bo> bos;
+  for (size_t t = 0; t < threads; ++t)
+    bos.emplace_back(device, 4096, xrt::bo::flags::host_only, 0);
+
+  std::vector<size_t> sums(threads, 0);
+  std::vector<std::thread> workers;
+  auto rss_start = get_rss_kb();
+  auto start = clock_type::now();
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&bo = bos[t], &sum = sums[t], calls] {
+      for (size_t i = 0; i < calls; ++i)
+        sum += bo.size();
+    });
+  }
+  for (auto& worker : workers)
+    worker.join();
+  auto end = clock_type::now();
+  auto rss_end = get_rss_kb();
+
+  for (auto sum : sums)
+    if (sum != calls * 4096)
+      throw std::runtime_error("unexpected bo size");
+
+  auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  auto total = threads * calls;
+  std::cout << std::setw(8) << threads << std::fixed << std::setprecision(0)
+            << std::setw(16) << total * 1000000.0 / elapsed_us
+            << std::setprecision(3)
+            << std::setw(16) << elapsed_us * 1000.0 * threads / total
+            << std::setw(16) << (rss_end - rss_start) << "\n";
+}
+
+static int
+run(int argc, char** argv)
+{
+  unsigned int device_index = 0;
+  size_t threads = 32;
+  size_t calls = 100000;
+
+  auto parsed = perf::parse_args(argc, argv, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--threads")
+      threads = std::stoi(arg);
+    else if (cur == "--calls")
+      calls = std::stoi(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  if (!threads || !calls)
+    throw std::runtime_error("threads and calls must be greater than 0");
+
+  auto device = xrt::device(device_index);
+
+  std::cout << "xrt_host_trace: calls per thread = " << calls << "\n";
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "calls/s"
+            << std::setw(16) << "ns/call" << std::setw(16) << "rss(KB)" << "\n";
+  for (size_t t = 1; t < threads; t *= 2)
+    run(device, t, calls);
+  run(device, threads, calls);
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
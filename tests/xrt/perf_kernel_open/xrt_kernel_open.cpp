@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures the startup cost of opening kernels in large
+// xclbins.  A synthetic xclbin with a configurable number of kernels
+// and arguments per kernel is generated in memory.  The test reports
+// the time to construct the xclbin and access its kernel meta data,
+// the time to create a hardware context, and the time to open
+// kernels in the hardware context.
+//
+// The test is intended to be run with the noop shim (no hardware)
+//   % XCL_EMULATION_MODE=noop xrt_kernel_open --kernels 500
+////////////////////////////////////////////////////////////////
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "xclbin.h"
+#include "perf_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+# pragma warning ( disable : 4267 )
+#endif
+
+using perf::clock_type;
+
+// Address range of each synthetic CU
+constexpr size_t cu_range = 0x10000;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_kernel_open [options]\n\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernels <number>]: number of kernels in synthetic xclbin (default: 500)\n";
+  std::cout << "  [--args <number>]: number of arguments per kernel (default: 16)\n";
+  std::cout << "  [--open <number>]: number of kernels to open (default: 64)\n";
+  std::cout << "  [--iterations <number>]: number of xclbins to generate and open (default: 5)\n";
+  std::cout << "";
+  std::cout << "* Summary prints average time in ms for each phase of opening kernels\n";
+  std::cout << "* The noop shim supports at most 128 open compute units\n";
+}
+
+static std::string
+kernel_name(size_t kidx)
+{
+  return "k" + std::to_string(kidx);
+}
+
+// EMBEDDED_METADATA with one CU per kernel and scalar arguments
+static std::string
+create_xml(size_t kernels, size_t args)
+{
+  std::ostringstream xml;
+  xml << std::hex << std::showbase;
+  xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      << "<project name=\"synthetic\">\n"
+      << "<platform vendor=\"xilinx\" boardid=\"noop\" name=\"noop\" featureRomTime=\"0\">\n"
+      << "<device name=\"fpga0\" fpgaDevice=\"noop\" addrWidth=\"0\">\n"
+      << "<core name=\"OCL_REGION_0\" target=\"hw\" type=\"clc_region\" clockFreq=\"0MHz\" numComputeUnits=\"" << kernels << "\">\n"
+      << "<kernelClocks><clock port=\"KERNEL_CLK\" frequency=\"500.0MHz\"/></kernelClocks>\n";
+
+  for (size_t kidx = 0; kidx < kernels; ++kidx) {
+    auto name = kernel_name(kidx);
+    xml << "<kernel name=\"" << name << "\" language=\"c\" vlnv=\"xilinx.com:hls:" << name
+        << ":1.0\" preferredWorkGroupSizeMultiple=\"0\" workGroupSize=\"1\" interrupt=\"true\""
+        << " hwControlProtocol=\"ap_ctrl_hs\">\n"
+        << "<port name=\"S_AXI_CONTROL\" mode=\"slave\" range=\"" << cu_range
+        << "\" dataWidth=\"32\" portType=\"addressable\" base=\"0x0\"/>\n";
+
+    for (size_t aidx = 0; aidx < args; ++aidx)
+      xml << "<arg name=\"a" << std::dec << aidx << "\" addressQualifier=\"0\" id=\"" << aidx
+          << "\" port=\"S_AXI_CONTROL\" size=\"0x4\" offset=\"" << std::hex << (0x10 + aidx * 8)
+          << "\" hostOffset=\"0x0\" hostSize=\"0x4\" type=\"int\"/>\n";
+
+    xml << "<instance name=\"" << name << "_1\"><addrRemap base=\"" << (kidx * cu_range)
+        << "\" port=\"S_AXI_CONTROL\"/></instance>\n"
+        << "</kernel>\n";
+  }
+
+  xml << "</core>\n</device>\n</platform>\n</project>\n";
+  return xml.str();
+}
+
+static std::vector<char>
+create_ip_layout(size_t kernels)
+{
+  std::vector<char> data(sizeof(ip_layout) + (kernels - 1) * sizeof(ip_data), 0);
+  auto layout = reinterpret_cast<ip_layout*>(data.data());
+  layout->m_count = static_cast<int32_t>(kernels);
+  for (size_t kidx = 0; kidx < kernels; ++kidx) {
+    auto& ip = layout->m_ip_data[kidx];
+    ip.m_type = IP_KERNEL;
+    ip.properties = (AP_CTRL_HS << IP_CONTROL_SHIFT) | IP_INT_ENABLE_MASK;
+    ip.m_base_address = kidx * cu_range;
+    auto name = kernel_name(kidx) + ":" + kernel_name(kidx) + "_1";
+    std::strncpy(reinterpret_cast<char*>(ip.m_name), name.c_str(), sizeof(ip.m_name) - 1);
+  }
+  return data;
+}
+
+// Synthetic xclbin with a random uuid so that every iteration
+// represents a new xclbin
+static std::vector<char>
+create_xclbin(size_t kernels, size_t args)
+{
+  auto xml = create_xml(kernels, args);
+  auto ips = create_ip_layout(kernels);
+
+  constexpr size_t num_sections = 2;
+  auto align = [](size_t sz) { return (sz + 7) & ~size_t(7); };
+  auto hdr_size = align(sizeof(axlf) + (num_sections - 1) * sizeof(axlf_section_header));
+  auto ips_offset = hdr_size;
+  auto xml_offset = align(ips_offset + ips.size());
+  auto total = xml_offset + xml.size();
+
+  std::vector<char> data(total, 0);
+  auto top = reinterpret_cast<axlf*>(data.data());
+  std::strcpy(top->m_magic, "xclbin2");
+  top->m_signature_length = -1;
+  top->m_header.m_length = total;
+  top->m_header.m_versionMajor = 2;
+  top->m_header.m_mode = XCLBIN_FLAT;
+  top->m_header.m_numSections = num_sections;
+
+  static std::mt19937 rng{std::random_device{}()};
+  for (auto& byte : top->m_header.uuid)
+    byte = static_cast<unsigned char>(rng());
+
+  auto& ips_hdr = top->m_sections[0];
+  ips_hdr.m_sectionKind = IP_LAYOUT;
+  ips_hdr.m_sectionOffset = ips_offset;
+  ips_hdr.m_sectionSize = ips.size();
+  std::memcpy(data.data() + ips_offset, ips.data(), ips.size());
+
+  auto& xml_hdr = top->m_sections[1];
+  xml_hdr.m_sectionKind = EMBEDDED_METADATA;
+  xml_hdr.m_sectionOffset = xml_offset;
+  xml_hdr.m_sectionSize = xml.size();
+  std::memcpy(data.data() + xml_offset, xml.data(), xml.size());
+
+  return data;
+}
+
+static double
+elapsed_ms(clock_type::time_point start, clock_type::time_point end)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+static int
+run(int argc, char** argv)
+{
+  unsigned int device_index = 0;
+  size_t kernels = 500;
+  size_t kargs = 16;
+  size_t open = 64;
+  size_t iterations = 5;
+
+  auto parsed = perf::parse_args(argc, argv, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--kernels")
+      kernels = std::stoi(arg);
+    else if (cur == "--args")
+      kargs = std::stoi(arg);
+    else if (cur == "--open")
+      open = std::stoi(arg);
+    else if (cur == "--iterations")
+      iterations = std::stoi(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  if (!kernels || !iterations)
+    throw std::runtime_error("kernels and iterations must be greater than 0");
+
+  open = std::min(open, kernels);
+  auto device = xrt::device(device_index);
+
+  double xclbin_ms = 0, hwctx_ms = 0, open_ms = 0;
+  for (size_t it = 0; it < iterations; ++it) {
+    auto data = create_xclbin(kernels, kargs);
+
+    auto t0 = clock_type::now();
+    auto xclbin = xrt::xclbin{data};
+    if (xclbin.get_kernels().size() != kernels)
+      throw std::runtime_error("unexpected number of kernels in synthetic xclbin");
+    auto t1 = clock_type::now();
+    auto uuid = device.register_xclbin(xclbin);
+    auto hwctx = xrt::hw_context{device, uuid};
+    auto t2 = clock_type::now();
+    {
+      std::vector<xrt::kernel> kernel_objects;
+      kernel_objects.reserve(open);
+      for (size_t kidx = 0; kidx < open; ++kidx)
+        kernel_objects.emplace_back(hwctx, kernel_name(kidx));
+      auto t3 = clock_type::now();
+      open_ms += elapsed_ms(t2, t3);
+    }
+
+    xclbin_ms += elapsed_ms(t0, t1);
+    hwctx_ms += elapsed_ms(t1, t2);
+  }
+
+  std::cout << "xrt_kernel_open: kernels args open iterations = "
+            << kernels << " " << kargs << " " << open << " " << iterations << "\n";
+  std::cout << std::fixed << std::setprecision(3)
+            << "xclbin meta data (ms): " << xclbin_ms / iterations << "\n"
+            << "hw context (ms):       " << hwctx_ms / iterations << "\n"
+            << "open kernels (ms):     " << open_ms / iterations
+            << " (" << open_ms / iterations / std::max<size_t>(open, 1) << " per kernel)\n";
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
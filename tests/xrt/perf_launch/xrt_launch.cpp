@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures throughput and completion notification latency
+// of managed command execution.  Multiple threads each keep a number
+// of runs in flight.  Every run has a completion callback, which
+// makes it managed by the XRT command monitor.  The latency is the
+// time from xrt::run::start() to the callback being invoked.
+//
+// The test is intended to be run with the noop shim (no hardware)
+// to measure host side overhead of command submission and completion.
+//   % XCL_EMULATION_MODE=noop xrt_launch -k verify.xclbin
+//
+// With --batch, the runs of a thread are started in batches using
+// xrt::start(std::vector<xrt::run>) rather than one at a time.
+////////////////////////////////////////////////////////////////
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+#include "experimental/xrt_kernel.h"
+#include "perf_test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+# pragma warning ( disable : 4267 )
+#endif
+
+using perf::clock_type;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_launch [options]\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to launch (default: hello)\n";
+  std::cout << "  [--threads <number>]: number of launching threads (default: 1)\n";
+  std::cout << "  [--jobs <number>]: number of runs in flight per thread (default: 16)\n";
+  std::cout << "  [--seconds <number>]: number of seconds to run (default: 5)\n";
+  std::cout << "  [--batch <number>]: start runs in batches of this size (default: 0, no batching)\n";
+  std::cout << "";
+  std::cout << "* Summary prints launches per second and notification latency percentiles\n";
+}
+
+// Flag to stop job rescheduling.  Is set to true after
+// specified number of seconds.
+static std::atomic<bool> stop{false};
+
+struct job_type
+{
+  xrt::bo bo;
+  xrt::run run;
+  clock_type::time_point start;
+  std::atomic<bool> notified{false};
+  std::vector<uint64_t> latency_ns;
+
+  job_type(const xrt::device& device, const xrt::kernel& kernel)
+    : bo(device, 1024, kernel.group_id(0))
+    , run(kernel)
+  {
+    run.set_arg(0, bo);
+    run.add_callback(ERT_CMD_STATE_COMPLETED, &job_type::callback, this);
+  }
+
+  static void
+  callback(const void*, ert_cmd_state, void* data)
+  {
+    auto job = static_cast<job_type*>(data);
+    auto end = clock_type::now();
+    job->latency_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - job->start).count());
+    job->notified = true;
+  }
+
+  void
+  launch()
+  {
+    notified = false;
+    start = clock_type::now();
+    run.start();
+  }
+
+  // Prepare for launch as part of a batch
+  void
+  prep_launch()
+  {
+    notified = false;
+    start = clock_type::now();
+  }
+
+  void
+  wait()
+  {
+    run.wait();
+
+    // The run is marked done before callbacks are invoked
+    while (!notified)
+      std::this_thread::yield();
+  }
+};
+
+struct thread_result
+{
+  size_t launches = 0;
+  std::vector<uint64_t> latency_ns;
+};
+
+// Launch jobs in batches of specified size
+static void
+launch_batched(std::vector<std::unique_ptr<job_type>>& jobs, size_t batch, thread_result& result)
+{
+  std::vector<xrt::run> runs;
+  runs.reserve(batch);
+  for (auto& job : jobs) {
+    job->prep_launch();
+    runs.push_back(job->run);
+    if (runs.size() == batch) {
+      xrt::start(runs);
+      result.launches += runs.size();
+      runs.clear();
+    }
+  }
+
+  if (!runs.empty()) {
+    xrt::start(runs);
+    result.launches += runs.size();
+  }
+}
+
+static thread_result
+run_thread(const xrt::device& device, const xrt::kernel& kernel, size_t num_jobs, size_t batch)
+{
+  std::vector<std::unique_ptr<job_type>> jobs;
+  for (size_t i = 0; i < num_jobs; ++i)
+    jobs.emplace_back(std::make_unique<job_type>(device, kernel));
+
+  thread_result result;
+  if (batch) {
+    launch_batched(jobs, batch, result);
+    while (!stop) {
+      for (auto& job : jobs)
+        job->wait();
+      launch_batched(jobs, batch, result);
+    }
+  }
+  else {
+    for (auto& job : jobs) {
+      job->launch();
+      ++result.launches;
+    }
+
+    while (!stop) {
+      for (auto& job : jobs) {
+        job->wait();
+        job->launch();
+        ++result.launches;
+      }
+    }
+  }
+
+  for (auto& job : jobs) {
+    job->wait();
+    result.latency_ns.insert(result.latency_ns.end(), job->latency_ns.begin(), job->latency_ns.end());
+  }
+
+  return result;
+}
+
+static uint64_t
+percentile(const std::vector<uint64_t>& sorted, double pct)
+{
+  if (sorted.empty())
+    return 0;
+  auto idx = static_cast<size_t>(pct / 100.0 * (sorted.size() - 1));
+  return sorted[idx];
+}
+
+static void
+run(const xrt::device& device, const xrt::kernel& kernel, size_t threads, size_t jobs, size_t batch, size_t seconds)
+{
+  std::vector<std::future<thread_result>> futures;
+  for (size_t i = 0; i < threads; ++i)
+    futures.emplace_back(std::async(std::launch::async, run_thread, device, kernel, jobs, batch));
+
+  auto start = clock_type::now();
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  stop = true;
+
+  size_t launches = 0;
+  std::vector<uint64_t> latency_ns;
+  for (auto& f : futures) {
+    auto result = f.get();
+    launches += result.launches;
+    latency_ns.insert(latency_ns.end(), result.latency_ns.begin(), result.latency_ns.end());
+  }
+  auto end = clock_type::now();
+  auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+  std::sort(latency_ns.begin(), latency_ns.end());
+  std::cout << "xrt_launch: threads jobs batch seconds launches = "
+            << threads << " " << jobs << " " << batch << " " << seconds << " " << launches << "\n";
+  std::cout << "launches/s: " << std::fixed << std::setprecision(0)
+            << (launches * 1000000.0 / elapsed_us) << "\n";
+  std::cout << "notify latency (us) p50 p99 p999 max: "
+            << std::setprecision(2)
+            << percentile(latency_ns, 50) / 1000.0 << " "
+            << percentile(latency_ns, 99) / 1000.0 << " "
+            << percentile(latency_ns, 99.9) / 1000.0 << " "
+            << (latency_ns.empty() ? 0 : latency_ns.back()) / 1000.0 << "\n";
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::string xclbin_fnm;
+  std::string kname = "hello";
+  unsigned int device_index = 0;
+  size_t secs = 5;
+  size_t jobs = 16;
+  size_t threads = 1;
+  size_t batch = 0;
+
+  auto parsed = perf::parse_args(argc, argv, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "--kernel")
+      kname = arg;
+    else if (cur == "--jobs")
+      jobs = std::stoi(arg);
+    else if (cur == "--threads")
+      threads = std::stoi(arg);
+    else if (cur == "--seconds")
+      secs = std::stoi(arg);
+    else if (cur == "--batch")
+      batch = std::stoi(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+  auto kernel = xrt::kernel(device, uuid, kname);
+
+  run(device, kernel, threads, jobs, batch, secs);
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
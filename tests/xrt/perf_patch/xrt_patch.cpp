@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures the cost of patching kernel arguments into
+// the control code of a kernel created from an ELF module.  Every
+// xrt::run::set_arg() of such a kernel patches the argument into
+// the control code of the run.  The test sets all arguments of a
+// run per iteration and reports the time per run and per argument.
+//
+// Buffer arguments are alternated between two buffer objects so
+// that every iteration patches a new address.  With --changed only
+// the first number of buffer arguments are changed per iteration,
+// and with --start each run is started and waited on, which syncs
+// the patched control code to device.  On the noop shim, the number
+// of synced bytes is reported when the device is closed.
+//   % xrt_patch -k design.xclbin -e control.elf --kernel DPU
+//   % XCL_EMULATION_MODE=noop xrt_patch -k design.xclbin -e control.elf --changed 1 --start
+////////////////////////////////////////////////////////////////
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "experimental/xrt_elf.h"
+#include "experimental/xrt_ext.h"
+#include "experimental/xrt_module.h"
+#include "experimental/xrt_xclbin.h"
+#include "perf_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+# pragma warning ( disable : 4267 )
+#endif
+
+using perf::clock_type;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_patch [options]\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -e <elf>: ELF with control code for kernel\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to patch (default: DPU)\n";
+  std::cout << "  [--iterations <number>]: number of runs to patch (default: 100000)\n";
+  std::cout << "  [--changed <number>]: number of buffer arguments changed per run (default: all)\n";
+  std::cout << "  [--start]: start and wait for each run after patching\n";
+  std::cout << "";
+  std::cout << "* Summary prints time per run in us\n";
+}
+
+static bool
+is_buffer(const xrt::xclbin::arg& arg)
+{
+  return arg.get_host_type().find('*') != std::string::npos;
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::string xclbin_fnm;
+  std::string elf_fnm;
+  std::string kname = "DPU";
+  unsigned int device_index = 0;
+  size_t iterations = 100000;
+  size_t changed = std::numeric_limits<size_t>::max();
+  bool start_runs = false;
+
+  auto parsed = perf::parse_args(argc, argv, {"--start"}, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "--start")
+      start_runs = true;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-e")
+      elf_fnm = arg;
+    else if (cur == "--kernel")
+      kname = arg;
+    else if (cur == "--iterations")
+      iterations = std::stoi(arg);
+    else if (cur == "--changed")
+      changed = std::stoi(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  if (!iterations)
+    throw std::runtime_error("iterations must be greater than 0");
+
+  auto device = xrt::device(device_index);
+  auto xclbin = xrt::xclbin(xclbin_fnm);
+  auto uuid = device.register_xclbin(xclbin);
+  auto hwctx = xrt::hw_context(device, uuid);
+  auto module = xrt::module(xrt::elf(elf_fnm));
+  auto kernel = xrt::ext::kernel(hwctx, module, kname);
+  auto run = xrt::run(kernel);
+
+  // Two buffers per buffer argument, alternated between iterations.
+  // Argument indices need not be dense, so buffers are keyed by index.
+  auto xargs = xclbin.get_kernel(kname).get_args();
+  std::map<size_t, std::pair<xrt::bo, xrt::bo>> bos;
+  for (const auto& xarg : xargs) {
+    if (!is_buffer(xarg))
+      continue;
+    auto idx = xarg.get_index();
+    bos[idx] = {xrt::ext::bo(hwctx, 4096), xrt::ext::bo(hwctx, 4096)};
+  }
+
+  // Set all arguments in first iteration, then only the first
+  // number of changed buffer arguments
+  auto set_args = [&](size_t iteration) {
+    size_t buffers = 0;
+    for (const auto& xarg : xargs) {
+      auto idx = xarg.get_index();
+      if (!is_buffer(xarg)) {
+        if (!iteration)
+          run.set_arg(idx, static_cast<uint32_t>(idx));
+        continue;
+      }
+      if (iteration && buffers++ >= changed)
+        continue;
+      const auto& [first, second] = bos.at(idx);
+      run.set_arg(idx, (iteration & 1) ? first : second);
+    }
+  };
+
+  // warm up, first patch of an argument resolves its patchers
+  set_args(0);
+  if (start_runs) {
+    run.start();
+    run.wait();
+  }
+
+  auto start = clock_type::now();
+  for (size_t it = 1; it <= iterations; ++it) {
+    set_args(it);
+    if (start_runs) {
+      run.start();
+      run.wait();
+    }
+  }
+  auto end = clock_type::now();
+
+  auto elapsed_us = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1000.0;
+  std::cout << "xrt_patch: kernel args iterations start = "
+            << kname << " " << xargs.size() << " " << iterations << " " << start_runs << "\n";
+  std::cout << std::fixed << std::setprecision(3)
+            << "time per run (us): " << elapsed_us / iterations << "\n";
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
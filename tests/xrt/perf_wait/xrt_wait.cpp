@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures the latency of waiting for run completion
+// with each of the wait policies in xrt::wait_policy.  The latency
+// is the time from xrt::run::start() until xrt::run::wait() returns.
+//
+// The test is intended to be run with the noop shim (no hardware)
+// and a completion delay to model asynchronous command completion.
+//   % XCL_EMULATION_MODE=noop xrt_wait -k verify.xclbin
+////////////////////////////////////////////////////////////////
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+#include "experimental/xrt_kernel.h"
+#include "perf_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+# pragma warning ( disable : 4267 )
+#endif
+
+using perf::clock_type;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_wait [options]\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to launch (default: hello)\n";
+  std::cout << "  [--iterations <number>]: number of start/wait per policy (default: 10000)\n";
+  std::cout << "";
+  std::cout << "* Summary prints wait latency percentiles and cpu time per wait for each wait policy\n";
+}
+
+static uint64_t
+percentile(const std::vector<uint64_t>& sorted, double pct)
+{
+  if (sorted.empty())
+    return 0;
+  auto idx = static_cast<size_t>(pct / 100.0 * (sorted.size() - 1));
+  return sorted[idx];
+}
+
+static void
+run(xrt::run& run, const std::string& name, xrt::wait_policy policy, size_t iterations)
+{
+  xrt::set_wait_policy(run, policy);
+
+  // warm up, lets adaptive spinning observe completion times
+  for (size_t i = 0; i < 100; ++i) {
+    run.start();
+    run.wait();
+  }
+
+  std::vector<uint64_t> latency_ns;
+  latency_ns.reserve(iterations);
+  auto cpu_start = std::clock();
+  for (size_t i = 0; i < iterations; ++i) {
+    auto start = clock_type::now();
+    run.start();
+    run.wait();
+    auto end = clock_type::now();
+    latency_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+  auto cpu_us = (std::clock() - cpu_start) * 1000000.0 / CLOCKS_PER_SEC;
+
+  std::sort(latency_ns.begin(), latency_ns.end());
+  std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << percentile(latency_ns, 50) / 1000.0
+            << std::setw(10) << percentile(latency_ns, 99) / 1000.0
+            << std::setw(10) << latency_ns.back() / 1000.0
+            << std::setw(10) << cpu_us / iterations << "\n";
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::string xclbin_fnm;
+  std::string kname = "hello";
+  unsigned int device_index = 0;
+  size_t iterations = 10000;
+
+  auto parsed = perf::parse_args(argc, argv, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "--kernel")
+      kname = arg;
+    else if (cur == "--iterations")
+      iterations = std::stoi(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  if (!iterations)
+    throw std::runtime_error("iterations must be greater than 0");
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+  auto kernel = xrt::kernel(device, uuid, kname);
+  auto bo = xrt::bo(device, 1024, kernel.group_id(0));
+  auto run = xrt::run(kernel);
+  run.set_arg(0, bo);
+
+  const std::vector<std::pair<std::string, xrt::wait_policy>> policies {
+    {"block", xrt::wait_policy::block},
+    {"spin_then_block", xrt::wait_policy::spin_then_block},
+    {"busy_poll", xrt::wait_policy::busy_poll}
+  };
+
+  std::cout << "xrt_wait: iterations = " << iterations << "\n";
+  std::cout << std::left << std::setw(16) << "policy" << std::right
+            << std::setw(10) << "p50(us)" << std::setw(10) << "p99(us)"
+            << std::setw(10) << "max(us)" << std::setw(10) << "cpu(us)" << "\n";
+  for (const auto& [name, policy] : policies)
+    ::run(run, name, policy, iterations);
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
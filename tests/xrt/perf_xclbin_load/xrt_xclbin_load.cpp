@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+////////////////////////////////////////////////////////////////
+// This test measures the time and memory used to construct
+// xrt::xclbin objects from an xclbin file.
+//
+// In file mode the xclbin is constructed from the file name, which
+// maps the file read-only into memory with xrt.ini
+// Runtime.xclbin_mmap=true.  In vector mode the file is read into a
+// std::vector<char> from which the xclbin is constructed, this is
+// equivalent to constructing from a file by default.
+//
+// The test holds a number of xclbin objects at the same time to
+// show how resident memory scales with the number of objects.
+//   % xrt_xclbin_load -k large.xclbin --mode file --count 8
+////////////////////////////////////////////////////////////////
+#include "experimental/xrt_xclbin.h"
+#include "perf_test.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
+using perf::clock_type;
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_xclbin_load [options]\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  [--mode <file|vector>]: construct from file name or from data read into vector (default: file)\n";
+  std::cout << "  [--count <number>]: number of xclbin objects to hold at the same time (default: 8)\n";
+  std::cout << "";
+  std::cout << "* Summary prints construction time and resident memory growth\n";
+}
+
+// Resident set size in KB
+static size_t
+get_rss_kb()
+{
+#ifndef _WIN32
+  std::ifstream statm("/proc/self/statm");
+  size_t size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+  return 0;
+#endif
+}
+
+static std::vector<char>
+read_file(const std::string& fnm)
+{
+  std::ifstream stream(fnm, std::ios::binary);
+  if (!stream)
+    throw std::runtime_error("Failed to open file '" + fnm + "' for reading");
+
+  stream.seekg(0, stream.end);
+  size_t size = stream.tellg();
+  stream.seekg(0, stream.beg);
+
+  std::vector<char> data(size);
+  stream.read(data.data(), size);
+  return data;
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::string xclbin_fnm;
+  std::string mode = "file";
+  size_t count = 8;
+
+  auto parsed = perf::parse_args(argc, argv, [&](const std::string& cur, const std::string& arg) {
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "--mode")
+      mode = arg;
+    else if (cur == "--count")
+      count = std::stoi(arg);
+    else
+      return false;
+    return true;
+  });
+  if (!parsed) {
+    usage();
+    return 1;
+  }
+
+  if (mode != "file" && mode != "vector")
+    throw std::runtime_error("bad mode '" + mode + "'");
+
+  if (!count)
+    throw std::runtime_error("count must be greater than 0");
+
+  std::vector<xrt::xclbin> xclbins;
+  xclbins.reserve(count);
+
+  auto rss_start = get_rss_kb();
+  auto start = clock_type::now();
+  for (size_t i = 0; i < count; ++i) {
+    auto xclbin = (mode == "file")
+      ? xrt::xclbin{xclbin_fnm}
+      : xrt::xclbin{read_file(xclbin_fnm)};
+
+    // access meta data as done when loading the xclbin
+    xclbin.get_kernels();
+    xclbin.get_mems();
+    xclbins.push_back(std::move(xclbin));
+  }
+  auto end = clock_type::now();
+  auto rss_end = get_rss_kb();
+
+  auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  std::cout << "xrt_xclbin_load: mode count = " << mode << " " << count << "\n";
+  std::cout << std::fixed << std::setprecision(3)
+            << "load time per xclbin (ms): " << elapsed_us / 1000.0 / count << "\n"
+            << "rss growth (KB): " << (rss_end - rss_start)
+            << " (" << (rss_end - rss_start) / count << " per xclbin)\n";
+
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  return perf::run_main(argc, argv, run);
+}
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "experimental/xrt_kernel.h"
+
+// Verify that xrt::run::wait() returns the completed state of a run
+// with every wait policy, whether the policy is set on the run or
+// inherited from its hardware context, with and without a timeout,
+// and for runs with and without completion callbacks.
+//
+// The test can be run without hardware using the noop shim
+// % XCL_EMULATION_MODE=noop wait_policy -k verify.xclbin
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o wait_policy.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] -k <bitstream>\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  [--kernel <name>]: kernel to run (default: hello)\n";
+  std::cout << "  [--iterations <number>]: runs per policy (default: 100)\n";
+  std::cout << "  -h\n\n";
+  std::cout << "* Bitstream is required\n";
+}
+
+static const char*
+to_string(xrt::wait_policy policy)
+{
+  switch (policy) {
+  case xrt::wait_policy::inherit:
+    return "inherit";
+  case xrt::wait_policy::block:
+    return "block";
+  case xrt::wait_policy::spin_then_block:
+    return "spin_then_block";
+  case xrt::wait_policy::busy_poll:
+    return "busy_poll";
+  }
+  return "unknown";
+}
+
+static void
+callback(const void*, ert_cmd_state, void*)
+{}
+
+static void
+run_policy(xrt::run& run, const std::string& what, size_t iterations)
+{
+  for (size_t i = 0; i < iterations; ++i) {
+    run.start();
+    auto state = (i % 2) ? run.wait(std::chrono::seconds(10)) : run.wait();
+    if (state != ERT_CMD_STATE_COMPLETED)
+      throw std::runtime_error(what + ": run completed with state " + std::to_string(state));
+  }
+}
+
+static void
+run(const xrt::device& device, const xrt::uuid& uuid, const std::string& kname, size_t iterations)
+{
+  static const std::vector<xrt::wait_policy> policies {
+    xrt::wait_policy::block,
+    xrt::wait_policy::spin_then_block,
+    xrt::wait_policy::busy_poll
+  };
+
+  xrt::hw_context hwctx{device, uuid};
+  xrt::kernel kernel{hwctx, kname};
+  xrt::bo bo(device, 1024, kernel.group_id(0));
+
+  xrt::run unmanaged{kernel};
+  unmanaged.set_arg(0, bo);
+
+  xrt::run managed{kernel};
+  managed.set_arg(0, bo);
+  managed.add_callback(ERT_CMD_STATE_COMPLETED, callback, nullptr);
+
+  // Policy of the run object
+  for (auto policy : policies) {
+    xrt::set_wait_policy(unmanaged, policy);
+    xrt::set_wait_policy(managed, policy);
+    run_policy(unmanaged, std::string{"run "} + to_string(policy), iterations);
+    run_policy(managed, std::string{"managed run "} + to_string(policy), iterations);
+  }
+
+  // Policy inherited from the hw context
+  xrt::set_wait_policy(unmanaged, xrt::wait_policy::inherit);
+  xrt::set_wait_policy(managed, xrt::wait_policy::inherit);
+  for (auto policy : policies) {
+    xrt::set_wait_policy(hwctx, policy);
+    run_policy(unmanaged, std::string{"hwctx "} + to_string(policy), iterations);
+    run_policy(managed, std::string{"managed hwctx "} + to_string(policy), iterations);
+  }
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  std::string kname = "hello";
+  unsigned int device_index = 0;
+  size_t iterations = 100;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "--kernel")
+      kname = arg;
+    else if (cur == "--iterations")
+      iterations = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("No xclbin specified");
+
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xclbin_fnm);
+
+  run(device, uuid, kname, iterations);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "experimental/xrt_ini.h"
+#include "experimental/xrt_xclbin.h"
+
+// Verify that xrt::xclbin objects constructed from a file hold the
+// content of the file, whether the file is read or mapped.  With
+// --mmap the test enables Runtime.xclbin_mmap, which maps the file
+// read-only rather than reading it.
+//
+// Several xclbin objects of the same file are held at the same time,
+// some are released, and the remaining ones must still hold the file
+// content.
+//
+// No device is needed
+// % xclbin_load -k verify.xclbin
+// % xclbin_load -k verify.xclbin --mmap
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o xclbin_load.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] -k <bitstream>\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  [--mmap]: map the xclbin file rather than reading it\n";
+  std::cout << "  [--count <number>]: number of xclbin objects to hold (default: 8)\n";
+  std::cout << "  -h\n\n";
+  std::cout << "* Bitstream is required\n";
+}
+
+static std::vector<char>
+read_file(const std::string& fnm)
+{
+  std::ifstream stream(fnm, std::ios::binary);
+  if (!stream)
+    throw std::runtime_error("Failed to open " + fnm);
+
+  return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+static void
+check(const xrt::xclbin& xclbin, const std::vector<char>& data, const xrt::uuid& uuid)
+{
+  if (xclbin.get_uuid() != uuid)
+    throw std::runtime_error("uuid mismatch");
+
+  auto top = xclbin.get_axlf();
+  if (top->m_header.m_length != data.size())
+    throw std::runtime_error("axlf length " + std::to_string(top->m_header.m_length)
+                             + " does not match file size " + std::to_string(data.size()));
+
+  if (std::memcmp(top, data.data(), data.size()))
+    throw std::runtime_error("axlf content does not match file content");
+}
+
+static void
+run(const std::string& xclbin_fnm, size_t count)
+{
+  auto data = read_file(xclbin_fnm);
+  auto uuid = xrt::xclbin{data}.get_uuid();
+
+  std::vector<xrt::xclbin> xclbins;
+  for (size_t i = 0; i < count; ++i)
+    xclbins.emplace_back(xclbin_fnm);
+
+  for (const auto& xclbin : xclbins)
+    check(xclbin, data, uuid);
+
+  // Release every other xclbin, the others are not affected
+  std::vector<xrt::xclbin> remaining;
+  for (size_t i = 0; i < xclbins.size(); i += 2)
+    remaining.push_back(xclbins[i]);
+  xclbins.clear();
+
+  for (const auto& xclbin : remaining)
+    check(xclbin, data, uuid);
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  size_t count = 8;
+  bool mmap = false;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+    else if (arg == "--mmap") {
+      mmap = true;
+      continue;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "--count")
+      count = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("No xclbin specified");
+
+  // Must be set before the first xclbin is constructed
+  xrt::ini::set("Runtime.xclbin_mmap", mmap ? "true" : "false");
+
+  run(xclbin_fnm, count);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}
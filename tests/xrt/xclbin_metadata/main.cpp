@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "experimental/xrt_xclbin.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+
+// Verify the kernel meta data of an xclbin, which is parsed from the
+// XML section once and shared by all users of the same xclbin.
+//
+// - xclbin objects constructed from the file and from a copy of its
+//   data report the same kernels and arguments.
+// - an xclbin with the same uuid but different XML meta data reports
+//   its own meta data, not the meta data of an earlier xclbin.
+// - kernel objects report the argument offsets of the xclbin.
+//
+// The test can be run without hardware using the noop shim
+// % XCL_EMULATION_MODE=noop xclbin_metadata -k verify.xclbin
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o xclbin_metadata.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+  std::cout << "usage: %s [options] -k <bitstream>\n\n";
+  std::cout << "  -k <bitstream>\n";
+  std::cout << "  -d <device_index>\n";
+  std::cout << "  -h\n\n";
+  std::cout << "* Bitstream is required\n";
+}
+
+static std::vector<char>
+read_file(const std::string& fnm)
+{
+  std::ifstream stream(fnm, std::ios::binary);
+  if (!stream)
+    throw std::runtime_error("Failed to open " + fnm);
+
+  return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+static void
+compare(const xrt::xclbin& expect, const xrt::xclbin& actual)
+{
+  auto ekernels = expect.get_kernels();
+  auto akernels = actual.get_kernels();
+  if (ekernels.size() != akernels.size())
+    throw std::runtime_error("kernel count mismatch");
+
+  for (size_t k = 0; k < ekernels.size(); ++k) {
+    auto kname = ekernels[k].get_name();
+    if (kname != akernels[k].get_name())
+      throw std::runtime_error("kernel name mismatch " + kname);
+
+    auto eargs = ekernels[k].get_args();
+    auto aargs = akernels[k].get_args();
+    if (eargs.size() != aargs.size())
+      throw std::runtime_error("argument count mismatch for kernel " + kname);
+
+    for (size_t a = 0; a < eargs.size(); ++a) {
+      const auto& earg = eargs[a];
+      const auto& aarg = aargs[a];
+      if (earg.get_name() != aarg.get_name()
+          || earg.get_index() != aarg.get_index()
+          || earg.get_offset() != aarg.get_offset()
+          || earg.get_size() != aarg.get_size())
+        throw std::runtime_error("argument mismatch for " + kname + "." + earg.get_name());
+    }
+  }
+}
+
+// Name of first argument of first kernel with arguments
+static std::string
+first_arg_name(const xrt::xclbin& xclbin)
+{
+  for (const auto& kernel : xclbin.get_kernels())
+    for (const auto& arg : kernel.get_args())
+      return arg.get_name();
+
+  throw std::runtime_error("xclbin has no kernel arguments");
+}
+
+// Same uuid and XML size as the original, but different meta data.
+// The first argument name in the XML is changed in place.
+static std::vector<char>
+modify_arg_name(std::vector<char> data, const std::string& name)
+{
+  auto pattern = "<arg name=\"" + name + "\"";
+  auto itr = std::search(data.begin(), data.end(), pattern.begin(), pattern.end());
+  if (itr == data.end())
+    throw std::runtime_error("argument '" + name + "' not found in XML");
+
+  auto& ch = *(itr + pattern.size() - name.size() - 1);
+  ch = std::isupper(static_cast<unsigned char>(ch)) ? 'a' : 'A';
+  return data;
+}
+
+static void
+run(const std::string& xclbin_fnm, unsigned int device_index)
+{
+  auto data = read_file(xclbin_fnm);
+  xrt::xclbin xfile{xclbin_fnm};
+  auto name = first_arg_name(xfile);
+
+  // Meta data from a copy of the data is the same
+  {
+    xrt::xclbin xdata{data};
+    if (xdata.get_uuid() != xfile.get_uuid())
+      throw std::runtime_error("uuid mismatch");
+    compare(xfile, xdata);
+  }
+
+  // The buffer of the released xclbin is likely reused for this one
+  auto modified = modify_arg_name(data, name);
+  {
+    xrt::xclbin xmod{modified};
+    if (xmod.get_uuid() != xfile.get_uuid())
+      throw std::runtime_error("uuid mismatch");
+    auto mname = first_arg_name(xmod);
+    if (mname == name)
+      throw std::runtime_error("stale meta data, argument name '" + mname + "' was not changed");
+  }
+
+  // Kernel objects report the argument offsets of the xclbin
+  auto device = xrt::device(device_index);
+  auto uuid = device.load_xclbin(xfile);
+  for (const auto& xkernel : xfile.get_kernels()) {
+    if (xkernel.get_cus().empty())
+      continue;
+
+    xrt::kernel kernel{device, uuid, xkernel.get_name()};
+    for (const auto& arg : xkernel.get_args()) {
+      auto idx = static_cast<int>(arg.get_index());
+      if (kernel.offset(idx) != arg.get_offset())
+        throw std::runtime_error("offset mismatch for " + xkernel.get_name() + "." + arg.get_name());
+    }
+  }
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  unsigned int device_index = 0;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("No xclbin specified");
+
+  run(xclbin_fnm, device_index);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+  }
+  catch (...) {
+    std::cout << "FAILED TEST\n";
+  }
+  return 1;
+}